@@ -11,8 +11,15 @@ class NodeServer
 public:
     using UPtr = std::unique_ptr<NodeServer>;
 
-    NodeServer(const RPCServer::Ptr& pForeignServer, const RPCServer::Ptr& pOwnerServer)
-        : m_pForeignServer(pForeignServer), m_pOwnerServer(pOwnerServer)
+    NodeServer(
+        const RPCServer::Ptr& pForeignServer,
+        const RPCServer::Ptr& pOwnerServer,
+        const RPCServer::Ptr& pFastForeignServer,
+        const RPCServer::Ptr& pFastOwnerServer)
+        : m_pForeignServer(pForeignServer),
+        m_pOwnerServer(pOwnerServer),
+        m_pFastForeignServer(pFastForeignServer),
+        m_pFastOwnerServer(pFastOwnerServer)
     {
         LOG_INFO("Starting node server");
     }
@@ -22,8 +29,13 @@ public:
         LOG_INFO("Shutting down node server");
     }
 
+    //
+    // pFastLaneServer is optional. When provided, it serves only the cheap methods (tip, status, pool sizes)
+    // on its own civetweb worker pool.
+    //
     static NodeServer::UPtr Create(
         const ServerPtr& pServer,
+        const ServerPtr& pFastLaneServer,
         const IBlockChain::Ptr& pBlockChain,
         const IP2PServerPtr& pP2PServer,
         const std::weak_ptr<ITxHashSet>& pTxHashSet,
@@ -33,4 +45,6 @@ public:
 private:
     RPCServer::Ptr m_pForeignServer;
     RPCServer::Ptr m_pOwnerServer;
+    RPCServer::Ptr m_pFastForeignServer;
+    RPCServer::Ptr m_pFastOwnerServer;
 };
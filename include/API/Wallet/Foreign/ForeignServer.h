@@ -40,7 +40,8 @@ public:
         const std::shared_ptr<ITorProcess>& pTorProcess,
         IWalletManager& walletManager,
         const SessionToken& token,
-        const int currentAddressIndex
+        const int currentAddressIndex,
+        const ServerOptions& options
     );
 
     uint16_t GetPortNumber() const noexcept { return m_pRPCServer->GetPortNumber(); }
@@ -17,7 +17,8 @@ public:
     // TODO: Add e2e encryption
     static OwnerServer::UPtr Create(
         const std::shared_ptr<ITorProcess>& pTorProcess,
-        const std::shared_ptr<IWalletManager>& pWalletManager
+        const std::shared_ptr<IWalletManager>& pWalletManager,
+        const ServerOptions& options
     );
 
 private:
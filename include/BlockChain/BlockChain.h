@@ -12,12 +12,14 @@
 #include <BlockChain/ChainType.h>
 #include <Core/Models/BlockHeader.h>
 #include <Core/Models/Transaction.h>
+#include <Core/Models/ShortId.h>
 #include <Core/Traits/Lockable.h>
 #include <Crypto/Models/BigInteger.h>
 #include <PMMR/HeaderMMR.h>
 #include <filesystem.h>
 
 #include <vector>
+#include <set>
 #include <memory>
 
 // Forward Declarations
@@ -49,13 +51,34 @@ public:
 	virtual uint64_t GetTotalDifficulty(const EChainType chainType) const = 0;
 
 	virtual EBlockChainStatus AddBlock(const FullBlock& block) = 0;
-	virtual EBlockChainStatus AddCompactBlock(const CompactBlock& compactBlock) = 0;
+
+	//
+	// Hydrates the compact block from the given txs, e.g. ones requested from the peer that sent it,
+	// and from the mempool for the rest. Returns TRANSACTIONS_MISSING if it couldn't be hydrated into a valid block.
+	//
+	virtual EBlockChainStatus AddCompactBlock(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions) = 0;
 
 	virtual fs::path SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) = 0;
+
+	//
+	// Prunes outputs and rangeproofs spent before the horizon from the TxHashSet.
+	// The compacted PMMR files are written under the chain state read lock. The write lock is only taken to copy over
+	// anything appended since and to swap the files in.
+	//
+	virtual void CompactTxHashSet() = 0;
 	virtual EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus) = 0;
 	virtual EBlockChainStatus AddTransaction(TransactionPtr pTransaction, const EPoolType poolType) = 0;
 	virtual TransactionPtr GetTransactionByKernelHash(const Hash& kernelHash) const = 0;
 
+	//
+	// Returns the mempool txs with a kernel matching one of the short ids of the given block.
+	//
+	virtual std::vector<TransactionPtr> GetTransactionsByShortId(
+		const Hash& blockHash,
+		const uint64_t nonce,
+		const std::set<ShortId>& shortIds
+	) const = 0;
+
 	virtual EBlockChainStatus AddBlockHeader(BlockHeaderPtr pBlockHeader) = 0;
 
 	//
@@ -93,6 +116,16 @@ public:
 	//
 	virtual std::vector<BlockHeaderPtr> GetBlockHeadersByHash(const std::vector<Hash>& blockHeaderHashes) const = 0;
 
+	//
+	// Returns the block headers from firstHeight to lastHeight (inclusive), in ascending order, taking the chain lock once.
+	// Stops at the first missing header, so fewer headers than requested may be returned.
+	//
+	virtual std::vector<BlockHeaderPtr> GetBlockHeadersByHeight(
+		const uint64_t firstHeight,
+		const uint64_t lastHeight,
+		const EChainType chainType
+	) const = 0;
+
 	//
 	// Creates a compact block to represent the block with the given hash, if it exists.
 	//
@@ -129,6 +162,18 @@ public:
 	//
 	virtual std::vector<std::pair<uint64_t, Hash>> GetBlocksNeeded(const uint64_t maxNumBlocks) const = 0;
 
+	//
+	// Builds a block on top of the confirmed tip, containing the given txs and coinbase.
+	// Everything but the proof of work is filled in, including the roots, the total difficulty and the secondary scaling.
+	// The txs must not conflict with each other, and may only spend outputs that are unspent, or created by another of the txs.
+	// Returns nullptr if the TxHashSet isn't available yet, or if the txs can't be applied to the tip.
+	//
+	virtual std::unique_ptr<FullBlock> BuildBlockTemplate(
+		const std::vector<TransactionPtr>& transactions,
+		const TransactionOutput& coinbaseOutput,
+		const TransactionKernel& coinbaseKernel
+	) const = 0;
+
 	virtual bool ProcessNextOrphanBlock() = 0;
 	virtual bool HasOrphan(const Hash& blockHash) const = 0;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <deque>
 #include <vector>
 #include <thread>
@@ -138,9 +139,19 @@ public:
 		}
 
 		m_deque.push_back(std::move(item));
+		writeLock.unlock();
+		m_conditional.notify_one();
 		return true;
 	}
 
+	// Blocks until the queue is non-empty or the timeout expires. Returns true if the queue has items.
+	template<class Rep, class Period>
+	bool wait_for_items(const std::chrono::duration<Rep, Period>& timeout) const
+	{
+		std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+		return m_conditional.wait_for(writeLock, timeout, [this] { return !m_deque.empty(); });
+	}
+
 	size_t size() const noexcept
 	{
 		std::shared_lock<std::shared_mutex> read_lock(m_mutex);
@@ -150,5 +161,5 @@ public:
 private:
 	std::deque<T> m_deque;
 	mutable std::shared_mutex m_mutex;
-	std::condition_variable m_conditional;
+	mutable std::condition_variable_any m_conditional;
 };
\ No newline at end of file
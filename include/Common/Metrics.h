@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+//
+// Process-wide counters, gauges and latency histograms, exported in the Prometheus text format.
+//
+// Metrics are registered once, typically into a function-local static reference.
+// After that, updating them is a handful of relaxed atomic operations, so they're cheap enough for hot paths.
+// Values that already live elsewhere (queue depths, per-peer traffic) are reported by collectors at scrape time instead.
+//
+// Ex:
+//     static Metrics::Counter& s_received = Metrics::Registry::Get().AddCounter(
+//         "grinpp_blocks_received_total", "Blocks received from peers"
+//     );
+//     s_received.Increment();
+//
+namespace Metrics
+{
+	using Labels = std::vector<std::pair<std::string, std::string>>;
+
+	class Counter
+	{
+	public:
+		void Increment(const uint64_t amount = 1) noexcept { m_value.fetch_add(amount, std::memory_order_relaxed); }
+		uint64_t Get() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<uint64_t> m_value{ 0 };
+	};
+
+	class Gauge
+	{
+	public:
+		void Set(const int64_t value) noexcept { m_value.store(value, std::memory_order_relaxed); }
+		void Add(const int64_t amount) noexcept { m_value.fetch_add(amount, std::memory_order_relaxed); }
+		int64_t Get() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<int64_t> m_value{ 0 };
+	};
+
+	//
+	// Histogram of durations, with fixed bucket bounds in seconds.
+	// Bucket counts are kept per bucket (not cumulative) so an observation only touches one of them.
+	//
+	class Histogram
+	{
+	public:
+		struct Snapshot
+		{
+			std::vector<double> bounds;
+			std::vector<uint64_t> cumulative; // One per bound, plus +Inf.
+			uint64_t count;
+			double sum;
+		};
+
+		// 10us up to ~10s, doubling.
+		static std::vector<double> DefaultBounds();
+
+		explicit Histogram(std::vector<double> bounds = DefaultBounds());
+
+		void Observe(const std::chrono::nanoseconds& duration) noexcept;
+
+		Snapshot GetSnapshot() const;
+
+	private:
+		std::vector<double> m_bounds;
+		std::unique_ptr<std::atomic<uint64_t>[]> m_buckets;
+		std::atomic<uint64_t> m_count{ 0 };
+		std::atomic<uint64_t> m_sumNanos{ 0 };
+	};
+
+	//
+	// Observes the time between construction and destruction.
+	//
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(Histogram& histogram)
+			: m_histogram(histogram), m_start(std::chrono::steady_clock::now()) { }
+		~ScopedTimer() { m_histogram.Observe(std::chrono::steady_clock::now() - m_start); }
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		Histogram& m_histogram;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+	//
+	// Receives the values reported by a collector during a scrape.
+	//
+	class Writer
+	{
+	public:
+		void AddCounter(const std::string& name, const std::string& help, const Labels& labels, const double value);
+		void AddGauge(const std::string& name, const std::string& help, const Labels& labels, const double value);
+
+	private:
+		friend class Registry;
+
+		struct Family
+		{
+			std::string help;
+			std::string type;
+			std::vector<std::pair<Labels, double>> samples;
+		};
+
+		void Add(const std::string& name, const std::string& help, const std::string& type, const Labels& labels, const double value);
+
+		std::map<std::string, Family> m_families;
+	};
+
+	using Collector = std::function<void(Writer&)>;
+
+	class Registry
+	{
+	public:
+		static Registry& Get();
+
+		//
+		// Returns the metric with the given name and labels, creating it if needed.
+		// The returned reference stays valid for the life of the process.
+		// Throws if the name is already registered as a different type of metric.
+		//
+		Counter& AddCounter(const std::string& name, const std::string& help, const Labels& labels = {});
+		Gauge& AddGauge(const std::string& name, const std::string& help, const Labels& labels = {});
+		Histogram& AddHistogram(const std::string& name, const std::string& help, const Labels& labels = {});
+
+		//
+		// Registers a function that reports values at scrape time.
+		// The collector is unregistered once the returned pointer is destroyed, so owners should hold on to it.
+		//
+		std::shared_ptr<Collector> AddCollector(Collector&& collector);
+
+		//
+		// Formats every metric in the Prometheus text exposition format (version 0.0.4).
+		//
+		std::string Format() const;
+
+	private:
+		Registry() = default;
+
+		template<typename T>
+		struct Family
+		{
+			std::string help;
+			std::vector<std::pair<Labels, std::unique_ptr<T>>> metrics;
+		};
+
+		template<typename T>
+		T& Add(
+			std::map<std::string, Family<T>>& families,
+			const std::string& type,
+			const std::string& name,
+			const std::string& help,
+			const Labels& labels
+		);
+
+		mutable std::mutex m_mutex;
+		std::map<std::string, Family<Counter>> m_counters;
+		std::map<std::string, Family<Gauge>> m_gauges;
+		std::map<std::string, Family<Histogram>> m_histograms;
+		std::map<std::string, std::string> m_types;
+		std::vector<std::weak_ptr<Collector>> m_collectors;
+	};
+}
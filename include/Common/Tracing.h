@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+//
+// Low-overhead tracing, for finding out where the time went when a block or header takes too long on a live node.
+//
+// Spans are recorded into a fixed-size ring buffer owned by the recording thread, so the most recent events
+// are always kept, and recording only ever waits on an export that's in progress.
+// While tracing is stopped, a span costs one relaxed atomic load.
+// Recorded spans are exported in the Chrome trace-event format, which chrome://tracing and ui.perfetto.dev can open.
+//
+// Category and name must be string literals (or otherwise outlive the trace), since only the pointers are stored.
+//
+// Ex:
+//     bool TxHashSet::ApplyBlock(...)
+//     {
+//         TRACE_SPAN("txhashset", "TxHashSet::ApplyBlock");
+//         ...
+//     }
+//
+namespace Tracing
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Events kept per thread. Once full, the oldest events are overwritten.
+	static constexpr size_t EVENTS_PER_THREAD = 16384;
+
+	namespace detail
+	{
+		extern std::atomic_bool ENABLED;
+	}
+
+	inline bool IsEnabled() noexcept { return detail::ENABLED.load(std::memory_order_relaxed); }
+
+	//
+	// Discards previously recorded events, and starts recording.
+	//
+	void Start();
+
+	//
+	// Stops recording. Recorded events are kept until the next Start().
+	//
+	void Stop();
+
+	//
+	// Names the calling thread in exported traces.
+	//
+	void SetThreadName(const std::string& threadName);
+
+	//
+	// Returns the recorded events (of every thread) as a Chrome trace-event JSON object.
+	// Can be called while tracing is running.
+	//
+	std::string ExportChromeTrace();
+
+	void Record(const char* category, const char* name, const Clock::time_point& start, const Clock::time_point& end) noexcept;
+
+	class Span
+	{
+	public:
+		Span(const char* category, const char* name) noexcept
+			: m_category(category), m_name(name), m_enabled(IsEnabled())
+		{
+			if (m_enabled) {
+				m_start = Clock::now();
+			}
+		}
+
+		~Span()
+		{
+			if (m_enabled) {
+				Record(m_category, m_name, m_start, Clock::now());
+			}
+		}
+
+		Span(const Span&) = delete;
+		Span& operator=(const Span&) = delete;
+
+	private:
+		const char* m_category;
+		const char* m_name;
+		bool m_enabled;
+		Clock::time_point m_start;
+	};
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SPAN(category, name) Tracing::Span TRACE_CONCAT(trace_span_, __LINE__)(category, name)
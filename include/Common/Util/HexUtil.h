@@ -12,4 +12,5 @@ public:
 
 	static std::string ConvertToHex(const std::vector<uint8_t>& data);
 	static std::string ConvertToHex(const std::vector<uint8_t>& data, const size_t numBytes);
+	static std::string ConvertToHex(const uint8_t* pData, const size_t numBytes);
 };
\ No newline at end of file
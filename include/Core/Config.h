@@ -3,9 +3,11 @@
 #include <Core/Enums/Environment.h>
 
 #include <string>
+#include <optional>
 #include <filesystem.h>
 #include <json/json.h>
 #include <Net/IPAddress.h>
+#include <Net/Servers/ServerOptions.h>
 #include <unordered_set>
 
 class Config
@@ -31,6 +33,9 @@ public:
 	const fs::path& GetDatabasePath() const noexcept;
 	const fs::path& GetTxHashSetPath() const noexcept;
 	uint16_t GetRestAPIPort() const noexcept;
+	const ServerOptions& GetRestAPIOptions() const noexcept;
+	const std::optional<uint16_t>& GetFastLanePort() const noexcept;
+	const ServerOptions& GetFastLaneOptions() const noexcept;
 	uint64_t GetFeeBase() const noexcept;
 
 	//
@@ -46,6 +51,7 @@ public:
 	const std::vector<uint8_t>& GetMagicBytes() const noexcept;
 
 	uint8_t GetMinSyncPeers() const noexcept;
+	uint8_t GetHighBandwidthPeers() const noexcept;
 
 	const std::unordered_set<IPAddress>& GetPreferredPeers() const noexcept;
 	const std::unordered_set<IPAddress>& GetAllowedPeers() const noexcept;
@@ -66,11 +72,34 @@ public:
 	uint8_t GetPatienceSeconds() const noexcept;
 	uint8_t GetStemProbability() const noexcept;
 
+	//
+	// TxPool
+	//
+	uint64_t GetMaxPoolWeight() const noexcept;
+	uint64_t GetMaxPoolBytes() const noexcept;
+	uint64_t GetMaxStemPoolWeight() const noexcept;
+	uint64_t GetMaxStemPoolBytes() const noexcept;
+	const fs::path& GetTxPoolSnapshotPath() const noexcept;
+	uint32_t GetTxPoolSnapshotIntervalSeconds() const noexcept;
+
+	//
+	// Mining
+	//
+	bool IsStratumEnabled() const noexcept;
+	uint16_t GetStratumPort() const noexcept;
+	uint64_t GetShareDifficulty() const noexcept;
+	const std::string& GetMiningWalletHost() const noexcept;
+	const std::optional<uint16_t>& GetMiningWalletPort() const noexcept;
+	const std::string& GetMiningWalletSessionToken() const noexcept;
+	bool ShouldBurnMiningReward() const noexcept;
+
 	//
 	// Wallet
 	//
 	const fs::path& GetWalletPath() const noexcept;
 	uint32_t GetOwnerPort() const noexcept;
+	const ServerOptions& GetOwnerAPIOptions() const noexcept;
+	const ServerOptions& GetForeignAPIOptions() const noexcept;
 	uint32_t GetPublicKeyVersion() const noexcept;
 	uint32_t GetPrivateKeyVersion() const noexcept;
 
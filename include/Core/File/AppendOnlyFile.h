@@ -29,6 +29,28 @@ public:
 
 	void Discard() noexcept;
 	uint64_t GetSize() const noexcept;
+	const fs::path& GetPath() const noexcept { return m_path; }
+
+	//
+	// Rewrites the file without the fixed-size entries at the given positions (sorted ascending).
+	// The compacted copy is built in a ".tmp" file next to the original and then renamed over it,
+	// so an interrupted compaction leaves the original file intact.
+	// Any unflushed changes must be flushed first.
+	//
+	void Compact(const uint64_t entrySize, const std::vector<uint64_t>& entriesToRemove);
+
+	//
+	// The two halves of Compact, for callers that need to swap several files together.
+	// WriteCompacted leaves this file untouched, and ReplaceWith renames the compacted copy over it and remaps it.
+	//
+	void WriteCompacted(const uint64_t entrySize, const std::vector<uint64_t>& entriesToRemove, const fs::path& compactedPath) const;
+	void ReplaceWith(const fs::path& compactedPath);
+
+	//
+	// Appends everything from the given byte position onward to the file at destinationPath.
+	// Used to bring a compacted copy up to date with entries appended after it was written.
+	//
+	void AppendTailTo(const uint64_t position, const fs::path& destinationPath) const;
 
 	bool Read(
 		const uint64_t position,
@@ -37,6 +59,8 @@ public:
 	) const;
 
 private:
+	void CopyTo(uint64_t position, const uint64_t endPosition, const uint64_t maxRunSize, AppendOnlyFile& destination) const;
+
 	fs::path m_path;
 	uint64_t m_bufferIndex;
 	uint64_t m_fileSize;
@@ -72,6 +72,54 @@ public:
 		return data;
 	}
 
+	//
+	// Removes the entries at the given positions (sorted ascending), shifting all later entries down.
+	// Must only be called when there are no uncommitted changes.
+	//
+	void Compact(const std::vector<uint64_t>& positionsToRemove)
+	{
+		if (IsDirty())
+		{
+			throw FILE_EXCEPTION("Unable to compact uncommitted data.");
+		}
+
+		m_pFile->Compact(NUM_BYTES, positionsToRemove);
+	}
+
+	//
+	// Writes a copy of the file without the entries at the given positions (sorted ascending) to compactedPath.
+	// The file itself is unchanged until ReplaceWith is called.
+	//
+	void WriteCompacted(const std::vector<uint64_t>& positionsToRemove, const fs::path& compactedPath) const
+	{
+		if (IsDirty())
+		{
+			throw FILE_EXCEPTION("Unable to compact uncommitted data.");
+		}
+
+		m_pFile->WriteCompacted(NUM_BYTES, positionsToRemove, compactedPath);
+	}
+
+	void ReplaceWith(const fs::path& compactedPath)
+	{
+		m_pFile->ReplaceWith(compactedPath);
+	}
+
+	//
+	// Appends the entries from firstEntry onward to compactedPath, for entries added after WriteCompacted.
+	//
+	void AppendTailTo(const uint64_t firstEntry, const fs::path& compactedPath) const
+	{
+		if (IsDirty())
+		{
+			throw FILE_EXCEPTION("Unable to copy uncommitted data.");
+		}
+
+		m_pFile->AppendTailTo(firstEntry * NUM_BYTES, compactedPath);
+	}
+
+	const fs::path& GetPath() const noexcept { return m_pFile->GetPath(); }
+
 	void AddData(const std::vector<unsigned char>& data)
 	{
 		SetDirty(true);
@@ -5,6 +5,7 @@
 #include <Core/Models/TransactionOutput.h>
 #include <Crypto/Models/RangeProof.h>
 #include <Crypto/Hasher.h>
+#include <Core/Util/JsonWriter.h>
 #include <json/json.h>
 
 class OutputDTO
@@ -62,6 +63,23 @@ public:
 		return json;
 	}
 
+	void WriteJSON(JsonWriter& writer) const
+	{
+		Serializer proofSerializer;
+		m_rangeProof.Serialize(proofSerializer);
+
+		writer.BeginObject();
+		writer.UInt64("block_height", m_location.GetBlockHeight());
+		writer.String("commit", m_identifier.GetCommitment().ToHex());
+		writer.Null("merkle_proof");
+		writer.UInt64("mmr_index", m_location.GetLeafIndex().GetPosition() + 1);
+		writer.String("output_type", OutputFeatures::ToString(m_identifier.GetFeatures()));
+		writer.String("proof", m_rangeProof.Format());
+		writer.String("proof_hash", Hasher::Blake2b(proofSerializer.GetBytes()).ToHex());
+		writer.Bool("spent", m_spent);
+		writer.EndObject();
+	}
+
 	static OutputDTO FromJSON(const Json::Value& json)
 	{
 		bool spent = JsonUtil::GetRequiredBool(json, "spent");
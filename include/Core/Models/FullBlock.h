@@ -14,6 +14,9 @@
 #include <memory>
 #include <vector>
 
+// Forward Declarations
+class JsonWriter;
+
 class FullBlock : public Traits::IPrintable, public Traits::ISerializable
 {
 public:
@@ -96,6 +99,9 @@ public:
 	static FullBlock Deserialize(ByteBuffer& byteBuffer);
 	Json::Value ToJSON() const;
 
+	// Streams the block in the same layout as ToJSON(). Range proofs can be left out to shrink the output.
+	void WriteJSON(JsonWriter& writer, const bool includeProofs = true) const;
+
 	//
 	// Hashing
 	//
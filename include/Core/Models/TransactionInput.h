@@ -13,6 +13,9 @@
 #include <Core/Serialization/Serializer.h>
 #include <json/json.h>
 
+// Forward Declarations
+class JsonWriter;
+
 ////////////////////////////////////////
 // TRANSACTION INPUT
 ////////////////////////////////////////
@@ -54,6 +57,7 @@ public:
 	void Serialize(Serializer& serializer) const;
 	static TransactionInput Deserialize(ByteBuffer& byteBuffer);
 	Json::Value ToJSON() const;
+	void WriteJSON(JsonWriter& writer) const;
 	static TransactionInput FromJSON(const Json::Value& transactionInputJSON);
 
 	//
@@ -16,6 +16,9 @@
 #include <Core/Serialization/Serializer.h>
 #include <json/json.h>
 
+// Forward Declarations
+class JsonWriter;
+
 ////////////////////////////////////////
 // TRANSACTION KERNEL
 ////////////////////////////////////////
@@ -64,6 +67,7 @@ public:
 	void Serialize(Serializer& serializer) const final;
 	static TransactionKernel Deserialize(ByteBuffer& byteBuffer);
 	Json::Value ToJSON() const;
+	void WriteJSON(JsonWriter& writer) const;
 	static TransactionKernel FromJSON(const Json::Value& transactionKernelJSON);
 
 	//
@@ -15,6 +15,9 @@
 #include <Core/Serialization/Serializer.h>
 #include <json/json.h>
 
+// Forward Declarations
+class JsonWriter;
+
 ////////////////////////////////////////
 // TRANSACTION OUTPUT
 ////////////////////////////////////////
@@ -57,6 +60,7 @@ public:
 	void Serialize(Serializer& serializer) const;
 	static TransactionOutput Deserialize(ByteBuffer& byteBuffer);
 	Json::Value ToJSON() const;
+	void WriteJSON(JsonWriter& writer) const;
 	static TransactionOutput FromJSON(const Json::Value& transactionOutputJSON);
 
 	//
@@ -5,6 +5,7 @@
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
 #include <Core/Serialization/EndianHelper.h>
+#include <Core/Serialization/ByteSlice.h>
 #include <Core/Exceptions/DeserializationException.h>
 #include <Core/Enums/ProtocolVersion.h>
 #include <Core/Traits/Serializable.h>
@@ -15,31 +16,35 @@
 #include <cstdint>
 #include <algorithm>
 #include <array>
+#include <memory>
 
 #include <Crypto/Models/BigInteger.h>
 
+//
+// Reads serialized data out of a buffer that's shared, rather than copied, so values read with ReadSlice
+// (e.g. range proofs) can reference the bytes in place instead of each getting an allocation of their own.
+//
 class ByteBuffer
 {
 public:
     ByteBuffer(std::vector<uint8_t>&& bytes, const EProtocolVersion version = EProtocolVersion::V1)
-        : m_index(0), m_bytes(std::move(bytes)), m_protocolVersion(version) { }
+        : ByteBuffer(std::make_shared<const std::vector<uint8_t>>(std::move(bytes)), version) { }
     ByteBuffer(const std::vector<uint8_t>& bytes, const EProtocolVersion version = EProtocolVersion::V1)
-        : m_index(0), m_bytes(bytes), m_protocolVersion(version) { }
+        : ByteBuffer(std::make_shared<const std::vector<uint8_t>>(bytes), version) { }
+    ByteBuffer(const ByteSlice::Buffer& pBytes, const EProtocolVersion version = EProtocolVersion::V1)
+        : m_index(0), m_pBytes(pBytes), m_pData(pBytes->data()), m_size(pBytes->size()), m_protocolVersion(version) { }
 
     template<class T>
     void ReadBigEndian(T& t)
     {
-        if (m_index + sizeof(T) > m_bytes.size()) {
-            throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
-        }
+        EnsureRemaining(sizeof(T));
 
         if (EndianHelper::IsBigEndian()) {
-            memcpy(&t, &m_bytes[m_index], sizeof(T));
+            memcpy(&t, m_pData + m_index, sizeof(T));
         } else {
-            std::vector<uint8_t> temp;
-            temp.resize(sizeof(T));
-            std::reverse_copy(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + sizeof(T), temp.begin());
-            memcpy(&t, &temp[0], sizeof(T));
+            std::array<uint8_t, sizeof(T)> temp;
+            std::reverse_copy(m_pData + m_index, m_pData + m_index + sizeof(T), temp.begin());
+            memcpy(&t, temp.data(), sizeof(T));
         }
 
         m_index += sizeof(T);
@@ -48,17 +53,14 @@ public:
     template<class T>
     void ReadLittleEndian(T& t)
     {
-        if (m_index + sizeof(T) > m_bytes.size()) {
-            throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
-        }
+        EnsureRemaining(sizeof(T));
 
         if (EndianHelper::IsBigEndian()) {
-            std::vector<uint8_t> temp;
-            temp.resize(sizeof(T));
-            std::reverse_copy(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + sizeof(T), temp.begin());
-            memcpy(&t, &temp[0], sizeof(T));
+            std::array<uint8_t, sizeof(T)> temp;
+            std::reverse_copy(m_pData + m_index, m_pData + m_index + sizeof(T), temp.begin());
+            memcpy(&t, temp.data(), sizeof(T));
         } else {
-            memcpy(&t, &m_bytes[m_index], sizeof(T));
+            memcpy(&t, m_pData + m_index, sizeof(T));
         }
 
         m_index += sizeof(T);
@@ -157,85 +159,93 @@ public:
             return "";
         }
 
-        if (m_index + stringLength > m_bytes.size()) {
-            throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
-        }
-
-        std::vector<uint8_t> temp(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + stringLength);
-        m_index += stringLength;
-
-        return std::string((char*)&temp[0], stringLength);
+        return ReadString(stringLength);
     }
 
     std::string ReadString(const size_t size)
     {
-        if (m_index + size > m_bytes.size()) {
-            throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
-        }
+        EnsureRemaining(size);
 
-        std::vector<uint8_t> temp(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + size);
+        std::string str((const char*)m_pData + m_index, size);
         m_index += size;
 
-        return std::string((char*)&temp[0], size);
+        return str;
     }
 
     template<size_t NUM_BYTES>
     CBigInteger<NUM_BYTES> ReadBigInteger()
     {
-        if (m_index + NUM_BYTES > m_bytes.size()) {
-            throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
-        }
-
-        std::vector<uint8_t> data(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + NUM_BYTES);
+        EnsureRemaining(NUM_BYTES);
 
+        CBigInteger<NUM_BYTES> value(m_pData + m_index);
         m_index += NUM_BYTES;
 
-        return CBigInteger<NUM_BYTES>(std::move(data));
+        return value;
     }
 
     std::vector<uint8_t> ReadVector(const uint64_t numBytes)
     {
-        if (m_index + numBytes > m_bytes.size()) {
-            throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
-        }
+        EnsureRemaining(numBytes);
+
+        const size_t index = m_index;
+        m_index += numBytes;
+
+        return std::vector<uint8_t>(m_pData + index, m_pData + index + numBytes);
+    }
+
+    //
+    // Like ReadVector, but references the bytes in this buffer instead of copying them.
+    // The slice keeps the whole buffer alive, so use it for values that don't outlive what they were read with.
+    //
+    ByteSlice ReadSlice(const uint64_t numBytes)
+    {
+        EnsureRemaining(numBytes);
 
         const size_t index = m_index;
         m_index += numBytes;
 
-        return std::vector<uint8_t>(m_bytes.cbegin() + index, m_bytes.cbegin() + index + numBytes);
+        return ByteSlice(m_pBytes, index, numBytes);
     }
 
     template<size_t T>
     std::array<uint8_t, T> ReadArray()
     {
-        if (m_index + T > m_bytes.size()) {
-            throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
-        }
+        EnsureRemaining(T);
 
         const size_t index = m_index;
         m_index += T;
 
         std::array<uint8_t, T> arr;
-        std::copy(m_bytes.begin() + index, m_bytes.begin() + index + T, arr.begin());
+        std::copy(m_pData + index, m_pData + index + T, arr.begin());
         return arr;
     }
 
     size_t GetRemainingSize() const noexcept
     {
-        return m_bytes.size() - m_index;
+        return m_size - m_index;
     }
 
     std::vector<uint8_t> ReadRemainingBytes() noexcept
     {
         size_t prev_index = m_index;
         m_index += GetRemainingSize();
-        return std::vector<uint8_t>(m_bytes.cbegin() + prev_index, m_bytes.cbegin() + m_index);
+        return std::vector<uint8_t>(m_pData + prev_index, m_pData + m_index);
     }
 
     EProtocolVersion GetProtocolVersion() const noexcept { return m_protocolVersion; }
 
 private:
+    // Lengths come straight off the wire, so they're compared against what's left rather than added to the index, which could overflow.
+    void EnsureRemaining(const uint64_t numBytes) const
+    {
+        if (numBytes > GetRemainingSize()) {
+            throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
+        }
+    }
+
     size_t m_index;
-    std::vector<uint8_t> m_bytes;
+    ByteSlice::Buffer m_pBytes;
+    const uint8_t* m_pData;
+    size_t m_size;
     EProtocolVersion m_protocolVersion;
 };
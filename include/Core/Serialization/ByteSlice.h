@@ -0,0 +1,83 @@
+#pragma once
+
+// Copyright (c) 2018-2019 David Burkett
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+//
+// Immutable run of bytes, either owned or sliced out of a larger shared buffer, like the payload of a received message.
+// A slice keeps the whole buffer alive, but taking or copying one never copies the bytes themselves.
+//
+class ByteSlice
+{
+public:
+	using Buffer = std::shared_ptr<const std::vector<uint8_t>>;
+
+	//
+	// Constructors
+	//
+	ByteSlice() : m_pData(nullptr), m_size(0) { }
+	ByteSlice(std::vector<uint8_t>&& bytes)
+		: m_pBuffer(std::make_shared<const std::vector<uint8_t>>(std::move(bytes))),
+		m_pData(m_pBuffer->data()),
+		m_size(m_pBuffer->size()) { }
+	ByteSlice(const Buffer& pBuffer, const size_t offset, const size_t size)
+		: m_pBuffer(pBuffer), m_pData(pBuffer->data() + offset), m_size(size) { }
+	ByteSlice(const ByteSlice& other) = default;
+	ByteSlice(ByteSlice&& other) noexcept
+		: m_pBuffer(std::move(other.m_pBuffer)), m_pData(other.m_pData), m_size(other.m_size)
+	{
+		other.m_pData = nullptr;
+		other.m_size = 0;
+	}
+
+	//
+	// Destructor
+	//
+	~ByteSlice() = default;
+
+	//
+	// Operators
+	//
+	ByteSlice& operator=(const ByteSlice& other) = default;
+	ByteSlice& operator=(ByteSlice&& other) noexcept
+	{
+		if (this != &other)
+		{
+			m_pBuffer = std::move(other.m_pBuffer);
+			m_pData = other.m_pData;
+			m_size = other.m_size;
+			other.m_pData = nullptr;
+			other.m_size = 0;
+		}
+
+		return *this;
+	}
+	bool operator==(const ByteSlice& rhs) const noexcept
+	{
+		return m_size == rhs.m_size && (m_size == 0 || memcmp(m_pData, rhs.m_pData, m_size) == 0);
+	}
+	bool operator!=(const ByteSlice& rhs) const noexcept { return !(*this == rhs); }
+	uint8_t operator[](const size_t index) const noexcept { return m_pData[index]; }
+
+	//
+	// Getters
+	//
+	const uint8_t* data() const noexcept { return m_pData; }
+	size_t size() const noexcept { return m_size; }
+	bool empty() const noexcept { return m_size == 0; }
+	const uint8_t* begin() const noexcept { return m_pData; }
+	const uint8_t* end() const noexcept { return m_pData + m_size; }
+
+	std::vector<uint8_t> ToVector() const { return std::vector<uint8_t>(begin(), end()); }
+
+private:
+	Buffer m_pBuffer;
+	const uint8_t* m_pData;
+	size_t m_size;
+};
@@ -2,11 +2,14 @@
 
 #include <Common/Secure.h>
 #include <Core/Serialization/EndianHelper.h>
+#include <Core/Serialization/ByteSlice.h>
 #include <Core/Traits/Serializable.h>
 #include <Core/Enums/ProtocolVersion.h>
 #include <Crypto/Models/BigInteger.h>
 
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 #include <string>
 #include <memory>
@@ -35,8 +38,8 @@ public:
     template <class T, typename SFINAE = typename std::enable_if_t<std::is_integral_v<T>>>
     Serializer& Append(const T& t)
     {
-        std::vector<uint8_t> temp(sizeof(T));
-        memcpy(&temp[0], &t, sizeof(T));
+        std::array<uint8_t, sizeof(T)> temp;
+        memcpy(temp.data(), &t, sizeof(T));
 
         if (EndianHelper::IsBigEndian()) {
             m_serialized.insert(m_serialized.end(), temp.cbegin(), temp.cend());
@@ -50,8 +53,8 @@ public:
     template <class T>
     Serializer& AppendLittleEndian(const T& t)
     {
-        std::vector<uint8_t> temp(sizeof(T));
-        memcpy(&temp[0], &t, sizeof(T));
+        std::array<uint8_t, sizeof(T)> temp;
+        memcpy(temp.data(), &t, sizeof(T));
 
         if (EndianHelper::IsBigEndian()) {
             m_serialized.insert(m_serialized.end(), temp.crbegin(), temp.crend());
@@ -102,6 +105,13 @@ public:
         return *this;
     }
 
+    Serializer& AppendByteSlice(const ByteSlice& bytes, const ESerializeLength prepend_length = ESerializeLength::NONE)
+    {
+        AppendLength(prepend_length, bytes.size());
+        m_serialized.insert(m_serialized.end(), bytes.begin(), bytes.end());
+        return *this;
+    }
+
     Serializer& AppendVarStr(const std::string& varString)
     {
         AppendLength(ESerializeLength::U64, varString.length());
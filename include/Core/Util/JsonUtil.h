@@ -298,7 +298,7 @@ public:
 	//
 	static Json::Value ConvertToJSON(const RangeProof& rangeProof)
 	{
-		return ConvertToJSON(rangeProof.GetProofBytes());
+		return Json::Value(rangeProof.ToHex());
 	}
 
 	static RangeProof ConvertToRangeProof(const Json::Value& rangeProofJSON)
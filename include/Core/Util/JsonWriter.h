@@ -0,0 +1,229 @@
+#pragma once
+
+#include <json/json.h>
+#include <charconv>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+//
+// Forward-only writer that emits compact JSON as it goes, instead of building a Json::Value tree first.
+// Output is buffered and handed to the sink in pieces of roughly bufferSize bytes.
+// Call Flush() once the document is complete to hand off any remaining output.
+//
+// Ex:
+//     writer.BeginObject();
+//     writer.UInt64("height", 123);
+//     writer.Key("outputs").BeginArray();
+//     ...
+//     writer.EndArray();
+//     writer.EndObject();
+//     writer.Flush();
+//
+class JsonWriter
+{
+public:
+	using Sink = std::function<void(const char* pData, const size_t length)>;
+
+	static constexpr size_t DEFAULT_BUFFER_SIZE = 16 * 1024;
+
+	explicit JsonWriter(const Sink& sink, const size_t bufferSize = DEFAULT_BUFFER_SIZE)
+		: m_sink(sink), m_bufferSize(bufferSize), m_afterKey(false)
+	{
+		m_buffer.reserve(bufferSize + 1024);
+	}
+
+	//
+	// Runs the given function against a writer whose output is collected into a string.
+	//
+	static std::string ToString(const std::function<void(JsonWriter&)>& write)
+	{
+		std::string output;
+		JsonWriter writer([&output](const char* pData, const size_t length) { output.append(pData, length); });
+		write(writer);
+		writer.Flush();
+		return output;
+	}
+
+	JsonWriter& BeginObject()
+	{
+		BeginValue();
+		m_buffer.push_back('{');
+		m_first.push_back(true);
+		return *this;
+	}
+
+	JsonWriter& EndObject()
+	{
+		m_buffer.push_back('}');
+		return EndContainer();
+	}
+
+	JsonWriter& BeginArray()
+	{
+		BeginValue();
+		m_buffer.push_back('[');
+		m_first.push_back(true);
+		return *this;
+	}
+
+	JsonWriter& EndArray()
+	{
+		m_buffer.push_back(']');
+		return EndContainer();
+	}
+
+	// Writes an object key. Must be followed by exactly one value.
+	JsonWriter& Key(const std::string& key)
+	{
+		BeginValue();
+		AppendString(key);
+		m_buffer.push_back(':');
+		m_afterKey = true;
+		return *this;
+	}
+
+	//
+	// Values
+	//
+	JsonWriter& String(const std::string& value)
+	{
+		BeginValue();
+		AppendString(value);
+		return EndValue();
+	}
+
+	JsonWriter& UInt64(const uint64_t value)
+	{
+		BeginValue();
+		char digits[24];
+		auto result = std::to_chars(digits, digits + sizeof(digits), value);
+		m_buffer.append(digits, result.ptr);
+		return EndValue();
+	}
+
+	JsonWriter& Int64(const int64_t value)
+	{
+		BeginValue();
+		char digits[24];
+		auto result = std::to_chars(digits, digits + sizeof(digits), value);
+		m_buffer.append(digits, result.ptr);
+		return EndValue();
+	}
+
+	JsonWriter& Bool(const bool value)
+	{
+		BeginValue();
+		m_buffer.append(value ? "true" : "false");
+		return EndValue();
+	}
+
+	JsonWriter& Null()
+	{
+		BeginValue();
+		m_buffer.append("null");
+		return EndValue();
+	}
+
+	// Writes an already-built json value. Meant for small subtrees, like block headers.
+	JsonWriter& Value(const Json::Value& json)
+	{
+		BeginValue();
+
+		Json::StreamWriterBuilder builder;
+		builder["indentation"] = "";
+		m_buffer.append(Json::writeString(builder, json));
+		return EndValue();
+	}
+
+	//
+	// Key-value shorthands
+	//
+	JsonWriter& String(const std::string& key, const std::string& value) { return Key(key).String(value); }
+	JsonWriter& UInt64(const std::string& key, const uint64_t value) { return Key(key).UInt64(value); }
+	JsonWriter& Int64(const std::string& key, const int64_t value) { return Key(key).Int64(value); }
+	JsonWriter& Bool(const std::string& key, const bool value) { return Key(key).Bool(value); }
+	JsonWriter& Null(const std::string& key) { return Key(key).Null(); }
+	JsonWriter& Value(const std::string& key, const Json::Value& json) { return Key(key).Value(json); }
+
+	// Hands all buffered output to the sink.
+	void Flush()
+	{
+		if (!m_buffer.empty()) {
+			m_sink(m_buffer.data(), m_buffer.size());
+			m_buffer.clear();
+		}
+	}
+
+private:
+	void BeginValue()
+	{
+		if (m_afterKey) {
+			m_afterKey = false;
+			return;
+		}
+
+		if (!m_first.empty()) {
+			if (!m_first.back()) {
+				m_buffer.push_back(',');
+			}
+
+			m_first.back() = false;
+		}
+	}
+
+	JsonWriter& EndValue()
+	{
+		if (m_buffer.size() >= m_bufferSize) {
+			Flush();
+		}
+
+		return *this;
+	}
+
+	JsonWriter& EndContainer()
+	{
+		m_first.pop_back();
+		return EndValue();
+	}
+
+	void AppendString(const std::string& value)
+	{
+		static const char* HEX = "0123456789abcdef";
+
+		m_buffer.push_back('"');
+		for (const char c : value)
+		{
+			switch (c)
+			{
+				case '"': m_buffer.append("\\\""); break;
+				case '\\': m_buffer.append("\\\\"); break;
+				case '\b': m_buffer.append("\\b"); break;
+				case '\f': m_buffer.append("\\f"); break;
+				case '\n': m_buffer.append("\\n"); break;
+				case '\r': m_buffer.append("\\r"); break;
+				case '\t': m_buffer.append("\\t"); break;
+				default:
+				{
+					if ((unsigned char)c < 0x20) {
+						m_buffer.append("\\u00");
+						m_buffer.push_back(HEX[(c >> 4) & 0x0F]);
+						m_buffer.push_back(HEX[c & 0x0F]);
+					} else {
+						m_buffer.push_back(c);
+					}
+				}
+			}
+		}
+		m_buffer.push_back('"');
+	}
+
+	Sink m_sink;
+	size_t m_bufferSize;
+	std::string m_buffer;
+
+	// One entry per open object/array. True until the first element is written.
+	std::vector<bool> m_first;
+	bool m_afterKey;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Crypto/Models/Commitment.h>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+//
+// Sums large sets of pedersen commitments by splitting them into chunks, summing the chunks
+// on a shared thread pool, and then summing the partial results.
+// Inputs no larger than a single chunk are summed directly on the calling thread.
+//
+class CommitmentSummer
+{
+public:
+	static constexpr uint64_t CHUNK_SIZE = 1000;
+
+	//
+	// Appends the commitments for items [begin, end) to the given vector.
+	// Called concurrently from multiple threads, each with its own range.
+	//
+	using Fetcher = std::function<void(const uint64_t begin, const uint64_t end, std::vector<Commitment>& commitments)>;
+
+	// Calculates sum(positive) - sum(negative).
+	static Commitment Sum(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative);
+
+	//
+	// Calculates the sum of the commitments for items [0, count), without holding them all in memory at once.
+	// Returns nullopt if there are no commitments to sum, or if they sum to zero.
+	//
+	static std::optional<Commitment> Sum(const uint64_t count, const Fetcher& fetcher);
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/Exceptions/BadDataException.h>
+#include <Core/Validation/CommitmentSummer.h>
 #include <Crypto/Crypto.h>
 #include <Crypto/Models/Commitment.h>
 #include <Crypto/Models/BlindingFactor.h>
@@ -58,7 +59,7 @@ public:
 		}
 
 		// Sum all input|output|overage commitments.
-		Commitment utxoSum = Crypto::AddCommitments(outputCommitments, inputCommitments);
+		Commitment utxoSum = CommitmentSummer::Sum(outputCommitments, inputCommitments);
 
 		// Sum the kernel excesses accounting for the kernel offset.
 		std::vector<Commitment> kernelCommitments = kernels;
@@ -67,7 +68,7 @@ public:
 			kernelCommitments.push_back(blockSumsOpt.value().GetKernelSum());
 		}
 
-		Commitment kernelSum = Crypto::AddCommitments(kernelCommitments, std::vector<Commitment>());
+		Commitment kernelSum = CommitmentSummer::Sum(kernelCommitments, std::vector<Commitment>());
 		Commitment kernelSumPlusOffset = AddKernelOffset(kernelSum, kernelOffset);
 		if (utxoSum != kernelSumPlusOffset) {
 			LOG_ERROR_F(
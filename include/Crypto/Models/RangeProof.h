@@ -9,6 +9,7 @@
 #include <Core/Traits/Printable.h>
 #include <Core/Traits/Serializable.h>
 #include <Core/Serialization/ByteBuffer.h>
+#include <Core/Serialization/ByteSlice.h>
 #include <Core/Serialization/Serializer.h>
 
 static const int MAX_PROOF_SIZE = 675;
@@ -23,6 +24,11 @@ public:
 		: m_proofBytes(std::move(proofBytes))
 	{
 
+	}
+	RangeProof(ByteSlice&& proofBytes)
+		: m_proofBytes(std::move(proofBytes))
+	{
+
 	}
 	RangeProof(const RangeProof& other) = default;
 	RangeProof(RangeProof&& other) noexcept = default;
@@ -42,7 +48,7 @@ public:
 	//
 	// Getters
 	//
-	const std::vector<unsigned char>& GetProofBytes() const noexcept { return m_proofBytes; }
+	const ByteSlice& GetProofBytes() const noexcept { return m_proofBytes; }
 
 	//
 	// Serialization/Deserialization
@@ -50,7 +56,7 @@ public:
 	void Serialize(Serializer& serializer) const final
 	{
 		serializer.Append<uint64_t>(m_proofBytes.size());
-		serializer.AppendByteVector(m_proofBytes);
+		serializer.AppendByteSlice(m_proofBytes);
 	}
 
 	static RangeProof Deserialize(ByteBuffer& byteBuffer)
@@ -60,7 +66,8 @@ public:
 			throw DESERIALIZATION_EXCEPTION_F("Proof of size {} exceeds the maximum", proofSize);
 		}
 
-		return RangeProof(byteBuffer.ReadVector(proofSize));
+		// Blocks and txs carry hundreds of proofs, so they reference the received bytes rather than each being copied.
+		return RangeProof(byteBuffer.ReadSlice(proofSize));
 	}
 
 	static RangeProof FromHex(const std::string& hex)
@@ -70,15 +77,15 @@ public:
 
 	std::string ToHex() const noexcept
 	{
-		return HexUtil::ConvertToHex(m_proofBytes);
+		return HexUtil::ConvertToHex(m_proofBytes.data(), m_proofBytes.size());
 	}
 
 	//
 	// Traits
 	//
-	std::string Format() const final { return HexUtil::ConvertToHex(m_proofBytes); }
+	std::string Format() const final { return ToHex(); }
 
 private:
-	// The proof itself, at most 675 bytes long.
-	std::vector<unsigned char> m_proofBytes;
+	// The proof itself, at most 675 bytes long. Often a slice of the block or tx it was deserialized with.
+	ByteSlice m_proofBytes;
 };
@@ -34,12 +34,12 @@ public:
 	virtual void SetVersion(const uint8_t version) = 0;
 
 	/// <summary>
-	/// Updates FullBlock entries to the latest serialization format.
+	/// Moves FullBlock entries from the legacy hash-keyed table to the height-keyed table.
 	/// </summary>
 	virtual void MigrateBlocks() = 0;
 
 	/// <summary>
-	/// Removes all blocks beyond the horizon.
+	/// Removes all blocks beyond the horizon, using a single range delete over the height-keyed blocks.
 	/// </summary>
 	/// <param name="pChain"></param>
 	virtual void Compact(const std::shared_ptr<const Chain>& pChain) = 0;
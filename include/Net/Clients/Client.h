@@ -26,12 +26,18 @@ public:
 	virtual Response Invoke(const Request& request) = 0;
 
 protected:
+	bool IsConnected() const noexcept { return m_socket.is_open(); }
+
+	void Disconnect()
+	{
+		asio::error_code ec;
+		m_socket.close(ec);
+		m_stringBuffer.clear();
+	}
+
 	void Connect(const SocketAddress& address, const asio::chrono::steady_clock::duration& timeout)
 	{
-		if (m_socket.is_open())
-		{
-			m_socket.close();
-		}
+		Disconnect();
 
 		asio::ip::address ipAddress(asio::ip::address_v4::from_string(address.GetIPAddress().Format()));
 		asio::ip::tcp::endpoint endpoint(ipAddress, address.GetPortNumber());
@@ -55,10 +61,7 @@ protected:
 
 	void Connect(const std::string& host, const uint16_t port, const asio::chrono::steady_clock::duration& timeout)
 	{
-		if (m_socket.is_open())
-		{
-			m_socket.close();
-		}
+		Disconnect();
 
 		asio::io_service ios;
 
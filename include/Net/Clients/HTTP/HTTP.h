@@ -5,6 +5,10 @@
 
 namespace HTTP
 {
+// Sent by clients that can read chunked responses. Servers only stream to clients that send it,
+// since older clients require a Content-Length.
+static constexpr const char* ACCEPT_CHUNKED_HEADER = "X-Accept-Chunked";
+
 enum class EHTTPMethod
 {
 	GET,
@@ -38,11 +42,13 @@ public:
 			"{} {} HTTP/1.1\r\n"
 			"Host: {}\r\n"
 			"Content-Length: {}\r\n"
-			"Content-Type: application/json-rpc\r\n\r\n{}",
+			"Content-Type: application/json-rpc\r\n"
+			"{}: true\r\n\r\n{}",
 			m_method == EHTTPMethod::GET ? "GET" : "POST",
 			m_location,
 			m_host,
 			m_body.size(),
+			ACCEPT_CHUNKED_HEADER,
 			m_body
 		);
 	}
@@ -8,95 +8,225 @@
 #include <sstream>
 #include <thread>
 
+//
+// HTTP/1.1 client that keeps its connection alive between requests.
+// A request to the same host and port as the previous one reuses the open connection, unless the server closed it.
+//
 class IHTTPClient : public Client<HTTP::Request, HTTP::Response>
 {
 public:
-	IHTTPClient() : m_connected(false) { }
+	IHTTPClient() = default;
 	virtual ~IHTTPClient() = default;
 
 	HTTP::Response Invoke(const HTTP::Request& request) final
 	{
-		//WALLET_INFO_F("Request: {}", request.ToString());
-		try
-		{
-			//if (!m_connected)
-			{
-				std::this_thread::sleep_for(std::chrono::seconds(1));
-				EstablishConnection(request.GetHost(), request.GetPort());
-				WALLET_INFO("Connection established");
-				m_connected = true;
-			}
+		std::vector<HTTP::Response> responses = InvokePipelined({ request });
+		return std::move(responses.front());
+	}
 
-			std::string lineToWrite = request.ToString();
-			Write(lineToWrite, asio::chrono::seconds(2));
+	//
+	// Writes all of the requests before reading any of the responses, so they cost a single round trip.
+	// All requests must go to the same host and port. Responses are returned in request order.
+	//
+	std::vector<HTTP::Response> InvokePipelined(const std::vector<HTTP::Request>& requests)
+	{
+		std::vector<HTTP::Response> responses;
+		responses.reserve(requests.size());
 
-			std::string responseLine = ReadLine(asio::chrono::seconds(10));
-			std::istringstream responseStream(responseLine);
+		bool retried = false;
+		while (responses.size() < requests.size())
+		{
+			const size_t numReceived = responses.size();
+			const HTTP::Request& next = requests[numReceived];
 
-			std::string http_version;
-			responseStream >> http_version;
+			bool reused = false;
+			try
+			{
+				reused = EnsureConnected(next.GetHost(), next.GetPort());
 
-			unsigned int statusCode;
-			responseStream >> statusCode;
+				std::string toWrite;
+				for (size_t i = numReceived; i < requests.size(); i++)
+				{
+					if (requests[i].GetHost() != next.GetHost() || requests[i].GetPort() != next.GetPort())
+					{
+						throw HTTP_EXCEPTION("Pipelined requests must share a host and port");
+					}
 
-			std::string statusMessage;
-			std::getline(responseStream, statusMessage);
+					toWrite += requests[i].ToString();
+				}
 
-			size_t contentLength = 0;
+				Write(toWrite, asio::chrono::seconds(2));
 
-			std::vector<HTTP::Header> headers;
-			GrinStr header = ReadLine(asio::chrono::seconds(1));
-			while (header != "\r")
-			{
-				std::vector<GrinStr> headerParts = header.Split(":");
-				if (headerParts.size() < 2)
+				while (responses.size() < requests.size())
 				{
-					throw HTTP_EXCEPTION("Invalid header: " + header);
+					bool keepAlive = true;
+					responses.push_back(ReadResponse(keepAlive));
+
+					// Any requests left unanswered are resent over a new connection.
+					if (!keepAlive)
+					{
+						Disconnect();
+						break;
+					}
 				}
+			}
+			catch (HTTPException& e)
+			{
+				WALLET_INFO_F("HTTPException: {}", e.what());
+				Disconnect();
+				throw e;
+			}
+			catch (std::exception& e)
+			{
+				Disconnect();
 
-				if (headerParts[0].Trim().ToLower() == "content-length")
+				// The server may have closed the kept-alive connection while it sat idle, so retry once on a fresh one.
+				if (reused && !retried && responses.size() == numReceived)
 				{
-					std::istringstream contentLengthStream(headerParts[1]);
-					contentLengthStream >> contentLength;
+					WALLET_DEBUG_F("Reused connection failed ({}). Reconnecting.", e.what());
+					retried = true;
+					continue;
 				}
 
-				headers.push_back(HTTP::Header{
-					headerParts[0].Trim(),
-					headerParts[1].Trim()
-				});
+				WALLET_INFO_F("Exception: {}", e.what());
+				throw HTTP_EXCEPTION(e.what());
+			}
+		}
+
+		return responses;
+	}
+
+private:
+	virtual void EstablishConnection(const std::string& host, const uint16_t port) = 0;
+
+	// Returns true if an already open connection is reused.
+	bool EnsureConnected(const std::string& host, const uint16_t port)
+	{
+		if (IsConnected() && m_host == host && m_port == port)
+		{
+			return true;
+		}
+
+		EstablishConnection(host, port);
+		WALLET_DEBUG_F("Connection established to {}:{}", host, port);
+		m_host = host;
+		m_port = port;
+		return false;
+	}
+
+	HTTP::Response ReadResponse(bool& keepAlive)
+	{
+		std::string responseLine = ReadLine(asio::chrono::seconds(10));
+		std::istringstream responseStream(responseLine);
+
+		std::string http_version;
+		responseStream >> http_version;
+
+		unsigned int statusCode;
+		responseStream >> statusCode;
+
+		std::string statusMessage;
+		std::getline(responseStream, statusMessage);
+
+		keepAlive = (http_version != "HTTP/1.0");
 
-				header = ReadLine(asio::chrono::seconds(1));
+		std::optional<size_t> contentLengthOpt;
+		bool chunked = false;
+
+		std::vector<HTTP::Header> headers;
+		GrinStr header = ReadLine(asio::chrono::seconds(1));
+		while (header != "\r")
+		{
+			// Header values can contain colons themselves (e.g. Date), so only split on the first one.
+			const size_t colon = header.find(':');
+			if (colon == std::string::npos)
+			{
+				throw HTTP_EXCEPTION("Invalid header: " + header);
 			}
 
-			if (contentLength == 0)
+			const GrinStr type = GrinStr(header.substr(0, colon)).Trim();
+			const GrinStr value = GrinStr(header.substr(colon + 1)).Trim();
+
+			const GrinStr typeLower = type.ToLower();
+			if (typeLower == "content-length")
 			{
-				throw HTTP_EXCEPTION("No Content-Length provided");
+				size_t contentLength = 0;
+				std::istringstream contentLengthStream(value);
+				contentLengthStream >> contentLength;
+				contentLengthOpt = std::make_optional(contentLength);
+			}
+			else if (typeLower == "transfer-encoding")
+			{
+				chunked = (value.ToLower() == "chunked");
+			}
+			else if (typeLower == "connection")
+			{
+				keepAlive = (value.ToLower() != "close");
 			}
 
-			std::vector<uint8_t> body = Read(contentLength, asio::chrono::seconds(2));
+			headers.push_back(HTTP::Header{ type, value });
 
-			return HTTP::Response(
-				statusCode,
-				std::move(headers),
-				std::string(body.begin(), body.end())
-			);
+			header = ReadLine(asio::chrono::seconds(1));
 		}
-		catch (HTTPException& e)
+
+		std::string body;
+		if (chunked)
 		{
-			WALLET_INFO_F("HTTPException: {}", e.what());
-			throw e;
+			body = ReadChunkedBody();
 		}
-		catch (std::exception& e)
+		else if (contentLengthOpt.has_value())
 		{
-			WALLET_INFO_F("Exception: {}", e.what());
-			throw HTTP_EXCEPTION(e.what());
+			std::vector<uint8_t> bytes = Read(contentLengthOpt.value(), asio::chrono::seconds(2));
+			body = std::string(bytes.begin(), bytes.end());
 		}
+		else
+		{
+			throw HTTP_EXCEPTION("No Content-Length provided");
+		}
+
+		return HTTP::Response(statusCode, std::move(headers), body);
 	}
 
-private:
-	virtual void EstablishConnection(const std::string& host, const uint16_t port) = 0;
+	// Streamed responses (e.g. output ranges) are sent with chunked transfer encoding.
+	std::string ReadChunkedBody()
+	{
+		std::string body;
+		while (true)
+		{
+			const GrinStr sizeLine = ReadLine(asio::chrono::seconds(2));
 
-	bool m_connected;
+			size_t chunkSize = 0;
+			try
+			{
+				chunkSize = std::stoull(sizeLine, nullptr, 16);
+			}
+			catch (std::exception&)
+			{
+				throw HTTP_EXCEPTION("Invalid chunk size: " + sizeLine);
+			}
+
+			if (chunkSize == 0)
+			{
+				break;
+			}
+
+			// Each chunk is followed by a CRLF.
+			std::vector<uint8_t> chunk = Read(chunkSize + 2, asio::chrono::seconds(2));
+			body.append(chunk.begin(), chunk.end() - 2);
+		}
+
+		// Skip any trailers, up to the blank line ending the body.
+		GrinStr trailer = ReadLine(asio::chrono::seconds(1));
+		while (trailer != "\r")
+		{
+			trailer = ReadLine(asio::chrono::seconds(1));
+		}
+
+		return body;
+	}
+
+	std::string m_host;
+	uint16_t m_port{ 0 };
 };
 
 class HTTPClient : public IHTTPClient
@@ -119,4 +249,4 @@ private:
 			Connect(SocketAddress(IPAddress(ipAddress), port), std::chrono::seconds(5));
 		}
 	}
-};
\ No newline at end of file
+};
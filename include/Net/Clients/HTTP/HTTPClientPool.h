@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Net/Clients/HTTP/HTTPClient.h>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//
+// Pool of keep-alive HTTP clients.
+// Sequential calls reuse the most recently used client, and with it its open connection.
+// Concurrent calls each get a client of their own, up to maxClients. Beyond that, callers wait for one to be released.
+//
+class HTTPClientPool
+{
+public:
+	using Ptr = std::shared_ptr<HTTPClientPool>;
+	using Factory = std::function<std::shared_ptr<IHTTPClient>()>;
+
+	static constexpr size_t DEFAULT_MAX_CLIENTS = 4;
+
+	HTTPClientPool(const Factory& factory, const size_t maxClients = DEFAULT_MAX_CLIENTS)
+		: m_factory(factory), m_maxClients(maxClients), m_numClients(0) { }
+
+	//
+	// Wraps a single client, so calls on it are serialized rather than interleaved on one connection.
+	// Used for clients that can't just be recreated, like ones tunneling through a proxy.
+	//
+	HTTPClientPool(const std::shared_ptr<IHTTPClient>& pClient)
+		: m_factory(nullptr), m_maxClients(1), m_numClients(1), m_idle({ pClient }) { }
+
+	HTTP::Response Invoke(const HTTP::Request& request)
+	{
+		Lease lease(*this);
+		return lease->Invoke(request);
+	}
+
+	std::vector<HTTP::Response> InvokePipelined(const std::vector<HTTP::Request>& requests)
+	{
+		Lease lease(*this);
+		return lease->InvokePipelined(requests);
+	}
+
+private:
+	class Lease
+	{
+	public:
+		Lease(HTTPClientPool& pool) : m_pool(pool), m_pClient(pool.Acquire()) { }
+		~Lease() { m_pool.Release(m_pClient); }
+
+		IHTTPClient* operator->() const noexcept { return m_pClient.get(); }
+
+	private:
+		HTTPClientPool& m_pool;
+		std::shared_ptr<IHTTPClient> m_pClient;
+	};
+
+	std::shared_ptr<IHTTPClient> Acquire()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_released.wait(lock, [this] { return !m_idle.empty() || m_numClients < m_maxClients; });
+
+		if (!m_idle.empty())
+		{
+			std::shared_ptr<IHTTPClient> pClient = m_idle.back();
+			m_idle.pop_back();
+			return pClient;
+		}
+
+		++m_numClients;
+		lock.unlock();
+
+		try
+		{
+			return m_factory();
+		}
+		catch (...)
+		{
+			lock.lock();
+			--m_numClients;
+			m_released.notify_one();
+			throw;
+		}
+	}
+
+	void Release(const std::shared_ptr<IHTTPClient>& pClient)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_idle.push_back(pClient);
+		m_released.notify_one();
+	}
+
+	Factory m_factory;
+	size_t m_maxClients;
+
+	std::mutex m_mutex;
+	std::condition_variable m_released;
+	size_t m_numClients;
+	std::vector<std::shared_ptr<IHTTPClient>> m_idle; // Most recently released last.
+};
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <Core/Util/JsonUtil.h>
+#include <Core/Util/JsonWriter.h>
 #include <Core/Traits/Jsonable.h>
 #include <Net/Util/HTTPUtil.h>
 #include <Net/Clients/RPC/RPCException.h>
 #include <atomic>
+#include <functional>
 
 namespace RPC
 {
@@ -69,6 +71,9 @@ private:
 class Response
 {
 public:
+	// Writes the "result" value of a streamed response.
+	using ResultWriter = std::function<void(JsonWriter&)>;
+
 	Response(const Response& other) = default;
 
 	static Response BuildResult(const Json::Value& id, const Json::Value& result)
@@ -76,6 +81,18 @@ public:
 		return Response(Json::Value(id), std::make_optional(result), std::nullopt);
 	}
 
+	//
+	// Builds a response whose result is written straight to the connection by RPCServer,
+	// rather than held in memory as a Json::Value. Used for large results, like blocks and output ranges.
+	// Any validation that could fail should happen before building the response, since headers are sent before the writer runs.
+	//
+	static Response BuildStreamingResult(const Json::Value& id, const ResultWriter& resultWriter)
+	{
+		Response response(Json::Value(id), std::nullopt, std::nullopt);
+		response.m_resultWriter = resultWriter;
+		return response;
+	}
+
 	static Response BuildError(const Json::Value& id, const int code, const std::string& message, const std::optional<Json::Value>& data = std::nullopt)
 	{
 		Error error(code, message, data.value_or(Json::nullValue));
@@ -83,13 +100,23 @@ public:
 	}
 
 	static Response Parse(const std::string& jsonStr)
+	{
+		Json::Value json;
+		if (!JsonUtil::Parse(jsonStr, json))
+		{
+			throw RPC_EXCEPTION("invalid json", std::nullopt);
+		}
+
+		return FromJSON(json);
+	}
+
+	static Response FromJSON(const Json::Value& json)
 	{
 		try
 		{
-			Json::Value json;
-			if (!JsonUtil::Parse(jsonStr, json))
+			if (!json.isObject())
 			{
-				throw RPC_EXCEPTION("invalid json", std::nullopt);
+				throw RPC_EXCEPTION("response must be an object", std::nullopt);
 			}
 
 			// Parse id
@@ -142,6 +169,7 @@ public:
 	const Json::Value& GetId() const noexcept { return m_id; }
 	const std::optional<Json::Value>& GetResult() const noexcept { return m_resultOpt; }
 	const std::optional<Error>& GetError() const noexcept { return m_errorOpt; }
+	bool IsStreaming() const noexcept { return m_resultWriter != nullptr; }
 
 	Json::Value ToJSON() const
 	{
@@ -153,6 +181,12 @@ public:
 		{
 			json["result"] = m_resultOpt.value();
 		}
+		else if (IsStreaming())
+		{
+			Json::Value result;
+			JsonUtil::Parse(JsonWriter::ToString(m_resultWriter), result);
+			json["result"] = result;
+		}
 		else
 		{
 			json["error"] = m_errorOpt.value().ToJSON();
@@ -161,6 +195,23 @@ public:
 		return json;
 	}
 
+	// Streams the full response, with members in the same order jsoncpp would write them.
+	void WriteJSON(JsonWriter& writer) const
+	{
+		if (!IsStreaming())
+		{
+			writer.Value(ToJSON());
+			return;
+		}
+
+		writer.BeginObject();
+		writer.Value("id", m_id);
+		writer.String("jsonrpc", "2.0");
+		writer.Key("result");
+		m_resultWriter(writer);
+		writer.EndObject();
+	}
+
 	std::string ToString() const
 	{
 		return JsonUtil::WriteCondensed(ToJSON());
@@ -176,6 +227,7 @@ private:
 	Json::Value m_id;
 	std::optional<Json::Value> m_resultOpt;
 	std::optional<Error> m_errorOpt;
+	ResultWriter m_resultWriter;
 };
 
 class Request
@@ -183,16 +235,33 @@ class Request
 public:
 	static Request Parse(mg_connection* pConnection)
 	{
+		std::optional<Json::Value> jsonOpt;
 		try
 		{
-			std::optional<Json::Value> jsonOpt = HTTPUtil::GetRequestBody(pConnection);
-			if (!jsonOpt.has_value())
+			jsonOpt = HTTPUtil::GetRequestBody(pConnection);
+		}
+		catch (const std::exception& e)
+		{
+			throw RPC_EXCEPTION(e.what(), std::nullopt);
+		}
+
+		if (!jsonOpt.has_value())
+		{
+			throw RPC_EXCEPTION("json missing or invalid", std::nullopt);
+		}
+
+		return FromJSON(jsonOpt.value());
+	}
+
+	static Request FromJSON(const Json::Value& json)
+	{
+		try
+		{
+			if (!json.isObject())
 			{
-				throw RPC_EXCEPTION("json missing or invalid", std::nullopt);
+				throw RPC_EXCEPTION("request must be an object", std::nullopt);
 			}
 
-			const Json::Value& json = jsonOpt.value();
-
 			// Parse id
 			std::optional<Json::Value> idOpt = JsonUtil::GetOptionalField(json, "id");
 			if (!idOpt.has_value())
@@ -273,6 +342,11 @@ public:
 		return Response::BuildResult(m_id, result);
 	}
 
+	Response BuildStreamingResult(const Response::ResultWriter& resultWriter) const
+	{
+		return Response::BuildStreamingResult(m_id, resultWriter);
+	}
+
 	Response BuildError(const int code, const std::string& message, const std::optional<Json::Value>& data = std::nullopt) const
 	{
 		return Response::BuildError(m_id, code, message, data);
@@ -1,19 +1,28 @@
 #pragma once
 
 #include <Net/Clients/HTTP/HTTPClient.h>
+#include <Net/Clients/HTTP/HTTPClientPool.h>
 #include <Net/Clients/HTTP/HTTP.h>
 #include <Net/Clients/RPC/RPC.h>
 #include <Net/Clients/RPC/RPCException.h>
+#include <unordered_map>
 
+//
+// JSON-RPC over HTTP. Connections are pooled and kept alive between calls, and calls can be made from multiple threads at once.
+//
 class HttpRpcClient
 {
 public:
 	using Ptr = std::shared_ptr<HttpRpcClient>;
 
-	HttpRpcClient() : m_httpClient(std::shared_ptr<IHTTPClient>(new HTTPClient())) { }
+	HttpRpcClient(const size_t maxConnections = HTTPClientPool::DEFAULT_MAX_CLIENTS)
+		: m_pClientPool(std::make_shared<HTTPClientPool>(
+			[]() { return std::shared_ptr<IHTTPClient>(new HTTPClient()); },
+			maxConnections
+		)) { }
 
 	HttpRpcClient(std::shared_ptr<IHTTPClient> httpClient)
-		: m_httpClient(httpClient)
+		: m_pClientPool(std::make_shared<HTTPClientPool>(httpClient))
 	{
 
 	}
@@ -23,7 +32,7 @@ public:
 		try
 		{
 			const HTTP::Request httpRequest(HTTP::EHTTPMethod::POST, location, host, portNumber, JsonUtil::WriteCondensed(request.ToJSON()));
-			const HTTP::Response response = m_httpClient->Invoke(httpRequest);
+			const HTTP::Response response = m_pClientPool->Invoke(httpRequest);
 
 			return RPC::Response::Parse(response.GetBody());
 		}
@@ -33,6 +42,84 @@ public:
 		}
 	}
 
+	//
+	// Sends the requests as a single JSON-RPC batch, and returns their responses in request order.
+	// If the server doesn't answer with a batch, the requests are pipelined over one connection instead,
+	// so either way it costs a single round trip.
+	//
+	std::vector<RPC::Response> InvokeBatch(
+		const std::string& host,
+		const std::string& location,
+		const uint16_t portNumber,
+		const std::vector<RPC::Request>& requests)
+	{
+		if (requests.empty())
+		{
+			return {};
+		}
+
+		try
+		{
+			Json::Value batchJson(Json::arrayValue);
+			for (const RPC::Request& request : requests)
+			{
+				batchJson.append(request.ToJSON());
+			}
+
+			const HTTP::Request httpRequest(HTTP::EHTTPMethod::POST, location, host, portNumber, JsonUtil::WriteCondensed(batchJson));
+			const HTTP::Response response = m_pClientPool->Invoke(httpRequest);
+
+			Json::Value responseJson;
+			if (JsonUtil::Parse(response.GetBody(), responseJson) && responseJson.isArray())
+			{
+				return MatchResponses(requests, responseJson);
+			}
+
+			std::vector<HTTP::Request> httpRequests;
+			for (const RPC::Request& request : requests)
+			{
+				httpRequests.push_back(HTTP::Request(HTTP::EHTTPMethod::POST, location, host, portNumber, JsonUtil::WriteCondensed(request.ToJSON())));
+			}
+
+			std::vector<RPC::Response> responses;
+			for (const HTTP::Response& pipelined : m_pClientPool->InvokePipelined(httpRequests))
+			{
+				responses.push_back(RPC::Response::Parse(pipelined.GetBody()));
+			}
+
+			return responses;
+		}
+		catch (HTTPException& e)
+		{
+			throw RPC_EXCEPTION(e.what(), std::nullopt);
+		}
+	}
+
 private:
-	std::shared_ptr<IHTTPClient> m_httpClient;
-};
\ No newline at end of file
+	// Batch responses can come back in any order, so they're matched to their requests by id.
+	static std::vector<RPC::Response> MatchResponses(const std::vector<RPC::Request>& requests, const Json::Value& responsesJson)
+	{
+		std::unordered_map<std::string, RPC::Response> responsesById;
+		for (const Json::Value& responseJson : responsesJson)
+		{
+			RPC::Response response = RPC::Response::FromJSON(responseJson);
+			responsesById.insert({ JsonUtil::WriteCondensed(response.GetId()), std::move(response) });
+		}
+
+		std::vector<RPC::Response> responses;
+		for (const RPC::Request& request : requests)
+		{
+			auto iter = responsesById.find(JsonUtil::WriteCondensed(request.GetId()));
+			if (iter == responsesById.end())
+			{
+				throw RPC_EXCEPTION("Batch response is missing a response", request.GetId());
+			}
+
+			responses.push_back(iter->second);
+		}
+
+		return responses;
+	}
+
+	HTTPClientPool::Ptr m_pClientPool;
+};
@@ -41,6 +41,22 @@ public:
 		return Invoke(location, RPC::Request::BuildRequest(method));
 	}
 
+	std::vector<RPC::Response> InvokeBatch(const std::string& location, const std::vector<RPC::Request>& requests)
+	{
+		try
+		{
+			return m_rpcClient.InvokeBatch(m_host, location, m_port, requests);
+		}
+		catch (RPCException&)
+		{
+			throw;
+		}
+		catch (std::exception& e)
+		{
+			throw RPC_EXCEPTION(e.what(), std::nullopt);
+		}
+	}
+
 private:
 	std::string m_host;
 	uint16_t m_port;
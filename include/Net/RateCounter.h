@@ -1,6 +1,8 @@
 #pragma once
 
+#include <Common/Metrics.h>
 #include <Common/Util/TimeUtil.h>
+#include <atomic>
 #include <mutex>
 #include <queue>
 
@@ -14,20 +16,63 @@ public:
 	{
 		m_received = other.m_received;
 		m_sent = other.m_sent;
+		m_messagesReceived = other.m_messagesReceived.load();
+		m_bytesReceived = other.m_bytesReceived.load();
+		m_messagesSent = other.m_messagesSent.load();
+		m_bytesSent = other.m_bytesSent.load();
 	}
 
-	void AddMessageReceived()
+	//
+	// Records a message for the lifetime totals, and (unless countTowardsRate is false) for the per-minute rate.
+	//
+	void AddMessageReceived(const size_t numBytes, const bool countTowardsRate = true)
 	{
-		std::unique_lock<std::mutex> lock(m_receivedMutex);
-		m_received.push(TimeUtil::Now());
+		static Metrics::Counter& s_messages = GetMessagesCounter("received");
+		s_messages.Increment();
+		m_messagesReceived++;
+		AddBytesReceived(numBytes);
+
+		if (countTowardsRate) {
+			std::unique_lock<std::mutex> lock(m_receivedMutex);
+			m_received.push(TimeUtil::Now());
+		}
 	}
 
-	void AddMessageSent()
+	void AddMessageSent(const size_t numBytes, const bool countTowardsRate = true)
 	{
-		std::unique_lock<std::mutex> lock(m_sentMutex);
-		m_sent.push(TimeUtil::Now());
+		static Metrics::Counter& s_messages = GetMessagesCounter("sent");
+		s_messages.Increment();
+		m_messagesSent++;
+		AddBytesSent(numBytes);
+
+		if (countTowardsRate) {
+			std::unique_lock<std::mutex> lock(m_sentMutex);
+			m_sent.push(TimeUtil::Now());
+		}
+	}
+
+	//
+	// Records raw bytes that aren't a whole message, like txhashset archive chunks.
+	//
+	void AddBytesReceived(const size_t numBytes)
+	{
+		static Metrics::Counter& s_bytes = GetBytesCounter("received");
+		s_bytes.Increment(numBytes);
+		m_bytesReceived += numBytes;
+	}
+
+	void AddBytesSent(const size_t numBytes)
+	{
+		static Metrics::Counter& s_bytes = GetBytesCounter("sent");
+		s_bytes.Increment(numBytes);
+		m_bytesSent += numBytes;
 	}
 
+	uint64_t GetTotalMessagesReceived() const noexcept { return m_messagesReceived; }
+	uint64_t GetTotalBytesReceived() const noexcept { return m_bytesReceived; }
+	uint64_t GetTotalMessagesSent() const noexcept { return m_messagesSent; }
+	uint64_t GetTotalBytesSent() const noexcept { return m_bytesSent; }
+
 	size_t GetReceivedInLastMinute()
 	{
 		std::unique_lock<std::mutex> lock(m_receivedMutex);
@@ -63,9 +108,24 @@ public:
 	}
 
 private:
+	static Metrics::Counter& GetMessagesCounter(const std::string& direction)
+	{
+		return Metrics::Registry::Get().AddCounter("grinpp_p2p_messages_total", "P2P messages, across all peers", { { "direction", direction } });
+	}
+
+	static Metrics::Counter& GetBytesCounter(const std::string& direction)
+	{
+		return Metrics::Registry::Get().AddCounter("grinpp_p2p_bytes_total", "P2P bytes, across all peers", { { "direction", direction } });
+	}
+
 	std::mutex m_receivedMutex;
 	std::queue<std::time_t> m_received;
 
 	std::mutex m_sentMutex;
 	std::queue<std::time_t> m_sent;
+
+	std::atomic<uint64_t> m_messagesReceived{ 0 };
+	std::atomic<uint64_t> m_bytesReceived{ 0 };
+	std::atomic<uint64_t> m_messagesSent{ 0 };
+	std::atomic<uint64_t> m_bytesSent{ 0 };
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Net/TokenBucket.h>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+//
+// Priority of an outgoing message. Lower values are sent first.
+//
+enum class ESendPriority : uint8_t
+{
+	CONTROL = 0,		// Handshakes, pings, errors and peer addresses. Small, and never throttled.
+	LATENCY = 1,		// Headers, compact blocks and requests. Never throttled, since sync and propagation wait on them.
+	TRANSACTION = 2,	// Transaction relay.
+	BULK = 3			// Full blocks and other large responses.
+};
+
+//
+// Per-connection queue of outgoing messages.
+//
+// Messages are sent strictly by priority, so a backlog of block responses never holds up pings or headers.
+// Transactions and bulk messages are also throttled by byte-based token buckets:
+// each connection has its own buckets, so no one peer can hog the upload,
+// and bulk traffic also draws from a bucket shared by every connection.
+//
+// Not thread-safe. The Socket guards it with its write queue mutex.
+//
+class SendQueue
+{
+public:
+	using Clock = TokenBucket::Clock;
+
+	static constexpr uint64_t TRANSACTION_BYTES_PER_SECOND = 1024 * 1024;
+	static constexpr uint64_t TRANSACTION_BURST_BYTES = 2 * 1024 * 1024;
+	static constexpr uint64_t PEER_BULK_BYTES_PER_SECOND = 8 * 1024 * 1024;
+	static constexpr uint64_t PEER_BULK_BURST_BYTES = 8 * 1024 * 1024;
+	static constexpr uint64_t SHARED_BULK_BYTES_PER_SECOND = 32 * 1024 * 1024;
+	static constexpr uint64_t SHARED_BULK_BURST_BYTES = 32 * 1024 * 1024;
+
+	struct Entry
+	{
+		std::vector<uint8_t> bytes;
+		ESendPriority priority;
+		bool isMessage; // False for raw bytes that aren't a whole message, like txhashset archive chunks.
+	};
+
+	explicit SendQueue(const std::shared_ptr<TokenBucket>& pSharedBulkBucket = GetSharedBulkBucket());
+
+	//
+	// The bucket shared by every connection's bulk traffic.
+	//
+	static std::shared_ptr<TokenBucket> GetSharedBulkBucket();
+
+	void Push(std::vector<uint8_t>&& bytes, const ESendPriority priority, const bool isMessage = true);
+
+	//
+	// Removes and returns the next entry that can be sent now.
+	// When every queued entry is throttled, returns nullopt and sets waitTime to when one can be sent.
+	//
+	std::optional<Entry> Pop(const Clock::time_point& now, Clock::duration& waitTime);
+
+	void Clear();
+
+	bool IsEmpty() const noexcept;
+	size_t GetQueuedBytes(const ESendPriority priority) const noexcept { return m_queuedBytes[(size_t)priority]; }
+	size_t GetQueuedBytes() const noexcept;
+
+private:
+	static constexpr size_t NUM_PRIORITIES = 4;
+
+	//
+	// Returns the buckets the priority is throttled by. Empty for unthrottled priorities.
+	//
+	std::vector<TokenBucket*> GetBuckets(const ESendPriority priority);
+
+	std::array<std::deque<Entry>, NUM_PRIORITIES> m_queues;
+	std::array<size_t, NUM_PRIORITIES> m_queuedBytes{};
+
+	TokenBucket m_transactionBucket;
+	TokenBucket m_bulkBucket;
+	std::shared_ptr<TokenBucket> m_pSharedBulkBucket;
+};
@@ -2,6 +2,7 @@
 
 #include <Net/Servers/Server.h>
 #include <Net/Servers/RPC/RPCMethod.h>
+#include <Net/Util/HTTPChunkedWriter.h>
 #include <Net/Clients/RPC/RPC.h>
 #include <Core/Exceptions/APIException.h>
 #include <unordered_map>
@@ -19,9 +20,10 @@ public:
 		const EServerType type,
 		const std::optional<uint16_t>& port,
 		const std::string& uri,
-		const LoggerAPI::LogFile& logFile)
+		const LoggerAPI::LogFile& logFile,
+		const ServerOptions& options = ServerOptions())
 	{
-		ServerPtr pServer = Server::Create(type, port);
+		ServerPtr pServer = Server::Create(type, port, options);
 		return RPCServer::Create(pServer, uri, logFile);
 	}
 
@@ -55,17 +57,98 @@ private:
 		RPCServer* pInstance = static_cast<RPCServer*>(pCbContext);
 		assert(pInstance != nullptr);
 
-		Json::Value responseJSON = Handle(pConnection, *pInstance).ToJSON();
+		std::optional<Json::Value> jsonOpt;
+		try
+		{
+			jsonOpt = HTTPUtil::GetRequestBody(pConnection);
+		}
+		catch (const std::exception& e)
+		{
+			RPC_LOG_ERROR_F(pInstance->m_logFile, "Failed to read request: {}", e.what());
+		}
+
+		// JSON-RPC batch: an array of requests, answered with an array of their responses.
+		if (jsonOpt.has_value() && jsonOpt.value().isArray() && !jsonOpt.value().empty())
+		{
+			Json::Value responsesJson(Json::arrayValue);
+			for (const Json::Value& requestJson : jsonOpt.value())
+			{
+				RPC::Response response = Handle(std::make_optional(requestJson), *pInstance);
+				try
+				{
+					// Streamed results are only written here, so this is where they can fail.
+					responsesJson.append(response.ToJSON());
+				}
+				catch (const std::exception& e)
+				{
+					RPC_LOG_ERROR_F(pInstance->m_logFile, "Failed to write response: {}", e.what());
+					responsesJson.append(RPC::Response::BuildError(response.GetId(), RPC::ErrorCode::INTERNAL_ERROR, e.what()).ToJSON());
+				}
+			}
+
+			return HTTPUtil::BuildSuccessResponseJSON(pConnection, responsesJson);
+		}
+
+		RPC::Response response = Handle(jsonOpt, *pInstance);
+		if (response.IsStreaming())
+		{
+			return StreamResponse(pConnection, *pInstance, response);
+		}
 
-		return HTTPUtil::BuildSuccessResponseJSON(pConnection, responseJSON);
+		return HTTPUtil::BuildSuccessResponseJSON(pConnection, response.ToJSON());
 	}
 
-	static RPC::Response Handle(mg_connection* pConnection, RPCServer& instance)
+	static int StreamResponse(mg_connection* pConnection, RPCServer& instance, const RPC::Response& response)
+	{
+		// Clients that can't read chunked responses (e.g. older wallets) get the same compact JSON, sent with a Content-Length.
+		if (!HTTPUtil::GetHeaderValue(pConnection, HTTP::ACCEPT_CHUNKED_HEADER).has_value())
+		{
+			std::string body;
+			try
+			{
+				body = JsonWriter::ToString([&response](JsonWriter& writer) { response.WriteJSON(writer); });
+			}
+			catch (const std::exception& e)
+			{
+				RPC_LOG_ERROR_F(instance.m_logFile, "Failed to write response: {}", e.what());
+				return HTTPUtil::BuildSuccessResponseJSON(
+					pConnection,
+					RPC::Response::BuildError(response.GetId(), RPC::ErrorCode::INTERNAL_ERROR, e.what()).ToJSON()
+				);
+			}
+
+			return HTTPUtil::BuildSuccessResponse(pConnection, body, "application/json");
+		}
+
+		HTTPChunkedWriter chunkedWriter(pConnection);
+		chunkedWriter.Begin();
+
+		try
+		{
+			JsonWriter writer([&chunkedWriter](const char* pData, const size_t length) { chunkedWriter.Write(pData, length); });
+			response.WriteJSON(writer);
+			writer.Flush();
+
+			return chunkedWriter.End();
+		}
+		catch (const std::exception& e)
+		{
+			RPC_LOG_ERROR_F(instance.m_logFile, "Failed to stream response: {}", e.what());
+			return chunkedWriter.Abort();
+		}
+	}
+
+	static RPC::Response Handle(const std::optional<Json::Value>& jsonOpt, RPCServer& instance)
 	{
 		Json::Value id(Json::nullValue);
 		try
 		{
-			RPC::Request request = RPC::Request::Parse(pConnection);
+			if (!jsonOpt.has_value())
+			{
+				throw RPC_EXCEPTION("json missing or invalid", std::nullopt);
+			}
+
+			RPC::Request request = RPC::Request::FromJSON(jsonOpt.value());
 			id = request.GetId();
 			try
 			{
@@ -88,7 +171,11 @@ private:
 					
 					auto response = iter->second->Handle(request);
 
-					if (!iter->second->ContainsSecrets())
+					if (response.IsStreaming())
+					{
+						RPC_LOG_INFO_F(instance.m_logFile, "REPLY: <streamed result for {}>", method);
+					}
+					else if (!iter->second->ContainsSecrets())
 					{
 						RPC_LOG_INFO_F(instance.m_logFile, "REPLY: {}", response.ToString());
 					}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <Net/Servers/ServerOptions.h>
+
 #include <cassert>
 #include <string>
 #include <optional>
@@ -19,7 +21,11 @@ typedef int(*mg_request_handler)(struct mg_connection* conn, void* cbdata);
 class Server
 {
 public:
-	static std::shared_ptr<Server> Create(const EServerType type, const std::optional<uint16_t>& port);
+	static std::shared_ptr<Server> Create(
+		const EServerType type,
+		const std::optional<uint16_t>& port,
+		const ServerOptions& options = ServerOptions()
+	);
 	virtual ~Server();
 
 	uint16_t GetPortNumber() const noexcept { return m_portNumber; }
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+//
+// civetweb tuning for a single HTTP listener.
+// civetweb pins a worker thread to each open connection, so an idle keep-alive
+// connection holds its thread until keepAliveTimeoutMs expires. Size numThreads accordingly.
+//
+struct ServerOptions
+{
+	uint32_t numThreads = 10;
+	bool keepAlive = true;
+	uint32_t keepAliveTimeoutMs = 3000;
+	uint32_t requestTimeoutMs = 120000;
+};
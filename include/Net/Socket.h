@@ -1,14 +1,15 @@
 #pragma once
 
 #include <Common/Compat.h>
-#include <Common/SharedQueue.h>
 #include <Core/Traits/Printable.h>
 #include <Net/RateCounter.h>
+#include <Net/SendQueue.h>
 #include <Net/SocketAddress.h>
 
 #include <inttypes.h>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <atomic>
 #include <shared_mutex>
 #include <queue>
@@ -72,13 +73,21 @@ public:
 	void SetConnectFailed(bool failed) { m_failed = failed; }
 
 	bool SendSync(const std::vector<uint8_t>& message, const bool incrementCount);
-	void SendAsync(const std::vector<uint8_t>& message);
+
+	//
+	// Queues the bytes to be sent once everything of a higher priority has been, and the priority isn't throttled.
+	// Set isMessage to false for raw bytes that aren't a whole message.
+	//
+	void SendAsync(std::vector<uint8_t> message, const ESendPriority priority, const bool isMessage = true);
+	size_t GetQueuedBytes(const ESendPriority priority);
+	bool HasPendingSends();
 
 	std::vector<uint8_t> ReceiveSync(const size_t numBytes, const bool incrementCount);
 
 private:
 	bool HasReceivedData();
 	void ThrowSocketException(const asio::error_code& ec);
+	void StartNextWrite();
 	void HandleSent(const asio::error_code& ec, size_t bytes_transferred);
 
 	std::shared_mutex m_socketMutex;
@@ -93,7 +102,10 @@ private:
 	RateCounter m_rateCounter;
 
 	std::mutex m_writeQueueMutex;
-	SharedQueue<std::vector<uint8_t>> m_writeQueue; // TODO: Use strand instead of queue
+	SendQueue m_sendQueue;
+	std::optional<SendQueue::Entry> m_writing; // Must stay alive until its async_write completes.
+	bool m_throttled;
+	asio::steady_timer m_throttleTimer;
 
 	asio::error_code m_errorCode;
 	std::atomic_bool m_socketOpen;
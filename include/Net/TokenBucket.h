@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+//
+// Byte-based token bucket. Tokens refill at a constant rate, up to the burst size.
+//
+// A message may be sent whenever the bucket isn't empty, even if it's larger than the tokens available.
+// The bucket then goes into debt, which delays later messages instead. That way, messages larger than
+// the burst size still go out, and the average rate still holds.
+//
+// Thread-safe, so a single bucket can be shared by every connection.
+//
+class TokenBucket
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	TokenBucket(const uint64_t bytesPerSecond, const uint64_t burstBytes)
+		: m_bytesPerSecond(bytesPerSecond),
+		m_burstBytes(burstBytes),
+		m_tokens((double)burstBytes),
+		m_lastRefill(Clock::now()) { }
+
+	bool HasTokens(const Clock::time_point& now)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		Refill(now);
+		return m_tokens > 0.0;
+	}
+
+	void Consume(const uint64_t numBytes, const Clock::time_point& now)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		Refill(now);
+		m_tokens -= (double)numBytes;
+	}
+
+	//
+	// Returns how long until the bucket has tokens again. Zero if it already does.
+	//
+	Clock::duration GetWaitTime(const Clock::time_point& now)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		Refill(now);
+		if (m_tokens > 0.0) {
+			return Clock::duration::zero();
+		}
+
+		// +1 byte, since we need a positive balance, not just a zero one.
+		const double seconds = (1.0 - m_tokens) / (double)m_bytesPerSecond;
+		return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+	}
+
+private:
+	void Refill(const Clock::time_point& now)
+	{
+		if (now > m_lastRefill) {
+			const double elapsed = std::chrono::duration<double>(now - m_lastRefill).count();
+			m_tokens = (std::min)((double)m_burstBytes, m_tokens + elapsed * (double)m_bytesPerSecond);
+			m_lastRefill = now;
+		}
+	}
+
+	std::mutex m_mutex;
+	uint64_t m_bytesPerSecond;
+	uint64_t m_burstBytes;
+	double m_tokens;
+	Clock::time_point m_lastRefill;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+// Forward Declarations
+struct mg_connection;
+
+//
+// Writes an HTTP/1.1 response using chunked transfer encoding.
+// Small writes are buffered, and sent as a single chunk once the buffer fills up,
+// so large responses can be written while they're built, without holding the whole body in memory.
+//
+class HTTPChunkedWriter
+{
+public:
+	static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+	HTTPChunkedWriter(mg_connection* conn, const size_t chunkSize = DEFAULT_CHUNK_SIZE);
+	~HTTPChunkedWriter() = default;
+
+	// Writes the status line and headers. Must be called before any data is written.
+	void Begin(const std::string& contentType = "application/json");
+
+	void Write(const char* pData, const size_t length);
+	void Write(const std::string& data) { Write(data.data(), data.size()); }
+
+	// Flushes any buffered data and writes the terminating chunk. Returns the HTTP status code.
+	int End();
+
+	// Ends the response without the terminating chunk, and closes the connection once the handler returns,
+	// so the client sees a truncated transfer. Use when the body fails part way through. Returns the HTTP status code.
+	int Abort() noexcept;
+
+private:
+	void Flush();
+
+	mg_connection* m_pConnection;
+	size_t m_chunkSize;
+	std::string m_buffer;
+};
@@ -24,6 +24,7 @@ public:
 
 	static int BuildSuccessResponseJSON(mg_connection* conn, const Json::Value& json);
 	static int BuildSuccessResponse(mg_connection* conn, const std::string& response);
+	static int BuildSuccessResponse(mg_connection* conn, const std::string& response, const std::string& contentType);
 	static int BuildBadRequestResponse(mg_connection* conn, const std::string& response);
 	static int BuildConflictResponse(mg_connection* conn, const std::string& response);
 	static int BuildUnauthorizedResponse(mg_connection* conn, const std::string& response);
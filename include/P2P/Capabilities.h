@@ -22,6 +22,10 @@ public:
 		// Can provide a list of healthy peers
 		PEER_LIST = 0x04,
 
+		// Accepts compact blocks pushed before they're fully validated, and can serve the txs they're missing by short id.
+		// Not part of the standard protocol, so it's set well above the bits other implementations use.
+		COMPACT_BLOCK_RELAY = 0x100,
+
 		FAST_SYNC_NODE = (TXHASHET_HIST | PEER_LIST),
 
 		ARCHIVE_NODE = (FULL_HIST | TXHASHET_HIST | PEER_LIST)
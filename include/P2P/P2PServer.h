@@ -56,6 +56,11 @@ public:
 	virtual bool UnbanAllPeers() = 0;
 
 	virtual void BroadcastTransaction(const TransactionPtr& pTransaction) = 0;
+
+	//
+	// Announces a block, eg. one we just mined, to all connected peers.
+	//
+	virtual void BroadcastBlock(const BlockHeaderPtr& pHeader) = 0;
 };
 
 typedef std::shared_ptr<IP2PServer> IP2PServerPtr;
@@ -9,6 +9,7 @@
 #include <Core/Traits/Batchable.h>
 #include <BlockChain/Chain.h>
 #include <Crypto/Models/Hash.h>
+#include <optional>
 
 // Forward Declarations
 class Config;
@@ -21,6 +22,23 @@ class Transaction;
 class TransactionBody;
 class SyncStatus;
 
+//
+// Compacted copies of the output and rangeproof PMMR files, written by ITxHashSet::PrepareCompaction.
+//
+struct TxHashSetCompaction
+{
+	// How many hashes and data entries of a PMMR's files the copies were written from.
+	struct Files
+	{
+		uint64_t numHashes;
+		uint64_t numData;
+	};
+
+	BlockHeaderPtr pHeader; // The block the txhashset was at when the copies were written.
+	std::optional<Files> output; // nullopt if there was nothing to prune.
+	std::optional<Files> rangeProof;
+};
+
 class ITxHashSet : public Traits::IBatchable
 {
 public:
@@ -101,9 +119,10 @@ public:
 
 	//
 	// Get outputs by leaf/insertion index.
+	// Block heights are derived from the confirmed chain's header output MMR sizes.
 	//
 	virtual OutputRange GetOutputsByLeafIndex(
-		std::shared_ptr<const IBlockDB> pBlockDB,
+		const IBlockChain& blockChain,
 		const uint64_t startIndex,
 		const uint64_t maxNumOutputs
 	) const = 0;
@@ -145,9 +164,20 @@ public:
 	virtual void Rollback() noexcept = 0;
 
 	//
-	// Removes pruned leaves and hashes from the output and rangeproof PMMRs to reduce disk usage.
+	// Removes outputs and rangeproofs that were spent before the cut-through horizon from the output and rangeproof PMMRs.
+	// Outputs spent after the horizon are kept, so the txhashset can still be rewound to any block above it.
+	// The caller must hold the TxHashSetManager write lock, and there must be no uncommitted changes.
+	//
+	virtual void Compact(std::shared_ptr<const IBlockDB> pBlockDB) = 0;
+
+	//
+	// Compact, split in two so the PMMR files can be rewritten without holding the write lock. Only one may be in progress at a time.
+	// PrepareCompaction writes the compacted copies next to the originals, and only needs the TxHashSetManager read lock.
+	// ApplyCompaction needs the write lock. It copies over anything appended since, then swaps the copies in.
+	// If the txhashset was rewound past the block the copies were written at, it discards them instead and returns false.
 	//
-	virtual void Compact() = 0;
+	virtual TxHashSetCompaction PrepareCompaction(std::shared_ptr<const IBlockDB> pBlockDB) const = 0;
+	virtual bool ApplyCompaction(std::shared_ptr<const IBlockDB> pBlockDB, const TxHashSetCompaction& compaction) = 0;
 };
 
 typedef std::shared_ptr<ITxHashSet> ITxHashSetPtr;
@@ -15,8 +15,40 @@ public:
 	//
 	bool IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const;
 
+	//
+	// Same as IsPoWValid, but skips the cuckoo cycle, for headers whose cycles were already checked by AreCyclesValid.
+	//
+	bool IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader) const;
+
+	struct NextDifficulty
+	{
+		uint64_t difficulty;
+		uint32_t secondaryScaling;
+	};
+
+	//
+	// Calculates the network difficulty and secondary scaling the header must have.
+	// Only the header's version, height and previous hash are used, so this works for headers still being built.
+	//
+	NextDifficulty GetNextDifficulty(const BlockHeader& header) const;
+
+	//
+	// Validates only the cuckoo cycle, without checking the difficulty it achieves.
+	//
+	static bool IsCycleValid(const BlockHeader& header);
+
+	//
+	// Validates the cuckoo cycles of many headers at once, spread across a thread pool.
+	// Returns whether each header's cycle is valid, in the same order as the given headers.
+	//
+	static std::vector<bool> AreCyclesValid(const std::vector<BlockHeaderPtr>& headers);
+
+	//
+	// Maximum difficulty the header's proof of work can achieve.
+	//
+	static uint64_t GetMaximumDifficulty(const BlockHeader& header);
+
 private:
-	uint64_t GetMaximumDifficulty(const BlockHeader& header) const;
 
 	std::shared_ptr<const IBlockDB> m_pBlockDB;
 };
\ No newline at end of file
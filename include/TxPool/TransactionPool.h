@@ -29,7 +29,8 @@ enum class EAddTransactionStatus
 	DUPL_TX,
 	LOW_FEE,
 	TX_INVALID,
-	NOT_ADDED
+	NOT_ADDED,
+	POOL_FULL
 };
 
 struct TransactionPoolEntry
@@ -66,6 +67,7 @@ public:
 	// * LOW_FEE - If fee does not meet the minimum set in the config.
 	// * TX_INVALID - If the transaction is not self-consistent. Source peer should be banned.
 	// * NOT_ADDED - If the transaction is valid, but can't be added yet due to eg. lock-heights.
+	// * POOL_FULL - If the pool is full, and the transaction's fee rate doesn't beat the lowest one in the pool.
 	//
 	virtual EAddTransactionStatus AddTransaction(
 		std::shared_ptr<const IBlockDB> pBlockDB,
@@ -87,6 +89,23 @@ public:
 	virtual size_t GetStemPoolSize() const = 0;
 	virtual std::vector<TransactionPoolEntry> GetTransactions(const EPoolType poolType) const = 0;
 
+	//
+	// Mempool txs to mine in the next block, highest fee rate first, with a total weight of at most maxWeight.
+	// Never includes conflicting txs, or txs spending outputs of txs that weren't included.
+	//
+	virtual std::vector<TransactionPtr> GetTransactionsForBlock(const uint64_t maxWeight) const = 0;
+
+	//
+	// Changes whenever a tx is added to or removed from the mempool.
+	//
+	virtual uint64_t GetMemPoolVersion() const = 0;
+
+	//
+	// Blocks until a tx is added to the mempool or a block is reconciled since lastChange, or until the timeout expires.
+	// Pass 0 the first time, and the returned value after that.
+	//
+	virtual uint64_t WaitForChange(const uint64_t lastChange, const std::chrono::milliseconds& timeout) const = 0;
+
 	// Dandelion
 	virtual TransactionPtr GetTransactionToStem(
 		std::shared_ptr<const IBlockDB> pBlockDB,
@@ -97,6 +116,23 @@ public:
 		ITxHashSetConstPtr pTxHashSet
 	) = 0;
 	virtual std::vector<TransactionPtr> GetExpiredTransactions() const = 0;
+
+	//
+	// Writes both pools to the snapshot file, so they can be restored after a restart.
+	// Also done periodically in the background, and once more when the pool is destroyed.
+	//
+	virtual void SaveSnapshot() const = 0;
+
+	//
+	// Restores the txs from the last snapshot, revalidating them in parallel against the current UTXO set.
+	// Txs that are no longer valid, e.g. because they were mined while the node was down, are dropped.
+	// Returns the number of txs restored.
+	//
+	virtual size_t LoadSnapshot(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		const BlockHeader& lastConfirmedBlock
+	) = 0;
 };
 
 namespace TxPoolAPI
@@ -41,10 +41,13 @@ public:
 	) const;
 
 private:
-	KeyChain(PrivateExtKey&& masterKey, SecretKey&& bulletProofNonce);
+	KeyChain(PrivateExtKey&& masterKey, SecretKey&& bulletProofNonce, SecretKey&& rewindNonceHash);
 
 	SecretKey CreateNonce(const Commitment& commitment, const SecretKey& nonceHash) const;
 
 	PrivateExtKey m_masterKey;
 	SecretKey m_bulletProofNonce;
+
+	// Blake2b(masterPublicKey) - cached, since deriving the public key on every rewind is expensive.
+	SecretKey m_rewindNonceHash;
 };
\ No newline at end of file
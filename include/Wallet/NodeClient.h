@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <memory>
 #include <map>
+#include <set>
 
 //
 // INodeClient is an interface whose implementations communicate with nodes in various ways.
@@ -36,6 +37,25 @@ public:
 	//
 	virtual BlockHeaderPtr GetBlockHeader(const uint64_t height) const = 0;
 
+	//
+	// Returns the headers of the confirmed blocks at the given heights. Heights without a block are left out.
+	// Remote clients override this to fetch them all in one round trip.
+	//
+	virtual std::map<uint64_t, BlockHeaderPtr> GetBlockHeaders(const std::set<uint64_t>& heights) const
+	{
+		std::map<uint64_t, BlockHeaderPtr> headers;
+		for (const uint64_t height : heights)
+		{
+			BlockHeaderPtr pHeader = GetBlockHeader(height);
+			if (pHeader != nullptr)
+			{
+				headers.insert({ height, pHeader });
+			}
+		}
+
+		return headers;
+	}
+
 	//
 	// Returns the location (block height and mmr index) of each requested output, if it is *unspent*.
 	//
@@ -6,6 +6,7 @@
 #include <uuid.h>
 #include <Core/Traits/Batchable.h>
 #include <Core/Traits/Lockable.h>
+#include <Crypto/Models/Hash.h>
 #include <Wallet/WalletDB/Models/EncryptedSeed.h>
 #include <Wallet/KeyChainPath.h>
 #include <Wallet/WalletDB/Models/SlateContextEntity.h>
@@ -52,7 +53,8 @@ public:
 
 	virtual uint32_t GetNextTransactionId() = 0;
 	virtual uint64_t GetRefreshBlockHeight() const = 0;
-	virtual void UpdateRefreshBlockHeight(const uint64_t refreshBlockHeight) = 0;
+	virtual Hash GetRefreshBlockHash() const = 0; // ZERO_HASH if not known
+	virtual void UpdateRefreshBlock(const uint64_t refreshBlockHeight, const Hash& refreshBlockHash) = 0;
 	virtual uint64_t GetRestoreLeafIndex() const = 0;
 	virtual void UpdateRestoreLeafIndex(const uint64_t lastLeafIndex) = 0;
 };
@@ -1,35 +1,21 @@
 #pragma once
 
 #include <BlockChain/BlockChain.h>
-#include <PMMR/TxHashSet.h>
-#include <Database/Database.h>
 #include <Net/Clients/RPC/RPC.h>
 #include <Net/Servers/RPC/RPCMethod.h>
 
 class CompactChainHandler : public RPCMethod
 {
 public:
-	CompactChainHandler(
-		const IBlockChain::Ptr& pBlockChain,
-		const std::weak_ptr<ITxHashSet>& pTxHashSet,
-		const IDatabasePtr& pDatabase)
-		: m_pBlockChain(pBlockChain), m_pTxHashSet(pTxHashSet), m_pDatabase(pDatabase) { }
+	CompactChainHandler(const IBlockChain::Ptr& pBlockChain)
+		: m_pBlockChain(pBlockChain) { }
 	~CompactChainHandler() override = default;
 
 	RPC::Response Handle(const RPC::Request& request) const final
 	{
-		auto pTxHashSet = m_pTxHashSet.lock();
-		if (!pTxHashSet)
-		{
-			return request.BuildError(RPC::ErrorCode::INTERNAL_ERROR, "TxHashSet not available");
-		}
-
-		(void)m_pBlockChain;
-		(void)m_pDatabase;
-
 		try
 		{
-			pTxHashSet->Compact();
+			m_pBlockChain->CompactTxHashSet();
 		}
 		catch (const std::exception& e)
 		{
@@ -45,6 +31,4 @@ public:
 
 private:
 	IBlockChain::Ptr m_pBlockChain;
-	std::weak_ptr<ITxHashSet> m_pTxHashSet;
-	IDatabasePtr m_pDatabase;
 };
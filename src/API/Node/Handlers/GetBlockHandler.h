@@ -44,9 +44,13 @@ public:
 			return request.BuildError("NOT_FOUND", "Block not found");
 		}
 
-		Json::Value result;
-		result["Ok"] = pBlock->ToJSON();
-		return request.BuildResult(result);
+		std::shared_ptr<const FullBlock> pResult(std::move(pBlock));
+		return request.BuildStreamingResult([pResult](JsonWriter& writer) {
+			writer.BeginObject();
+			writer.Key("Ok");
+			pResult->WriteJSON(writer);
+			writer.EndObject();
+		});
 	}
 
 	bool ContainsSecrets() const noexcept final { return false; }
@@ -81,48 +81,33 @@ public:
 			endHeight = pTip->GetHeight();
 		}
 
-		Json::Value blocks(Json::arrayValue);
-		uint64_t lastRetrievedHeight = startHeight;
-		uint64_t count = 0;
-
-		for (uint64_t height = startHeight; height <= endHeight && count < maxBlocks; ++height)
-		{
-			std::unique_ptr<FullBlock> pBlock = m_pBlockChain->GetBlockByHeight(height);
-			if (pBlock == nullptr)
-			{
-				continue;
-			}
-
-			Json::Value blockJson = pBlock->ToJSON();
-			if (!includeProof && blockJson.isMember("outputs"))
+		// Blocks are loaded and written one at a time, so only a single block is held in memory.
+		IBlockChain::Ptr pBlockChain = m_pBlockChain;
+		return request.BuildStreamingResult([pBlockChain, startHeight, endHeight, maxBlocks, includeProof](JsonWriter& writer) {
+			uint64_t lastRetrievedHeight = startHeight;
+			uint64_t count = 0;
+
+			writer.BeginObject();
+			writer.Key("Ok").BeginObject();
+			writer.Key("blocks").BeginArray();
+			for (uint64_t height = startHeight; height <= endHeight && count < maxBlocks; ++height)
 			{
-				Json::Value& outputs = blockJson["outputs"];
-				if (outputs.isArray())
+				std::unique_ptr<FullBlock> pBlock = pBlockChain->GetBlockByHeight(height);
+				if (pBlock == nullptr)
 				{
-					for (Json::Value::ArrayIndex i = 0; i < outputs.size(); ++i)
-					{
-						outputs[i].removeMember("proof");
-					}
+					continue;
 				}
-			}
-
-			blocks.append(blockJson);
-			lastRetrievedHeight = height;
-			++count;
-		}
 
-		if (blocks.empty())
-		{
-			lastRetrievedHeight = startHeight;
-		}
-
-		Json::Value listing;
-		listing["last_retrieved_height"] = Json::UInt64(lastRetrievedHeight);
-		listing["blocks"] = blocks;
+				pBlock->WriteJSON(writer, includeProof);
+				lastRetrievedHeight = height;
+				++count;
+			}
+			writer.EndArray();
 
-		Json::Value result;
-		result["Ok"] = listing;
-		return request.BuildResult(result);
+			writer.UInt64("last_retrieved_height", lastRetrievedHeight);
+			writer.EndObject();
+			writer.EndObject();
+		});
 	}
 
 	bool ContainsSecrets() const noexcept final { return false; }
@@ -2,7 +2,7 @@
 
 #include <PMMR/TxHashSet.h>
 #include <Core/Util/JsonUtil.h>
-#include <Database/Database.h>
+#include <BlockChain/BlockChain.h>
 #include <Net/Clients/RPC/RPC.h>
 #include <Net/Servers/RPC/RPCMethod.h>
 #include <Crypto/Hasher.h>
@@ -10,8 +10,8 @@
 class GetPMMRIndicesHandler : public RPCMethod
 {
 public:
-	GetPMMRIndicesHandler(const std::weak_ptr<ITxHashSet>& pTxHashSet, const IDatabasePtr& pDatabase)
-		: m_pTxHashSet(pTxHashSet), m_pDatabase(pDatabase) { }
+	GetPMMRIndicesHandler(const std::weak_ptr<ITxHashSet>& pTxHashSet, const IBlockChain::Ptr& pBlockChain)
+		: m_pTxHashSet(pTxHashSet), m_pBlockChain(pBlockChain) { }
 	~GetPMMRIndicesHandler() override = default;
 
 	RPC::Response Handle(const RPC::Request& request) const final
@@ -49,8 +49,7 @@ public:
 			max = 1000;
 		}
 
-		auto pBlockDB = m_pDatabase->GetBlockDB()->Read();
-		OutputRange range = pTxHashSet->GetOutputsByLeafIndex(pBlockDB.GetShared(), startIndex, max);
+		OutputRange range = pTxHashSet->GetOutputsByLeafIndex(*m_pBlockChain, startIndex, max);
 
 		Json::Value outputs(Json::arrayValue);
 		for (const OutputDTO& info : range.GetOutputs())
@@ -87,5 +86,5 @@ public:
 
 private:
 	std::weak_ptr<ITxHashSet> m_pTxHashSet;
-	IDatabasePtr m_pDatabase;
+	IBlockChain::Ptr m_pBlockChain;
 };
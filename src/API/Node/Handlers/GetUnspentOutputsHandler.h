@@ -9,8 +9,8 @@
 class GetUnspentOutputsHandler : public RPCMethod
 {
 public:
-	GetUnspentOutputsHandler(const std::weak_ptr<ITxHashSet>& pTxHashSet, const IDatabasePtr& pDatabase)
-		: m_pTxHashSet(pTxHashSet), m_pDatabase(pDatabase) { }
+	GetUnspentOutputsHandler(const std::weak_ptr<ITxHashSet>& pTxHashSet, const IBlockChain::Ptr& pBlockChain)
+		: m_pTxHashSet(pTxHashSet), m_pBlockChain(pBlockChain) { }
 	~GetUnspentOutputsHandler() = default;
 
 	RPC::Response Handle(const RPC::Request& request) const final
@@ -37,42 +37,27 @@ public:
 			max = maxParam.value();
 		}
 
-		auto pBlockDB = m_pDatabase->GetBlockDB()->Read();
-		OutputRange range = tx->GetOutputsByLeafIndex(pBlockDB.GetShared(), startIndex, max);
-
-		Json::Value outputs;
-		for (const OutputDTO& info : range.GetOutputs())
-		{
-			if (info.IsSpent())
+		auto pRange = std::make_shared<const OutputRange>(tx->GetOutputsByLeafIndex(*m_pBlockChain, startIndex, max));
+		return request.BuildStreamingResult([pRange](JsonWriter& writer) {
+			writer.BeginObject();
+			writer.Key("Ok").BeginArray();
+			for (const OutputDTO& info : pRange->GetOutputs())
 			{
-				continue;
-			}
-			Json::Value output;
-			output["output_type"] = OutputFeatures::ToString(info.GetIdentifier().GetFeatures());
-			output["commit"] = info.GetIdentifier().GetCommitment().ToHex();
-			output["spent"] = info.IsSpent();
-			output["proof"] = info.GetRangeProof().Format();
-
-			Serializer proofSerializer;
-			info.GetRangeProof().Serialize(proofSerializer);
-			output["proof_hash"] = Hasher::Blake2b(proofSerializer.GetBytes()).ToHex();
-
-			output["block_height"] = info.GetLocation().GetBlockHeight();
-			output["merkle_proof"] = Json::nullValue;
-			output["mmr_index"] = info.GetLeafIndex().GetPosition() + 1;
+				if (info.IsSpent())
+				{
+					continue;
+				}
 
-			outputs.append(output);
-		}
-
-		Json::Value result;
-		result["Ok"] = outputs;
-
-		return request.BuildResult(result);
+				info.WriteJSON(writer);
+			}
+			writer.EndArray();
+			writer.EndObject();
+		});
 	}
 
 	bool ContainsSecrets() const noexcept final { return false; }
 
 private:
 	std::weak_ptr<ITxHashSet> m_pTxHashSet;
-	IDatabasePtr m_pDatabase;
+	IBlockChain::Ptr m_pBlockChain;
 };
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Common/Tracing.h>
+#include <Net/Servers/RPC/RPCMethod.h>
+
+//
+// Discards any previously recorded spans, and starts recording.
+// Use stop_tracing to retrieve the trace.
+//
+class StartTracingHandler : public RPCMethod
+{
+public:
+	RPC::Response Handle(const RPC::Request& request) const final
+	{
+		Tracing::Start();
+
+		Json::Value result;
+		result["Ok"] = "";
+		return request.BuildResult(result);
+	}
+
+	bool ContainsSecrets() const noexcept final { return false; }
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Common/Tracing.h>
+#include <Core/Util/JsonUtil.h>
+#include <Net/Servers/RPC/RPCMethod.h>
+
+//
+// Stops recording, and returns the recorded spans in the Chrome trace-event format.
+// Save the "Ok" object to a file and open it in chrome://tracing or ui.perfetto.dev.
+//
+class StopTracingHandler : public RPCMethod
+{
+public:
+	RPC::Response Handle(const RPC::Request& request) const final
+	{
+		Tracing::Stop();
+
+		Json::Value trace;
+		if (!JsonUtil::Parse(Tracing::ExportChromeTrace(), trace)) {
+			return request.BuildError(RPC::ErrorCode::INTERNAL_ERROR, "Failed to export trace");
+		}
+
+		Json::Value result;
+		result["Ok"] = trace;
+		return request.BuildResult(result);
+	}
+
+	bool ContainsSecrets() const noexcept final { return false; }
+};
@@ -12,13 +12,15 @@ ForeignServer::UPtr ForeignServer::Create(
     const std::shared_ptr<ITorProcess>& pTorProcess,
     IWalletManager& walletManager,
     const SessionToken& token,
-    const int currentAddressIndex)
+    const int currentAddressIndex,
+    const ServerOptions& options)
 {
     RPCServerPtr pServer = RPCServer::Create(
         EServerType::PUBLIC,
         std::nullopt,
         "/v2/foreign",
-        LoggerAPI::LogFile::WALLET
+        LoggerAPI::LogFile::WALLET,
+        options
     );
 
     /*
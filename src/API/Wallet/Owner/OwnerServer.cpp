@@ -27,13 +27,17 @@
 #include "Handlers/GetWalletAddressHandler.h"
 #include "Handlers/GetNewWalletAddressHandler.h"
 
-OwnerServer::UPtr OwnerServer::Create(const TorProcess::Ptr& pTorProcess, const IWalletManagerPtr& pWalletManager)
+OwnerServer::UPtr OwnerServer::Create(
+    const TorProcess::Ptr& pTorProcess,
+    const IWalletManagerPtr& pWalletManager,
+    const ServerOptions& options)
 {
     RPCServerPtr pServer = RPCServer::Create(
         EServerType::LOCAL,
         std::make_optional<uint16_t>((uint16_t)3421), // TODO: Read port from config (Use same port as v1 owner)
         "/v2",
-        LoggerAPI::LogFile::WALLET
+        LoggerAPI::LogFile::WALLET,
+        options
     );
 
     /*
@@ -14,8 +14,13 @@
 #include <Common/Logger.h>
 #include <Core/Global.h>
 #include <Core/Exceptions/BadDataException.h>
+#include <Core/Exceptions/TxHashSetException.h>
 #include <Core/Config.h>
+#include <Core/Util/TransactionUtil.h>
+#include <Common/Util/TimeUtil.h>
+#include <Crypto/Crypto.h>
 #include <PMMR/TxHashSet.h>
+#include <PoW/PoWValidator.h>
 #include <filesystem.h>
 #include <algorithm>
 
@@ -58,7 +63,7 @@ std::shared_ptr<BlockChain> BlockChain::Create(
 
 	// Migrate database
 	const uint8_t db_version = pDatabase->Read()->GetVersion();
-	if (db_version > 3) {
+	if (db_version > 4) {
 		LOG_ERROR("Database is from a newer version of Grin++!");
 		std::terminate();
 	}
@@ -78,10 +83,10 @@ std::shared_ptr<BlockChain> BlockChain::Create(
 		pBlockDB->SetVersion(2);
 	}
 
-	if (db_version < 3) {
-		LOG_WARNING_F("Migrating blocks to v3 for Grin++ {}", GRINPP_VERSION);
+	if (db_version < 4) {
+		LOG_WARNING_F("Migrating blocks to v4 for Grin++ {}", GRINPP_VERSION);
 		pDatabase->Write()->MigrateBlocks();
-		pDatabase->Write()->SetVersion(3);
+		pDatabase->Write()->SetVersion(4);
 	}
 
 	// Trigger Compaction
@@ -97,7 +102,7 @@ std::shared_ptr<BlockChain> BlockChain::Create(
 			if (pTxHashSet->GetFlushedBlockHeader()->GetHeight() < horizon) {
 				pTxHashSetManager->Write()->Close();
 			} else {
-				pTxHashSet->Compact();
+				pTxHashSet->Compact(pBatchDB.GetShared());
 			}
 
 			pBatchTxHashSet->Commit();
@@ -135,7 +140,7 @@ EBlockChainStatus BlockChain::AddBlock(const FullBlock& block)
 	return BlockProcessor(m_pChainState).ProcessBlock(block);
 }
 
-EBlockChainStatus BlockChain::AddCompactBlock(const CompactBlock& compactBlock)
+EBlockChainStatus BlockChain::AddCompactBlock(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions)
 {
 	const Hash& hash = compactBlock.GetHash();
 	const uint64_t height = compactBlock.GetHeight();
@@ -151,7 +156,7 @@ EBlockChainStatus BlockChain::AddCompactBlock(const CompactBlock& compactBlock)
 
 	try
 	{
-		std::unique_ptr<FullBlock> pHydratedBlock = BlockHydrator(m_pTransactionPool).Hydrate(compactBlock);
+		std::unique_ptr<FullBlock> pHydratedBlock = BlockHydrator(m_pTransactionPool).Hydrate(compactBlock, transactions);
 		if (pHydratedBlock != nullptr)
 		{
 			const EBlockChainStatus added = AddBlock(*pHydratedBlock);
@@ -184,6 +189,39 @@ fs::path BlockChain::SnapshotTxHashSet(BlockHeaderPtr pBlockHeader)
 	return pBatch->GetTxHashSetManager()->SaveSnapshot(pBatch->GetBlockDB(), pBlockHeader);
 }
 
+void BlockChain::CompactTxHashSet()
+{
+	std::unique_lock<std::mutex> compactLock(m_compactMutex);
+
+	// Writing the compacted files is the slow part, so it's done under the read lock.
+	TxHashSetCompaction compaction;
+	std::shared_ptr<const ITxHashSet> pPrepared;
+	{
+		auto pReader = m_pChainState->Read();
+		auto pTxHashSetManager = pReader->GetTxHashSetManager();
+		auto pTxHashSet = pTxHashSetManager->GetTxHashSet();
+		if (pTxHashSet == nullptr)
+		{
+			throw TXHASHSET_EXCEPTION("TxHashSet not available");
+		}
+
+		compaction = pTxHashSet->PrepareCompaction(pReader->GetBlockDB().GetShared());
+		pPrepared = pTxHashSet;
+	}
+
+	auto pBatch = m_pChainState->BatchWrite();
+	auto pTxHashSet = pBatch->GetTxHashSetManager()->GetTxHashSet();
+	if (pTxHashSet != pPrepared)
+	{
+		// Replaced by a downloaded txhashset in the meantime. RecoverCompaction cleans up the unused copies on the next load.
+		LOG_WARNING("TxHashSet was replaced while compacting");
+		return;
+	}
+
+	pTxHashSet->ApplyCompaction(pBatch->GetBlockDB(), compaction);
+	pBatch->Commit();
+}
+
 EBlockChainStatus BlockChain::ProcessTransactionHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus)
 {
 	try
@@ -244,6 +282,11 @@ TransactionPtr BlockChain::GetTransactionByKernelHash(const Hash& kernelHash) co
 	return m_pTransactionPool->FindTransactionByKernelHash(kernelHash);
 }
 
+std::vector<TransactionPtr> BlockChain::GetTransactionsByShortId(const Hash& blockHash, const uint64_t nonce, const std::set<ShortId>& shortIds) const
+{
+	return m_pTransactionPool->GetTransactionsByShortId(blockHash, nonce, shortIds);
+}
+
 EBlockChainStatus BlockChain::AddBlockHeader(BlockHeaderPtr pBlockHeader)
 {
 	try
@@ -294,6 +337,32 @@ std::vector<BlockHeaderPtr> BlockChain::GetBlockHeadersByHash(const std::vector<
 	return headers;
 }
 
+std::vector<BlockHeaderPtr> BlockChain::GetBlockHeadersByHeight(
+	const uint64_t firstHeight,
+	const uint64_t lastHeight,
+	const EChainType chainType) const
+{
+	auto pReader = m_pChainState->Read();
+
+	std::vector<BlockHeaderPtr> headers;
+	if (lastHeight >= firstHeight) {
+		headers.reserve(lastHeight - firstHeight + 1);
+	}
+
+	for (uint64_t height = firstHeight; height <= lastHeight; height++)
+	{
+		BlockHeaderPtr pHeader = pReader->GetBlockHeaderByHeight(height, chainType);
+		if (pHeader == nullptr)
+		{
+			break;
+		}
+
+		headers.push_back(pHeader);
+	}
+
+	return headers;
+}
+
 BlockHeaderPtr BlockChain::GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const
 {
 	return m_pChainState->Read()->GetBlockHeaderByHeight(height, chainType);
@@ -383,50 +452,137 @@ std::vector<std::pair<uint64_t, Hash>> BlockChain::GetBlocksNeeded(const uint64_
 	return m_pChainState->Read()->GetBlocksNeeded(maxNumBlocks);
 }
 
+std::unique_ptr<FullBlock> BlockChain::BuildBlockTemplate(
+	const std::vector<TransactionPtr>& transactions,
+	const TransactionOutput& coinbaseOutput,
+	const TransactionKernel& coinbaseKernel) const
+{
+	std::vector<TransactionPtr> blockTransactions = transactions;
+	blockTransactions.push_back(std::make_shared<Transaction>(
+		BlindingFactor(),
+		TransactionBody({}, { coinbaseOutput }, { coinbaseKernel })
+	));
+	TransactionPtr pAggregated = TransactionUtil::Aggregate(blockTransactions);
+
+	// Applying the body is the only way to calculate the roots. DO NOT COMMIT THIS BATCH
+	auto pBatch = m_pChainState->BatchWrite();
+
+	auto pTxHashSet = pBatch->GetTxHashSetManager()->GetTxHashSet();
+	BlockHeaderPtr pPrevHeader = pBatch->GetTipBlockHeader(EChainType::CONFIRMED);
+	if (pTxHashSet == nullptr || pPrevHeader == nullptr)
+	{
+		return nullptr;
+	}
+
+	try
+	{
+		const TxHashSetRoots roots = pTxHashSet->GetRoots(pBatch->GetBlockDB(), pAggregated->GetBody());
+		Hash prevRoot = pBatch->GetHeaderMMR()->Root(pPrevHeader->GetHeight());
+		pBatch->Rollback();
+
+		const uint64_t height = pPrevHeader->GetHeight() + 1;
+		const uint16_t version = Consensus::GetHeaderVersion(height);
+		const int64_t timestamp = (std::max)((int64_t)TimeUtil::Now(), pPrevHeader->GetTimestamp() + 1);
+		BlindingFactor totalKernelOffset = Crypto::AddBlindingFactors(
+			{ pPrevHeader->GetTotalKernelOffset(), pAggregated->GetOffset() },
+			{}
+		);
+
+		const auto createHeader = [&](const uint64_t totalDifficulty, const uint32_t scalingDifficulty) {
+			return std::make_shared<BlockHeader>(
+				version,
+				height,
+				timestamp,
+				Hash(pPrevHeader->GetHash()),
+				Hash(prevRoot),
+				Hash(roots.GetOutputInfo().root),
+				Hash(roots.GetRangeProofInfo().root),
+				Hash(roots.GetKernelInfo().root),
+				BlindingFactor(totalKernelOffset),
+				roots.GetOutputInfo().size,
+				roots.GetKernelInfo().size,
+				totalDifficulty,
+				scalingDifficulty,
+				0,
+				ProofOfWork(Consensus::SECOND_POW_EDGE_BITS, std::vector<uint64_t>(Consensus::PROOFSIZE, 0))
+			);
+		};
+
+		// Difficulty only depends on the height, version and previous hash, so a draft header is enough to calculate it.
+		const PoWValidator::NextDifficulty nextDifficulty = PoWValidator(pBatch->GetBlockDB())
+			.GetNextDifficulty(*createHeader(pPrevHeader->GetTotalDifficulty(), pPrevHeader->GetScalingDifficulty()));
+
+		BlockHeaderPtr pHeader = createHeader(
+			pPrevHeader->GetTotalDifficulty() + nextDifficulty.difficulty,
+			nextDifficulty.secondaryScaling
+		);
+
+		return std::make_unique<FullBlock>(pHeader, TransactionBody(pAggregated->GetBody()));
+	}
+	catch (std::exception& e)
+	{
+		pBatch->Rollback();
+		LOG_WARNING_F("Failed to build block template on {}: {}", *pPrevHeader, e.what());
+	}
+
+	return nullptr;
+}
+
 bool BlockChain::ProcessNextOrphanBlock()
 {
-	BlockHeaderPtr pNextHeader = nullptr;
-	std::shared_ptr<const FullBlock> pOrphanBlock = nullptr;
+	std::vector<std::shared_ptr<const FullBlock>> orphans;
 
 	{
 		auto pReader = m_pChainState->Read();
-		const uint64_t height = pReader->GetHeight(EChainType::CONFIRMED) + 1;
-		pNextHeader = pReader->GetBlockHeaderByHeight(height, EChainType::CANDIDATE);
-		if (pNextHeader == nullptr)
+
+		// Orphans whose parent was just applied are found through the orphan pool's previous hash index.
+		auto pTip = pReader->GetTipBlockHeader(EChainType::CONFIRMED);
+		if (pTip != nullptr)
 		{
-			return false;
+			orphans = pReader->GetOrphanChildren(pTip->GetHash());
 		}
 
-		pOrphanBlock = pReader->GetOrphanBlock(height, pNextHeader->GetHash());
-		if (pOrphanBlock == nullptr)
+		// The next candidate block may instead build on a fork, and need a reorg to connect.
+		if (orphans.empty())
 		{
-			return false;
+			const uint64_t height = pReader->GetHeight(EChainType::CONFIRMED) + 1;
+			auto pNextHeader = pReader->GetBlockHeaderByHeight(height, EChainType::CANDIDATE);
+			if (pNextHeader != nullptr)
+			{
+				auto pOrphanBlock = pReader->GetOrphanBlock(pNextHeader->GetHash());
+				if (pOrphanBlock != nullptr)
+				{
+					orphans.push_back(pOrphanBlock);
+				}
+			}
 		}
 	}
 
-	try
+	for (const auto& pOrphanBlock : orphans)
 	{
-		return BlockProcessor(m_pChainState).ProcessBlock(*pOrphanBlock) == EBlockChainStatus::SUCCESS;
-	}
-	catch (std::exception&)
-	{
-		m_pChainState->
-			Write()->
-			GetOrphanPool()->
-			RemoveOrphan(pNextHeader->GetHeight(), pNextHeader->GetHash());
-		return false;
+		try
+		{
+			if (BlockProcessor(m_pChainState).ProcessBlock(*pOrphanBlock) == EBlockChainStatus::SUCCESS)
+			{
+				return true;
+			}
+		}
+		catch (std::exception&)
+		{
+			// Nothing building on a block that failed to process can be connected either.
+			m_pChainState->
+				Write()->
+				GetOrphanPool()->
+				RemoveOrphanAndDescendants(pOrphanBlock->GetHash());
+		}
 	}
+
+	return false;
 }
 
 bool BlockChain::HasOrphan(const Hash& blockHash) const
 {
-	auto pReader = m_pChainState->Read();
-	auto pHeader = pReader->GetBlockHeaderByHash(blockHash);
-	if (pHeader == nullptr) {
-		return false;
-	}
-
-	return pReader->GetOrphanBlock(pHeader->GetHeight(), blockHash) != nullptr;
+	return m_pChainState->Read()->GetOrphanBlock(blockHash) != nullptr;
 }
 
 namespace BlockChainAPI
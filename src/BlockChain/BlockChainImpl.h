@@ -36,21 +36,28 @@ public:
 	uint64_t GetTotalDifficulty(const EChainType chainType) const final;
 
 	EBlockChainStatus AddBlock(const FullBlock& block) final;
-	EBlockChainStatus AddCompactBlock(const CompactBlock& block) final;
+	EBlockChainStatus AddCompactBlock(const CompactBlock& block, const std::vector<TransactionPtr>& transactions) final;
 
 	EBlockChainStatus AddBlockHeader(BlockHeaderPtr pBlockHeader) final;
 	EBlockChainStatus AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders) final;
 
 	fs::path SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) final;
+	void CompactTxHashSet() final;
 	EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus) final;
 	EBlockChainStatus AddTransaction(TransactionPtr pTransaction, const EPoolType poolType) final;
 	TransactionPtr GetTransactionByKernelHash(const Hash& kernelHash) const final;
+	std::vector<TransactionPtr> GetTransactionsByShortId(const Hash& blockHash, const uint64_t nonce, const std::set<ShortId>& shortIds) const final;
 
 	BlockHeaderPtr GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const final;
 	BlockHeaderPtr GetBlockHeaderByHash(const CBigInteger<32>& hash) const final;
 	BlockHeaderPtr GetBlockHeaderByCommitment(const Commitment& outputCommitment) const final;
 	BlockHeaderPtr GetTipBlockHeader(const EChainType chainType) const final;
 	std::vector<BlockHeaderPtr> GetBlockHeadersByHash(const std::vector<CBigInteger<32>>& hashes) const final;
+	std::vector<BlockHeaderPtr> GetBlockHeadersByHeight(
+		const uint64_t firstHeight,
+		const uint64_t lastHeight,
+		const EChainType chainType
+	) const final;
 
 	std::unique_ptr<CompactBlock> GetCompactBlockByHash(const Hash& hash) const final;
 	std::unique_ptr<FullBlock> GetBlockByCommitment(const Commitment& blockHash) const final;
@@ -61,6 +68,12 @@ public:
 	std::vector<BlockWithOutputs> GetOutputsByHeight(const uint64_t startHeight, const uint64_t maxHeight) const final;
 	std::vector<std::pair<uint64_t, Hash>> GetBlocksNeeded(const uint64_t maxNumBlocks) const final;
 
+	std::unique_ptr<FullBlock> BuildBlockTemplate(
+		const std::vector<TransactionPtr>& transactions,
+		const TransactionOutput& coinbaseOutput,
+		const TransactionKernel& coinbaseKernel
+	) const final;
+
 	bool ProcessNextOrphanBlock() final;
 	bool HasOrphan(const Hash& blockHash) const final;
 
@@ -72,4 +85,5 @@ private:
 
 	std::shared_ptr<ITransactionPool> m_pTransactionPool;
 	std::shared_ptr<Locked<ChainState>> m_pChainState;
+	std::mutex m_compactMutex;
 };
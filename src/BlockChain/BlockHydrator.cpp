@@ -2,6 +2,7 @@
 
 #include <Core/Util/TransactionUtil.h>
 #include <unordered_set>
+#include <set>
 
 BlockHydrator::BlockHydrator(std::shared_ptr<const ITransactionPool> pTransactionPool)
 	: m_pTransactionPool(pTransactionPool)
@@ -9,30 +10,62 @@ BlockHydrator::BlockHydrator(std::shared_ptr<const ITransactionPool> pTransactio
 
 }
 
-std::unique_ptr<FullBlock> BlockHydrator::Hydrate(const CompactBlock& compactBlock) const
+// Moves the txs with a kernel matching one of the missing short ids into matched, and removes those short ids.
+static void MatchShortIds(
+	const std::vector<TransactionPtr>& transactions,
+	const Hash& hash,
+	const uint64_t nonce,
+	std::set<ShortId>& missingShortIds,
+	std::vector<TransactionPtr>& matched)
+{
+	for (const TransactionPtr& pTransaction : transactions)
+	{
+		bool matches = false;
+		for (const TransactionKernel& kernel : pTransaction->GetKernels())
+		{
+			if (missingShortIds.erase(ShortId::Create(kernel.GetHash(), hash, nonce)) > 0)
+			{
+				matches = true;
+			}
+		}
+
+		if (matches)
+		{
+			matched.push_back(pTransaction);
+		}
+	}
+}
+
+std::unique_ptr<FullBlock> BlockHydrator::Hydrate(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions) const
 {
 	const std::vector<ShortId>& shortIds = compactBlock.GetShortIds();
 	if (shortIds.empty())
 	{
-		return Hydrate(compactBlock, std::vector<TransactionPtr>());
+		return Build(compactBlock, std::vector<TransactionPtr>());
 	}
-	else
+
+	const Hash& hash = compactBlock.GetHash();
+	const uint64_t nonce = compactBlock.GetNonce();
+	std::set<ShortId> missingShortIds(shortIds.cbegin(), shortIds.cend());
+
+	std::vector<TransactionPtr> matched;
+	MatchShortIds(transactions, hash, nonce, missingShortIds, matched);
+
+	if (!missingShortIds.empty())
 	{
-		const Hash& hash = compactBlock.GetHash();
-		uint64_t nonce = compactBlock.GetNonce();
-		std::set<ShortId> shortIdsSet(shortIds.cbegin(), shortIds.cend());
-		std::vector<TransactionPtr> transactions = m_pTransactionPool->GetTransactionsByShortId(hash, nonce, shortIdsSet);
+		const std::vector<TransactionPtr> pooled = m_pTransactionPool->GetTransactionsByShortId(hash, nonce, missingShortIds);
+		MatchShortIds(pooled, hash, nonce, missingShortIds, matched);
+	}
 
-		if (transactions.size() == shortIds.size())
-		{
-			return Hydrate(compactBlock, transactions);
-		}
+	if (!missingShortIds.empty())
+	{
+		return std::unique_ptr<FullBlock>(nullptr);
 	}
 
-	return std::unique_ptr<FullBlock>(nullptr);
+	return Build(compactBlock, matched);
 }
 
-std::unique_ptr<FullBlock> BlockHydrator::Hydrate(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions) const
+std::unique_ptr<FullBlock> BlockHydrator::Build(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions) const
 {
 	std::unordered_set<Hash> inputsSet;
 	std::unordered_set<Hash> outputsSet;
@@ -13,10 +13,14 @@ class BlockHydrator
 public:
 	explicit BlockHydrator(std::shared_ptr<const ITransactionPool> pTransactionPool);
 
-	std::unique_ptr<FullBlock> Hydrate(const CompactBlock& compactBlock) const;
+	//
+	// Fills in the compact block's short ids from the given txs first, and then from the mempool.
+	// Returns nullptr if any short id can't be matched.
+	//
+	std::unique_ptr<FullBlock> Hydrate(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions) const;
 
 private:
-	std::unique_ptr<FullBlock> Hydrate(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions) const;
+	std::unique_ptr<FullBlock> Build(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions) const;
 
 	std::shared_ptr<const ITransactionPool> m_pTransactionPool;
 };
\ No newline at end of file
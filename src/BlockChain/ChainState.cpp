@@ -2,6 +2,7 @@
 
 #include <Consensus.h>
 #include <Crypto/Crypto.h>
+#include <Common/Tracing.h>
 #include <Database/BlockDb.h>
 #include <PMMR/TxHashSetManager.h>
 #include <TxPool/TransactionPool.h>
@@ -161,9 +162,14 @@ std::unique_ptr<FullBlock> ChainState::GetBlockByHeight(const uint64_t height) c
 	return std::unique_ptr<FullBlock>(nullptr);
 }
 
-std::shared_ptr<const FullBlock> ChainState::GetOrphanBlock(const uint64_t height, const Hash& hash) const
+std::shared_ptr<const FullBlock> ChainState::GetOrphanBlock(const Hash& hash) const
 {
-	return m_pOrphanPool->GetOrphanBlock(height, hash);
+	return m_pOrphanPool->GetOrphanBlock(hash);
+}
+
+std::vector<std::shared_ptr<const FullBlock>> ChainState::GetOrphanChildren(const Hash& previousHash) const
+{
+	return m_pOrphanPool->GetChildren(previousHash);
 }
 
 std::unique_ptr<BlockWithOutputs> ChainState::GetBlockWithOutputs(const uint64_t height) const
@@ -205,7 +211,7 @@ std::vector<std::pair<uint64_t, Hash>> ChainState::GetBlocksNeeded(const uint64_
     uint64_t nextHeight = GetChainStore()->FindCommonIndex(EChainType::CANDIDATE, EChainType::CONFIRMED)->GetHeight() + 1;
     while (nextHeight <= candidateHeight) {
         auto pIndex = pCandidateChain->GetByHeight(nextHeight);
-        if (!m_pOrphanPool->IsOrphan(nextHeight, pIndex->GetHash())) {
+        if (!m_pOrphanPool->IsOrphan(pIndex->GetHash())) {
             blocksNeeded.emplace_back(std::pair<uint64_t, Hash>(nextHeight, pIndex->GetHash()));
 
             if (blocksNeeded.size() == maxNumBlocks) {
@@ -221,6 +227,8 @@ std::vector<std::pair<uint64_t, Hash>> ChainState::GetBlocksNeeded(const uint64_
 
 void ChainState::Commit()
 {
+	TRACE_SPAN("chain", "ChainState::Commit");
+
 	if (!m_chainStoreWriter.IsNull())
 	{
 		m_chainStoreWriter->Commit();
@@ -42,7 +42,8 @@ public:
 
 	std::unique_ptr<FullBlock> GetBlockByHash(const Hash& hash) const;
 	std::unique_ptr<FullBlock> GetBlockByHeight(const uint64_t height) const;
-	std::shared_ptr<const FullBlock> GetOrphanBlock(const uint64_t height, const Hash& hash) const;
+	std::shared_ptr<const FullBlock> GetOrphanBlock(const Hash& hash) const;
+	std::vector<std::shared_ptr<const FullBlock>> GetOrphanChildren(const Hash& previousHash) const;
 
 	std::unique_ptr<BlockWithOutputs> GetBlockWithOutputs(const uint64_t height) const;
 
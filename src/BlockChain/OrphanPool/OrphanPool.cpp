@@ -1,105 +1,158 @@
 #include "OrphanPool.h"
 
-OrphanPool::OrphanPool() : m_orphanHeadersByHash(64)
+#include <Common/Logger.h>
+#include <Common/Metrics.h>
+#include <algorithm>
+
+// Rough per-orphan cost of the indexes and shared pointers, on top of the block itself.
+static const uint64_t ORPHAN_OVERHEAD_BYTES = 256;
+
+OrphanPool::OrphanPool(const uint64_t maxBytes)
+	: m_maxBytes(maxBytes), m_totalBytes(0), m_orphanHeadersByHash(64)
 {
 
 }
 
-bool OrphanPool::IsOrphan(const uint64_t height, const Hash& hash) const
+uint64_t OrphanPool::EstimateBytes(const FullBlock& block)
 {
-	auto heightIter = m_orphansByHeight.find(height);
-	if (heightIter != m_orphansByHeight.cend())
-	{
-		for (auto orphanIter = heightIter->second.cbegin(); orphanIter != heightIter->second.cend(); orphanIter++)
-		{
-			if (orphanIter->GetHash() == hash)
-			{
-				return true;
-			}
-		}
-	}
+	// Calculated from the counts, rather than by serializing a second copy of the block.
+	// Range proofs are counted at their maximum size, since they're the bulk of an output.
+	return sizeof(FullBlock)
+		+ sizeof(BlockHeader)
+		+ (block.GetInputs().size() * sizeof(TransactionInput))
+		+ (block.GetOutputs().size() * (sizeof(TransactionOutput) + MAX_PROOF_SIZE))
+		+ (block.GetKernels().size() * sizeof(TransactionKernel))
+		+ ORPHAN_OVERHEAD_BYTES;
+}
 
-	return false;
+bool OrphanPool::IsOrphan(const Hash& hash) const
+{
+	return m_orphansByHash.find(hash) != m_orphansByHash.cend();
 }
 
-void OrphanPool::AddOrphanBlock(const FullBlock& block)
+void OrphanPool::AddOrphanBlock(const FullBlock& block, const uint64_t tipHeight)
 {
 	if (!m_orphanHeadersByHash.Cached(block.GetHash()))
 	{
 		m_orphanHeadersByHash.Put(block.GetHash(), block.GetHeader());
 	}
 
-	auto heightIter = m_orphansByHeight.find(block.GetHeight());
-	if (heightIter != m_orphansByHeight.cend())
+	if (IsOrphan(block.GetHash()))
 	{
-		for (auto orphanIter = heightIter->second.cbegin(); orphanIter != heightIter->second.cend(); orphanIter++)
-		{
-			if (orphanIter->GetHash() == block.GetHash())
-			{
-				return;
-			}
-		}
-
-		heightIter->second.emplace_back(Orphan(block));
+		return;
 	}
-	else
+
+	const Orphan orphan(block, EstimateBytes(block));
+	if (orphan.GetNumBytes() > m_maxBytes)
 	{
-		m_orphansByHeight[block.GetHeight()] = std::vector<Orphan>({ Orphan(block) });
+		LOG_WARNING_F("Orphan {} is too big to keep", block);
+		return;
 	}
+
+	m_totalBytes += orphan.GetNumBytes();
+	m_childrenByPreviousHash[orphan.GetPreviousHash()].push_back(orphan.GetHash());
+	m_orphansByHeight.insert({ orphan.GetHeight(), orphan.GetHash() });
+	m_orphansByHash.insert({ orphan.GetHash(), orphan });
+
+	EvictFurthest(tipHeight);
 }
 
-std::shared_ptr<const FullBlock> OrphanPool::GetOrphanBlock(const uint64_t height, const Hash& hash) const
+std::shared_ptr<const FullBlock> OrphanPool::GetOrphanBlock(const Hash& hash) const
 {
-	auto heightIter = m_orphansByHeight.find(height);
-	if (heightIter != m_orphansByHeight.cend())
+	auto iter = m_orphansByHash.find(hash);
+	if (iter != m_orphansByHash.cend())
 	{
-		for (auto orphanIter = heightIter->second.cbegin(); orphanIter != heightIter->second.cend(); orphanIter++)
-		{
-			if (orphanIter->GetHash() == hash)
-			{
-				return orphanIter->GetBlock();
-			}
-		}
+		return iter->second.GetBlock();
 	}
 
 	return std::shared_ptr<const FullBlock>(nullptr);
 }
 
-std::shared_ptr<const FullBlock> OrphanPool::GetNextOrphanBlock(const uint64_t height, const Hash& previousHash) const
+std::vector<std::shared_ptr<const FullBlock>> OrphanPool::GetChildren(const Hash& previousHash) const
 {
-	auto heightIter = m_orphansByHeight.find(height);
-	if (heightIter != m_orphansByHeight.cend())
+	std::vector<std::shared_ptr<const FullBlock>> children;
+
+	auto iter = m_childrenByPreviousHash.find(previousHash);
+	if (iter != m_childrenByPreviousHash.cend())
 	{
-		for (auto orphanIter = heightIter->second.cbegin(); orphanIter != heightIter->second.cend(); orphanIter++)
+		for (const Hash& hash : iter->second)
 		{
-			if (orphanIter->GetBlock()->GetPreviousHash() == previousHash)
-			{
-				return orphanIter->GetBlock();
-			}
+			children.push_back(m_orphansByHash.at(hash).GetBlock());
 		}
 	}
 
-	return std::shared_ptr<const FullBlock>(nullptr);
+	return children;
 }
 
-void OrphanPool::RemoveOrphan(const uint64_t height, const Hash& hash)
+void OrphanPool::RemoveOrphan(const Hash& hash)
 {
-	auto iter = m_orphansByHeight.find(height);
-	if (iter != m_orphansByHeight.end())
+	auto iter = m_orphansByHash.find(hash);
+	if (iter == m_orphansByHash.end())
+	{
+		return;
+	}
+
+	const Orphan& orphan = iter->second;
+
+	auto childrenIter = m_childrenByPreviousHash.find(orphan.GetPreviousHash());
+	if (childrenIter != m_childrenByPreviousHash.end())
 	{
-		for (auto orphanIter = iter->second.begin(); orphanIter != iter->second.end(); orphanIter++)
+		std::vector<Hash>& siblings = childrenIter->second;
+		siblings.erase(std::remove(siblings.begin(), siblings.end(), hash), siblings.end());
+		if (siblings.empty())
 		{
-			if (orphanIter->GetHash() == hash)
-			{
-				iter->second.erase(orphanIter);
-				break;
-			}
+			m_childrenByPreviousHash.erase(childrenIter);
 		}
+	}
+
+	m_orphansByHeight.erase({ orphan.GetHeight(), hash });
+	m_totalBytes -= orphan.GetNumBytes();
+	m_orphansByHash.erase(iter);
+}
 
-		if (iter->second.empty())
+void OrphanPool::RemoveOrphanAndDescendants(const Hash& hash)
+{
+	std::vector<Hash> toRemove({ hash });
+	while (!toRemove.empty())
+	{
+		const Hash next = toRemove.back();
+		toRemove.pop_back();
+
+		auto childrenIter = m_childrenByPreviousHash.find(next);
+		if (childrenIter != m_childrenByPreviousHash.end())
 		{
-			m_orphansByHeight.erase(height);
+			toRemove.insert(toRemove.end(), childrenIter->second.cbegin(), childrenIter->second.cend());
 		}
+
+		RemoveOrphan(next);
+	}
+}
+
+void OrphanPool::EvictFurthest(const uint64_t tipHeight)
+{
+	static Metrics::Counter& s_evicted = Metrics::Registry::Get().AddCounter(
+		"grinpp_orphans_evicted_total",
+		"Orphan blocks evicted to keep the orphan pool under its size limit"
+	);
+
+	size_t numEvicted = 0;
+	while (m_totalBytes > m_maxBytes && !m_orphansByHeight.empty())
+	{
+		// Either the lowest orphan is on a stale fork far below the tip, or the highest is far ahead of it.
+		const std::pair<uint64_t, Hash>& lowest = *m_orphansByHeight.cbegin();
+		const std::pair<uint64_t, Hash>& highest = *m_orphansByHeight.crbegin();
+		const uint64_t lowestDistance = lowest.first < tipHeight ? tipHeight - lowest.first : 0;
+		const uint64_t highestDistance = highest.first > tipHeight ? highest.first - tipHeight : 0;
+
+		const Hash hash = lowestDistance > highestDistance ? lowest.second : highest.second;
+		RemoveOrphan(hash);
+		++numEvicted;
+	}
+
+	if (numEvicted > 0)
+	{
+		LOG_DEBUG_F("Evicted {} orphans. {} remaining, using {} bytes.", numEvicted, m_orphansByHash.size(), m_totalBytes);
+		s_evicted.Increment(numEvicted);
 	}
 }
 
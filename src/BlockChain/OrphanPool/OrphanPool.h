@@ -5,23 +5,49 @@
 #include <Crypto/Models/Hash.h>
 #include <Core/Models/FullBlock.h>
 #include <unordered_map>
+#include <set>
 #include <caches/Cache.h>
 
+//
+// Blocks received before their parent, indexed by hash and by previous hash.
+// Bounded by the estimated memory the blocks take up. When full, the orphans furthest from the tip are evicted first,
+// since they're the least likely to be connected soon.
+//
 class OrphanPool
 {
 public:
-	OrphanPool();
+	static const uint64_t DEFAULT_MAX_BYTES = 128ull * 1024 * 1024;
 
-	bool IsOrphan(const uint64_t height, const Hash& hash) const;
-	void AddOrphanBlock(const FullBlock& block);
-	std::shared_ptr<const FullBlock> GetOrphanBlock(const uint64_t height, const Hash& hash) const;
-	std::shared_ptr<const FullBlock> GetNextOrphanBlock(const uint64_t height, const Hash& previousHash) const;
-	void RemoveOrphan(const uint64_t height, const Hash& hash);
+	explicit OrphanPool(const uint64_t maxBytes = DEFAULT_MAX_BYTES);
+
+	bool IsOrphan(const Hash& hash) const;
+	void AddOrphanBlock(const FullBlock& block, const uint64_t tipHeight);
+	std::shared_ptr<const FullBlock> GetOrphanBlock(const Hash& hash) const;
+
+	//
+	// Returns the orphans that build directly on the given block.
+	//
+	std::vector<std::shared_ptr<const FullBlock>> GetChildren(const Hash& previousHash) const;
+	void RemoveOrphan(const Hash& hash);
+	void RemoveOrphanAndDescendants(const Hash& hash);
+
+	size_t GetNumOrphans() const noexcept { return m_orphansByHash.size(); }
+	uint64_t GetTotalBytes() const noexcept { return m_totalBytes; }
 
 	void AddOrphanHeader(BlockHeaderPtr pHeader);
 	BlockHeaderPtr GetOrphanHeader(const Hash& hash) const;
 
+	static uint64_t EstimateBytes(const FullBlock& block);
+
 private:
-	std::unordered_map<uint64_t, std::vector<Orphan>> m_orphansByHeight;
+	void EvictFurthest(const uint64_t tipHeight);
+
+	uint64_t m_maxBytes;
+	uint64_t m_totalBytes;
+
+	std::unordered_map<Hash, Orphan> m_orphansByHash;
+	std::unordered_map<Hash, std::vector<Hash>> m_childrenByPreviousHash;
+	std::set<std::pair<uint64_t, Hash>> m_orphansByHeight;
+
 	LRUCache<Hash, BlockHeaderPtr> m_orphanHeadersByHash;
 };
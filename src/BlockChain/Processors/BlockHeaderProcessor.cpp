@@ -6,6 +6,7 @@
 #include <Core/Exceptions/BlockChainException.h>
 #include <BlockChain/BadBlocks.h>
 #include <Common/Logger.h>
+#include <Common/Tracing.h>
 #include <PMMR/HeaderMMR.h>
 #include <Common/Util/HexUtil.h>
 #include <Common/Util/StringUtil.h>
@@ -14,6 +15,7 @@ static const size_t SYNC_BATCH_SIZE = 128;
 
 EBlockChainStatus BlockHeaderProcessor::ProcessSingleHeader(const BlockHeaderPtr& pHeader)
 {
+    TRACE_SPAN("header", "BlockHeaderProcessor::ProcessSingleHeader");
     LOG_TRACE_F("Validating {}", *pHeader);
 
     if (BAD_BLOCKS.find(pHeader->GetHash()) != BAD_BLOCKS.end()) {
@@ -110,6 +112,7 @@ EBlockChainStatus BlockHeaderProcessor::ProcessOrphan(Writer<ChainState> pLocked
 
 EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<BlockHeaderPtr>& headers)
 {
+    TRACE_SPAN("header", "BlockHeaderProcessor::ProcessSyncHeaders");
     if (headers.empty()) {
         return EBlockChainStatus::SUCCESS;
     }
@@ -153,6 +156,7 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<Blo
 
 EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(const std::vector<BlockHeaderPtr>& headers)
 {
+    TRACE_SPAN("header", "BlockHeaderProcessor::ProcessChunkedSyncHeaders");
     auto pLockedState = m_pChainState->BatchWrite();
     auto pHeaderMMR = pLockedState->GetHeaderMMR();
     auto pChainStore = pLockedState->GetChainStore();
@@ -236,8 +240,12 @@ void BlockHeaderProcessor::ValidateHeaders(Writer<ChainState> pLockedState, cons
         throw BLOCK_CHAIN_EXCEPTION_F("Previous header ({}) not found.", previousHash);
     }
 
-    for (const auto& pHeader : headers) {
-        validator.Validate(*pHeader, *pPreviousHeader);
+    // The cuckoo cycles don't depend on the chain, so they're all checked up front in parallel.
+    // Everything else still runs in order, so the first invalid header is the one reported.
+    const std::vector<bool> cyclesValid = validator.AreCyclesValid(headers);
+    for (size_t i = 0; i < headers.size(); i++) {
+        const auto& pHeader = headers[i];
+        validator.Validate(*pHeader, *pPreviousHeader, cyclesValid[i]);
 
         pHeaderMMR->AddHeader(*pHeader);
         pBlockDB->AddBlockHeader(pHeader);
@@ -7,15 +7,62 @@
 #include <Core/Exceptions/BadDataException.h>
 #include <Core/Validation/KernelSumValidator.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
+#include <Common/Tracing.h>
 #include <Common/Util/HexUtil.h>
 #include <Common/Util/StringUtil.h>
 #include <algorithm>
+#include <optional>
+
+static Metrics::Histogram& GetStageHistogram(const std::string& stage)
+{
+	return Metrics::Registry::Get().AddHistogram(
+		"grinpp_block_processing_seconds",
+		"Time spent in each stage of processing a block",
+		{ { "stage", stage } }
+	);
+}
+
+static Metrics::Counter& GetOutcomeCounter(const std::string& outcome)
+{
+	return Metrics::Registry::Get().AddCounter("grinpp_blocks_processed_total", "Blocks processed, by outcome", { { "outcome", outcome } });
+}
 
 BlockProcessor::BlockProcessor(const std::shared_ptr<Locked<ChainState>>& pChainState)
 	: m_pChainState(pChainState) { }
 
 EBlockChainStatus BlockProcessor::ProcessBlock(const FullBlock& block)
-{	
+{
+	static Metrics::Histogram& s_total = GetStageHistogram("total");
+	static Metrics::Counter& s_success = GetOutcomeCounter("success");
+	static Metrics::Counter& s_orphaned = GetOutcomeCounter("orphaned");
+	static Metrics::Counter& s_alreadyExists = GetOutcomeCounter("already_exists");
+	static Metrics::Counter& s_failed = GetOutcomeCounter("failed");
+
+	TRACE_SPAN("block", "BlockProcessor::ProcessBlock");
+	Metrics::ScopedTimer timer(s_total);
+	try {
+		const EBlockChainStatus status = ProcessBlockImpl(block);
+		switch (status) {
+			case EBlockChainStatus::SUCCESS: s_success.Increment(); break;
+			case EBlockChainStatus::ORPHANED: s_orphaned.Increment(); break;
+			case EBlockChainStatus::ALREADY_EXISTS: s_alreadyExists.Increment(); break;
+			default: s_failed.Increment(); break;
+		}
+
+		return status;
+	}
+	catch (...) {
+		s_failed.Increment();
+		throw;
+	}
+}
+
+EBlockChainStatus BlockProcessor::ProcessBlockImpl(const FullBlock& block)
+{
+	static Metrics::Histogram& s_header = GetStageHistogram("header");
+	static Metrics::Histogram& s_selfConsistent = GetStageHistogram("self_consistent");
+
 	const uint64_t candidateHeight = m_pChainState->Read()->GetHeight(EChainType::CANDIDATE);
 	const uint64_t horizonHeight = Consensus::GetHorizonHeight(candidateHeight);
 
@@ -25,10 +72,17 @@ EBlockChainStatus BlockProcessor::ProcessBlock(const FullBlock& block)
 	}
 
 	// Make sure header is processed and valid before processing block.
-	BlockHeaderProcessor(m_pChainState).ProcessSingleHeader(pHeader);
+	{
+		Metrics::ScopedTimer timer(s_header);
+		BlockHeaderProcessor(m_pChainState).ProcessSingleHeader(pHeader);
+	}
 
 	// Verify block is self-consistent before locking
-	BlockValidator::VerifySelfConsistent(block);
+	{
+		TRACE_SPAN("block", "BlockValidator::VerifySelfConsistent");
+		Metrics::ScopedTimer timer(s_selfConsistent);
+		BlockValidator::VerifySelfConsistent(block);
+	}
 
 	const EBlockChainStatus returnStatus = ProcessBlockInternal(block);
 	if (returnStatus == EBlockChainStatus::SUCCESS) {
@@ -41,6 +95,8 @@ EBlockChainStatus BlockProcessor::ProcessBlock(const FullBlock& block)
 EBlockChainStatus BlockProcessor::ProcessBlockInternal(const FullBlock& block)
 {
 	auto pBatch = m_pChainState->BatchWrite();
+	TRACE_SPAN("block", "BlockProcessor::ProcessBlockInternal");
+
 	auto pChainStore = pBatch->GetChainStore();
 	auto pOrphanPool = pBatch->GetOrphanPool();
 	auto pConfirmedChain = pChainStore->GetConfirmedChain();
@@ -60,12 +116,12 @@ EBlockChainStatus BlockProcessor::ProcessBlockInternal(const FullBlock& block)
 	// 3. Orphan if block should be processed as an orphan
 	const BlockProcessingInfo info = DetermineBlockStatus(block, pBatch);
 	if (info.status == EBlockStatus::ORPHAN) {
-		if (pOrphanPool->IsOrphan(block.GetHeight(), block.GetHash())) {
+		if (pOrphanPool->IsOrphan(block.GetHash())) {
 			LOG_TRACE_F("Block {} already processed as an orphan.", block);
 			return EBlockChainStatus::ALREADY_EXISTS;
 		}
 
-		pOrphanPool->AddOrphanBlock(block);
+		pOrphanPool->AddOrphanBlock(block, pConfirmedChain->GetHeight());
 
 		return EBlockChainStatus::ORPHANED;
 	}
@@ -107,7 +163,7 @@ BlockProcessor::BlockProcessingInfo BlockProcessor::DetermineBlockStatus(const F
 	while (!pConfirmedChain->IsOnChain(pForkBlock->GetHeight() - 1, pForkBlock->GetPreviousHash()))
 	{
 		Hash previousHash = pForkBlock->GetPreviousHash();
-		pForkBlock = pOrphanPool->GetOrphanBlock(pForkBlock->GetHeight() - 1, previousHash);
+		pForkBlock = pOrphanPool->GetOrphanBlock(previousHash);
 		if (pForkBlock == nullptr) {
 			pForkBlock = pBlockDB->GetBlock(previousHash);
 		}
@@ -131,6 +187,7 @@ BlockProcessor::BlockProcessingInfo BlockProcessor::DetermineBlockStatus(const F
 
 void BlockProcessor::HandleReorg(Writer<ChainState> pBatch, const std::vector<FullBlock::CPtr>& reorgBlocks)
 {
+	TRACE_SPAN("block", "BlockProcessor::HandleReorg");
 	const uint64_t totalDifficulty = pBatch->GetTotalDifficulty(EChainType::CONFIRMED);
 
 	auto pTxHashSet = pBatch->GetTxHashSetManager()->GetTxHashSet();
@@ -183,6 +240,14 @@ void BlockProcessor::HandleReorg(Writer<ChainState> pBatch, const std::vector<Fu
 
 void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainState> pBatch)
 {
+	static Metrics::Histogram& s_apply = GetStageHistogram("apply");
+	static Metrics::Histogram& s_roots = GetStageHistogram("validate_roots");
+	static Metrics::Histogram& s_kernelSums = GetStageHistogram("kernel_sums");
+	static Metrics::Histogram& s_store = GetStageHistogram("store");
+	static Metrics::Histogram& s_reconcile = GetStageHistogram("txpool_reconcile");
+
+	TRACE_SPAN("block", "BlockProcessor::ValidateAndAddBlock");
+
 	auto pOrphanPool = pBatch->GetOrphanPool();
 	auto pBlockDB = pBatch->GetBlockDB();
 	auto pTxHashSet = pBatch->GetTxHashSetManager()->GetTxHashSet();
@@ -195,14 +260,20 @@ void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainSta
 		throw BLOCK_CHAIN_EXCEPTION("Previous header not found.");
 	}
 
-	if (pTxHashSet == nullptr || !pTxHashSet->ApplyBlock(pBlockDB, block)) {
-		throw BAD_DATA_EXCEPTION_F(EBanReason::BadBlock, "Failed to apply block {} to the TxHashSet.", block);
+	{
+		Metrics::ScopedTimer timer(s_apply);
+		if (pTxHashSet == nullptr || !pTxHashSet->ApplyBlock(pBlockDB, block)) {
+			throw BAD_DATA_EXCEPTION_F(EBanReason::BadBlock, "Failed to apply block {} to the TxHashSet.", block);
+		}
 	}
 
 	BlockValidator::VerifySelfConsistent(block);
 
-	if (!pTxHashSet->ValidateRoots(*block.GetHeader())) {
-		throw BAD_DATA_EXCEPTION_F(EBanReason::BadBlock, "Failed to validate TxHashSet roots for block {}.", block);
+	{
+		Metrics::ScopedTimer timer(s_roots);
+		if (!pTxHashSet->ValidateRoots(*block.GetHeader())) {
+			throw BAD_DATA_EXCEPTION_F(EBanReason::BadBlock, "Failed to validate TxHashSet roots for block {}.", block);
+		}
 	}
 
 	std::unique_ptr<BlockSums> pPreviousBlockSums = pBlockDB->GetBlockSums(previousHash);
@@ -211,15 +282,23 @@ void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainSta
 		throw BLOCK_CHAIN_EXCEPTION("Failed to retrieve block sums.");
 	}
 
-	BlockSums blockSums = KernelSumValidator::ValidateKernelSums(
-		block.GetTransactionBody(),
-		0 - Consensus::REWARD,
-		block.GetTotalKernelOffset(),
-		std::make_optional(*pPreviousBlockSums)
-	);
-
+	std::optional<Metrics::ScopedTimer> timer;
+	timer.emplace(s_kernelSums);
+	BlockSums blockSums = [&]() {
+		TRACE_SPAN("block", "KernelSumValidator::ValidateKernelSums");
+		return KernelSumValidator::ValidateKernelSums(
+			block.GetTransactionBody(),
+			0 - Consensus::REWARD,
+			block.GetTotalKernelOffset(),
+			std::make_optional(*pPreviousBlockSums)
+		);
+	}();
+
+	timer.emplace(s_store);
 	pBlockDB->AddBlockSums(block.GetHash(), blockSums);
 	pBlockDB->AddBlock(block);
-	pOrphanPool->RemoveOrphan(block.GetHeight(), block.GetHash());
+	pOrphanPool->RemoveOrphan(block.GetHash());
+
+	timer.emplace(s_reconcile);
 	pTxPool->ReconcileBlock(pBlockDB, pTxHashSet, block);
 }
\ No newline at end of file
@@ -25,6 +25,7 @@ public:
 	EBlockChainStatus ProcessBlock(const FullBlock& block);
 
 private:
+	EBlockChainStatus ProcessBlockImpl(const FullBlock& block);
 	EBlockChainStatus ProcessBlockInternal(const FullBlock& block);
 	void HandleReorg(Writer<ChainState> pBatch, const std::vector<FullBlock::CPtr>& reorgBlocks);
 	void ValidateAndAddBlock(const FullBlock& block, Writer<ChainState> pLockedState);
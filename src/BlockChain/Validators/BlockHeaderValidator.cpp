@@ -4,11 +4,48 @@
 #include <Consensus.h>
 #include <Common/Util/HexUtil.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
+#include <Common/Tracing.h>
 #include <PoW/PoWValidator.h>
 #include <PMMR/HeaderMMR.h>
 #include <chrono>
 
-void BlockHeaderValidator::Validate(const BlockHeader& header, const BlockHeader& prev_header) const
+void BlockHeaderValidator::Validate(const BlockHeader& header, const BlockHeader& prev_header, const std::optional<bool>& cycleValid) const
+{
+    static Metrics::Histogram& s_latency = Metrics::Registry::Get().AddHistogram(
+        "grinpp_header_validation_seconds",
+        "Time spent validating a block header, including proof of work"
+    );
+    static Metrics::Counter& s_valid = Metrics::Registry::Get().AddCounter(
+        "grinpp_headers_validated_total", "Block headers validated, by outcome", { { "outcome", "valid" } }
+    );
+    static Metrics::Counter& s_invalid = Metrics::Registry::Get().AddCounter(
+        "grinpp_headers_validated_total", "Block headers validated, by outcome", { { "outcome", "invalid" } }
+    );
+
+    TRACE_SPAN("header", "BlockHeaderValidator::Validate");
+    Metrics::ScopedTimer timer(s_latency);
+    try {
+        ValidateInternal(header, prev_header, cycleValid);
+        s_valid.Increment();
+    }
+    catch (...) {
+        s_invalid.Increment();
+        throw;
+    }
+}
+
+std::vector<bool> BlockHeaderValidator::AreCyclesValid(const std::vector<BlockHeaderPtr>& headers) const
+{
+    if (Global::IsAutomatedTesting()) {
+        return std::vector<bool>(headers.size(), true);
+    }
+
+    TRACE_SPAN("header", "BlockHeaderValidator::AreCyclesValid");
+    return PoWValidator::AreCyclesValid(headers);
+}
+
+void BlockHeaderValidator::ValidateInternal(const BlockHeader& header, const BlockHeader& prev_header, const std::optional<bool>& cycleValid) const
 {
     // Validate Height
     if (header.GetHeight() != (prev_header.GetHeight() + 1)) {
@@ -32,7 +69,7 @@ void BlockHeaderValidator::Validate(const BlockHeader& header, const BlockHeader
     }
 
     // Validate Proof Of Work
-    const bool validPoW = IsPoWValid(header, prev_header);
+    const bool validPoW = IsPoWValid(header, prev_header, cycleValid);
     if (!validPoW) {
         throw BAD_DATA_EXCEPTION_F(EBanReason::BadBlockHeader, "Invalid Proof of Work for header {}", header);
     }
@@ -45,11 +82,15 @@ void BlockHeaderValidator::Validate(const BlockHeader& header, const BlockHeader
     LOG_TRACE_F("Header {} valid", header);
 }
 
-bool BlockHeaderValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev_header) const
+bool BlockHeaderValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev_header, const std::optional<bool>& cycleValid) const
 {
     if (Global::IsAutomatedTesting()) {
         return true;
     }
 
+    if (cycleValid.has_value()) {
+        return cycleValid.value() && PoWValidator(m_pBlockDB).IsDifficultyValid(header, prev_header);
+    }
+
     return PoWValidator(m_pBlockDB).IsPoWValid(header, prev_header);
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <Core/Models/BlockHeader.h>
 #include <Database/BlockDb.h>
 #include <PMMR/HeaderMMR.h>
+#include <optional>
 
 class BlockHeaderValidator
 {
@@ -15,11 +16,20 @@ public:
 	/// </summary>
 	/// <param name="header">The header to validate.</param>
 	/// <param name="prev_header">The previous header.</param>
+	/// <param name="cycleValid">Result of AreCyclesValid for the header, if already known, to avoid checking the cuckoo cycle again.</param>
 	/// <throws>BadDataException if the header is invalid.</throws>
-	void Validate(const BlockHeader& header, const BlockHeader& prev_header) const;
+	void Validate(const BlockHeader& header, const BlockHeader& prev_header, const std::optional<bool>& cycleValid = std::nullopt) const;
+
+	/// <summary>
+	/// Checks the cuckoo cycles of a batch of headers in parallel, before they're validated one by one.
+	/// </summary>
+	/// <param name="headers">The headers to check.</param>
+	/// <returns>Whether each header's cycle is valid, in the same order as the headers.</returns>
+	std::vector<bool> AreCyclesValid(const std::vector<BlockHeaderPtr>& headers) const;
 
 private:
-	bool IsPoWValid(const BlockHeader& header, const BlockHeader& prev_header) const;
+	void ValidateInternal(const BlockHeader& header, const BlockHeader& prev_header, const std::optional<bool>& cycleValid) const;
+	bool IsPoWValid(const BlockHeader& header, const BlockHeader& prev_header, const std::optional<bool>& cycleValid) const;
 
 	IBlockDB::CPtr m_pBlockDB;
 	IHeaderMMR::CPtr m_pHeaderMMR;
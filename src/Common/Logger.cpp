@@ -1,5 +1,6 @@
 #include <spdlog/spdlog.h>
 #include <Common/Logger.h>
+#include <Common/Tracing.h>
 #include <Common/Util/FileUtil.h>
 #include <shared_mutex>
 #include <sstream>
@@ -219,6 +220,7 @@ namespace LoggerAPI
 	LOGGER_API void SetThreadName(const std::string& thread_name)
 	{
 		Logger::GetInstance().SetThreadName(thread_name);
+		Tracing::SetThreadName(thread_name);
 	}
 
 	LOGGER_API bool WillLog(const LogFile file, const LogLevel level)
@@ -0,0 +1,281 @@
+#include <Common/Metrics.h>
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace Metrics;
+
+static std::string EscapeLabelValue(const std::string& value)
+{
+	std::string escaped;
+	escaped.reserve(value.size());
+	for (const char c : value) {
+		if (c == '\\' || c == '"') {
+			escaped.push_back('\\');
+			escaped.push_back(c);
+		} else if (c == '\n') {
+			escaped.append("\\n");
+		} else {
+			escaped.push_back(c);
+		}
+	}
+
+	return escaped;
+}
+
+static std::string FormatLabels(const Labels& labels, const std::string& extraName = "", const std::string& extraValue = "")
+{
+	if (labels.empty() && extraName.empty()) {
+		return "";
+	}
+
+	std::string formatted = "{";
+	for (const auto& label : labels) {
+		if (formatted.size() > 1) {
+			formatted.push_back(',');
+		}
+
+		formatted += fmt::format("{}=\"{}\"", label.first, EscapeLabelValue(label.second));
+	}
+
+	if (!extraName.empty()) {
+		if (formatted.size() > 1) {
+			formatted.push_back(',');
+		}
+
+		formatted += fmt::format("{}=\"{}\"", extraName, extraValue);
+	}
+
+	formatted.push_back('}');
+	return formatted;
+}
+
+static std::string FormatValue(const double value)
+{
+	return fmt::format("{}", value);
+}
+
+static std::string FormatHeader(const std::string& name, const std::string& help, const std::string& type)
+{
+	return fmt::format("# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+}
+
+std::vector<double> Histogram::DefaultBounds()
+{
+	std::vector<double> bounds;
+	for (double bound = 0.00001; bound < 20.0; bound *= 2) {
+		bounds.push_back(bound);
+	}
+
+	return bounds;
+}
+
+Histogram::Histogram(std::vector<double> bounds)
+	: m_bounds(std::move(bounds)), m_buckets(new std::atomic<uint64_t>[m_bounds.size() + 1])
+{
+	std::sort(m_bounds.begin(), m_bounds.end());
+	for (size_t i = 0; i <= m_bounds.size(); i++) {
+		m_buckets[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+void Histogram::Observe(const std::chrono::nanoseconds& duration) noexcept
+{
+	const double seconds = std::chrono::duration<double>(duration).count();
+	const size_t bucket = std::lower_bound(m_bounds.cbegin(), m_bounds.cend(), seconds) - m_bounds.cbegin();
+
+	m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_sumNanos.fetch_add((uint64_t)(std::max)(duration.count(), (int64_t)0), std::memory_order_relaxed);
+}
+
+//
+// Buckets are read one at a time, so a snapshot taken while observations are being made may be off by a few,
+// but cumulative counts are always increasing, and the +Inf bucket always equals the count.
+//
+Histogram::Snapshot Histogram::GetSnapshot() const
+{
+	Snapshot snapshot;
+	snapshot.bounds = m_bounds;
+
+	uint64_t total = 0;
+	for (size_t i = 0; i <= m_bounds.size(); i++) {
+		total += m_buckets[i].load(std::memory_order_relaxed);
+		snapshot.cumulative.push_back(total);
+	}
+
+	snapshot.count = total;
+	snapshot.sum = m_sumNanos.load(std::memory_order_relaxed) / 1e9;
+	return snapshot;
+}
+
+void Writer::AddCounter(const std::string& name, const std::string& help, const Labels& labels, const double value)
+{
+	Add(name, help, "counter", labels, value);
+}
+
+void Writer::AddGauge(const std::string& name, const std::string& help, const Labels& labels, const double value)
+{
+	Add(name, help, "gauge", labels, value);
+}
+
+void Writer::Add(const std::string& name, const std::string& help, const std::string& type, const Labels& labels, const double value)
+{
+	Family& family = m_families[name];
+	if (family.type.empty()) {
+		family.help = help;
+		family.type = type;
+	}
+
+	family.samples.push_back({ labels, value });
+}
+
+Registry& Registry::Get()
+{
+	static Registry registry;
+	return registry;
+}
+
+Counter& Registry::AddCounter(const std::string& name, const std::string& help, const Labels& labels)
+{
+	return Add(m_counters, "counter", name, help, labels);
+}
+
+Gauge& Registry::AddGauge(const std::string& name, const std::string& help, const Labels& labels)
+{
+	return Add(m_gauges, "gauge", name, help, labels);
+}
+
+Histogram& Registry::AddHistogram(const std::string& name, const std::string& help, const Labels& labels)
+{
+	return Add(m_histograms, "histogram", name, help, labels);
+}
+
+template<typename T>
+T& Registry::Add(
+	std::map<std::string, Family<T>>& families,
+	const std::string& type,
+	const std::string& name,
+	const std::string& help,
+	const Labels& labels)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto type_iter = m_types.find(name);
+	if (type_iter == m_types.end()) {
+		m_types.insert({ name, type });
+	} else if (type_iter->second != type) {
+		throw std::invalid_argument(fmt::format("Metric {} is already registered as a {}", name, type_iter->second));
+	}
+
+	Family<T>& family = families[name];
+	if (family.help.empty()) {
+		family.help = help;
+	}
+
+	for (auto& metric : family.metrics) {
+		if (metric.first == labels) {
+			return *metric.second;
+		}
+	}
+
+	family.metrics.push_back({ labels, std::make_unique<T>() });
+	return *family.metrics.back().second;
+}
+
+std::shared_ptr<Collector> Registry::AddCollector(Collector&& collector)
+{
+	auto pCollector = std::make_shared<Collector>(std::move(collector));
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_collectors.erase(
+		std::remove_if(m_collectors.begin(), m_collectors.end(), [](const auto& pWeak) { return pWeak.expired(); }),
+		m_collectors.end()
+	);
+	m_collectors.push_back(pCollector);
+
+	return pCollector;
+}
+
+std::string Registry::Format() const
+{
+	// Collectors run without the registry lock held, since they take locks of their own.
+	std::vector<std::shared_ptr<Collector>> collectors;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (const auto& pWeak : m_collectors) {
+			auto pCollector = pWeak.lock();
+			if (pCollector != nullptr) {
+				collectors.push_back(pCollector);
+			}
+		}
+	}
+
+	Writer writer;
+	for (const auto& pCollector : collectors) {
+		(*pCollector)(writer);
+	}
+
+	// Families are output sorted by name, so the output is stable between scrapes.
+	std::map<std::string, std::string> families;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (const auto& entry : m_counters) {
+		std::string& text = families[entry.first];
+		text += FormatHeader(entry.first, entry.second.help, "counter");
+		for (const auto& metric : entry.second.metrics) {
+			text += fmt::format("{}{} {}\n", entry.first, FormatLabels(metric.first), metric.second->Get());
+		}
+	}
+
+	for (const auto& entry : m_gauges) {
+		std::string& text = families[entry.first];
+		text += FormatHeader(entry.first, entry.second.help, "gauge");
+		for (const auto& metric : entry.second.metrics) {
+			text += fmt::format("{}{} {}\n", entry.first, FormatLabels(metric.first), metric.second->Get());
+		}
+	}
+
+	for (const auto& entry : m_histograms) {
+		const std::string& name = entry.first;
+		std::string& text = families[name];
+		text += FormatHeader(name, entry.second.help, "histogram");
+		for (const auto& metric : entry.second.metrics) {
+			const Histogram::Snapshot snapshot = metric.second->GetSnapshot();
+			for (size_t i = 0; i < snapshot.bounds.size(); i++) {
+				text += fmt::format(
+					"{}_bucket{} {}\n",
+					name,
+					FormatLabels(metric.first, "le", FormatValue(snapshot.bounds[i])),
+					snapshot.cumulative[i]
+				);
+			}
+
+			text += fmt::format("{}_bucket{} {}\n", name, FormatLabels(metric.first, "le", "+Inf"), snapshot.count);
+			text += fmt::format("{}_sum{} {}\n", name, FormatLabels(metric.first), FormatValue(snapshot.sum));
+			text += fmt::format("{}_count{} {}\n", name, FormatLabels(metric.first), snapshot.count);
+		}
+	}
+	lock.unlock();
+
+	for (const auto& entry : writer.m_families) {
+		if (families.find(entry.first) != families.end()) {
+			// Name clashes with a registered metric. Reporting both would produce an invalid exposition.
+			continue;
+		}
+
+		std::string& text = families[entry.first];
+		text += FormatHeader(entry.first, entry.second.help, entry.second.type);
+		for (const auto& sample : entry.second.samples) {
+			text += fmt::format("{}{} {}\n", entry.first, FormatLabels(sample.first), FormatValue(sample.second));
+		}
+	}
+
+	std::string formatted;
+	for (const auto& entry : families) {
+		formatted += entry.second;
+	}
+
+	return formatted;
+}
@@ -0,0 +1,245 @@
+#include <Common/Tracing.h>
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic_bool Tracing::detail::ENABLED{ false };
+
+namespace
+{
+	struct Event
+	{
+		const char* category;
+		const char* name;
+		Tracing::Clock::time_point start;
+		Tracing::Clock::time_point end;
+	};
+
+	//
+	// Written only by its owning thread, and read by exports.
+	// The mutex is practically never contended, so locking it is cheap.
+	//
+	struct ThreadBuffer
+	{
+		std::mutex mutex;
+		uint32_t threadId{ 0 };
+		std::string threadName;
+		std::vector<Event> events; // Grows up to EVENTS_PER_THREAD, so short-lived threads stay cheap.
+		size_t next{ 0 }; // Oldest event, once the buffer is full.
+		std::atomic_bool finished{ false };
+	};
+
+	// Buffers of exited threads are kept so their events can still be exported, but only this many of them.
+	static const size_t MAX_FINISHED_THREADS = 256;
+
+	struct Buffers
+	{
+		std::mutex mutex;
+		std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+		uint32_t nextThreadId{ 1 };
+	};
+
+	Buffers& GetBuffers()
+	{
+		static Buffers buffers;
+		return buffers;
+	}
+
+	// Flags the buffer when its thread exits, so it can be dropped once its events are no longer needed.
+	struct ThreadBufferHolder
+	{
+		std::shared_ptr<ThreadBuffer> pBuffer;
+
+		~ThreadBufferHolder()
+		{
+			if (pBuffer != nullptr) {
+				pBuffer->finished = true;
+			}
+		}
+	};
+
+	ThreadBuffer& GetThreadBuffer()
+	{
+		thread_local ThreadBufferHolder holder;
+		if (holder.pBuffer == nullptr) {
+			auto pBuffer = std::make_shared<ThreadBuffer>();
+
+			Buffers& buffers = GetBuffers();
+			std::unique_lock<std::mutex> lock(buffers.mutex);
+			pBuffer->threadId = buffers.nextThreadId++;
+
+			size_t numFinished = std::count_if(
+				buffers.buffers.cbegin(), buffers.buffers.cend(),
+				[](const std::shared_ptr<ThreadBuffer>& pBuf) { return pBuf->finished.load(); }
+			);
+			for (auto iter = buffers.buffers.begin(); numFinished >= MAX_FINISHED_THREADS && iter != buffers.buffers.end();) {
+				if ((*iter)->finished) {
+					iter = buffers.buffers.erase(iter);
+					numFinished--;
+				} else {
+					++iter;
+				}
+			}
+
+			buffers.buffers.push_back(pBuffer);
+
+			holder.pBuffer = pBuffer;
+		}
+
+		return *holder.pBuffer;
+	}
+
+	std::string EscapeJSON(const std::string& value)
+	{
+		std::string escaped;
+		escaped.reserve(value.size());
+		for (const char c : value) {
+			switch (c) {
+				case '"': escaped += "\\\""; break;
+				case '\\': escaped += "\\\\"; break;
+				case '\n': escaped += "\\n"; break;
+				case '\t': escaped += "\\t"; break;
+				default:
+					if ((unsigned char)c < 0x20) {
+						escaped += fmt::format("\\u{:04x}", (int)c);
+					} else {
+						escaped.push_back(c);
+					}
+			}
+		}
+
+		return escaped;
+	}
+
+	double ToMicros(const Tracing::Clock::duration& duration)
+	{
+		return std::chrono::duration<double, std::micro>(duration).count();
+	}
+}
+
+void Tracing::Start()
+{
+	Buffers& buffers = GetBuffers();
+	std::unique_lock<std::mutex> lock(buffers.mutex);
+
+	buffers.buffers.erase(
+		std::remove_if(
+			buffers.buffers.begin(), buffers.buffers.end(),
+			[](const std::shared_ptr<ThreadBuffer>& pBuffer) { return pBuffer->finished.load(); }
+		),
+		buffers.buffers.end()
+	);
+
+	for (const auto& pBuffer : buffers.buffers) {
+		std::unique_lock<std::mutex> bufferLock(pBuffer->mutex);
+		pBuffer->events.clear();
+		pBuffer->next = 0;
+	}
+
+	detail::ENABLED = true;
+}
+
+void Tracing::Stop()
+{
+	detail::ENABLED = false;
+}
+
+void Tracing::SetThreadName(const std::string& threadName)
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+	std::unique_lock<std::mutex> lock(buffer.mutex);
+	buffer.threadName = threadName;
+}
+
+void Tracing::Record(const char* category, const char* name, const Clock::time_point& start, const Clock::time_point& end) noexcept
+{
+	try {
+		ThreadBuffer& buffer = GetThreadBuffer();
+		std::unique_lock<std::mutex> lock(buffer.mutex);
+		if (buffer.events.size() < EVENTS_PER_THREAD) {
+			buffer.events.push_back(Event{ category, name, start, end });
+		} else {
+			buffer.events[buffer.next] = Event{ category, name, start, end };
+			buffer.next = (buffer.next + 1) % EVENTS_PER_THREAD;
+		}
+	}
+	catch (...) {
+		// Dropping an event is better than throwing from a destructor.
+	}
+}
+
+std::string Tracing::ExportChromeTrace()
+{
+	// Timestamps are relative to the earliest event, to keep them short.
+	struct ThreadEvents
+	{
+		uint32_t threadId;
+		std::string threadName;
+		std::vector<Event> events;
+	};
+
+	std::vector<ThreadEvents> threads;
+	{
+		Buffers& buffers = GetBuffers();
+		std::unique_lock<std::mutex> lock(buffers.mutex);
+		for (const auto& pBuffer : buffers.buffers) {
+			std::unique_lock<std::mutex> bufferLock(pBuffer->mutex);
+
+			ThreadEvents thread{ pBuffer->threadId, pBuffer->threadName, {} };
+			thread.events.reserve(pBuffer->events.size());
+			thread.events.insert(thread.events.end(), pBuffer->events.cbegin() + pBuffer->next, pBuffer->events.cend());
+			thread.events.insert(thread.events.end(), pBuffer->events.cbegin(), pBuffer->events.cbegin() + pBuffer->next);
+
+			threads.push_back(std::move(thread));
+		}
+	}
+
+	Clock::time_point origin = Clock::time_point::max();
+	for (const ThreadEvents& thread : threads) {
+		for (const Event& event : thread.events) {
+			origin = (std::min)(origin, event.start);
+		}
+	}
+
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	const auto append = [&json, &first](const std::string& event) {
+		if (!first) {
+			json += ",\n";
+		}
+
+		json += event;
+		first = false;
+	};
+
+	for (const ThreadEvents& thread : threads) {
+		if (thread.events.empty()) {
+			continue;
+		}
+
+		if (!thread.threadName.empty()) {
+			append(fmt::format(
+				"{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+				thread.threadId,
+				EscapeJSON(thread.threadName)
+			));
+		}
+
+		for (const Event& event : thread.events) {
+			append(fmt::format(
+				"{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+				EscapeJSON(event.name),
+				EscapeJSON(event.category),
+				thread.threadId,
+				ToMicros(event.start - origin),
+				ToMicros(event.end - event.start)
+			));
+		}
+	}
+
+	json += "]}";
+	return json;
+}
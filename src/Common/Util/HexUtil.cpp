@@ -39,4 +39,9 @@ std::string HexUtil::ConvertToHex(const std::vector<uint8_t>& data)
 std::string HexUtil::ConvertToHex(const std::vector<uint8_t>& data, const size_t numBytes)
 {
 	return cppcodec::hex_lower::encode(data.data(), numBytes);
+}
+
+std::string HexUtil::ConvertToHex(const uint8_t* pData, const size_t numBytes)
+{
+	return cppcodec::hex_lower::encode(pData, numBytes);
 }
\ No newline at end of file
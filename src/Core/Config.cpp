@@ -130,6 +130,9 @@ const fs::path& Config::GetChainPath() const noexcept { return m_pImpl->m_nodeCo
 const fs::path& Config::GetDatabasePath() const noexcept { return m_pImpl->m_nodeConfig.GetDatabasePath(); }
 const fs::path& Config::GetTxHashSetPath() const noexcept { return m_pImpl->m_nodeConfig.GetTxHashSetPath(); }
 uint16_t Config::GetRestAPIPort() const noexcept { return m_pImpl->m_nodeConfig.GetRestAPIPort(); }
+const ServerOptions& Config::GetRestAPIOptions() const noexcept { return m_pImpl->m_nodeConfig.GetRestAPIOptions(); }
+const std::optional<uint16_t>& Config::GetFastLanePort() const noexcept { return m_pImpl->m_nodeConfig.GetFastLanePort(); }
+const ServerOptions& Config::GetFastLaneOptions() const noexcept { return m_pImpl->m_nodeConfig.GetFastLaneOptions(); }
 uint64_t Config::GetFeeBase() const noexcept { return m_pImpl->m_nodeConfig.GetFeeBase(); }
 
 //
@@ -145,6 +148,7 @@ uint16_t Config::GetP2PPort() const noexcept { return m_pImpl->m_nodeConfig.GetP
 const std::vector<uint8_t>& Config::GetMagicBytes() const noexcept { return m_pImpl->m_nodeConfig.GetP2P().GetMagicBytes(); }
 
 uint8_t Config::GetMinSyncPeers() const noexcept { return m_pImpl->m_nodeConfig.GetP2P().GetMinSyncPeers(); }
+uint8_t Config::GetHighBandwidthPeers() const noexcept { return m_pImpl->m_nodeConfig.GetP2P().GetHighBandwidthPeers(); }
 
 const std::unordered_set<IPAddress>& Config::GetPreferredPeers() const noexcept { return m_pImpl->m_nodeConfig.GetP2P().GetPreferredPeers(); }
 const std::unordered_set<IPAddress>& Config::GetAllowedPeers() const noexcept { return m_pImpl->m_nodeConfig.GetP2P().GetAllowedPeers(); }
@@ -180,11 +184,34 @@ uint16_t Config::GetEmbargoSeconds() const noexcept { return m_pImpl->m_nodeConf
 uint8_t Config::GetPatienceSeconds() const noexcept { return m_pImpl->m_nodeConfig.GetDandelion().GetPatienceSeconds(); }
 uint8_t Config::GetStemProbability() const noexcept { return m_pImpl->m_nodeConfig.GetDandelion().GetStemProbability(); }
 
+//
+// TxPool
+//
+uint64_t Config::GetMaxPoolWeight() const noexcept { return m_pImpl->m_nodeConfig.GetTxPool().GetMaxPoolWeight(); }
+uint64_t Config::GetMaxPoolBytes() const noexcept { return m_pImpl->m_nodeConfig.GetTxPool().GetMaxPoolBytes(); }
+uint64_t Config::GetMaxStemPoolWeight() const noexcept { return m_pImpl->m_nodeConfig.GetTxPool().GetMaxStemPoolWeight(); }
+uint64_t Config::GetMaxStemPoolBytes() const noexcept { return m_pImpl->m_nodeConfig.GetTxPool().GetMaxStemPoolBytes(); }
+const fs::path& Config::GetTxPoolSnapshotPath() const noexcept { return m_pImpl->m_nodeConfig.GetTxPoolSnapshotPath(); }
+uint32_t Config::GetTxPoolSnapshotIntervalSeconds() const noexcept { return m_pImpl->m_nodeConfig.GetTxPool().GetSnapshotIntervalSeconds(); }
+
+//
+// Mining
+//
+bool Config::IsStratumEnabled() const noexcept { return m_pImpl->m_nodeConfig.GetMining().IsStratumEnabled(); }
+uint16_t Config::GetStratumPort() const noexcept { return m_pImpl->m_nodeConfig.GetMining().GetStratumPort(); }
+uint64_t Config::GetShareDifficulty() const noexcept { return m_pImpl->m_nodeConfig.GetMining().GetShareDifficulty(); }
+const std::string& Config::GetMiningWalletHost() const noexcept { return m_pImpl->m_nodeConfig.GetMining().GetWalletHost(); }
+const std::optional<uint16_t>& Config::GetMiningWalletPort() const noexcept { return m_pImpl->m_nodeConfig.GetMining().GetWalletPort(); }
+const std::string& Config::GetMiningWalletSessionToken() const noexcept { return m_pImpl->m_nodeConfig.GetMining().GetWalletSessionToken(); }
+bool Config::ShouldBurnMiningReward() const noexcept { return m_pImpl->m_nodeConfig.GetMining().ShouldBurnReward(); }
+
 //
 // Wallet
 //
 const fs::path& Config::GetWalletPath() const noexcept { return m_pImpl->m_walletConfig.GetWalletPath(); }
 uint32_t Config::GetOwnerPort() const noexcept { return m_pImpl->m_walletConfig.GetOwnerPort(); }
+const ServerOptions& Config::GetOwnerAPIOptions() const noexcept { return m_pImpl->m_walletConfig.GetOwnerAPIOptions(); }
+const ServerOptions& Config::GetForeignAPIOptions() const noexcept { return m_pImpl->m_walletConfig.GetForeignAPIOptions(); }
 uint32_t Config::GetPublicKeyVersion() const noexcept { return m_pImpl->m_walletConfig.GetPublicKeyVersion(); }
 uint32_t Config::GetPrivateKeyVersion() const noexcept { return m_pImpl->m_walletConfig.GetPrivateKeyVersion(); }
 
@@ -17,6 +17,7 @@ namespace ConfigProps
 		static const std::string PREFERRED_PEERS = "PREFERRED_PEERS";
 		static const std::string ALLOWED_PEERS = "ALLOWED_PEERS";
 		static const std::string BLOCKED_PEERS = "BLOCKED_PEERS";
+		static const std::string HIGH_BANDWIDTH_PEERS = "HIGH_BANDWIDTH_PEERS";
 	}
 
 	namespace Dandelion
@@ -28,6 +29,30 @@ namespace ConfigProps
 		static const std::string PATIENCE_SECS = "PATIENCE_SECS";
 		static const std::string STEM_PROBABILITY = "STEM_PROBABILITY";
 	}
+
+	namespace TxPool
+	{
+		static const std::string TX_POOL = "TX_POOL";
+
+		static const std::string MAX_POOL_WEIGHT = "MAX_POOL_WEIGHT";
+		static const std::string MAX_POOL_MB = "MAX_POOL_MB";
+		static const std::string MAX_STEMPOOL_WEIGHT = "MAX_STEMPOOL_WEIGHT";
+		static const std::string MAX_STEMPOOL_MB = "MAX_STEMPOOL_MB";
+		static const std::string SNAPSHOT_INTERVAL_SECONDS = "SNAPSHOT_INTERVAL_SECONDS";
+	}
+
+	namespace Mining
+	{
+		static const std::string MINING = "MINING";
+
+		static const std::string ENABLE_STRATUM = "ENABLE_STRATUM";
+		static const std::string STRATUM_PORT = "STRATUM_PORT";
+		static const std::string SHARE_DIFFICULTY = "SHARE_DIFFICULTY";
+		static const std::string WALLET_HOST = "WALLET_HOST";
+		static const std::string WALLET_PORT = "WALLET_PORT";
+		static const std::string WALLET_SESSION_TOKEN = "WALLET_SESSION_TOKEN";
+		static const std::string BURN_REWARD = "BURN_REWARD";
+	}
 	
 	namespace Server
 	{
@@ -35,6 +60,17 @@ namespace ConfigProps
 
 		static const std::string REST_API_PORT = "REST_API_PORT";
 		static const std::string OWNER_API_PORT = "OWNER_API_PORT";
+		static const std::string REST_API = "REST_API";
+		static const std::string FAST_LANE_PORT = "FAST_LANE_PORT";
+		static const std::string FAST_LANE = "FAST_LANE";
+	}
+
+	namespace HTTP
+	{
+		static const std::string NUM_THREADS = "NUM_THREADS";
+		static const std::string ENABLE_KEEP_ALIVE = "ENABLE_KEEP_ALIVE";
+		static const std::string KEEP_ALIVE_TIMEOUT_MS = "KEEP_ALIVE_TIMEOUT_MS";
+		static const std::string REQUEST_TIMEOUT_MS = "REQUEST_TIMEOUT_MS";
 	}
 
 	namespace Logger
@@ -51,6 +87,9 @@ namespace ConfigProps
 		static const std::string MIN_CONFIRMATIONS = "MIN_CONFIRMATIONS";
 
 		static const std::string REUSE_ADDRESS = "REUSE_ADDRESS";
+
+		static const std::string OWNER_API = "OWNER_API";
+		static const std::string FOREIGN_API = "FOREIGN_API";
 	}
 
 	namespace Tor
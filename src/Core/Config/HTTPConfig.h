@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ConfigProps.h"
+
+#include <Net/Servers/ServerOptions.h>
+#include <algorithm>
+#include <json/json.h>
+
+namespace HTTPConfig
+{
+	//
+	// Reads the civetweb options for one listener, falling back to the given defaults for any missing values.
+	// Ex: { "NUM_THREADS": 32, "ENABLE_KEEP_ALIVE": true, "KEEP_ALIVE_TIMEOUT_MS": 3000, "REQUEST_TIMEOUT_MS": 120000 }
+	//
+	static ServerOptions Parse(const Json::Value& json, const ServerOptions& defaults)
+	{
+		ServerOptions options = defaults;
+		if (!json.isObject()) {
+			return options;
+		}
+
+		options.numThreads = std::max(1u, json.get(ConfigProps::HTTP::NUM_THREADS, defaults.numThreads).asUInt());
+		options.keepAlive = json.get(ConfigProps::HTTP::ENABLE_KEEP_ALIVE, defaults.keepAlive).asBool();
+		options.keepAliveTimeoutMs = json.get(ConfigProps::HTTP::KEEP_ALIVE_TIMEOUT_MS, defaults.keepAliveTimeoutMs).asUInt();
+		options.requestTimeoutMs = json.get(ConfigProps::HTTP::REQUEST_TIMEOUT_MS, defaults.requestTimeoutMs).asUInt();
+		return options;
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "ConfigProps.h"
+
+#include <Core/Enums/Environment.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <json/json.h>
+
+class MiningConfig
+{
+public:
+	// Whether to run the stratum server, which hands out block templates to local miners.
+	bool IsStratumEnabled() const { return m_stratumEnabled; }
+	uint16_t GetStratumPort() const { return m_stratumPort; }
+
+	// Minimum difficulty of the shares miners submit. Shares meeting the network difficulty are mined as blocks.
+	uint64_t GetShareDifficulty() const { return m_shareDifficulty; }
+
+	// Wallet foreign API that builds the coinbase outputs. Its port changes every time the wallet logs in.
+	const std::string& GetWalletHost() const { return m_walletHost; }
+	const std::optional<uint16_t>& GetWalletPort() const { return m_walletPort; }
+	const std::string& GetWalletSessionToken() const { return m_walletSessionToken; }
+
+	// Mine without a wallet, sending the rewards to a random key nobody holds. Only useful for testing.
+	bool ShouldBurnReward() const { return m_burnReward; }
+
+	//
+	// Constructor
+	//
+	MiningConfig(const Environment env, const Json::Value& json)
+	{
+		m_stratumEnabled = false;
+		m_stratumPort = (env == Environment::MAINNET) ? 3416 : 13416;
+		m_shareDifficulty = 1;
+		m_walletHost = "127.0.0.1";
+		m_burnReward = false;
+
+		if (json.isMember(ConfigProps::Mining::MINING))
+		{
+			const Json::Value& miningJSON = json[ConfigProps::Mining::MINING];
+
+			if (miningJSON.isMember(ConfigProps::Mining::ENABLE_STRATUM))
+			{
+				m_stratumEnabled = miningJSON[ConfigProps::Mining::ENABLE_STRATUM].asBool();
+			}
+
+			if (miningJSON.isMember(ConfigProps::Mining::STRATUM_PORT))
+			{
+				m_stratumPort = (uint16_t)miningJSON[ConfigProps::Mining::STRATUM_PORT].asUInt();
+			}
+
+			if (miningJSON.isMember(ConfigProps::Mining::SHARE_DIFFICULTY))
+			{
+				m_shareDifficulty = miningJSON[ConfigProps::Mining::SHARE_DIFFICULTY].asUInt64();
+			}
+
+			if (miningJSON.isMember(ConfigProps::Mining::WALLET_HOST))
+			{
+				m_walletHost = miningJSON[ConfigProps::Mining::WALLET_HOST].asString();
+			}
+
+			if (miningJSON.isMember(ConfigProps::Mining::WALLET_PORT))
+			{
+				m_walletPort = std::make_optional<uint16_t>((uint16_t)miningJSON[ConfigProps::Mining::WALLET_PORT].asUInt());
+			}
+
+			if (miningJSON.isMember(ConfigProps::Mining::WALLET_SESSION_TOKEN))
+			{
+				m_walletSessionToken = miningJSON[ConfigProps::Mining::WALLET_SESSION_TOKEN].asString();
+			}
+
+			if (miningJSON.isMember(ConfigProps::Mining::BURN_REWARD))
+			{
+				m_burnReward = miningJSON[ConfigProps::Mining::BURN_REWARD].asBool();
+			}
+		}
+	}
+
+private:
+	bool m_stratumEnabled;
+	uint16_t m_stratumPort;
+	uint64_t m_shareDifficulty;
+	std::string m_walletHost;
+	std::optional<uint16_t> m_walletPort;
+	std::string m_walletSessionToken;
+	bool m_burnReward;
+};
@@ -2,10 +2,14 @@
 
 #include "ConfigProps.h"
 #include "DandelionConfig.h"
+#include "TxPoolConfig.h"
+#include "MiningConfig.h"
 #include "P2PConfig.h"
+#include "HTTPConfig.h"
 
 #include <Common/Util/FileUtil.h>
 #include <cstdint>
+#include <optional>
 #include <json/json.h>
 
 class NodeConfig
@@ -16,17 +20,25 @@ public:
 	//
 	P2PConfig& GetP2P() { return m_p2pConfig; }
 	const DandelionConfig& GetDandelion() const { return m_dandelion; }
+	const TxPoolConfig& GetTxPool() const { return m_txPool; }
+	const MiningConfig& GetMining() const { return m_mining; }
 	const fs::path& GetChainPath() const { return m_chainPath; }
 	const fs::path& GetDatabasePath() const { return m_databasePath; }
 	const fs::path& GetTxHashSetPath() const { return m_txHashSetPath; }
+	const fs::path& GetTxPoolSnapshotPath() const { return m_txPoolSnapshotPath; }
 	uint64_t GetFeeBase() const noexcept { return 500000; } // TODO: Read from config.
 	uint16_t GetRestAPIPort() const { return m_restAPIPort; }
+	const ServerOptions& GetRestAPIOptions() const { return m_restAPIOptions; }
+
+	// Optional second listener with its own worker pool, serving only cheap methods (tip, status, pool size).
+	const std::optional<uint16_t>& GetFastLanePort() const { return m_fastLanePort; }
+	const ServerOptions& GetFastLaneOptions() const { return m_fastLaneOptions; }
 
 	//
 	// Constructor
 	//
 	NodeConfig(const Environment env, const Json::Value& json, const fs::path& dataPath)
-		: m_p2pConfig(env, json), m_dandelion(json)
+		: m_p2pConfig(env, json), m_dandelion(json), m_txPool(json), m_mining(env, json)
 	{
 		if (env == Environment::MAINNET) {
 			m_restAPIPort = 3413;
@@ -34,12 +46,25 @@ public:
 			m_restAPIPort = 13413;
 		}
 
+		m_restAPIOptions.numThreads = 32;
+
+		m_fastLaneOptions.numThreads = 4;
+		m_fastLaneOptions.requestTimeoutMs = 10000;
+
 		if (json.isMember(ConfigProps::Server::SERVER)) {
 			const Json::Value& serverJSON = json[ConfigProps::Server::SERVER];
 
 			if (serverJSON.isMember(ConfigProps::Server::REST_API_PORT)) {
 				m_restAPIPort = (uint16_t)serverJSON.get(ConfigProps::Server::REST_API_PORT, m_restAPIPort).asInt();
 			}
+
+			m_restAPIOptions = HTTPConfig::Parse(serverJSON[ConfigProps::Server::REST_API], m_restAPIOptions);
+
+			if (serverJSON.isMember(ConfigProps::Server::FAST_LANE_PORT)) {
+				m_fastLanePort = std::make_optional<uint16_t>((uint16_t)serverJSON[ConfigProps::Server::FAST_LANE_PORT].asUInt());
+			}
+
+			m_fastLaneOptions = HTTPConfig::Parse(serverJSON[ConfigProps::Server::FAST_LANE], m_fastLaneOptions);
 		}
 
 		const fs::path nodePath = dataPath / "NODE";
@@ -56,14 +81,22 @@ public:
 		fs::create_directories(m_txHashSetPath / "kernel");
 		fs::create_directories(m_txHashSetPath / "output");
 		fs::create_directories(m_txHashSetPath / "rangeproof");
+
+		m_txPoolSnapshotPath = nodePath / "txpool.bin";
 	}
 
 private:
 	fs::path m_chainPath;
 	fs::path m_databasePath;
 	fs::path m_txHashSetPath;
+	fs::path m_txPoolSnapshotPath;
 
 	uint16_t m_restAPIPort;
+	ServerOptions m_restAPIOptions;
+	std::optional<uint16_t> m_fastLanePort;
+	ServerOptions m_fastLaneOptions;
 	P2PConfig m_p2pConfig;
 	DandelionConfig m_dandelion;
+	TxPoolConfig m_txPool;
+	MiningConfig m_mining;
 };
\ No newline at end of file
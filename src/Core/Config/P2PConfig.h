@@ -24,6 +24,9 @@ public:
 
 	uint8_t GetMinSyncPeers() const noexcept { return m_minSyncPeers; }
 
+	// Peers sent compact blocks as soon as their header checks out, instead of just the header once fully validated.
+	uint8_t GetHighBandwidthPeers() const noexcept { return m_highBandwidthPeers; }
+
     const std::unordered_set<IPAddress>& GetPreferredPeers() const noexcept { return m_peferredPeers; }
 	const std::unordered_set<IPAddress>& GetAllowedPeers() const noexcept { return m_allowedPeers; }
 	const std::unordered_set<IPAddress>& GetBlockedPeers() const noexcept { return m_blockedPeers; }
@@ -44,6 +47,7 @@ public:
 		m_minConnections = 10;
 
 		m_minSyncPeers = 3;
+		m_highBandwidthPeers = 3;
 
 		if (env == Environment::MAINNET) {
 			m_port = 3414;
@@ -67,6 +71,10 @@ public:
 			m_minConnections = p2pJSON.get(ConfigProps::P2P::MIN_PEERS, 10).asInt();
 		}
 
+		if (p2pJSON.isMember(ConfigProps::P2P::HIGH_BANDWIDTH_PEERS)) {
+			m_highBandwidthPeers = (uint8_t)p2pJSON.get(ConfigProps::P2P::HIGH_BANDWIDTH_PEERS, 3).asUInt();
+		}
+
 		if (p2pJSON.isMember(ConfigProps::P2P::PREFERRED_PEERS)) {
 			Json::Value peers = p2pJSON.get(ConfigProps::P2P::PREFERRED_PEERS, Json::Value(Json::nullValue));
 			for (auto& peer : peers) { 
@@ -101,6 +109,7 @@ private:
 	uint16_t m_port;
 	std::vector<uint8_t> m_magicBytes;
 	uint8_t m_minSyncPeers;
+	uint8_t m_highBandwidthPeers;
 	std::unordered_set<IPAddress> m_peferredPeers;
 	std::unordered_set<IPAddress> m_allowedPeers;
 	std::unordered_set<IPAddress> m_blockedPeers;
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ConfigProps.h"
+
+#include <cstdint>
+#include <json/json.h>
+
+class TxPoolConfig
+{
+public:
+	// Max total weight of the txs in the mempool. Lowest fee-rate txs are evicted beyond that.
+	uint64_t GetMaxPoolWeight() const { return m_maxPoolWeight; }
+
+	// Max estimated memory used by the txs in the mempool.
+	uint64_t GetMaxPoolBytes() const { return m_maxPoolBytes; }
+
+	// Same limits, for the stempool.
+	uint64_t GetMaxStemPoolWeight() const { return m_maxStemPoolWeight; }
+	uint64_t GetMaxStemPoolBytes() const { return m_maxStemPoolBytes; }
+
+	// How often the pools are snapshotted to disk, to be reloaded on restart. 0 only snapshots them on shutdown.
+	uint32_t GetSnapshotIntervalSeconds() const { return m_snapshotIntervalSeconds; }
+
+	//
+	// Constructor
+	//
+	TxPoolConfig(const Json::Value& json)
+	{
+		// 100 full blocks worth of txs in the mempool, and 10 in the stempool.
+		m_maxPoolWeight = 4'000'000;
+		m_maxPoolBytes = 128ull * 1024 * 1024;
+		m_maxStemPoolWeight = 400'000;
+		m_maxStemPoolBytes = 16ull * 1024 * 1024;
+		m_snapshotIntervalSeconds = 300;
+
+		if (json.isMember(ConfigProps::TxPool::TX_POOL))
+		{
+			const Json::Value& txPoolJSON = json[ConfigProps::TxPool::TX_POOL];
+
+			if (txPoolJSON.isMember(ConfigProps::TxPool::MAX_POOL_WEIGHT))
+			{
+				m_maxPoolWeight = txPoolJSON[ConfigProps::TxPool::MAX_POOL_WEIGHT].asUInt64();
+			}
+
+			if (txPoolJSON.isMember(ConfigProps::TxPool::MAX_POOL_MB))
+			{
+				m_maxPoolBytes = txPoolJSON[ConfigProps::TxPool::MAX_POOL_MB].asUInt64() * 1024 * 1024;
+			}
+
+			if (txPoolJSON.isMember(ConfigProps::TxPool::MAX_STEMPOOL_WEIGHT))
+			{
+				m_maxStemPoolWeight = txPoolJSON[ConfigProps::TxPool::MAX_STEMPOOL_WEIGHT].asUInt64();
+			}
+
+			if (txPoolJSON.isMember(ConfigProps::TxPool::MAX_STEMPOOL_MB))
+			{
+				m_maxStemPoolBytes = txPoolJSON[ConfigProps::TxPool::MAX_STEMPOOL_MB].asUInt64() * 1024 * 1024;
+			}
+
+			if (txPoolJSON.isMember(ConfigProps::TxPool::SNAPSHOT_INTERVAL_SECONDS))
+			{
+				m_snapshotIntervalSeconds = txPoolJSON[ConfigProps::TxPool::SNAPSHOT_INTERVAL_SECONDS].asUInt();
+			}
+		}
+	}
+
+private:
+	uint64_t m_maxPoolWeight;
+	uint64_t m_maxPoolBytes;
+	uint64_t m_maxStemPoolWeight;
+	uint64_t m_maxStemPoolBytes;
+	uint32_t m_snapshotIntervalSeconds;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ConfigProps.h"
+#include "HTTPConfig.h"
 
 #include <Core/Enums/Environment.h>
 #include <Common/Util/BitUtil.h>
@@ -32,6 +33,8 @@ public:
 
 		m_minimumConfirmations = 10;
 		m_reuseAddress = 1;
+		m_ownerAPIOptions.numThreads = 32;
+		m_foreignAPIOptions.numThreads = 10;
 		if (json.isMember(ConfigProps::Wallet::WALLET))
 		{
 			const Json::Value& walletJSON = json[ConfigProps::Wallet::WALLET];
@@ -39,6 +42,9 @@ public:
 			m_minimumConfirmations = walletJSON.get(ConfigProps::Wallet::MIN_CONFIRMATIONS, 10).asUInt();
 
 			m_reuseAddress = walletJSON.get(ConfigProps::Wallet::REUSE_ADDRESS, 1).asUInt();
+
+			m_ownerAPIOptions = HTTPConfig::Parse(walletJSON[ConfigProps::Wallet::OWNER_API], m_ownerAPIOptions);
+			m_foreignAPIOptions = HTTPConfig::Parse(walletJSON[ConfigProps::Wallet::FOREIGN_API], m_foreignAPIOptions);
 		}
 	}
 
@@ -50,6 +56,8 @@ public:
 	void SetMinConfirmations(const uint32_t min_confirmations) { m_minimumConfirmations = min_confirmations; }
 	uint32_t GetReuseAddress() const { return m_reuseAddress; }
 	void SetReuseAddress(const uint32_t reuse_address) { m_reuseAddress = reuse_address; }
+	const ServerOptions& GetOwnerAPIOptions() const { return m_ownerAPIOptions; }
+	const ServerOptions& GetForeignAPIOptions() const { return m_foreignAPIOptions; }
 
 private:
 	fs::path m_walletPath;
@@ -58,4 +66,6 @@ private:
 	uint32_t m_privateKeyVersion;
 	uint32_t m_minimumConfirmations;
 	uint32_t m_reuseAddress;
+	ServerOptions m_ownerAPIOptions;
+	ServerOptions m_foreignAPIOptions;
 };
@@ -1,6 +1,8 @@
 #include <Core/File/AppendOnlyFile.h>
 #include <Core/Exceptions/FileException.h>
 #include <Common/Util/FileUtil.h>
+#include <Common/Logger.h>
+#include <algorithm>
 
 void AppendOnlyFile::Load()
 {
@@ -93,4 +95,105 @@ bool AppendOnlyFile::Read(const uint64_t position, const uint64_t numBytes, std:
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+void AppendOnlyFile::Compact(const uint64_t entrySize, const std::vector<uint64_t>& entriesToRemove)
+{
+	if (entriesToRemove.empty())
+	{
+		return;
+	}
+
+	const fs::path tmpPath = GrinStr(m_path.u8string() + ".tmp").ToPath();
+	WriteCompacted(entrySize, entriesToRemove, tmpPath);
+	ReplaceWith(tmpPath);
+}
+
+void AppendOnlyFile::WriteCompacted(const uint64_t entrySize, const std::vector<uint64_t>& entriesToRemove, const fs::path& compactedPath) const
+{
+	if (m_fileSize != m_bufferIndex || !m_buffer.empty())
+	{
+		throw FILE_EXCEPTION_F("Unable to compact {}. File has unflushed changes.", m_path);
+	}
+
+	// Copy the entries we're keeping in runs, so large files aren't read one entry at a time.
+	const uint64_t maxRunSize = (std::max<uint64_t>)(entrySize, (4 * 1024 * 1024 / entrySize) * entrySize);
+	const uint64_t numEntries = m_fileSize / entrySize;
+	FileUtil::RemoveFile(compactedPath);
+
+	AppendOnlyFile compactedFile(compactedPath);
+	compactedFile.Load();
+
+	uint64_t entry = 0;
+	auto removeIter = entriesToRemove.cbegin();
+	while (entry < numEntries)
+	{
+		while (removeIter != entriesToRemove.cend() && *removeIter < entry)
+		{
+			++removeIter;
+		}
+
+		if (removeIter != entriesToRemove.cend() && *removeIter == entry)
+		{
+			++removeIter;
+			++entry;
+			continue;
+		}
+
+		const uint64_t runEnd = (removeIter != entriesToRemove.cend()) ? (std::min)(*removeIter, numEntries) : numEntries;
+		CopyTo(entry * entrySize, runEnd * entrySize, maxRunSize, compactedFile);
+		entry = runEnd;
+	}
+}
+
+void AppendOnlyFile::AppendTailTo(const uint64_t position, const fs::path& destinationPath) const
+{
+	if (m_fileSize != m_bufferIndex || !m_buffer.empty())
+	{
+		throw FILE_EXCEPTION_F("Unable to copy from {}. File has unflushed changes.", m_path);
+	}
+
+	if (position > m_fileSize)
+	{
+		throw FILE_EXCEPTION_F("Unable to copy from {}. File was truncated to {} bytes.", m_path, m_fileSize);
+	}
+
+	AppendOnlyFile destinationFile(destinationPath);
+	destinationFile.Load();
+	CopyTo(position, m_fileSize, 4 * 1024 * 1024, destinationFile);
+}
+
+void AppendOnlyFile::CopyTo(uint64_t position, const uint64_t endPosition, const uint64_t maxRunSize, AppendOnlyFile& destination) const
+{
+	while (position < endPosition)
+	{
+		const uint64_t numBytes = (std::min)(maxRunSize, endPosition - position);
+
+		std::vector<unsigned char> data;
+		m_pMappedFile->Read(position, numBytes, data);
+		destination.Append(data);
+		if (!destination.Flush())
+		{
+			throw FILE_EXCEPTION_F("Failed to write {}", destination.GetPath());
+		}
+
+		position += numBytes;
+	}
+}
+
+void AppendOnlyFile::ReplaceWith(const fs::path& compactedPath)
+{
+	// The mapping must be released before the file can be replaced on Windows.
+	m_pMappedFile.reset();
+
+	std::error_code ec;
+	fs::rename(compactedPath, m_path, ec);
+	if (ec)
+	{
+		LOG_ERROR_F("Failed to rename {} to {}. Error: {}", compactedPath, m_path, ec.message());
+		Load();
+		throw FILE_EXCEPTION_F("Failed to rename {} to {}. Error: {}", compactedPath, m_path, ec.message());
+	}
+
+	Load();
+}
@@ -1,4 +1,5 @@
 #include <Core/Models/FullBlock.h>
+#include <Core/Util/JsonWriter.h>
 
 FullBlock::FullBlock(BlockHeaderPtr pBlockHeader, TransactionBody&& transactionBody)
 	: m_pBlockHeader(pBlockHeader), m_transactionBody(std::move(transactionBody)), m_validated(false) { }
@@ -53,4 +54,44 @@ Json::Value FullBlock::ToJSON() const
 	json["kernels"] = kernelsJSON;
 
 	return json;
+}
+
+void FullBlock::WriteJSON(JsonWriter& writer, const bool includeProofs) const
+{
+	writer.BeginObject();
+	writer.Value("header", GetHeader()->ToJSON());
+
+	// Transaction Inputs
+	writer.Key("inputs").BeginArray();
+	for (const TransactionInput& input : GetInputs())
+	{
+		input.WriteJSON(writer);
+	}
+	writer.EndArray();
+
+	// Transaction Outputs
+	writer.Key("outputs").BeginArray();
+	for (const TransactionOutput& output : GetOutputs())
+	{
+		writer.BeginObject();
+		writer.UInt64("block_height", GetHeight());
+		writer.String("commit", output.GetCommitment().ToHex());
+		writer.String("features", OutputFeatures::ToString(output.GetFeatures()));
+		if (includeProofs)
+		{
+			writer.String("proof", output.GetRangeProof().Format());
+		}
+		writer.EndObject();
+	}
+	writer.EndArray();
+
+	// Transaction Kernels
+	writer.Key("kernels").BeginArray();
+	for (const TransactionKernel& kernel : GetKernels())
+	{
+		kernel.WriteJSON(writer);
+	}
+	writer.EndArray();
+
+	writer.EndObject();
 }
\ No newline at end of file
@@ -5,6 +5,12 @@
 #include <Core/Util/JsonUtil.h>
 #include <Core/Global.h>
 #include <Crypto/Hasher.h>
+#include <algorithm>
+
+// Smallest possible serialized sizes, used to sanity check the counts read ahead of each list.
+static const uint64_t MIN_INPUT_SIZE = 33;		// Commitment (features are omitted in protocol V3)
+static const uint64_t MIN_OUTPUT_SIZE = 42;		// Features, Commitment, and proof length
+static const uint64_t MIN_KERNEL_SIZE = 98;		// Features, Excess, and Signature
 
 TransactionBody::TransactionBody(std::vector<TransactionInput>&& inputs, std::vector<TransactionOutput>&& outputs, std::vector<TransactionKernel>&& kernels)
 	: m_inputs(std::move(inputs)), m_outputs(std::move(outputs)), m_kernels(std::move(kernels))
@@ -58,23 +64,29 @@ TransactionBody TransactionBody::Deserialize(ByteBuffer& byteBuffer)
 	const uint64_t numOutputs = byteBuffer.ReadU64();
 	const uint64_t numKernels = byteBuffer.ReadU64();
 
+	// Each list is allocated once up front. The counts come from the peer, so they're capped by what the remaining bytes could hold.
+	const uint64_t remaining = byteBuffer.GetRemainingSize();
+
 	// Read Inputs (variable size)
 	std::vector<TransactionInput> inputs;
-	for (int i = 0; i < numInputs; i++)
+	inputs.reserve(std::min(numInputs, remaining / MIN_INPUT_SIZE));
+	for (uint64_t i = 0; i < numInputs; i++)
 	{
 		inputs.emplace_back(TransactionInput::Deserialize(byteBuffer));
 	}
 
 	// Read Outputs (variable size)
 	std::vector<TransactionOutput> outputs;
-	for (int i = 0; i < numOutputs; i++)
+	outputs.reserve(std::min(numOutputs, remaining / MIN_OUTPUT_SIZE));
+	for (uint64_t i = 0; i < numOutputs; i++)
 	{
 		outputs.emplace_back(TransactionOutput::Deserialize(byteBuffer));
 	}
 
 	// Read Kernels (variable size)
 	std::vector<TransactionKernel> kernels;
-	for (int i = 0; i < numKernels; i++)
+	kernels.reserve(std::min(numKernels, remaining / MIN_KERNEL_SIZE));
+	for (uint64_t i = 0; i < numKernels; i++)
 	{
 		kernels.emplace_back(TransactionKernel::Deserialize(byteBuffer));
 	}
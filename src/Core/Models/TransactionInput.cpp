@@ -3,6 +3,7 @@
 #include <Core/Global.h>
 #include <Core/Serialization/Serializer.h>
 #include <Core/Util/JsonUtil.h>
+#include <Core/Util/JsonWriter.h>
 #include <Crypto/Hasher.h>
 #include <BlockChain/ICoinView.h>
 
@@ -44,6 +45,14 @@ Json::Value TransactionInput::ToJSON() const
 	return inputNode;
 }
 
+void TransactionInput::WriteJSON(JsonWriter& writer) const
+{
+	writer.BeginObject();
+	writer.String("commit", GetCommitment().ToHex());
+	writer.String("features", OutputFeatures::ToString(m_features));
+	writer.EndObject();
+}
+
 TransactionInput TransactionInput::FromJSON(const Json::Value& transactionInputJSON)
 {
 	EOutputFeatures features = OutputFeatures::FromString(JsonUtil::GetRequiredString(transactionInputJSON, "features"));
@@ -3,6 +3,7 @@
 #include <Consensus.h>
 #include <Core/Serialization/Serializer.h>
 #include <Core/Util/JsonUtil.h>
+#include <Core/Util/JsonWriter.h>
 #include <Crypto/Crypto.h>
 #include <Crypto/Hasher.h>
 
@@ -127,6 +128,29 @@ Json::Value TransactionKernel::ToJSON() const
 	return kernelNode;
 }
 
+void TransactionKernel::WriteJSON(JsonWriter& writer) const
+{
+	writer.BeginObject();
+	writer.String("excess", GetExcessCommitment().ToHex());
+	writer.String("excess_sig", Crypto::ToCompact(GetExcessSignature()).ToHex());
+
+	writer.Key("features").BeginObject();
+	writer.Key(KernelFeatures::ToString(GetFeatures()));
+	if (m_features == EKernelFeatures::COINBASE_KERNEL) {
+		writer.Null();
+	} else {
+		writer.BeginObject();
+		writer.UInt64("fee", m_fee.ToJSON().asUInt64());
+		if (m_features == EKernelFeatures::HEIGHT_LOCKED) {
+			writer.UInt64("lock_height", GetLockHeight());
+		}
+		writer.EndObject();
+	}
+	writer.EndObject();
+
+	writer.EndObject();
+}
+
 TransactionKernel TransactionKernel::FromJSON(const Json::Value& transactionKernelJSON)
 {
 	Json::Value features_json = JsonUtil::GetRequiredField(transactionKernelJSON, "features");
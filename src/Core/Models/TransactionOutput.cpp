@@ -1,17 +1,17 @@
 #include <Core/Models/TransactionOutput.h>
 #include <Core/Util/JsonUtil.h>
+#include <Core/Util/JsonWriter.h>
 #include <Crypto/Hasher.h>
+#include <array>
 
 TransactionOutput::TransactionOutput(const EOutputFeatures features, Commitment commitment, RangeProof rangeProof)
 	: m_features(features), m_commitment(std::move(commitment)), m_rangeProof(std::move(rangeProof))
 {
-		Serializer serializer;
-		// Serialize OutputFeatures
-		serializer.Append<uint8_t>((uint8_t)m_features);
-
-		// Serialize Commitment
-		m_commitment.Serialize(serializer);
-		m_hash = Hasher::Blake2b(serializer.GetBytes());
+	// OutputFeatures (1 byte) followed by the Commitment (33 bytes), hashed straight from the stack.
+	std::array<uint8_t, 34> serialized;
+	serialized[0] = (uint8_t)m_features;
+	std::copy(m_commitment.data(), m_commitment.data() + 33, serialized.begin() + 1);
+	m_hash = Hasher::Blake2b(serialized.data(), serialized.size());
 }
 
 void TransactionOutput::Serialize(Serializer& serializer) const
@@ -49,6 +49,15 @@ Json::Value TransactionOutput::ToJSON() const
 	return outputNode;
 }
 
+void TransactionOutput::WriteJSON(JsonWriter& writer) const
+{
+	writer.BeginObject();
+	writer.String("commit", GetCommitment().ToHex());
+	writer.String("features", OutputFeatures::ToString(GetFeatures()));
+	writer.String("proof", GetRangeProof().Format());
+	writer.EndObject();
+}
+
 TransactionOutput TransactionOutput::FromJSON(const Json::Value& transactionOutputJSON)
 {
 	const EOutputFeatures features = OutputFeatures::FromString(JsonUtil::GetRequiredString(transactionOutputJSON, "features"));
@@ -0,0 +1,107 @@
+#include <Core/Validation/CommitmentSummer.h>
+#include <Crypto/Crypto.h>
+#include <Core/Exceptions/CryptoException.h>
+#include <scheduler/ctpl_stl.h>
+
+#include <algorithm>
+#include <future>
+#include <thread>
+
+static ctpl::thread_pool& GetThreadPool()
+{
+	static ctpl::thread_pool threadPool((int)(std::max)(1u, std::thread::hardware_concurrency()));
+	return threadPool;
+}
+
+//
+// Sums a single chunk, returning nullopt if the commitments cancel out.
+// pedersen_commit_sum can't represent the point at infinity, but a chunk is free to sum to it
+// (e.g. r*G and -r*G), so it's treated as zero rather than as an invalid set of commitments.
+//
+static std::optional<Commitment> SumChunk(std::vector<Commitment>&& commitments)
+{
+	const Commitment zeroCommitment(CBigInteger<33>::ValueOf(0));
+	commitments.erase(std::remove(commitments.begin(), commitments.end(), zeroCommitment), commitments.end());
+	if (commitments.empty()) {
+		return std::nullopt;
+	}
+
+	try {
+		return std::make_optional(Crypto::AddCommitments(commitments, {}));
+	} catch (const CryptoException&) {
+		// The sum is only infinity if the last commitment is the negation of the sum of the others.
+		// Anything else, like an unparseable commitment, is still an error.
+		const Commitment last = commitments.back();
+		commitments.pop_back();
+		if (commitments.empty() || Crypto::AddCommitments({}, commitments) != last) {
+			throw;
+		}
+
+		return std::nullopt;
+	}
+}
+
+// Sums each chunk of the given commitments on the thread pool, returning one partial sum per non-zero chunk.
+static std::vector<Commitment> SumChunks(const std::vector<Commitment>& commitments)
+{
+	std::vector<std::future<std::optional<Commitment>>> futures;
+	for (size_t begin = 0; begin < commitments.size(); begin += CommitmentSummer::CHUNK_SIZE) {
+		const size_t end = (std::min)(begin + (size_t)CommitmentSummer::CHUNK_SIZE, commitments.size());
+		futures.push_back(GetThreadPool().push([&commitments, begin, end](int) {
+			return SumChunk(std::vector<Commitment>(commitments.cbegin() + begin, commitments.cbegin() + end));
+		}));
+	}
+
+	// Wait for every task before calling get(), since they reference the caller's commitments.
+	for (auto& future : futures) {
+		future.wait();
+	}
+
+	std::vector<Commitment> partialSums;
+	for (auto& future : futures) {
+		std::optional<Commitment> partialSum = future.get();
+		if (partialSum.has_value()) {
+			partialSums.push_back(partialSum.value());
+		}
+	}
+
+	return partialSums;
+}
+
+Commitment CommitmentSummer::Sum(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative)
+{
+	if ((positive.size() + negative.size()) <= CHUNK_SIZE) {
+		return Crypto::AddCommitments(positive, negative);
+	}
+
+	return Crypto::AddCommitments(SumChunks(positive), SumChunks(negative));
+}
+
+std::optional<Commitment> CommitmentSummer::Sum(const uint64_t count, const Fetcher& fetcher)
+{
+	std::vector<std::future<std::optional<Commitment>>> futures;
+	for (uint64_t begin = 0; begin < count; begin += CHUNK_SIZE) {
+		const uint64_t end = (std::min)(begin + CHUNK_SIZE, count);
+		futures.push_back(GetThreadPool().push([&fetcher, begin, end](int) -> std::optional<Commitment> {
+			std::vector<Commitment> commitments;
+			commitments.reserve(end - begin);
+			fetcher(begin, end, commitments);
+
+			return SumChunk(std::move(commitments));
+		}));
+	}
+
+	for (auto& future : futures) {
+		future.wait();
+	}
+
+	std::vector<Commitment> partialSums;
+	for (auto& future : futures) {
+		std::optional<Commitment> partialSum = future.get();
+		if (partialSum.has_value()) {
+			partialSums.push_back(partialSum.value());
+		}
+	}
+
+	return SumChunk(std::move(partialSums));
+}
@@ -4,6 +4,7 @@
 #include <secp256k1-zkp/secp256k1_bulletproofs.h>
 #include <Common/Util/FunctionalUtil.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
 #include <Crypto/CSPRNG.h>
 #include <Core/Exceptions/CryptoException.h>
 
@@ -32,6 +33,17 @@ Bulletproofs::~Bulletproofs()
 
 bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs) const
 {
+	static Metrics::Counter& s_cacheHits = Metrics::Registry::Get().AddCounter(
+		"grinpp_bulletproof_cache_total", "Rangeproofs checked against the verified cache, by result", { { "result", "hit" } }
+	);
+	static Metrics::Counter& s_cacheMisses = Metrics::Registry::Get().AddCounter(
+		"grinpp_bulletproof_cache_total", "Rangeproofs checked against the verified cache, by result", { { "result", "miss" } }
+	);
+	static Metrics::Histogram& s_latency = Metrics::Registry::Get().AddHistogram(
+		"grinpp_bulletproof_verify_seconds", "Time spent verifying a batch of rangeproofs"
+	);
+
+	Metrics::ScopedTimer timer(s_latency);
 	std::shared_lock<std::shared_mutex> readLock(m_mutex);
 
 	const size_t numBits = 64;
@@ -51,6 +63,9 @@ bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, Ra
 		}
 	}
 
+	s_cacheHits.Increment(rangeProofs.size() - commitments.size());
+	s_cacheMisses.Increment(commitments.size());
+
 	if (commitments.empty()) {
 		return true;
 	}
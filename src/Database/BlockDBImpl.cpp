@@ -6,8 +6,10 @@
 #include <Core/Models/FullBlock.h>
 #include <Core/Models/BlockSums.h>
 #include <Core/Models/OutputLocation.h>
+#include <Core/Serialization/Serializer.h>
 #include <Database/DatabaseException.h>
 #include <Common/Logger.h>
+#include <Common/Tracing.h>
 #include <Common/Util/StringUtil.h>
 #include <utility>
 #include <string>
@@ -15,6 +17,24 @@
 
 using namespace rocksdb;
 
+//
+// Blocks are keyed by big-endian height followed by hash, so they're sorted by height
+// and everything below the horizon can be dropped with a single range delete.
+//
+static std::vector<uint8_t> BlockKey(const uint64_t height, const Hash& hash)
+{
+	Serializer serializer(40);
+	serializer.Append<uint64_t>(height);
+	serializer.AppendBigInteger(hash);
+	return serializer.GetBytes();
+}
+
+static std::vector<uint8_t> BlockKeyPrefix(const uint64_t height)
+{
+	Serializer serializer(8);
+	serializer.Append<uint64_t>(height);
+	return serializer.GetBytes();
+}
 
 BlockDB::BlockDB(const Config& config, std::unique_ptr<RocksDB>&& pRocksDB)
 	: m_config(config), m_pRocksDB(std::move(pRocksDB)), m_blockHeadersCache(128)
@@ -36,8 +56,9 @@ std::shared_ptr<BlockDB> BlockDB::OpenDB(const Config& config)
 	ColumnFamilyDescriptor OUTPUT_POS_COLUMN = ColumnFamilyDescriptor("OUTPUT_POS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
 	ColumnFamilyDescriptor INPUT_BITMAP_COLUMN = ColumnFamilyDescriptor("INPUT_BITMAP", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
 	ColumnFamilyDescriptor SPENT_OUTPUTS_COLUMN = ColumnFamilyDescriptor("SPENT_OUTPUTS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
+	ColumnFamilyDescriptor BLOCK_BY_HEIGHT_COLUMN = ColumnFamilyDescriptor("BLOCK_BY_HEIGHT", ColumnFamilyOptions());
 
-	std::vector<ColumnFamilyDescriptor> tableNames = { ColumnFamilyDescriptor(), BLOCK_COLUMN, HEADER_COLUMN, BLOCK_SUMS_COLUMN, OUTPUT_POS_COLUMN, INPUT_BITMAP_COLUMN, SPENT_OUTPUTS_COLUMN };
+	std::vector<ColumnFamilyDescriptor> tableNames = { ColumnFamilyDescriptor(), BLOCK_COLUMN, HEADER_COLUMN, BLOCK_SUMS_COLUMN, OUTPUT_POS_COLUMN, INPUT_BITMAP_COLUMN, SPENT_OUTPUTS_COLUMN, BLOCK_BY_HEIGHT_COLUMN };
 	std::unique_ptr<RocksDB> pRocksDB = RocksDBFactory::Open(dbPath, tableNames);
 	pRocksDB->DeleteAll("INPUT_BITMAP");
 
@@ -46,6 +67,7 @@ std::shared_ptr<BlockDB> BlockDB::OpenDB(const Config& config)
 
 void BlockDB::Commit()
 {
+	TRACE_SPAN("db", "BlockDB::Commit");
 	m_pRocksDB->Commit();
 
 	for (auto pHeader : m_uncommitted)
@@ -100,49 +122,40 @@ void BlockDB::SetVersion(const uint8_t version)
 
 void BlockDB::MigrateBlocks()
 {
-	//std::vector<FullBlock> blocks;
-
-	//auto iter = m_pRocksDB->GetIterator("BLOCK");
-	//for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
-	//	rocksdb::Slice key = iter->key();
-	//	try {
-	//		auto pBlock = m_pRocksDB->Get<FullBlock>("BLOCK", key, EProtocolVersion::V1);
-	//		blocks.push_back(std::move(*pBlock));
-	//	}
-	//	catch (std::exception& e) {
-	//		LOG_DEBUG_F("Failed to migrate block {}. Error: {}", key.data(), e.what());
-	//	}
-	//}
-
-	//for (const FullBlock& block : blocks)
-	//{
-	//	const Hash& hash = block.GetHash();
-	//	rocksdb::Slice key((const char*)hash.data(), hash.size());
-	//	m_pRocksDB->Put("BLOCK", DBEntry(key, block));
-	//}
-}
-
-void BlockDB::Compact(const std::shared_ptr<const Chain>& pChain)
-{
-	std::vector<std::string> blocks_to_remove;
-
-	const uint64_t horizon = Consensus::GetHorizonHeight(pChain->GetHeight());
+	// Blocks used to be stored in the BLOCK table, keyed only by hash.
+	// Move them into BLOCK_BY_HEIGHT, so they can be pruned by height without deserializing them.
+	size_t numMigrated = 0;
 	auto iter = m_pRocksDB->GetIterator("BLOCK");
 	for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
-		rocksdb::Slice key = iter->key();
 		try {
-			auto pBlock = m_pRocksDB->Get<FullBlock>("BLOCK", key);
-			if (pBlock->GetHeight() < horizon) {
-				blocks_to_remove.push_back(key.ToString());
-			}
+			std::vector<uint8_t> data(iter->value().data(), iter->value().data() + iter->value().size());
+			ByteBuffer byteBuffer(std::move(data));
+			FullBlock block = FullBlock::Deserialize(byteBuffer);
+
+			AddBlock(block);
+			++numMigrated;
 		}
 		catch (std::exception& e) {
-			LOG_DEBUG_F("Failed to deserialize block {}. Error: {}", key.ToString(true), e.what());
-			blocks_to_remove.push_back(key.ToString());
+			LOG_DEBUG_F("Failed to migrate block {}. Error: {}", iter->key().ToString(true), e.what());
 		}
 	}
 
-	m_pRocksDB->Delete("BLOCK", blocks_to_remove);
+	LOG_INFO_F("Migrated {} blocks", numMigrated);
+	m_pRocksDB->DeleteAll("BLOCK");
+}
+
+void BlockDB::Compact(const std::shared_ptr<const Chain>& pChain)
+{
+	const uint64_t horizon = Consensus::GetHorizonHeight(pChain->GetHeight());
+	LOG_INFO_F("Removing blocks below height {}", horizon);
+
+	const std::vector<uint8_t> begin = BlockKeyPrefix(0);
+	const std::vector<uint8_t> end = BlockKeyPrefix(horizon);
+	m_pRocksDB->DeleteRange(
+		"BLOCK_BY_HEIGHT",
+		rocksdb::Slice((const char*)begin.data(), begin.size()),
+		rocksdb::Slice((const char*)end.data(), end.size())
+	);
 }
 
 BlockHeaderPtr BlockDB::GetBlockHeader(const Hash& hash) const
@@ -182,6 +195,7 @@ void BlockDB::AddBlockHeader(BlockHeaderPtr pBlockHeader)
 
 void BlockDB::AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders)
 {
+	TRACE_SPAN("db", "BlockDB::AddBlockHeaders");
 	LOG_TRACE_F("Adding {} headers.", blockHeaders.size());
 
 	std::vector<DBEntry<BlockHeader>> entries;
@@ -201,28 +215,35 @@ void BlockDB::AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders)
 
 void BlockDB::AddBlock(const FullBlock& block)
 {
+	TRACE_SPAN("db", "BlockDB::AddBlock");
 	LOG_TRACE_F("Adding block {}", block);
 
-	const Hash& hash = block.GetHash();
-	rocksdb::Slice key((const char*)hash.data(), hash.size());
-	m_pRocksDB->Put("BLOCK", DBEntry<FullBlock>(key, block));
+	const std::vector<uint8_t> key = BlockKey(block.GetHeight(), block.GetHash());
+	m_pRocksDB->Put("BLOCK_BY_HEIGHT", DBEntry<FullBlock>(rocksdb::Slice((const char*)key.data(), key.size()), block));
 }
 
 std::unique_ptr<FullBlock> BlockDB::GetBlock(const Hash& hash) const
 {
-	rocksdb::Slice key((const char*)hash.data(), hash.size());
-	return m_pRocksDB->Get<FullBlock>("BLOCK", key);
+	// Blocks are only stored once their header is, so the header gives us the height part of the key.
+	BlockHeaderPtr pHeader = GetBlockHeader(hash);
+	if (pHeader == nullptr) {
+		return nullptr;
+	}
+
+	const std::vector<uint8_t> key = BlockKey(pHeader->GetHeight(), hash);
+	return m_pRocksDB->Get<FullBlock>("BLOCK_BY_HEIGHT", rocksdb::Slice((const char*)key.data(), key.size()));
 }
 
 void BlockDB::ClearBlocks()
 {
 	LOG_WARNING("Deleting all blocks.");
 
-	m_pRocksDB->DeleteAll("BLOCK");
+	m_pRocksDB->DeleteAll("BLOCK_BY_HEIGHT");
 }
 
 void BlockDB::AddBlockSums(const Hash& blockHash, const BlockSums& blockSums)
 {
+	TRACE_SPAN("db", "BlockDB::AddBlockSums");
 	LOG_TRACE_F("Adding BlockSums for block {}", blockHash);
 
 	rocksdb::Slice key((const char*)blockHash.data(), blockHash.size());
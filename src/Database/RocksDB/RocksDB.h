@@ -5,6 +5,7 @@
 #include <Core/Traits/Batchable.h>
 #include <Database/DatabaseException.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
 #include <Core/Serialization/ByteBuffer.h>
 
 #include <rocksdb/db.h>
@@ -52,15 +53,20 @@ public:
 		typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::ISerializable, T>>>
 	std::unique_ptr<T> Get(const RocksDBTable& table, const rocksdb::Slice& key, const EProtocolVersion protocol = EProtocolVersion::V1) const
 	{
+		static Metrics::Histogram& s_latency = GetLatencyHistogram("get");
+
 		rocksdb::Status status;
 		std::string itemStr;
-		if (m_pTransaction != nullptr)
-		{
-			status = m_pTransaction->Get(rocksdb::ReadOptions(), table.GetHandle(), key, &itemStr);
-		}
-		else
 		{
-			status = m_pTransactionDB->GetBaseDB()->Get(rocksdb::ReadOptions(), table.GetHandle(), key, &itemStr);
+			Metrics::ScopedTimer timer(s_latency);
+			if (m_pTransaction != nullptr)
+			{
+				status = m_pTransaction->Get(rocksdb::ReadOptions(), table.GetHandle(), key, &itemStr);
+			}
+			else
+			{
+				status = m_pTransactionDB->GetBaseDB()->Get(rocksdb::ReadOptions(), table.GetHandle(), key, &itemStr);
+			}
 		}
 
 		if (status.ok())
@@ -97,16 +103,21 @@ public:
 		typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::ISerializable, T>>>
 	void Put(const RocksDBTable& table, const DBEntry<T>& entry)
 	{
+		static Metrics::Histogram& s_latency = GetLatencyHistogram("put");
+
 		rocksdb::Status status;
 		std::vector<unsigned char> serialized = entry.SerializeValue();
 		rocksdb::Slice value((const char*)serialized.data(), serialized.size());
-		if (m_pTransaction != nullptr)
-		{
-			status = m_pTransaction->Put(table.GetHandle(), entry.key, value);
-		}
-		else
 		{
-			status = m_pTransactionDB->Put(rocksdb::WriteOptions(), table.GetHandle(), entry.key, value);
+			Metrics::ScopedTimer timer(s_latency);
+			if (m_pTransaction != nullptr)
+			{
+				status = m_pTransaction->Put(table.GetHandle(), entry.key, value);
+			}
+			else
+			{
+				status = m_pTransactionDB->Put(rocksdb::WriteOptions(), table.GetHandle(), entry.key, value);
+			}
 		}
 
 		if (status.ok())
@@ -138,6 +149,9 @@ public:
 	{
 		assert(!entries.empty());
 
+		static Metrics::Histogram& s_latency = GetLatencyHistogram("put_batch");
+		Metrics::ScopedTimer timer(s_latency);
+
 		std::shared_ptr<rocksdb::Transaction> pTempTransaction = nullptr;
 		if (m_pTransaction == nullptr)
 		{
@@ -224,6 +238,30 @@ public:
 		}
 	}
 
+	//
+	// Deletes all keys in [begin, end) and compacts the range so the space is reclaimed right away.
+	// Transactions don't support range deletes, so this always writes directly to the base DB.
+	//
+	void DeleteRange(const std::string& tableName, const rocksdb::Slice& begin, const rocksdb::Slice& end)
+	{
+		const RocksDBTable& table = GetTable(tableName);
+		LOG_DEBUG_F("Deleting range [{}, {}) from table {}", begin.ToString(true), end.ToString(true), table);
+
+		rocksdb::DB* pBaseDB = m_pTransactionDB->GetBaseDB();
+		rocksdb::Status status = pBaseDB->DeleteRange(rocksdb::WriteOptions(), table.GetHandle(), begin, end);
+		if (!status.ok())
+		{
+			LOG_ERROR_F("Error while attempting to delete range from table {}. Error: {}", table, status.getState());
+			throw DATABASE_EXCEPTION("DeleteRange Failed");
+		}
+
+		status = pBaseDB->CompactRange(rocksdb::CompactRangeOptions(), table.GetHandle(), &begin, &end);
+		if (!status.ok())
+		{
+			LOG_WARNING_F("Failed to compact range in table {}. Error: {}", table, status.getState());
+		}
+	}
+
 	void DeleteAll(const RocksDBTable& table)
 	{
 		LOG_WARNING_F("Deleting all rows from table {}", table);
@@ -310,6 +348,15 @@ public:
 	}
 
 private:
+	static Metrics::Histogram& GetLatencyHistogram(const std::string& operation)
+	{
+		return Metrics::Registry::Get().AddHistogram(
+			"grinpp_db_operation_seconds",
+			"Time spent in RocksDB reads and writes, by operation",
+			{ { "operation", operation } }
+		);
+	}
+
 	const RocksDBTable& GetTable(const std::string& name) const
 	{
 		for (const RocksDBTable& table : m_tables)
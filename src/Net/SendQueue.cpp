@@ -0,0 +1,100 @@
+#include <Net/SendQueue.h>
+
+SendQueue::SendQueue(const std::shared_ptr<TokenBucket>& pSharedBulkBucket)
+	: m_transactionBucket(TRANSACTION_BYTES_PER_SECOND, TRANSACTION_BURST_BYTES),
+	m_bulkBucket(PEER_BULK_BYTES_PER_SECOND, PEER_BULK_BURST_BYTES),
+	m_pSharedBulkBucket(pSharedBulkBucket)
+{
+
+}
+
+std::shared_ptr<TokenBucket> SendQueue::GetSharedBulkBucket()
+{
+	static auto pBucket = std::make_shared<TokenBucket>(SHARED_BULK_BYTES_PER_SECOND, SHARED_BULK_BURST_BYTES);
+	return pBucket;
+}
+
+void SendQueue::Push(std::vector<uint8_t>&& bytes, const ESendPriority priority, const bool isMessage)
+{
+	m_queuedBytes[(size_t)priority] += bytes.size();
+	m_queues[(size_t)priority].push_back(Entry{ std::move(bytes), priority, isMessage });
+}
+
+std::optional<SendQueue::Entry> SendQueue::Pop(const Clock::time_point& now, Clock::duration& waitTime)
+{
+	waitTime = Clock::duration::max();
+
+	for (size_t i = 0; i < NUM_PRIORITIES; i++) {
+		std::deque<Entry>& queue = m_queues[i];
+		if (queue.empty()) {
+			continue;
+		}
+
+		const std::vector<TokenBucket*> buckets = GetBuckets((ESendPriority)i);
+
+		// Only sent once every bucket has tokens. Otherwise, lower priorities get a chance to go first.
+		Clock::duration priorityWait = Clock::duration::zero();
+		for (TokenBucket* pBucket : buckets) {
+			priorityWait = (std::max)(priorityWait, pBucket->GetWaitTime(now));
+		}
+
+		if (priorityWait > Clock::duration::zero()) {
+			waitTime = (std::min)(waitTime, priorityWait);
+			continue;
+		}
+
+		Entry entry = std::move(queue.front());
+		queue.pop_front();
+		m_queuedBytes[i] -= entry.bytes.size();
+
+		for (TokenBucket* pBucket : buckets) {
+			pBucket->Consume(entry.bytes.size(), now);
+		}
+
+		waitTime = Clock::duration::zero();
+		return std::make_optional(std::move(entry));
+	}
+
+	return std::nullopt;
+}
+
+void SendQueue::Clear()
+{
+	for (size_t i = 0; i < NUM_PRIORITIES; i++) {
+		m_queues[i].clear();
+		m_queuedBytes[i] = 0;
+	}
+}
+
+bool SendQueue::IsEmpty() const noexcept
+{
+	for (const auto& queue : m_queues) {
+		if (!queue.empty()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+size_t SendQueue::GetQueuedBytes() const noexcept
+{
+	size_t total = 0;
+	for (const size_t bytes : m_queuedBytes) {
+		total += bytes;
+	}
+
+	return total;
+}
+
+std::vector<TokenBucket*> SendQueue::GetBuckets(const ESendPriority priority)
+{
+	switch (priority) {
+		case ESendPriority::TRANSACTION:
+			return { &m_transactionBucket };
+		case ESendPriority::BULK:
+			return { &m_bulkBucket, m_pSharedBulkBucket.get() };
+		default:
+			return {};
+	}
+}
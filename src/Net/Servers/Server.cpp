@@ -6,17 +6,21 @@
 
 #include <civetweb.h>
 
-std::shared_ptr<Server> Server::Create(const EServerType type, const std::optional<uint16_t>& port)
+std::shared_ptr<Server> Server::Create(const EServerType type, const std::optional<uint16_t>& port, const ServerOptions& options)
 {
 	std::string listenerAddr = type == EServerType::LOCAL ? "127.0.0.1" : "0.0.0.0";
 	std::string listeningPort = StringUtil::Format("{}:{}", listenerAddr, port.value_or(0));
 
+	const std::string numThreads = std::to_string(options.numThreads);
+	const std::string keepAliveTimeout = std::to_string(options.keepAliveTimeoutMs);
+	const std::string requestTimeout = std::to_string(options.requestTimeoutMs);
+
 	const char* pOptions[] = {
-		"num_threads", "10", // TODO: this could be a parameter or adjust it depending on the OS
+		"num_threads", numThreads.c_str(),
 		"listening_ports", listeningPort.c_str(),
-		"enable_keep_alive", "no",
-		"keep_alive_timeout_ms", "no",
-		"request_timeout_ms", "120000",
+		"enable_keep_alive", options.keepAlive ? "yes" : "no",
+		"keep_alive_timeout_ms", keepAliveTimeout.c_str(),
+		"request_timeout_ms", requestTimeout.c_str(),
 		NULL
 	};
 
@@ -36,6 +40,13 @@ std::shared_ptr<Server> Server::Create(const EServerType type, const std::option
 		throw HTTP_EXCEPTION("mg_get_server_ports failed.");
 	}
 
+	LOG_INFO_F(
+		"Started server ({}) with {} threads, keep-alive: {}",
+		listeningPort,
+		options.numThreads,
+		options.keepAlive
+	);
+
 	return std::shared_ptr<Server>(new Server(pCivetContext, (uint16_t)ports.port));
 }
 
@@ -24,7 +24,9 @@ Socket::Socket(
     m_blocking(true),
     m_receiveBufferSize(0),
     m_receiveTimeout(DEFAULT_TIMEOUT),
-    m_sendTimeout(DEFAULT_TIMEOUT)
+    m_sendTimeout(DEFAULT_TIMEOUT),
+    m_throttled(false),
+    m_throttleTimer(pSocket->get_executor())
 {
 
 }
@@ -169,60 +171,93 @@ bool Socket::SetBlocking(const bool blocking)
 
 bool Socket::SendSync(const std::vector<uint8_t>& message, const bool incrementCount)
 {
-    if (incrementCount) {
-        m_rateCounter.AddMessageSent();
-    }
-
     const size_t bytesWritten = asio::write(*m_pSocket, asio::buffer(message.data(), message.size()), m_errorCode);
     if (m_errorCode && m_errorCode.value() != EAGAIN && m_errorCode.value() != EWOULDBLOCK) {
         ThrowSocketException(m_errorCode);
     }
 
+    if (incrementCount) {
+        m_rateCounter.AddMessageSent(bytesWritten);
+    } else {
+        m_rateCounter.AddBytesSent(bytesWritten);
+    }
+
     return bytesWritten == message.size();
 }
 
-void Socket::SendAsync(const std::vector<uint8_t>& message)
+void Socket::SendAsync(std::vector<uint8_t> message, const ESendPriority priority, const bool isMessage)
 {
-    bool first_in_queue = m_writeQueue.empty();
-    m_writeQueue.push_back(message);
+    std::unique_lock<std::mutex> lock(m_writeQueueMutex);
+    m_sendQueue.Push(std::move(message), priority, isMessage);
 
-    if (!first_in_queue) {
-        // There is already an async_write in process.
-        // It will send this message when it completes.
-        return;
+    if (!m_writing.has_value() && !m_throttled) {
+        StartNextWrite();
     }
+}
+
+size_t Socket::GetQueuedBytes(const ESendPriority priority)
+{
+    std::unique_lock<std::mutex> lock(m_writeQueueMutex);
+    return m_sendQueue.GetQueuedBytes(priority);
+}
 
+bool Socket::HasPendingSends()
+{
+    std::unique_lock<std::mutex> lock(m_writeQueueMutex);
+    return m_writing.has_value() || !m_sendQueue.IsEmpty();
+}
+
+//
+// Starts writing the next sendable entry, or waits for the throttled ones to become sendable.
+// Only one write is outstanding at a time. Caller must hold m_writeQueueMutex.
+//
+void Socket::StartNextWrite()
+{
     std::shared_lock<std::shared_mutex> socketLock(m_socketMutex);
-    if (m_socketOpen) {
+    if (!m_socketOpen) {
+        m_sendQueue.Clear();
+        return;
+    }
+
+    SendQueue::Clock::duration waitTime;
+    m_writing = m_sendQueue.Pop(SendQueue::Clock::now(), waitTime);
+    if (m_writing.has_value()) {
         asio::async_write(
             *m_pSocket,
-            asio::buffer(message.data(), message.size()),
+            asio::buffer(m_writing.value().bytes.data(), m_writing.value().bytes.size()),
             std::bind(&Socket::HandleSent, shared_from_this(), std::placeholders::_1, std::placeholders::_2)
         );
+    } else if (!m_sendQueue.IsEmpty()) {
+        m_throttled = true;
+        m_throttleTimer.expires_after(waitTime);
+        m_throttleTimer.async_wait([pSocket = shared_from_this()](const asio::error_code& ec) {
+            std::unique_lock<std::mutex> lock(pSocket->m_writeQueueMutex);
+            pSocket->m_throttled = false;
+            if (!ec && !pSocket->m_writing.has_value()) {
+                pSocket->StartNextWrite();
+            }
+        });
     }
 }
 
-void Socket::HandleSent(const asio::error_code& ec, size_t)
+void Socket::HandleSent(const asio::error_code& ec, size_t bytes_transferred)
 {
-    m_rateCounter.AddMessageSent();
+    std::unique_lock<std::mutex> lock(m_writeQueueMutex);
 
-    if (!m_writeQueue.empty()) {
-        m_writeQueue.pop_front();
+    // Outgoing traffic is shaped by the send queue, so it doesn't count towards the peer's rate limit.
+    if (m_writing.has_value() && m_writing.value().isMessage) {
+        m_rateCounter.AddMessageSent(bytes_transferred, false);
+    } else {
+        m_rateCounter.AddBytesSent(bytes_transferred);
     }
 
+    m_writing.reset();
+
     if (ec) {
         LOG_INFO_F("Failed to send message to {}: {}", *this, ec.message());
-    } else if (!m_writeQueue.empty()) {
-        std::vector<uint8_t> message = m_writeQueue.front();
-
-        std::shared_lock<std::shared_mutex> socketLock(m_socketMutex);
-        if (m_socketOpen) {
-            asio::async_write(
-                *m_pSocket,
-                asio::buffer(message.data(), message.size()),
-                std::bind(&Socket::HandleSent, shared_from_this(), std::placeholders::_1, std::placeholders::_2)
-            );
-        }
+        m_sendQueue.Clear();
+    } else if (!m_throttled) {
+        StartNextWrite();
     }
 }
 
@@ -249,7 +284,9 @@ std::vector<uint8_t> Socket::ReceiveSync(const size_t num_bytes, const bool incr
 
         if (bytesRead == num_bytes) {
             if (incrementCount) {
-                m_rateCounter.AddMessageReceived();
+                m_rateCounter.AddMessageReceived(num_bytes);
+            } else {
+                m_rateCounter.AddBytesReceived(num_bytes);
             }
 
             return bytes;
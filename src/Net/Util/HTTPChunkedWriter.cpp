@@ -0,0 +1,60 @@
+#include <Net/Util/HTTPChunkedWriter.h>
+#include <Net/Clients/HTTP/HTTPException.h>
+
+#include <civetweb.h>
+#include <cassert>
+
+HTTPChunkedWriter::HTTPChunkedWriter(mg_connection* conn, const size_t chunkSize)
+	: m_pConnection(conn), m_chunkSize(chunkSize)
+{
+	assert(conn != nullptr);
+	m_buffer.reserve(chunkSize);
+}
+
+void HTTPChunkedWriter::Begin(const std::string& contentType)
+{
+	// A negative content length makes civetweb send "Transfer-Encoding: chunked"
+	mg_send_http_ok(m_pConnection, contentType.c_str(), -1);
+}
+
+void HTTPChunkedWriter::Write(const char* pData, const size_t length)
+{
+	m_buffer.append(pData, length);
+	if (m_buffer.size() >= m_chunkSize) {
+		Flush();
+	}
+}
+
+int HTTPChunkedWriter::End()
+{
+	Flush();
+
+	// Zero-length chunk terminates the response
+	if (mg_send_chunk(m_pConnection, "", 0) < 0) {
+		throw HTTP_EXCEPTION("Failed to write final chunk");
+	}
+
+	return 200;
+}
+
+int HTTPChunkedWriter::Abort() noexcept
+{
+	// The status line has already been sent, so there's no way to report the error other than dropping the connection.
+	m_buffer.clear();
+	mg_disable_connection_keep_alive(m_pConnection);
+
+	return 500;
+}
+
+void HTTPChunkedWriter::Flush()
+{
+	if (m_buffer.empty()) {
+		return;
+	}
+
+	if (mg_send_chunk(m_pConnection, m_buffer.data(), (unsigned int)m_buffer.size()) < 0) {
+		throw HTTP_EXCEPTION("Failed to write chunk");
+	}
+
+	m_buffer.clear();
+}
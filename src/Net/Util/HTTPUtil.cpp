@@ -137,48 +137,43 @@ int HTTPUtil::BuildSuccessResponseJSON(mg_connection* conn, const Json::Value& j
 	return HTTPUtil::BuildSuccessResponse(conn, output);
 }
 
+// civetweb decides whether the connection can be kept alive (server config, client's Connection header, HTTP version),
+// so responses are sent through mg_send_http_ok/mg_send_http_error, which emit the matching Connection header.
 int HTTPUtil::BuildSuccessResponse(mg_connection* conn, const std::string& response)
 {
 	assert(conn != nullptr);
 
-	unsigned long len = (unsigned long)response.size();
-
 	if (response.empty())
 	{
-		mg_printf(conn,
-			"HTTP/1.1 200 OK\r\n"
-			"Content-Length: 0\r\n"
-			"Connection: close\r\n\r\n");
+		mg_send_http_ok(conn, "text/plain", 0);
 	}
 	else
 	{
-		mg_printf(conn,
-			"HTTP/1.1 200 OK\r\n"
-			"Content-Length: %lu\r\n"
-			"Content-Type: application/json\r\n"
-			"Connection: close\r\n\r\n",
-			len);
+		mg_send_http_ok(conn, "application/json", (long long)response.size());
+		mg_write(conn, response.c_str(), response.size());
 	}
 
-	mg_write(conn, response.c_str(), len);
-
 	return 200;
 }
 
-int HTTPUtil::BuildBadRequestResponse(mg_connection* conn, const std::string& response)
+int HTTPUtil::BuildSuccessResponse(mg_connection* conn, const std::string& response, const std::string& contentType)
 {
 	assert(conn != nullptr);
 
-	unsigned long len = (unsigned long)response.size();
+	mg_send_http_ok(conn, contentType.c_str(), (long long)response.size());
+	if (!response.empty())
+	{
+		mg_write(conn, response.c_str(), response.size());
+	}
 
-	mg_printf(conn,
-		"HTTP/1.1 400 Bad Request\r\n"
-		"Content-Length: %lu\r\n"
-		"Content-Type: text/plain\r\n"
-		"Connection: close\r\n\r\n",
-		len);
+	return 200;
+}
 
-	mg_write(conn, response.c_str(), len);
+int HTTPUtil::BuildBadRequestResponse(mg_connection* conn, const std::string& response)
+{
+	assert(conn != nullptr);
+
+	mg_send_http_error(conn, 400, "%s", response.c_str());
 
 	return 400;
 }
@@ -187,16 +182,7 @@ int HTTPUtil::BuildConflictResponse(mg_connection* conn, const std::string& resp
 {
 	assert(conn != nullptr);
 
-	unsigned long len = (unsigned long)response.size();
-
-	mg_printf(conn,
-		"HTTP/1.1 409 Conflict\r\n"
-		"Content-Length: %lu\r\n"
-		"Content-Type: text/plain\r\n"
-		"Connection: close\r\n\r\n",
-		len);
-
-	mg_write(conn, response.c_str(), len);
+	mg_send_http_error(conn, 409, "%s", response.c_str());
 
 	return 409;
 }
@@ -205,16 +191,7 @@ int HTTPUtil::BuildUnauthorizedResponse(mg_connection* conn, const std::string&
 {
 	assert(conn != nullptr);
 
-	unsigned long len = (unsigned long)response.size();
-
-	mg_printf(conn,
-		"HTTP/1.1 401 Unauthorized\r\n"
-		"Content-Length: %lu\r\n"
-		"Content-Type: text/plain\r\n"
-		"Connection: close\r\n\r\n",
-		len);
-
-	mg_write(conn, response.c_str(), len);
+	mg_send_http_error(conn, 401, "%s", response.c_str());
 
 	return 401;
 }
@@ -223,16 +200,7 @@ int HTTPUtil::BuildNotFoundResponse(mg_connection* conn, const std::string& resp
 {
 	assert(conn != nullptr);
 
-	unsigned long len = (unsigned long)response.size();
-
-	mg_printf(conn,
-		"HTTP/1.1 404 Not Found\r\n"
-		"Content-Length: %lu\r\n"
-		"Content-Type: text/plain\r\n"
-		"Connection: close\r\n\r\n",
-		len);
-
-	mg_write(conn, response.c_str(), len);
+	mg_send_http_error(conn, 404, "%s", response.c_str());
 
 	return 400;
 }
@@ -241,16 +209,7 @@ int HTTPUtil::BuildInternalErrorResponse(mg_connection* conn, const std::string&
 {
 	assert(conn != nullptr);
 
-	unsigned long len = (unsigned long)response.size();
-
-	mg_printf(conn,
-		"HTTP/1.1 500 Internal Server Error\r\n"
-		"Content-Length: %lu\r\n"
-		"Content-Type: text/plain\r\n"
-		"Connection: close\r\n\r\n",
-		len);
-
-	mg_write(conn, response.c_str(), len);
+	mg_send_http_error(conn, 500, "%s", response.c_str());
 
 	return 500;
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "CompactBlockRelay.h"
+#include "ConnectionManager.h"
+#include "Messages/CompactBlockMessage.h"
+#include "Messages/BlockMessage.h"
+#include "Messages/HeaderMessage.h"
+
+#include <Common/Logger.h>
+#include <Common/Metrics.h>
+#include <algorithm>
+
+static Metrics::Counter& GetEventCounter(const std::string& event)
+{
+	return Metrics::Registry::Get().AddCounter(
+		"grinpp_p2p_compact_blocks_total",
+		"Compact block relay events",
+		{ { "event", event } }
+	);
+}
+
+static void SendTo(const std::vector<ConnectionPtr>& connections, const std::vector<uint64_t>& connectionIds, const IMessage& message)
+{
+	for (const ConnectionPtr& pConnection : connections)
+	{
+		if (std::find(connectionIds.cbegin(), connectionIds.cend(), pConnection->GetId()) != connectionIds.cend())
+		{
+			pConnection->SendAsync(message);
+		}
+	}
+}
+
+void CompactBlockRelay::RelayEarly(const CompactBlock& compactBlock, const uint64_t sourceId)
+{
+	static Metrics::Counter& s_relayedEarly = GetEventCounter("relayed_early");
+
+	const std::vector<ConnectionPtr> connections = m_connectionManager.GetConnections();
+	const std::vector<uint64_t> targets = m_tracker.SelectEarly(compactBlock, sourceId, ToPeers(connections));
+	if (!targets.empty())
+	{
+		LOG_DEBUG_F("Relaying compact block {} to {} high-bandwidth peers before validation", compactBlock.GetHash(), targets.size());
+
+		SendTo(connections, targets, CompactBlockMessage(compactBlock));
+		s_relayedEarly.Increment(targets.size());
+	}
+}
+
+void CompactBlockRelay::RelayValidated(const BlockHeaderPtr& pHeader, const uint64_t sourceId)
+{
+	static Metrics::Counter& s_relayedValidated = GetEventCounter("relayed_validated");
+	static Metrics::Counter& s_queuedBlockSent = GetEventCounter("queued_block_sent");
+
+	const std::vector<ConnectionPtr> connections = m_connectionManager.GetConnections();
+	const CompactBlockTracker::ValidatedTargets targets = m_tracker.SelectValidated(pHeader->GetHash(), sourceId, ToPeers(connections));
+
+	std::vector<uint64_t> headerTargets = targets.headers;
+	if (!targets.compact.empty())
+	{
+		std::unique_ptr<CompactBlock> pCompactBlock = m_pBlockChain->GetCompactBlockByHash(pHeader->GetHash());
+		if (pCompactBlock != nullptr)
+		{
+			m_tracker.MarkSentCompact(pHeader->GetHash(), pCompactBlock->GetNonce(), targets.compact);
+
+			SendTo(connections, targets.compact, CompactBlockMessage(*pCompactBlock));
+			s_relayedValidated.Increment(targets.compact.size());
+		}
+		else
+		{
+			headerTargets.insert(headerTargets.end(), targets.compact.cbegin(), targets.compact.cend());
+		}
+	}
+
+	if (!targets.blocks.empty())
+	{
+		std::unique_ptr<FullBlock> pBlock = m_pBlockChain->GetBlockByHash(pHeader->GetHash());
+		if (pBlock != nullptr)
+		{
+			LOG_DEBUG_F("Sending block {} to {} peers that requested it during validation", pHeader->GetHash(), targets.blocks.size());
+
+			SendTo(connections, targets.blocks, BlockMessage(std::move(*pBlock)));
+			s_queuedBlockSent.Increment(targets.blocks.size());
+		}
+	}
+
+	SendTo(connections, headerTargets, HeaderMessage(pHeader));
+}
+
+std::vector<TransactionPtr> CompactBlockRelay::FindTransactions(const Hash& blockHash, const std::set<ShortId>& shortIds) const
+{
+	std::vector<TransactionPtr> cached;
+	std::optional<uint64_t> nonceOpt = m_tracker.GetCachedTransactions(blockHash, cached);
+
+	if (!nonceOpt.has_value())
+	{
+		std::unique_ptr<CompactBlock> pCompactBlock = m_pBlockChain->GetCompactBlockByHash(blockHash);
+		if (pCompactBlock == nullptr)
+		{
+			return {};
+		}
+
+		nonceOpt = pCompactBlock->GetNonce();
+	}
+
+	std::set<ShortId> remaining = shortIds;
+	std::vector<TransactionPtr> found;
+	for (const TransactionPtr& pTransaction : cached)
+	{
+		bool matches = false;
+		for (const TransactionKernel& kernel : pTransaction->GetKernels())
+		{
+			if (remaining.erase(ShortId::Create(kernel.GetHash(), blockHash, nonceOpt.value())) > 0)
+			{
+				matches = true;
+			}
+		}
+
+		if (matches)
+		{
+			found.push_back(pTransaction);
+		}
+	}
+
+	if (!remaining.empty())
+	{
+		const std::vector<TransactionPtr> pooled = m_pBlockChain->GetTransactionsByShortId(blockHash, nonceOpt.value(), remaining);
+		found.insert(found.end(), pooled.cbegin(), pooled.cend());
+	}
+
+	return found;
+}
+
+std::set<ShortId> CompactBlockRelay::GetMissingShortIds(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions)
+{
+	const std::vector<ShortId>& shortIds = compactBlock.GetShortIds();
+	std::set<ShortId> missing(shortIds.cbegin(), shortIds.cend());
+
+	for (const TransactionPtr& pTransaction : transactions)
+	{
+		for (const TransactionKernel& kernel : pTransaction->GetKernels())
+		{
+			missing.erase(ShortId::Create(kernel.GetHash(), compactBlock.GetHash(), compactBlock.GetNonce()));
+		}
+	}
+
+	return missing;
+}
+
+std::vector<CompactBlockTracker::Peer> CompactBlockRelay::ToPeers(const std::vector<ConnectionPtr>& connections)
+{
+	std::vector<CompactBlockTracker::Peer> peers;
+	peers.reserve(connections.size());
+	for (const ConnectionPtr& pConnection : connections)
+	{
+		peers.push_back(CompactBlockTracker::Peer{
+			pConnection->GetId(),
+			pConnection->GetCapabilities().HasCapability(Capabilities::COMPACT_BLOCK_RELAY)
+		});
+	}
+
+	return peers;
+}
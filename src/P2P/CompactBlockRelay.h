@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Connection.h"
+#include "CompactBlockTracker.h"
+
+#include <BlockChain/BlockChain.h>
+#include <Core/Config.h>
+#include <Core/Models/CompactBlock.h>
+#include <Core/Models/ShortId.h>
+#include <Core/Models/Transaction.h>
+#include <Crypto/Models/Hash.h>
+#include <optional>
+#include <set>
+
+// Forward Declarations
+class ConnectionManager;
+
+//
+// High-bandwidth compact block relay.
+//
+// A few peers with the COMPACT_BLOCK_RELAY capability are picked as high-bandwidth peers, preferring the ones that most
+// recently delivered us a new block first. Those are sent compact blocks as soon as the header's proof of work checks out,
+// before the block is hydrated or validated. All other peers are only sent the header, once the block is fully validated.
+//
+// When a compact block can't be hydrated from the mempool, capable peers are asked for just the missing txs by short id,
+// instead of the whole block. To be able to answer those requests, the txs of recent blocks are kept after they leave the mempool.
+// A peer that was sent a compact block early may ask for the full block before we have it. Those requests are answered
+// once the block is validated, since the peer won't be sent the block or its header again.
+//
+class CompactBlockRelay
+{
+public:
+	using Ptr = std::shared_ptr<CompactBlockRelay>;
+
+	CompactBlockRelay(const Config& config, ConnectionManager& connectionManager, const IBlockChain::Ptr& pBlockChain)
+		: m_tracker(config.GetHighBandwidthPeers()),
+		m_connectionManager(connectionManager),
+		m_pBlockChain(pBlockChain) { }
+
+	//
+	// Sends the compact block to the high-bandwidth peers that weren't sent it yet, except for the peer it came from.
+	// The caller must have checked the header first.
+	//
+	void RelayEarly(const CompactBlock& compactBlock, const uint64_t sourceId);
+
+	//
+	// Relays a block that was just fully validated, crediting the peer it came from for delivering it.
+	// High-bandwidth peers that weren't sent it early get the compact block. Everyone else gets the header,
+	// except for peers that asked for the full block while it was being validated, which are sent the block.
+	//
+	void RelayValidated(const BlockHeaderPtr& pHeader, const uint64_t sourceId);
+
+	//
+	// Holds on to a request for a block that was relayed to the peer early, but isn't validated yet.
+	// Returns false if the request wasn't held, in which case the block should be looked up again, since it may have just been stored.
+	//
+	bool QueueBlockRequest(const Hash& blockHash, const uint64_t connectionId)
+	{
+		return m_tracker.QueueBlockRequest(blockHash, connectionId);
+	}
+
+	//
+	// Remembers the txs a block was hydrated with, so they can still be served once they've left the mempool.
+	//
+	void CacheTransactions(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions)
+	{
+		m_tracker.CacheTransactions(compactBlock, transactions);
+	}
+
+	//
+	// Finds the txs for the requested short ids of the block, from the cache or the mempool.
+	//
+	std::vector<TransactionPtr> FindTransactions(const Hash& blockHash, const std::set<ShortId>& shortIds) const;
+
+	//
+	// Holds on to a compact block while its missing txs are requested from the given peer.
+	// TakePending returns it once they arrive, but only if they came from that same peer.
+	//
+	void AddPending(const CompactBlock& compactBlock, const uint64_t connectionId)
+	{
+		m_tracker.AddPending(compactBlock, connectionId);
+	}
+
+	std::optional<CompactBlock> TakePending(const Hash& blockHash, const uint64_t connectionId)
+	{
+		return m_tracker.TakePending(blockHash, connectionId);
+	}
+
+	static std::set<ShortId> GetMissingShortIds(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions);
+
+private:
+	static std::vector<CompactBlockTracker::Peer> ToPeers(const std::vector<ConnectionPtr>& connections);
+
+	CompactBlockTracker m_tracker;
+	ConnectionManager& m_connectionManager;
+	IBlockChain::Ptr m_pBlockChain;
+};
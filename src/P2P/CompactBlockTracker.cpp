@@ -0,0 +1,206 @@
+#include "CompactBlockTracker.h"
+
+#include <algorithm>
+
+std::vector<uint64_t> CompactBlockTracker::GetHighBandwidthPeers(const std::vector<Peer>& peers) const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return SelectHighBandwidthPeers(peers);
+}
+
+std::vector<uint64_t> CompactBlockTracker::SelectEarly(const CompactBlock& compactBlock, const uint64_t sourceId, const std::vector<Peer>& peers)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	RecentBlock& recentBlock = GetRecentBlock(compactBlock.GetHash(), compactBlock.GetNonce());
+	recentBlock.sentCompactTo.insert(sourceId);
+
+	std::vector<uint64_t> targets;
+	for (const uint64_t connectionId : SelectHighBandwidthPeers(peers))
+	{
+		if (recentBlock.sentCompactTo.insert(connectionId).second)
+		{
+			targets.push_back(connectionId);
+		}
+	}
+
+	return targets;
+}
+
+CompactBlockTracker::ValidatedTargets CompactBlockTracker::SelectValidated(const Hash& blockHash, const uint64_t sourceId, const std::vector<Peer>& peers)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	if (sourceId != 0)
+	{
+		auto iter = std::find(m_recentDeliverers.begin(), m_recentDeliverers.end(), sourceId);
+		if (iter != m_recentDeliverers.end())
+		{
+			m_recentDeliverers.erase(iter);
+		}
+
+		m_recentDeliverers.push_front(sourceId);
+		if (m_recentDeliverers.size() > MAX_RECENT_BLOCKS)
+		{
+			m_recentDeliverers.pop_back();
+		}
+	}
+
+	const std::vector<uint64_t> highBandwidthPeers = SelectHighBandwidthPeers(peers);
+	const std::set<uint64_t> highBandwidthIds(highBandwidthPeers.cbegin(), highBandwidthPeers.cend());
+
+	ValidatedTargets targets;
+
+	auto iter = m_recentBlocks.find(blockHash);
+	if (iter != m_recentBlocks.end())
+	{
+		iter->second.validated = true;
+		targets.blocks.assign(iter->second.blockRequestedBy.cbegin(), iter->second.blockRequestedBy.cend());
+		iter->second.blockRequestedBy.clear();
+	}
+
+	for (const Peer& peer : peers)
+	{
+		if (peer.connectionId == sourceId)
+		{
+			continue;
+		}
+
+		if (iter != m_recentBlocks.end() && iter->second.sentCompactTo.count(peer.connectionId) > 0)
+		{
+			continue;
+		}
+
+		if (highBandwidthIds.count(peer.connectionId) > 0)
+		{
+			targets.compact.push_back(peer.connectionId);
+		}
+		else
+		{
+			targets.headers.push_back(peer.connectionId);
+		}
+	}
+
+	return targets;
+}
+
+void CompactBlockTracker::MarkSentCompact(const Hash& blockHash, const uint64_t nonce, const std::vector<uint64_t>& connectionIds)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	RecentBlock& recentBlock = GetRecentBlock(blockHash, nonce);
+	recentBlock.sentCompactTo.insert(connectionIds.cbegin(), connectionIds.cend());
+}
+
+bool CompactBlockTracker::QueueBlockRequest(const Hash& blockHash, const uint64_t connectionId)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto iter = m_recentBlocks.find(blockHash);
+	if (iter == m_recentBlocks.end() || iter->second.validated || iter->second.sentCompactTo.count(connectionId) == 0)
+	{
+		return false;
+	}
+
+	iter->second.blockRequestedBy.insert(connectionId);
+	return true;
+}
+
+void CompactBlockTracker::CacheTransactions(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	RecentBlock& recentBlock = GetRecentBlock(compactBlock.GetHash(), compactBlock.GetNonce());
+	recentBlock.transactions = transactions;
+}
+
+std::optional<uint64_t> CompactBlockTracker::GetCachedTransactions(const Hash& blockHash, std::vector<TransactionPtr>& transactions) const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto iter = m_recentBlocks.find(blockHash);
+	if (iter == m_recentBlocks.end())
+	{
+		return std::nullopt;
+	}
+
+	transactions = iter->second.transactions;
+	return std::make_optional(iter->second.nonce);
+}
+
+void CompactBlockTracker::AddPending(const CompactBlock& compactBlock, const uint64_t connectionId)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	RecentBlock& recentBlock = GetRecentBlock(compactBlock.GetHash(), compactBlock.GetNonce());
+	recentBlock.pending = std::make_optional<CompactBlock>(compactBlock);
+	recentBlock.pendingConnectionId = connectionId;
+}
+
+std::optional<CompactBlock> CompactBlockTracker::TakePending(const Hash& blockHash, const uint64_t connectionId)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto iter = m_recentBlocks.find(blockHash);
+	if (iter == m_recentBlocks.end() || !iter->second.pending.has_value() || iter->second.pendingConnectionId != connectionId)
+	{
+		return std::nullopt;
+	}
+
+	std::optional<CompactBlock> pending = std::move(iter->second.pending);
+	iter->second.pending.reset();
+	return pending;
+}
+
+std::vector<uint64_t> CompactBlockTracker::SelectHighBandwidthPeers(const std::vector<Peer>& peers) const
+{
+	std::vector<uint64_t> capable;
+	if (m_maxHighBandwidthPeers == 0)
+	{
+		return capable;
+	}
+
+	for (const Peer& peer : peers)
+	{
+		if (peer.compactCapable)
+		{
+			capable.push_back(peer.connectionId);
+		}
+	}
+
+	// Peers that delivered the latest blocks first, the rest in the order given.
+	auto rank = [this](const uint64_t connectionId) {
+		auto iter = std::find(m_recentDeliverers.cbegin(), m_recentDeliverers.cend(), connectionId);
+		return (size_t)std::distance(m_recentDeliverers.cbegin(), iter);
+	};
+	std::stable_sort(
+		capable.begin(),
+		capable.end(),
+		[&rank](const uint64_t a, const uint64_t b) { return rank(a) < rank(b); }
+	);
+
+	if (capable.size() > m_maxHighBandwidthPeers)
+	{
+		capable.resize(m_maxHighBandwidthPeers);
+	}
+
+	return capable;
+}
+
+CompactBlockTracker::RecentBlock& CompactBlockTracker::GetRecentBlock(const Hash& blockHash, const uint64_t nonce)
+{
+	auto iter = m_recentBlocks.find(blockHash);
+	if (iter != m_recentBlocks.end())
+	{
+		return iter->second;
+	}
+
+	while (m_recentBlockHashes.size() >= MAX_RECENT_BLOCKS)
+	{
+		m_recentBlocks.erase(m_recentBlockHashes.front());
+		m_recentBlockHashes.pop_front();
+	}
+
+	m_recentBlockHashes.push_back(blockHash);
+	return m_recentBlocks.emplace(blockHash, RecentBlock{ nonce, {}, {}, std::nullopt, 0, false, {} }).first->second;
+}
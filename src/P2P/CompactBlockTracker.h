@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Core/Models/CompactBlock.h>
+#include <Core/Models/Transaction.h>
+#include <Crypto/Models/Hash.h>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+//
+// The bookkeeping behind CompactBlockRelay, which holds no connections itself, so peers are identified by connection id.
+//
+// Keeps track of which peers delivered the latest blocks, which peers were already sent each recent block,
+// and the txs and requests held on to for recent blocks.
+//
+// Thread-safe.
+//
+class CompactBlockTracker
+{
+public:
+	struct Peer
+	{
+		uint64_t connectionId;
+		bool compactCapable; // Has the COMPACT_BLOCK_RELAY capability.
+	};
+
+	struct ValidatedTargets
+	{
+		// High-bandwidth peers that weren't sent the compact block early.
+		std::vector<uint64_t> compact;
+
+		// All other peers that weren't sent the compact block early.
+		std::vector<uint64_t> headers;
+
+		// Peers that were sent the compact block early, and asked for the full block before it was validated.
+		std::vector<uint64_t> blocks;
+	};
+
+	explicit CompactBlockTracker(const uint8_t maxHighBandwidthPeers)
+		: m_maxHighBandwidthPeers(maxHighBandwidthPeers) { }
+
+	//
+	// Picks up to maxHighBandwidthPeers of the capable peers, preferring the ones that most recently delivered us a new block first.
+	//
+	std::vector<uint64_t> GetHighBandwidthPeers(const std::vector<Peer>& peers) const;
+
+	//
+	// Returns the high-bandwidth peers that weren't sent the compact block yet, excluding the peer it came from.
+	// They're all marked as sent it, along with the source.
+	//
+	std::vector<uint64_t> SelectEarly(const CompactBlock& compactBlock, const uint64_t sourceId, const std::vector<Peer>& peers);
+
+	//
+	// Credits the peer a block came from for delivering it, once it's fully validated, and returns the peers that still need it.
+	// Compact targets aren't marked as sent, since the caller may fall back to sending them the header. See MarkSentCompact.
+	//
+	ValidatedTargets SelectValidated(const Hash& blockHash, const uint64_t sourceId, const std::vector<Peer>& peers);
+	void MarkSentCompact(const Hash& blockHash, const uint64_t nonce, const std::vector<uint64_t>& connectionIds);
+
+	//
+	// Queues a request for a block that was sent to the peer early, so it can be answered once the block is validated.
+	// Returns false if it wasn't queued, because the peer wasn't sent the block early, or because it was already validated.
+	//
+	bool QueueBlockRequest(const Hash& blockHash, const uint64_t connectionId);
+
+	void CacheTransactions(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions);
+
+	//
+	// Returns the nonce of a recent block, along with the txs cached for it, or nullopt if the block isn't recent.
+	//
+	std::optional<uint64_t> GetCachedTransactions(const Hash& blockHash, std::vector<TransactionPtr>& transactions) const;
+
+	void AddPending(const CompactBlock& compactBlock, const uint64_t connectionId);
+	std::optional<CompactBlock> TakePending(const Hash& blockHash, const uint64_t connectionId);
+
+private:
+	struct RecentBlock
+	{
+		uint64_t nonce;
+		std::vector<TransactionPtr> transactions;
+		std::set<uint64_t> sentCompactTo;
+		std::optional<CompactBlock> pending;
+		uint64_t pendingConnectionId;
+		bool validated;
+		std::set<uint64_t> blockRequestedBy;
+	};
+
+	std::vector<uint64_t> SelectHighBandwidthPeers(const std::vector<Peer>& peers) const;
+	RecentBlock& GetRecentBlock(const Hash& blockHash, const uint64_t nonce);
+
+	static const size_t MAX_RECENT_BLOCKS = 16;
+
+	uint8_t m_maxHighBandwidthPeers;
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<Hash, RecentBlock> m_recentBlocks;
+	std::deque<Hash> m_recentBlockHashes; // Oldest first.
+	std::deque<uint64_t> m_recentDeliverers; // Connection ids of the peers that delivered the latest blocks, most recent first.
+};
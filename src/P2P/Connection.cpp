@@ -6,16 +6,66 @@
 #include "Seed/HandShake.h"
 
 #include <Net/SocketException.h>
-#include <Common/Util/ThreadUtil.h>
 #include <Common/Logger.h>
-#include <thread>
 #include <chrono>
 #include <memory>
 
+static const std::chrono::seconds CONNECT_TIMEOUT(5);
+static const std::chrono::seconds HANDSHAKE_TIMEOUT(10);
+
+// Bulk messages queued beyond this are dropped. The peer will re-request them from someone else.
+static const size_t MAX_BULK_BACKLOG = 32 * 1024 * 1024;
+
+static ESendPriority GetSendPriority(const MessageTypes::EMessageType messageType)
+{
+    switch (messageType) {
+        case MessageTypes::Error:
+        case MessageTypes::Hand:
+        case MessageTypes::Shake:
+        case MessageTypes::Ping:
+        case MessageTypes::Pong:
+        case MessageTypes::GetPeerAddrs:
+        case MessageTypes::PeerAddrs:
+        case MessageTypes::BanReasonMsg:
+            return ESendPriority::CONTROL;
+        case MessageTypes::StemTransaction:
+        case MessageTypes::TransactionMsg:
+        case MessageTypes::GetTransactionMsg:
+        case MessageTypes::TransactionKernelMsg:
+            return ESendPriority::TRANSACTION;
+        case MessageTypes::Block:
+        case MessageTypes::TxHashSetArchive:
+        case MessageTypes::OutputBitmapSegment:
+        case MessageTypes::OutputSegment:
+        case MessageTypes::RangeProofSegment:
+        case MessageTypes::KernelSegment:
+            return ESendPriority::BULK;
+        default:
+            // Headers, compact blocks, and requests.
+            return ESendPriority::LATENCY;
+    }
+}
+
+//
+// Starts connection setup, which continues on the socket's io_context:
+// connect (outbound only) -> hand/shake -> steady state, where messages are read until disconnected.
+//
 void Connection::Connect()
 {
-    std::thread connect_thr(Thread_Connect, shared_from_this());
-    ThreadUtil::Detach(connect_thr);
+    m_pTimer = std::make_unique<asio::steady_timer>(m_pSocket->GetAsioSocket()->get_executor());
+
+    if (GetDirection() == EDirection::OUTBOUND) {
+        StartTimeout(CONNECT_TIMEOUT);
+        m_pSocket->GetAsioSocket()->async_connect(
+            m_pSocket->GetEndpoint(),
+            std::bind(&Connection::HandleConnected, shared_from_this(), std::placeholders::_1)
+        );
+    } else {
+        asio::post(
+            m_pSocket->GetAsioSocket()->get_executor(),
+            std::bind(&Connection::StartHandshake, shared_from_this())
+        );
+    }
 }
 
 void Connection::Disconnect()
@@ -62,7 +112,17 @@ void Connection::SendAsync(const IMessage& message)
             );
         }
 
-        m_pSocket->SendAsync(serialized);
+        const ESendPriority priority = GetSendPriority(message.GetMessageType());
+        if (priority == ESendPriority::BULK && m_pSocket->GetQueuedBytes(ESendPriority::BULK) > MAX_BULK_BACKLOG) {
+            LOG_DEBUG_F(
+                "Dropping '{}' message to {}. Too much bulk data already queued.",
+                MessageTypes::ToString(message.GetMessageType()),
+                m_pSocket
+            );
+            return;
+        }
+
+        m_pSocket->SendAsync(std::move(serialized), priority);
     }
 }
 
@@ -72,73 +132,144 @@ bool Connection::ExceedsRateLimit() const
         || m_pSocket->GetRateCounter().GetReceivedInLastMinute() > 500;
 }
 
-void Connection::Thread_Connect(std::shared_ptr<Connection> pConnection)
+//
+// Closes the socket if the current setup stage doesn't complete in time, which aborts the pending operation.
+//
+void Connection::StartTimeout(const std::chrono::seconds& timeout)
 {
-    LoggerAPI::SetThreadName("PEER");
-
-    try {
-        if (pConnection->GetDirection() == EDirection::OUTBOUND) {
-            pConnection->ConnectOutbound();
+    m_pTimer->expires_after(timeout);
+    m_pTimer->async_wait([pConnection = shared_from_this()](const asio::error_code& ec) {
+        if (!ec) {
+            asio::error_code ignore;
+            pConnection->GetSocket()->GetAsioSocket()->close(ignore);
         }
+    });
+}
 
-        pConnection->GetSocket()->SetDefaultOptions();
-        pConnection->GetSocket()->SetBlocking(true);
-        
-        HandShake(pConnection->m_connectionManager, pConnection->m_pSyncStatus)
-            .PerformHandshake(pConnection->m_pSocket, pConnection->m_connectedPeer);
+void Connection::HandleConnected(const asio::error_code& ec)
+{
+    if (ec) {
+        m_pSocket->SetConnectFailed(true);
+        HandleConnectFailed(ec == asio::error::operation_aborted ? "No response" : ec.message());
+        return;
+    }
 
-        pConnection->m_lastPing = system_clock::now();
-        pConnection->m_lastReceived = system_clock::now();
+    m_pSocket->SetOpen(true);
+    StartHandshake();
+}
 
-        LOG_DEBUG_F("Connected to {}", pConnection->m_connectedPeer);
-        pConnection->GetPeer()->SetConnected(true);
-        pConnection->m_connectionManager.AddConnection(pConnection);
+void Connection::StartHandshake()
+{
+    if (m_terminate) {
+        HandleConnectFailed("Connection terminated");
+        return;
+    }
+
+    try {
+        m_pSocket->SetDefaultOptions();
+
+        LOG_TRACE_F(
+            "Performing handshake with {}({})",
+            m_pSocket,
+            (GetDirection() == EDirection::INBOUND ? "inbound" : "outbound")
+        );
 
-        if (pConnection->GetDirection() == EDirection::OUTBOUND) {
-            pConnection->SendSync(GetPeerAddressesMessage(Capabilities::ECapability::FAST_SYNC_NODE));
-            LOG_DEBUG_F("Capabilities sent to {}", pConnection->m_connectedPeer);
+        StartTimeout(HANDSHAKE_TIMEOUT);
+        if (GetDirection() == EDirection::OUTBOUND) {
+            m_pSocket->SendAsync(HandShake(m_connectionManager, m_pSyncStatus).BuildHandMessage(m_pSocket), ESendPriority::CONTROL);
         }
 
-        pConnection->m_received.resize(11);
+        m_received.resize(11);
         asio::async_read(
-            *pConnection->GetSocket()->GetAsioSocket(),
-            asio::buffer(pConnection->m_received, 11),
-            std::bind(&Connection::HandleReceivedHeader, pConnection, std::placeholders::_1, std::placeholders::_2)
+            *m_pSocket->GetAsioSocket(),
+            asio::buffer(m_received, 11),
+            std::bind(&Connection::HandleHandshakeHeader, shared_from_this(), std::placeholders::_1, std::placeholders::_2)
         );
     }
     catch (const std::exception& e) {
-        LOG_TRACE_F("Failed to connect to {}: {}", pConnection->m_connectedPeer, e);
+        HandleConnectFailed(e.what());
     }
 }
 
-void Connection::ConnectOutbound()
+void Connection::HandleHandshakeHeader(const asio::error_code& ec, const size_t bytes_received)
 {
-    auto pAsioSocket = m_pSocket->GetAsioSocket();
-    pAsioSocket->async_connect(
-        m_pSocket->GetEndpoint(),
-        std::bind(&Connection::HandleConnected, shared_from_this(), std::placeholders::_1)
-    );
-
-    auto timeout = std::chrono::system_clock::now() + std::chrono::seconds(1);
-    while (!m_pSocket->IsConnectFailed() && !m_pSocket->IsOpen() && system_clock::now() < timeout && Global::IsRunning()) {
-        ThreadUtil::SleepFor(std::chrono::milliseconds(5));
+    if (ec || bytes_received != 11) {
+        HandleConnectFailed(ec == asio::error::operation_aborted ? "Handshake timed out" : ec.message());
+        return;
     }
 
-    if (m_pSocket->IsConnectFailed() || !m_pSocket->IsOpen()) {
-        pAsioSocket->cancel();
-        throw std::runtime_error("No response");
+    try {
+        MessageHeader msg_header = ByteBuffer(m_received).Read<MessageHeader>();
+        LOG_TRACE_F("Received '{}' message from {}", msg_header, GetPeer());
+
+        m_received.clear();
+        m_received.resize(msg_header.GetLength());
+        asio::async_read(
+            *m_pSocket->GetAsioSocket(),
+            asio::buffer(m_received, m_received.size()),
+            std::bind(&Connection::HandleHandshakeBody, shared_from_this(), msg_header, std::placeholders::_1, std::placeholders::_2)
+        );
+    }
+    catch (const std::exception& e) {
+        HandleConnectFailed(e.what());
     }
 }
 
-void Connection::HandleConnected(const asio::error_code& ec)
+void Connection::HandleHandshakeBody(MessageHeader msg_header, const asio::error_code& ec, const size_t bytes_received)
 {
-    if (m_pSocket) {
-        if (!ec) {
-            m_pSocket->SetOpen(true);
+    if (ec || bytes_received != msg_header.GetLength()) {
+        HandleConnectFailed(ec == asio::error::operation_aborted ? "Handshake timed out" : ec.message());
+        return;
+    }
+
+    try {
+        GetPeer()->UpdateLastContactTime();
+
+        const RawMessage received(std::move(msg_header), std::move(m_received));
+        HandShake handshake(m_connectionManager, m_pSyncStatus);
+        if (GetDirection() == EDirection::OUTBOUND) {
+            handshake.ProcessShakeMessage(received, m_connectedPeer);
         } else {
-            m_pSocket->SetConnectFailed(true);
+            m_pSocket->SendAsync(handshake.ProcessHandMessage(received, m_connectedPeer), ESendPriority::CONTROL);
         }
+
+        m_pTimer->cancel();
+        HandleHandshakeComplete();
     }
+    catch (const std::exception& e) {
+        HandleConnectFailed(e.what());
+    }
+}
+
+void Connection::HandleHandshakeComplete()
+{
+    m_lastPing = system_clock::now();
+    m_lastReceived = system_clock::now();
+
+    LOG_DEBUG_F("Connected to {}", m_connectedPeer);
+    GetPeer()->SetConnected(true);
+    m_connectionManager.AddConnection(shared_from_this());
+
+    if (GetDirection() == EDirection::OUTBOUND) {
+        SendAsync(GetPeerAddressesMessage(Capabilities::ECapability::FAST_SYNC_NODE));
+        LOG_DEBUG_F("Capabilities sent to {}", m_connectedPeer);
+    }
+
+    m_received.clear();
+    m_received.resize(11);
+    asio::async_read(
+        *m_pSocket->GetAsioSocket(),
+        asio::buffer(m_received, 11),
+        std::bind(&Connection::HandleReceivedHeader, shared_from_this(), std::placeholders::_1, std::placeholders::_2)
+    );
+}
+
+void Connection::HandleConnectFailed(const std::string& reason)
+{
+    LOG_TRACE_F("Failed to connect to {}: {}", m_connectedPeer, reason);
+
+    m_pTimer->cancel();
+    Disconnect();
 }
 
 void Connection::HandleReceivedHeader(const asio::error_code& ec, const size_t bytes_received)
@@ -191,6 +322,9 @@ void Connection::HandleReceivedBody(MessageHeader msg_header, const asio::error_
             GetPeer()->UpdateLastContactTime();
             m_lastReceived = std::chrono::system_clock::now();
 
+            // Not counted towards the rate limit, since a syncing node can legitimately receive hundreds of blocks a minute.
+            m_pSocket->GetRateCounter().AddMessageReceived(11 + bytes_received, false);
+
             auto pMessageProcessor = m_pMessageProcessor.lock();
             if (pMessageProcessor != nullptr) {
                 RawMessage message(std::move(msg_header), std::move(m_received));
@@ -21,7 +21,9 @@ class MessageRetriever;
 
 //
 // A Connection will be created for each ConnectedPeer.
-// Each Connection will run on its own thread, and will watch the socket for messages,
+// Connecting, the hand/shake exchange, and reading messages all run as async operations on the seeder's asio context,
+// so connections don't need threads of their own. Each stage of setup is bounded by a timer.
+// Once established, the Connection will watch the socket for messages,
 // and will ping the peer when it hasn't been heard from in a while.
 //
 class Connection : public Traits::IPrintable, public std::enable_shared_from_this<Connection>
@@ -89,13 +91,16 @@ public:
 	void AdvertisedBlock(const Hash& hash) { return m_advertisedBlocks.Put(hash, hash); }
 
 private:
-	static void Thread_Connect(std::shared_ptr<Connection> pConnection);
+	void StartTimeout(const std::chrono::seconds& timeout);
 	void HandleConnected(const asio::error_code& ec);
+	void StartHandshake();
+	void HandleHandshakeHeader(const asio::error_code& ec, const size_t bytes_received);
+	void HandleHandshakeBody(MessageHeader msg_header, const asio::error_code& ec, const size_t bytes_received);
+	void HandleHandshakeComplete();
+	void HandleConnectFailed(const std::string& reason);
 	void HandleReceivedHeader(const asio::error_code& ec, const size_t bytes_received);
 	void HandleReceivedBody(MessageHeader msg_header, const asio::error_code& ec, const size_t bytes_received);
 
-	void ConnectOutbound();
-
 	ConnectionManager& m_connectionManager;
 	SyncStatusConstPtr m_pSyncStatus;
 	std::weak_ptr<MessageProcessor> m_pMessageProcessor;
@@ -107,7 +112,7 @@ private:
 	std::atomic<bool> m_terminate;
 	std::atomic<bool> m_sendingDisabled;
 	std::atomic<bool> m_receivingDisabled;
-	std::thread m_connectionThread;
+	std::unique_ptr<asio::steady_timer> m_pTimer;
 	const uint64_t m_connectionId;
 	ConnectedPeer m_connectedPeer;
 	mutable SocketPtr m_pSocket;
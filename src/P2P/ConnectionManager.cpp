@@ -15,6 +15,7 @@
 
 ConnectionManager::ConnectionManager()
 	: m_connections(std::make_shared<std::vector<ConnectionPtr>>()),
+	m_pSyncEvents(std::make_shared<SyncEvents>()),
 	m_numOutbound(0),
 	m_numInbound(0)
 {
@@ -48,9 +49,35 @@ std::shared_ptr<ConnectionManager> ConnectionManager::Create()
 {
 	auto pConnectionManager = std::shared_ptr<ConnectionManager>(new ConnectionManager());
 	pConnectionManager->m_pingThread = std::thread(ThreadPing, std::ref(*pConnectionManager));
+
+	std::weak_ptr<ConnectionManager> pWeak = pConnectionManager;
+	pConnectionManager->m_pMetricsCollector = Metrics::Registry::Get().AddCollector([pWeak](Metrics::Writer& writer) {
+		auto pManager = pWeak.lock();
+		if (pManager != nullptr) {
+			pManager->CollectMetrics(writer);
+		}
+	});
+
 	return pConnectionManager;
 }
 
+void ConnectionManager::CollectMetrics(Metrics::Writer& writer) const
+{
+	writer.AddGauge("grinpp_p2p_connections", "Connected peers", { { "direction", "inbound" } }, (double)m_numInbound);
+	writer.AddGauge("grinpp_p2p_connections", "Connected peers", { { "direction", "outbound" } }, (double)m_numOutbound);
+
+	auto connections = m_connections.Read();
+	for (const ConnectionPtr& pConnection : *connections) {
+		const std::string peer = pConnection->GetIPAddress().Format();
+		const RateCounter& counter = pConnection->GetSocket()->GetRateCounter();
+
+		writer.AddCounter("grinpp_peer_messages_total", "P2P messages per connected peer", { { "peer", peer }, { "direction", "received" } }, (double)counter.GetTotalMessagesReceived());
+		writer.AddCounter("grinpp_peer_messages_total", "P2P messages per connected peer", { { "peer", peer }, { "direction", "sent" } }, (double)counter.GetTotalMessagesSent());
+		writer.AddCounter("grinpp_peer_bytes_total", "P2P bytes per connected peer", { { "peer", peer }, { "direction", "received" } }, (double)counter.GetTotalBytesReceived());
+		writer.AddCounter("grinpp_peer_bytes_total", "P2P bytes per connected peer", { { "peer", peer }, { "direction", "sent" } }, (double)counter.GetTotalBytesSent());
+	}
+}
+
 void ConnectionManager::UpdateSyncStatus(SyncStatus& syncStatus) const
 {
 	auto connections = m_connections.Read();
@@ -174,6 +201,7 @@ void ConnectionManager::AddConnection(ConnectionPtr pConnection)
 {
 	LOG_DEBUG("Adding connection: {}", pConnection->GetPeer());
 	m_connections.Write()->emplace_back(pConnection);
+	m_pSyncEvents->Notify(SyncEvents::EEvent::PEER_CONNECTED);
 }
 
 ConnectionPtr ConnectionManager::GetConnection(const uint64_t connectionId) const
@@ -192,6 +220,7 @@ void ConnectionManager::PruneConnections(const bool bInactiveOnly)
 {
 	auto connectionsWriter = m_connections.Write();
 	std::vector<ConnectionPtr>& connections = *connectionsWriter;
+	const size_t numConnections = connections.size();
 
 	for (auto iter = connections.begin(); iter < connections.end(); iter++) {
 		ConnectionPtr pConnection = *iter;
@@ -214,6 +243,10 @@ void ConnectionManager::PruneConnections(const bool bInactiveOnly)
 	);
 
 	m_numOutbound = connections.size() - m_numInbound;
+
+	if (connections.size() < numConnections) {
+		m_pSyncEvents->Notify(SyncEvents::EEvent::PEER_DISCONNECTED);
+	}
 }
 
 ConnectionPtr ConnectionManager::GetMostWorkPeer(const std::vector<ConnectionPtr>& connections) const
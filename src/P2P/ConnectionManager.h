@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Connection.h"
+#include "Sync/SyncEvents.h"
 
 #include <Common/ConcurrentQueue.h>
+#include <Common/Metrics.h>
 #include <Core/Traits/Lockable.h>
 #include <memory>
 #include <vector>
@@ -23,6 +25,7 @@ public:
 	size_t GetNumInbound() const { return m_numInbound; }
 	size_t GetNumOutbound() const { return m_numOutbound; }
 	size_t GetNumberOfActiveConnections() const { return m_connections.Read()->size(); }
+	const SyncEvents::Ptr& GetSyncEvents() const noexcept { return m_pSyncEvents; }
 
 	bool IsConnected(const IPAddress& address) const;
 	std::vector<PeerPtr> GetMostWorkPeers() const;
@@ -37,15 +40,19 @@ public:
 	void PruneConnections(const bool bInactiveOnly);
 	void AddConnection(ConnectionPtr pConnection);
 	ConnectionPtr GetConnection(const uint64_t connectionId) const;
+	std::vector<ConnectionPtr> GetConnections() const { return *m_connections.Read(); }
 
 private:
 	ConnectionManager();
 
 	ConnectionPtr GetMostWorkPeer(const std::vector<ConnectionPtr>& connections) const;
 	static void ThreadPing(ConnectionManager& connectionManager);
+	void CollectMetrics(Metrics::Writer& writer) const;
 	
 	Locked<std::vector<ConnectionPtr>> m_connections;
+	SyncEvents::Ptr m_pSyncEvents;
 	std::thread m_pingThread;
+	std::shared_ptr<Metrics::Collector> m_pMetricsCollector;
 
 	std::atomic<size_t> m_numOutbound;
 	std::atomic<size_t> m_numInbound;
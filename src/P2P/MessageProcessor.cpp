@@ -1,6 +1,7 @@
 #include "MessageProcessor.h"
 #include "BlockLocator.h"
 #include "ConnectionManager.h"
+#include "CompactBlockRelay.h"
 #include "Pipeline/Pipeline.h"
 
 // Network Messages
@@ -19,6 +20,8 @@
 #include "Messages/GetBlockMessage.h"
 #include "Messages/CompactBlockMessage.h"
 #include "Messages/GetCompactBlockMessage.h"
+#include "Messages/GetCompactTransactionsMessage.h"
+#include "Messages/CompactTransactionsMessage.h"
 
 // Transaction Messages
 #include "Messages/TransactionMessage.h"
@@ -40,6 +43,7 @@
 #include <Common/Util/FileUtil.h>
 #include <BlockChain/BlockChain.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
 #include <thread>
 #include <fstream>
 
@@ -52,11 +56,13 @@ MessageProcessor::MessageProcessor(
     Locked<PeerManager> peerManager,
     const IBlockChain::Ptr& pBlockChain,
     const std::shared_ptr<Pipeline>& pPipeline,
+    const std::shared_ptr<CompactBlockRelay>& pCompactBlockRelay,
     SyncStatusConstPtr pSyncStatus)
     : m_connectionManager(connectionManager),
     m_peerManager(peerManager),
     m_pBlockChain(pBlockChain),
     m_pPipeline(pPipeline),
+    m_pCompactBlockRelay(pCompactBlockRelay),
     m_pSyncStatus(pSyncStatus)
 {
 
@@ -106,7 +112,7 @@ void MessageProcessor::ProcessMessageInternal(const std::shared_ptr<Connection>&
 {
     const MessageHeader& header = rawMessage.GetMessageHeader();
     EProtocolVersion protocolVersion = pConnection->GetProtocolVersion();
-    ByteBuffer byteBuffer(rawMessage.GetPayload(), protocolVersion);
+    ByteBuffer byteBuffer(rawMessage.GetSharedPayload(), protocolVersion);
 
     switch (header.GetMessageType())
     {
@@ -192,6 +198,8 @@ void MessageProcessor::ProcessMessageInternal(const std::shared_ptr<Connection>&
 
             const EBlockChainStatus status = m_pBlockChain->AddBlockHeader(pBlockHeader);
             if (status == EBlockChainStatus::SUCCESS || status == EBlockChainStatus::ALREADY_EXISTS || status == EBlockChainStatus::ORPHANED) {
+                m_connectionManager.GetSyncEvents()->Notify(SyncEvents::EEvent::HEADERS_RECEIVED);
+
                 if (!m_pBlockChain->HasBlock(pBlockHeader->GetHeight(), pBlockHeader->GetHash())) {
                     LOG_TRACE_F("Valid header {} received from {}. Requesting compact block", *pBlockHeader, pConnection);
                     const GetCompactBlockMessage getCompactBlockMessage(pBlockHeader->GetHash());
@@ -215,6 +223,8 @@ void MessageProcessor::ProcessMessageInternal(const std::shared_ptr<Connection>&
             const EBlockChainStatus status = m_pBlockChain->AddBlockHeaders(blockHeaders);
             if (status == EBlockChainStatus::INVALID) {
                 pConnection->BanPeer(EBanReason::BadBlockHeader);
+            } else {
+                m_connectionManager.GetSyncEvents()->Notify(SyncEvents::EEvent::HEADERS_RECEIVED);
             }
 
             LOG_TRACE_F("Headers message from {} finished processing", pConnection);
@@ -224,6 +234,11 @@ void MessageProcessor::ProcessMessageInternal(const std::shared_ptr<Connection>&
         {
             const GetBlockMessage getBlockMessage = GetBlockMessage::Deserialize(byteBuffer);
             std::unique_ptr<FullBlock> pBlock = m_pBlockChain->GetBlockByHash(getBlockMessage.GetHash());
+            if (pBlock == nullptr && !m_pCompactBlockRelay->QueueBlockRequest(getBlockMessage.GetHash(), pConnection->GetId())) {
+                // Not a block we relayed early and are still validating, but it may have been stored since the lookup.
+                pBlock = m_pBlockChain->GetBlockByHash(getBlockMessage.GetHash());
+            }
+
             if (pBlock != nullptr) {
                 pConnection->SendAsync(BlockMessage{ std::move(*pBlock) });
             }
@@ -238,12 +253,12 @@ void MessageProcessor::ProcessMessageInternal(const std::shared_ptr<Connection>&
             LOG_TRACE_F("Block received: {}", block.GetHeight());
 
             if (m_pSyncStatus->GetStatus() == ESyncStatus::SYNCING_BLOCKS) {
-                m_pPipeline->ProcessBlock(*pConnection, block);
+                m_pPipeline->ProcessBlock(*pConnection, block, rawMessage.GetPayload().size());
             } else {
                 const EBlockChainStatus added = m_pBlockChain->AddBlock(block);
                 if (added == EBlockChainStatus::SUCCESS) {
-                    const HeaderMessage headerMessage(block.GetHeader());
-                    m_connectionManager.BroadcastMessage(headerMessage, pConnection->GetId());
+                    m_connectionManager.GetSyncEvents()->Notify(SyncEvents::EEvent::BLOCK_APPLIED);
+                    m_pCompactBlockRelay->RelayValidated(block.GetHeader(), pConnection->GetId());
                 } else if (added == EBlockChainStatus::ORPHANED) {
                     if (block.GetTotalDifficulty() > m_pBlockChain->GetTotalDifficulty(EChainType::CONFIRMED))
                     {
@@ -268,29 +283,32 @@ void MessageProcessor::ProcessMessageInternal(const std::shared_ptr<Connection>&
         case CompactBlockMsg:
         {
             const CompactBlockMessage compactBlockMessage = CompactBlockMessage::Deserialize(byteBuffer);
-            const CompactBlock& compactBlock = compactBlockMessage.GetCompactBlock();
-
-            const EBlockChainStatus added = m_pBlockChain->AddCompactBlock(compactBlock);
-            if (added == EBlockChainStatus::SUCCESS)
-            {
-                const HeaderMessage headerMessage(compactBlock.GetHeader());
-                m_connectionManager.BroadcastMessage(headerMessage, pConnection->GetId());
-                break;
-            }
-            else if (added == EBlockChainStatus::TRANSACTIONS_MISSING)
-            {
-                pConnection->SendAsync(GetBlockMessage{ compactBlock.GetHash() });
-                break;
-            }
-            else if (added == EBlockChainStatus::ORPHANED)
-            {
-                if (compactBlock.GetHeight() < (m_pBlockChain->GetHeight(EChainType::CONFIRMED) + 100))
-                {
-                    if (compactBlock.GetTotalDifficulty() > m_pBlockChain->GetTotalDifficulty(EChainType::CONFIRMED))
-                    {
-                        pConnection->SendAsync(GetCompactBlockMessage{ compactBlock.GetPreviousHash() });
-                    }
-                }
+            ProcessCompactBlock(pConnection, compactBlockMessage.GetCompactBlock(), {}, false);
+            break;
+        }
+        case GetCompactTransactions:
+        {
+            const GetCompactTransactionsMessage message = GetCompactTransactionsMessage::Deserialize(byteBuffer);
+            std::vector<TransactionPtr> transactions = m_pCompactBlockRelay->FindTransactions(message.GetBlockHash(), message.GetShortIds());
+
+            LOG_DEBUG_F(
+                "Sending {} of {} requested txs for block {} to {}",
+                transactions.size(),
+                message.GetShortIds().size(),
+                message.GetBlockHash(),
+                pConnection
+            );
+            pConnection->SendAsync(CompactTransactionsMessage{ message.GetBlockHash(), std::move(transactions) });
+            break;
+        }
+        case CompactTransactions:
+        {
+            const CompactTransactionsMessage message = CompactTransactionsMessage::Deserialize(byteBuffer);
+            std::optional<CompactBlock> pendingOpt = m_pCompactBlockRelay->TakePending(message.GetBlockHash(), pConnection->GetId());
+            if (pendingOpt.has_value()) {
+                ProcessCompactBlock(pConnection, pendingOpt.value(), message.GetTransactions(), true);
+            } else {
+                LOG_DEBUG_F("Ignoring unrequested txs for block {} from {}", message.GetBlockHash(), pConnection);
             }
 
             break;
@@ -432,4 +450,80 @@ void MessageProcessor::ProcessMessageInternal(const std::shared_ptr<Connection>&
     }
 
     return;
-}
\ No newline at end of file
+}
+
+void MessageProcessor::ProcessCompactBlock(
+    const std::shared_ptr<Connection>& pConnection,
+    const CompactBlock& compactBlock,
+    const std::vector<TransactionPtr>& requestedTxs,
+    const bool fromRequest)
+{
+    static Metrics::Counter& s_hydrated = Metrics::Registry::Get().AddCounter(
+        "grinpp_p2p_compact_blocks_total",
+        "Compact block relay events",
+        { { "event", "hydrated" } }
+    );
+    static Metrics::Counter& s_requestedMissing = Metrics::Registry::Get().AddCounter(
+        "grinpp_p2p_compact_blocks_total",
+        "Compact block relay events",
+        { { "event", "requested_missing" } }
+    );
+    static Metrics::Counter& s_fullBlockFallback = Metrics::Registry::Get().AddCounter(
+        "grinpp_p2p_compact_blocks_total",
+        "Compact block relay events",
+        { { "event", "full_block_fallback" } }
+    );
+
+    // The header's proof of work is all that's checked before relaying to high-bandwidth peers.
+    // Hydrating and validating the rest of the block happens while it's already on its way.
+    if (!fromRequest && m_pSyncStatus->GetStatus() == ESyncStatus::NOT_SYNCING) {
+        const EBlockChainStatus headerStatus = m_pBlockChain->AddBlockHeader(compactBlock.GetHeader());
+        if (headerStatus == EBlockChainStatus::INVALID) {
+            pConnection->BanPeer(EBanReason::BadBlockHeader);
+            return;
+        }
+
+        if (headerStatus == EBlockChainStatus::SUCCESS || headerStatus == EBlockChainStatus::ALREADY_EXISTS) {
+            if (compactBlock.GetTotalDifficulty() > m_pBlockChain->GetTotalDifficulty(EChainType::CONFIRMED)) {
+                m_pCompactBlockRelay->RelayEarly(compactBlock, pConnection->GetId());
+            }
+        }
+    }
+
+    // Looked up here rather than left to the hydrator, so they can still be served once the block removes them from the mempool.
+    std::vector<TransactionPtr> transactions = requestedTxs;
+    const std::set<ShortId> missingShortIds = CompactBlockRelay::GetMissingShortIds(compactBlock, transactions);
+    if (!missingShortIds.empty()) {
+        const std::vector<TransactionPtr> pooled = m_pBlockChain->GetTransactionsByShortId(
+            compactBlock.GetHash(),
+            compactBlock.GetNonce(),
+            missingShortIds
+        );
+        transactions.insert(transactions.end(), pooled.cbegin(), pooled.cend());
+    }
+
+    const EBlockChainStatus added = m_pBlockChain->AddCompactBlock(compactBlock, transactions);
+    if (added == EBlockChainStatus::SUCCESS) {
+        s_hydrated.Increment();
+        m_connectionManager.GetSyncEvents()->Notify(SyncEvents::EEvent::BLOCK_APPLIED);
+        m_pCompactBlockRelay->CacheTransactions(compactBlock, transactions);
+        m_pCompactBlockRelay->RelayValidated(compactBlock.GetHeader(), pConnection->GetId());
+    } else if (added == EBlockChainStatus::TRANSACTIONS_MISSING) {
+        std::set<ShortId> stillMissing = CompactBlockRelay::GetMissingShortIds(compactBlock, transactions);
+        if (!stillMissing.empty() && !fromRequest && pConnection->GetCapabilities().HasCapability(Capabilities::COMPACT_BLOCK_RELAY)) {
+            LOG_DEBUG_F("Requesting {} missing txs for block {} from {}", stillMissing.size(), compactBlock.GetHash(), pConnection);
+            s_requestedMissing.Increment();
+            m_pCompactBlockRelay->AddPending(compactBlock, pConnection->GetId());
+            pConnection->SendAsync(GetCompactTransactionsMessage{ compactBlock.GetHash(), std::move(stillMissing) });
+        } else {
+            s_fullBlockFallback.Increment();
+            pConnection->SendAsync(GetBlockMessage{ compactBlock.GetHash() });
+        }
+    } else if (added == EBlockChainStatus::ORPHANED) {
+        if (compactBlock.GetHeight() < (m_pBlockChain->GetHeight(EChainType::CONFIRMED) + 100)) {
+            if (compactBlock.GetTotalDifficulty() > m_pBlockChain->GetTotalDifficulty(EChainType::CONFIRMED)) {
+                pConnection->SendAsync(GetCompactBlockMessage{ compactBlock.GetPreviousHash() });
+            }
+        }
+    }
+}
@@ -12,6 +12,8 @@ class ConnectionManager;
 class Connection;
 class RawMessage;
 class Pipeline;
+class CompactBlock;
+class CompactBlockRelay;
 class TxHashSetArchiveMessage;
 class TxHashSetRequestMessage;
 
@@ -34,6 +36,7 @@ public:
 		Locked<PeerManager> peerManager,
 		const IBlockChain::Ptr& pBlockChain,
 		const std::shared_ptr<Pipeline>& pipeline,
+		const std::shared_ptr<CompactBlockRelay>& pCompactBlockRelay,
 		SyncStatusConstPtr pSyncStatus
 	);
 
@@ -42,9 +45,21 @@ public:
 private:
 	void ProcessMessageInternal(const std::shared_ptr<Connection>& pConnection, const RawMessage& rawMessage);
 
+	//
+	// Relays, hydrates, and adds a compact block. requestedTxs are the txs the peer sent back for its missing short ids,
+	// in which case fromRequest is set, and the block isn't relayed early or asked about again.
+	//
+	void ProcessCompactBlock(
+		const std::shared_ptr<Connection>& pConnection,
+		const CompactBlock& compactBlock,
+		const std::vector<TransactionPtr>& requestedTxs,
+		const bool fromRequest
+	);
+
 	ConnectionManager& m_connectionManager;
 	Locked<PeerManager> m_peerManager;
 	IBlockChain::Ptr m_pBlockChain;
 	std::shared_ptr<Pipeline> m_pPipeline;
+	std::shared_ptr<CompactBlockRelay> m_pCompactBlockRelay;
 	SyncStatusConstPtr m_pSyncStatus;
 };
\ No newline at end of file
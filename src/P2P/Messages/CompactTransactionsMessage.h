@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Message.h"
+
+#include <Core/Exceptions/DeserializationException.h>
+#include <Core/Models/Transaction.h>
+#include <Crypto/Models/Hash.h>
+
+//
+// Response to a GetCompactTransactionsMessage, with whichever of the requested txs the peer could find.
+//
+class CompactTransactionsMessage : public IMessage
+{
+public:
+	//
+	// Constructors
+	//
+	CompactTransactionsMessage(const Hash& blockHash, std::vector<TransactionPtr>&& transactions)
+		: m_blockHash(blockHash), m_transactions(std::move(transactions))
+	{
+
+	}
+	CompactTransactionsMessage(const CompactTransactionsMessage& other) = default;
+	CompactTransactionsMessage(CompactTransactionsMessage&& other) noexcept = default;
+
+	//
+	// Destructor
+	//
+	virtual ~CompactTransactionsMessage() = default;
+
+	//
+	// Operators
+	//
+	CompactTransactionsMessage& operator=(const CompactTransactionsMessage& other) = default;
+	CompactTransactionsMessage& operator=(CompactTransactionsMessage&& other) noexcept = default;
+
+	//
+	// Clone
+	//
+	IMessagePtr Clone() const final { return IMessagePtr(new CompactTransactionsMessage(*this)); }
+
+	//
+	// Getters
+	//
+	MessageTypes::EMessageType GetMessageType() const final { return MessageTypes::CompactTransactions; }
+	const Hash& GetBlockHash() const { return m_blockHash; }
+	const std::vector<TransactionPtr>& GetTransactions() const { return m_transactions; }
+
+	//
+	// Deserialization
+	//
+	static CompactTransactionsMessage Deserialize(ByteBuffer& byteBuffer)
+	{
+		Hash blockHash = byteBuffer.ReadBigInteger<32>();
+
+		// Even an empty tx takes an offset and 3 counts.
+		const uint64_t numTransactions = byteBuffer.ReadU64();
+		if (numTransactions > byteBuffer.GetRemainingSize() / 56)
+		{
+			throw DESERIALIZATION_EXCEPTION_F("Message can't hold {} txs", numTransactions);
+		}
+
+		std::vector<TransactionPtr> transactions;
+		transactions.reserve((size_t)numTransactions);
+		for (uint64_t i = 0; i < numTransactions; i++)
+		{
+			transactions.push_back(std::make_shared<Transaction>(Transaction::Deserialize(byteBuffer)));
+		}
+
+		return CompactTransactionsMessage(blockHash, std::move(transactions));
+	}
+
+protected:
+	void SerializeBody(Serializer& serializer) const final
+	{
+		serializer.AppendBigInteger<32>(m_blockHash);
+		serializer.Append<uint64_t>(m_transactions.size());
+		for (const TransactionPtr& pTransaction : m_transactions)
+		{
+			pTransaction->Serialize(serializer);
+		}
+	}
+
+private:
+	Hash m_blockHash;
+	std::vector<TransactionPtr> m_transactions;
+};
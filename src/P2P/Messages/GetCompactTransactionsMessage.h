@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Message.h"
+
+#include <Core/Exceptions/DeserializationException.h>
+#include <Core/Models/ShortId.h>
+#include <Crypto/Models/Hash.h>
+#include <set>
+
+//
+// Requests just the txs a compact block couldn't be hydrated with, by their kernel short ids,
+// instead of falling back to the full block.
+// Only sent to peers with the COMPACT_BLOCK_RELAY capability.
+//
+class GetCompactTransactionsMessage : public IMessage
+{
+public:
+	//
+	// Constructors
+	//
+	GetCompactTransactionsMessage(const Hash& blockHash, std::set<ShortId>&& shortIds)
+		: m_blockHash(blockHash), m_shortIds(std::move(shortIds))
+	{
+
+	}
+	GetCompactTransactionsMessage(const GetCompactTransactionsMessage& other) = default;
+	GetCompactTransactionsMessage(GetCompactTransactionsMessage&& other) noexcept = default;
+
+	//
+	// Destructor
+	//
+	virtual ~GetCompactTransactionsMessage() = default;
+
+	//
+	// Operators
+	//
+	GetCompactTransactionsMessage& operator=(const GetCompactTransactionsMessage& other) = default;
+	GetCompactTransactionsMessage& operator=(GetCompactTransactionsMessage&& other) noexcept = default;
+
+	//
+	// Clone
+	//
+	IMessagePtr Clone() const final { return IMessagePtr(new GetCompactTransactionsMessage(*this)); }
+
+	//
+	// Getters
+	//
+	MessageTypes::EMessageType GetMessageType() const final { return MessageTypes::GetCompactTransactions; }
+	const Hash& GetBlockHash() const { return m_blockHash; }
+	const std::set<ShortId>& GetShortIds() const { return m_shortIds; }
+
+	//
+	// Deserialization
+	//
+	static GetCompactTransactionsMessage Deserialize(ByteBuffer& byteBuffer)
+	{
+		Hash blockHash = byteBuffer.ReadBigInteger<32>();
+
+		const uint64_t numShortIds = byteBuffer.ReadU64();
+		if (numShortIds > byteBuffer.GetRemainingSize() / 6)
+		{
+			throw DESERIALIZATION_EXCEPTION_F("Message can't hold {} short ids", numShortIds);
+		}
+
+		std::set<ShortId> shortIds;
+		for (uint64_t i = 0; i < numShortIds; i++)
+		{
+			shortIds.insert(ShortId::Deserialize(byteBuffer));
+		}
+
+		return GetCompactTransactionsMessage(blockHash, std::move(shortIds));
+	}
+
+protected:
+	void SerializeBody(Serializer& serializer) const final
+	{
+		serializer.AppendBigInteger<32>(m_blockHash);
+		serializer.Append<uint64_t>(m_shortIds.size());
+		for (const ShortId& shortId : m_shortIds)
+		{
+			shortId.Serialize(serializer);
+		}
+	}
+
+private:
+	Hash m_blockHash;
+	std::set<ShortId> m_shortIds;
+};
@@ -36,7 +36,9 @@ namespace MessageTypes
         GetRangeProofSegment = 25,
         RangeProofSegment = 26,
         GetKernelSegment = 27,
-        KernelSegment = 28
+        KernelSegment = 28,
+        GetCompactTransactions = 29,
+        CompactTransactions = 30
     };
 
     static uint64_t GetMaximumSize(const EMessageType messageType)
@@ -95,6 +97,10 @@ namespace MessageTypes
             case RangeProofSegment:
             case KernelSegment:
                 return 2 * P2P::MAX_BLOCK_SIZE;
+            case GetCompactTransactions:
+                return 40 + P2P::MAX_BLOCK_SIZE / 10;
+            case CompactTransactions:
+                return 40 + P2P::MAX_BLOCK_SIZE;
         }
 
         return 0;
@@ -162,6 +168,10 @@ namespace MessageTypes
                 return "Msg::GetKernelSegment";
             case KernelSegment:
                 return "Msg::KernelSegment";
+            case GetCompactTransactions:
+                return "Msg::GetCompactTransactions";
+            case CompactTransactions:
+                return "Msg::CompactTransactions";
         }
 
         return "UNKNOWN";
@@ -2,6 +2,8 @@
 
 #include "MessageHeader.h"
 
+#include <Core/Serialization/ByteSlice.h>
+#include <memory>
 #include <vector>
 
 class RawMessage : public Traits::IPrintable
@@ -11,7 +13,7 @@ public:
 	// Constructors
 	//
 	RawMessage(MessageHeader&& messageHeader, std::vector<unsigned char>&& payload)
-		: m_header(messageHeader), m_payload(std::move(payload))
+		: m_header(messageHeader), m_pPayload(std::make_shared<const std::vector<unsigned char>>(std::move(payload)))
 	{
 
 	}
@@ -34,7 +36,10 @@ public:
 	//
 	const MessageHeader& GetMessageHeader() const { return m_header; }
 	MessageTypes::EMessageType GetMessageType() const { return m_header.GetMessageType(); }
-	const std::vector<unsigned char>& GetPayload() const { return m_payload; }
+	const std::vector<unsigned char>& GetPayload() const { return *m_pPayload; }
+
+	// Deserialize from this, so large objects like blocks can reference the payload rather than copy it.
+	const ByteSlice::Buffer& GetSharedPayload() const { return m_pPayload; }
 
 	std::string Format() const noexcept final
 	{
@@ -43,5 +48,5 @@ public:
 
 private:
 	MessageHeader m_header;
-	std::vector<unsigned char> m_payload;
+	ByteSlice::Buffer m_pPayload;
 };
\ No newline at end of file
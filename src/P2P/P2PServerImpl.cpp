@@ -15,14 +15,16 @@ P2PServer::P2PServer(
 	std::shared_ptr<Pipeline> pPipeline,
 	std::unique_ptr<Seeder>&& pSeeder,
 	std::shared_ptr<Syncer> pSyncer,
-	std::shared_ptr<Dandelion> pDandelion)
+	std::shared_ptr<Dandelion> pDandelion,
+	std::shared_ptr<CompactBlockRelay> pCompactBlockRelay)
 	: m_pSyncStatus(pSyncStatus),
 	m_pPeerManager(pPeerManager),
 	m_pConnectionManager(pConnectionManager),
 	m_pPipeline(pPipeline),
 	m_pSeeder(std::move(pSeeder)),
 	m_pSyncer(pSyncer),
-	m_pDandelion(pDandelion)
+	m_pDandelion(pDandelion),
+	m_pCompactBlockRelay(pCompactBlockRelay)
 {
 
 }
@@ -66,12 +68,20 @@ std::shared_ptr<P2PServer> P2PServer::Create(
 		pSyncStatus
 	);
 
+	// Compact Block Relay
+	auto pCompactBlockRelay = std::make_shared<CompactBlockRelay>(
+		config,
+		*pConnectionManager,
+		pBlockChain
+	);
+
 	// Seeder
 	std::unique_ptr<Seeder> pSeeder = Seeder::Create(
 		*pConnectionManager,
 		*peerManager,
 		pBlockChain,
 		pPipeline,
+		pCompactBlockRelay,
 		pSyncStatus
 	);
 
@@ -101,7 +111,8 @@ std::shared_ptr<P2PServer> P2PServer::Create(
 		pPipeline,
 		std::move(pSeeder),
 		pSyncer,
-		pDandelion
+		pDandelion,
+		pCompactBlockRelay
 	));
 }
 
@@ -161,6 +172,12 @@ void P2PServer::BroadcastTransaction(const TransactionPtr& pTransaction)
 	}
 }
 
+void P2PServer::BroadcastBlock(const BlockHeaderPtr& pHeader)
+{
+	m_pConnectionManager->GetSyncEvents()->Notify(SyncEvents::EEvent::BLOCK_APPLIED);
+	m_pCompactBlockRelay->RelayValidated(pHeader, 0);
+}
+
 namespace P2PAPI
 {
 	std::shared_ptr<IP2PServer> StartP2PServer(
@@ -2,6 +2,7 @@
 
 #include "Dandelion.h"
 #include "ConnectionManager.h"
+#include "CompactBlockRelay.h"
 #include "Pipeline/Pipeline.h"
 #include "Sync/Syncer.h"
 #include "Seed/Seeder.h"
@@ -36,6 +37,7 @@ public:
 	bool UnbanAllPeers() final;
 
 	void BroadcastTransaction(const TransactionPtr& pTransaction) final;
+	void BroadcastBlock(const BlockHeaderPtr& pHeader) final;
 
 private:
 	P2PServer(
@@ -45,7 +47,8 @@ private:
 		std::shared_ptr<Pipeline> pPipeline,
 		std::unique_ptr<Seeder>&& pSeeder,
 		std::shared_ptr<Syncer> pSyncer,
-		std::shared_ptr<Dandelion> pDandelion
+		std::shared_ptr<Dandelion> pDandelion,
+		std::shared_ptr<CompactBlockRelay> pCompactBlockRelay
 	);
 
 	SyncStatusConstPtr m_pSyncStatus;
@@ -55,4 +58,5 @@ private:
 	std::unique_ptr<Seeder> m_pSeeder;
 	std::shared_ptr<Syncer> m_pSyncer;
 	std::shared_ptr<Dandelion> m_pDandelion;
+	std::shared_ptr<CompactBlockRelay> m_pCompactBlockRelay;
 };
\ No newline at end of file
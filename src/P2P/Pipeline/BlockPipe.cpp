@@ -6,25 +6,34 @@
 #include <Common/Logger.h>
 #include <BlockChain/BlockChain.h>
 
-BlockPipe::BlockPipe(const Config& config, const IBlockChain::Ptr& pBlockChain)
-	: m_config(config), m_pBlockChain(pBlockChain), m_terminate(false)
+BlockPipe::BlockPipe(const Config& config, const IBlockChain::Ptr& pBlockChain, const SyncEvents::Ptr& pSyncEvents)
+	: m_config(config), m_pBlockChain(pBlockChain), m_pSyncEvents(pSyncEvents), m_terminate(false)
 {
 }
 
 BlockPipe::~BlockPipe()
 {
 	m_terminate = true;
+	m_pSyncEvents->Notify(SyncEvents::EEvent::STOPPING);
 
 	ThreadUtil::Join(m_blockThread);
 	ThreadUtil::Join(m_processThread);
 }
 
-std::shared_ptr<BlockPipe> BlockPipe::Create(const Config& config, const IBlockChain::Ptr& pBlockChain)
+std::shared_ptr<BlockPipe> BlockPipe::Create(const Config& config, const IBlockChain::Ptr& pBlockChain, const SyncEvents::Ptr& pSyncEvents)
 {
-	std::shared_ptr<BlockPipe> pBlockPipe = std::shared_ptr<BlockPipe>(new BlockPipe(config, pBlockChain));
+	std::shared_ptr<BlockPipe> pBlockPipe = std::shared_ptr<BlockPipe>(new BlockPipe(config, pBlockChain, pSyncEvents));
 	pBlockPipe->m_blockThread = std::thread(Thread_ProcessNewBlocks, std::ref(*pBlockPipe.get()));
 	pBlockPipe->m_processThread = std::thread(Thread_PostProcessBlocks, std::ref(*pBlockPipe.get()));
 
+	std::weak_ptr<BlockPipe> pWeak = pBlockPipe;
+	pBlockPipe->m_pMetricsCollector = Metrics::Registry::Get().AddCollector([pWeak](Metrics::Writer& writer) {
+		auto pPipe = pWeak.lock();
+		if (pPipe != nullptr) {
+			writer.AddGauge("grinpp_pipeline_queue_depth", "Items waiting in a P2P processing pipe", { { "pipe", "block" } }, (double)pPipe->m_blocksToProcess.size());
+		}
+	});
+
 	return pBlockPipe;
 }
 
@@ -57,7 +66,7 @@ void BlockPipe::Thread_ProcessNewBlocks(BlockPipe& pipeline)
 		}
 		else
 		{
-			ThreadUtil::SleepFor(std::chrono::milliseconds(5));
+			pipeline.m_blocksToProcess.wait_for_items(std::chrono::milliseconds(250));
 		}
 	}
 
@@ -73,6 +82,11 @@ void BlockPipe::ProcessNewBlock(BlockPipe& pipeline, const BlockEntry& blockEntr
 		{
 			blockEntry.m_peer->Ban(EBanReason::BadBlock);
 		}
+		else if (status == EBlockChainStatus::SUCCESS)
+		{
+			// Orphans may now be processable, and the block syncer may be waiting to request more blocks.
+			pipeline.m_pSyncEvents->Notify(SyncEvents::EEvent::BLOCK_APPLIED);
+		}
 	}
 	catch (std::exception& e)
 	{
@@ -86,11 +100,18 @@ void BlockPipe::Thread_PostProcessBlocks(BlockPipe& pipeline)
 	LoggerAPI::SetThreadName("BLOCK_POSTPROCESS_PIPE");
 	LOG_TRACE("BEGIN");
 
+	// Orphans only become processable once their parent is applied, so sleep until a block is applied.
+	// Blocks relayed by peers or mined locally notify too. The timeout covers anything else, like API-submitted blocks.
+	SyncEvents::Cursor cursor;
 	while (!pipeline.m_terminate && Global::IsRunning())
 	{
-		if (!pipeline.m_pBlockChain->ProcessNextOrphanBlock())
+		if (pipeline.m_pBlockChain->ProcessNextOrphanBlock())
+		{
+			pipeline.m_pSyncEvents->Notify(SyncEvents::EEvent::BLOCK_APPLIED);
+		}
+		else
 		{
-			ThreadUtil::SleepFor(std::chrono::milliseconds(5));
+			pipeline.m_pSyncEvents->WaitFor(cursor, { SyncEvents::EEvent::BLOCK_APPLIED }, std::chrono::seconds(1));
 		}
 	}
 
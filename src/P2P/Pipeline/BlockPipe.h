@@ -1,10 +1,13 @@
 #pragma once
 
+#include "../Sync/SyncEvents.h"
+
 #include <Crypto/Models/Hash.h>
 #include <P2P/Peer.h>
 #include <Core/Models/FullBlock.h>
 #include <BlockChain/BlockChain.h>
 #include <Common/ConcurrentQueue.h>
+#include <Common/Metrics.h>
 #include <string>
 #include <cstdint>
 #include <atomic>
@@ -20,7 +23,8 @@ class BlockPipe
 public:
 	static std::shared_ptr<BlockPipe> Create(
 		const Config& config,
-		const IBlockChain::Ptr& pBlockChain
+		const IBlockChain::Ptr& pBlockChain,
+		const SyncEvents::Ptr& pSyncEvents
 	);
 	~BlockPipe();
 
@@ -28,10 +32,11 @@ public:
 	bool IsProcessingBlock(const Hash& hash) const;
 
 private:
-	BlockPipe(const Config& config, const IBlockChain::Ptr& pBlockChain);
+	BlockPipe(const Config& config, const IBlockChain::Ptr& pBlockChain, const SyncEvents::Ptr& pSyncEvents);
 
 	const Config& m_config;
 	IBlockChain::Ptr m_pBlockChain;
+	SyncEvents::Ptr m_pSyncEvents;
 
 	struct BlockEntry
 	{
@@ -56,4 +61,5 @@ private:
 	static void Thread_PostProcessBlocks(BlockPipe& pipeline);
 
 	std::atomic_bool m_terminate;
+	std::shared_ptr<Metrics::Collector> m_pMetricsCollector;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "BlockPipe.h"
 #include "TransactionPipe.h"
 #include "TxHashSetPipe.h"
+#include "../Sync/BlockDownloadScheduler.h"
 
 #include <P2P/SyncStatus.h>
 #include <BlockChain/BlockChain.h>
@@ -22,19 +23,26 @@ public:
 		const IBlockChain::Ptr& pBlockChain,
 		SyncStatusPtr pSyncStatus)
 	{
-		std::shared_ptr<BlockPipe> pBlockPipe = BlockPipe::Create(config, pBlockChain);
+		std::shared_ptr<BlockPipe> pBlockPipe = BlockPipe::Create(config, pBlockChain, pConnectionManager->GetSyncEvents());
 		std::shared_ptr<TransactionPipe> pTransactionPipe = TransactionPipe::Create(config, pConnectionManager, pBlockChain);
 		std::shared_ptr<TxHashSetPipe> pTxHashSetPipe = TxHashSetPipe::Create(pConnectionManager, pBlockChain, pSyncStatus);
 
-		return std::shared_ptr<Pipeline>(new Pipeline(pBlockPipe, pTransactionPipe, pTxHashSetPipe));
+		return std::shared_ptr<Pipeline>(new Pipeline(
+			pBlockPipe,
+			pTransactionPipe,
+			pTxHashSetPipe,
+			std::make_shared<BlockDownloadScheduler>()
+		));
 	}
 
 	std::shared_ptr<BlockPipe> GetBlockPipe() { return m_pBlockPipe; }
 	std::shared_ptr<TransactionPipe> GetTransactionPipe() { return m_pTransactionPipe; }
 	std::shared_ptr<TxHashSetPipe> GetTxHashSetPipe() { return m_pTxHashSetPipe; }
+	BlockDownloadScheduler::Ptr GetBlockDownloads() { return m_pBlockDownloads; }
 
-	void ProcessBlock(Connection& connection, const FullBlock& block)
+	void ProcessBlock(Connection& connection, const FullBlock& block, const size_t numBytes)
 	{
+		m_pBlockDownloads->OnBlockReceived(connection.GetPeer(), block.GetHash(), numBytes);
 		m_pBlockPipe->AddBlockToProcess(connection.GetPeer(), block);
 	}
 
@@ -57,10 +65,12 @@ private:
 	Pipeline(
 		std::shared_ptr<BlockPipe> pBlockPipe,
 		std::shared_ptr<TransactionPipe> pTransactionPipe,
-		std::shared_ptr<TxHashSetPipe> pTxHashSetPipe)
+		std::shared_ptr<TxHashSetPipe> pTxHashSetPipe,
+		BlockDownloadScheduler::Ptr pBlockDownloads)
 		: m_pBlockPipe(pBlockPipe),
 		m_pTransactionPipe(pTransactionPipe),
-		m_pTxHashSetPipe(pTxHashSetPipe)
+		m_pTxHashSetPipe(pTxHashSetPipe),
+		m_pBlockDownloads(pBlockDownloads)
 	{
 
 	}
@@ -68,4 +78,5 @@ private:
 	std::shared_ptr<BlockPipe> m_pBlockPipe;
 	std::shared_ptr<TransactionPipe> m_pTransactionPipe;
 	std::shared_ptr<TxHashSetPipe> m_pTxHashSetPipe;
+	BlockDownloadScheduler::Ptr m_pBlockDownloads;
 };
\ No newline at end of file
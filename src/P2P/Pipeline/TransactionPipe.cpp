@@ -27,6 +27,14 @@ std::shared_ptr<TransactionPipe> TransactionPipe::Create(
 	std::shared_ptr<TransactionPipe> pTxPipe = std::shared_ptr<TransactionPipe>(new TransactionPipe(config, pConnectionManager, pBlockChain));
 	pTxPipe->m_transactionThread = std::thread(Thread_ProcessTransactions, std::ref(*pTxPipe.get()));
 
+	std::weak_ptr<TransactionPipe> pWeak = pTxPipe;
+	pTxPipe->m_pMetricsCollector = Metrics::Registry::Get().AddCollector([pWeak](Metrics::Writer& writer) {
+		auto pPipe = pWeak.lock();
+		if (pPipe != nullptr) {
+			writer.AddGauge("grinpp_pipeline_queue_depth", "Items waiting in a P2P processing pipe", { { "pipe", "transaction" } }, (double)pPipe->m_transactionsToProcess.size());
+		}
+	});
+
 	return pTxPipe;
 }
 
@@ -63,7 +71,7 @@ void TransactionPipe::Thread_ProcessTransactions(TransactionPipe& pipeline)
 			}
 			else
 			{
-				ThreadUtil::SleepFor(std::chrono::milliseconds(5));
+				pipeline.m_transactionsToProcess.wait_for_items(std::chrono::milliseconds(250));
 			}
 		}
 		catch (std::exception& e)
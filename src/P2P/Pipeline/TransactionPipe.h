@@ -5,6 +5,7 @@
 #include <TxPool/PoolType.h>
 #include <Core/Models/Transaction.h>
 #include <Common/ConcurrentQueue.h>
+#include <Common/Metrics.h>
 #include <string>
 #include <cstdint>
 #include <atomic>
@@ -60,4 +61,5 @@ private:
 	ConcurrentQueue<TxEntry> m_transactionsToProcess;
 
 	std::atomic_bool m_terminate;
+	std::shared_ptr<Metrics::Collector> m_pMetricsCollector;
 };
\ No newline at end of file
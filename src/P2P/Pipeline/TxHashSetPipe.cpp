@@ -213,6 +213,16 @@ void TxHashSetPipe::Thread_SendTxHashSet(
 		const uint64_t fileSize = FileUtil::GetFileSize(zipFilePath);
 		file.seekg(0);
 
+		// The archive is written straight to the socket, so messages queued before sends were disabled must go out first.
+		const auto drainTimeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+		while (pConnection->GetSocket()->HasPendingSends()) {
+			if (std::chrono::steady_clock::now() >= drainTimeout || !Global::IsRunning()) {
+				throw std::runtime_error("Timed out waiting for queued messages to send");
+			}
+
+			ThreadUtil::SleepFor(std::chrono::milliseconds(10));
+		}
+
 		pConnection->SendSync(TxHashSetArchiveMessage{ pHeader->GetHash(), pHeader->GetHeight(), fileSize });
 
 		std::vector<uint8_t> buffer(BUFFER_SIZE, 0);
@@ -11,38 +11,30 @@
 
 static const uint64_t SELF_NONCE = CSPRNG::GenerateRandom(0, UINT64_MAX);
 
-void HandShake::PerformHandshake(const Socket::Ptr& pSocket, ConnectedPeer& connectedPeer) const
+std::vector<uint8_t> HandShake::BuildHandMessage(const Socket::Ptr& pSocket) const
 {
-    EDirection direction = connectedPeer.GetDirection();
-    LOG_TRACE_F(
-        "Performing handshake with {}({})",
-        pSocket,
-        (direction == EDirection::INBOUND ? "inbound" : "outbound")
+    IPAddress localHostIP = IPAddress::CreateV4({ 0x7F, 0x00, 0x00, 0x01 });
+    HandMessage hand(
+        P2P::PROTOCOL_VERSION,
+        Capabilities(Capabilities::FAST_SYNC_NODE | Capabilities::COMPACT_BLOCK_RELAY),
+        SELF_NONCE,
+        Global::GetGenesisHash(),
+        m_pSyncStatus->GetBlockDifficulty(),
+        SocketAddress(localHostIP, Global::GetConfig().GetP2PPort()),
+        SocketAddress(localHostIP, pSocket->GetPort()),
+        P2P::USER_AGENT
     );
 
-    if (direction == EDirection::OUTBOUND) {
-        PerformOutboundHandshake(pSocket, connectedPeer);
-    } else {
-        PerformInboundHandshake(pSocket, connectedPeer);
-    }
+    return hand.Serialize(ProtocolVersion::Local());
 }
 
-void HandShake::PerformOutboundHandshake(const Socket::Ptr& pSocket, ConnectedPeer& connectedPeer) const
+void HandShake::ProcessShakeMessage(const RawMessage& received, ConnectedPeer& connectedPeer) const
 {
-    // Send Hand Message
-    TransmitHandMessage(pSocket);
-
-    // Get Shake Message
-    auto pReceived = RetrieveMessage(pSocket, *connectedPeer.GetPeer());
-    if (pReceived == nullptr) {
-        throw PROTOCOL_EXCEPTION("Shake message not received");
-    }
-
-    if (pReceived->GetMessageType() != MessageTypes::Shake) {
-        throw PROTOCOL_EXCEPTION_F("Expected shake but received {}.", *pReceived);
+    if (received.GetMessageType() != MessageTypes::Shake) {
+        throw PROTOCOL_EXCEPTION_F("Expected shake but received {}.", received);
     }
 
-    ByteBuffer buffer(pReceived->GetPayload());
+    ByteBuffer buffer(received.GetSharedPayload());
     ShakeMessage shakeMessage = ShakeMessage::Deserialize(buffer);
 
     uint32_t version = (std::min)(P2P::PROTOCOL_VERSION, shakeMessage.GetVersion());
@@ -52,19 +44,13 @@ void HandShake::PerformOutboundHandshake(const Socket::Ptr& pSocket, ConnectedPe
     connectedPeer.UpdateTotals(shakeMessage.GetTotalDifficulty(), 0);
 }
 
-void HandShake::PerformInboundHandshake(const Socket::Ptr& pSocket, ConnectedPeer& connectedPeer) const
+std::vector<uint8_t> HandShake::ProcessHandMessage(const RawMessage& received, ConnectedPeer& connectedPeer) const
 {
-    // Get Hand Message
-    auto pReceived = RetrieveMessage(pSocket, *connectedPeer.GetPeer());
-    if (pReceived == nullptr) {
-        throw PROTOCOL_EXCEPTION("Hand message not received.");
-    }
-
-    if (pReceived->GetMessageType() != MessageTypes::Hand) {
-        throw PROTOCOL_EXCEPTION_F("Expected hand but received {}", *pReceived);
+    if (received.GetMessageType() != MessageTypes::Hand) {
+        throw PROTOCOL_EXCEPTION_F("Expected hand but received {}", received);
     }
 
-    ByteBuffer byteBuffer(pReceived->GetPayload());
+    ByteBuffer byteBuffer(received.GetSharedPayload());
     HandMessage hand_message = HandMessage::Deserialize(byteBuffer);
     
     if (hand_message.GetNonce() == SELF_NONCE) {
@@ -82,59 +68,18 @@ void HandShake::PerformInboundHandshake(const Socket::Ptr& pSocket, ConnectedPee
     uint32_t version = (std::min)(P2P::PROTOCOL_VERSION, hand_message.GetVersion());
     connectedPeer.UpdateVersion(version);
 
-    // Send Shake Message
-    TransmitShakeMessage(pSocket, version);
-}
-
-void HandShake::TransmitHandMessage(const Socket::Ptr& pSocket) const
-{
-    IPAddress localHostIP = IPAddress::CreateV4({ 0x7F, 0x00, 0x00, 0x01 });
-    HandMessage hand(
-        P2P::PROTOCOL_VERSION,
-        Capabilities::FAST_SYNC_NODE,
-        SELF_NONCE,
-        Global::GetGenesisHash(),
-        m_pSyncStatus->GetBlockDifficulty(),
-        SocketAddress(localHostIP, Global::GetConfig().GetP2PPort()),
-        SocketAddress(localHostIP, pSocket->GetPort()),
-        P2P::USER_AGENT
-    );
-
-    if (!pSocket->SendSync(hand.Serialize(ProtocolVersion::Local()), true)) {
-        throw PROTOCOL_EXCEPTION("Failed to send hand message.");
-    }
+    return BuildShakeMessage(version);
 }
 
-void HandShake::TransmitShakeMessage(const Socket::Ptr& pSocket, const uint32_t protocolVersion) const
+std::vector<uint8_t> HandShake::BuildShakeMessage(const uint32_t protocolVersion) const
 {
     ShakeMessage shakeMessage(
         protocolVersion,
-        Capabilities::FAST_SYNC_NODE,
+        Capabilities(Capabilities::FAST_SYNC_NODE | Capabilities::COMPACT_BLOCK_RELAY),
         Global::GetGenesisHash(),
         m_pSyncStatus->GetBlockDifficulty(),
         P2P::USER_AGENT
     );
 
-    if (!pSocket->SendSync(shakeMessage.Serialize(ProtocolVersion::ToEnum(protocolVersion)), true)) {
-        throw PROTOCOL_EXCEPTION("Failed to send shake message.");
-    }
+    return shakeMessage.Serialize(ProtocolVersion::ToEnum(protocolVersion));
 }
-
-std::unique_ptr<RawMessage> HandShake::RetrieveMessage(const Socket::Ptr& pSocket, const Peer& peer) const
-{
-    std::vector<uint8_t> headerBuffer = pSocket->ReceiveSync(11, true);
-    if (headerBuffer.size() != 11) {
-        return nullptr;
-    }
-
-    MessageHeader messageHeader = ByteBuffer(std::move(headerBuffer)).Read<MessageHeader>();
-    LOG_TRACE_F("Received '{}' message from {}", messageHeader, peer);
-
-    std::vector<uint8_t> payload = pSocket->ReceiveSync(messageHeader.GetMessageLength(), false);
-    if (payload.size() != messageHeader.GetMessageLength()) {
-        throw PROTOCOL_EXCEPTION("Expected payload not received");
-    }
-
-    peer.UpdateLastContactTime();
-    return std::make_unique<RawMessage>(std::move(messageHeader), std::move(payload));
-}
\ No newline at end of file
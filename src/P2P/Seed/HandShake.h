@@ -8,21 +8,26 @@
 // Forward Declarations
 class ConnectionManager;
 
+//
+// Builds and validates the hand/shake messages exchanged when a connection is established.
+// Reading and writing is left to the Connection, so the handshake can run asynchronously.
+//
+// Outbound: send BuildHandMessage(), then pass the reply to ProcessShakeMessage().
+// Inbound: pass the first message to ProcessHandMessage(), then send the shake it returns.
+//
 class HandShake
 {
 public:
 	HandShake(ConnectionManager& connectionManager, const SyncStatusConstPtr& pSyncStatus)
 		: m_connectionManager(connectionManager), m_pSyncStatus(pSyncStatus) { }
 
-	void PerformHandshake(const Socket::Ptr& pSocket, ConnectedPeer& connectedPeer) const;
+	std::vector<uint8_t> BuildHandMessage(const Socket::Ptr& pSocket) const;
+	void ProcessShakeMessage(const RawMessage& received, ConnectedPeer& connectedPeer) const;
+	std::vector<uint8_t> ProcessHandMessage(const RawMessage& received, ConnectedPeer& connectedPeer) const;
 
 private:
-	void PerformOutboundHandshake(const Socket::Ptr& pSocket, ConnectedPeer& connectedPeer) const;
-	void PerformInboundHandshake(const Socket::Ptr& pSocket, ConnectedPeer& connectedPeer) const;
-	void TransmitHandMessage(const Socket::Ptr& pSocket) const;
-	void TransmitShakeMessage(const Socket::Ptr& pSocket, const uint32_t protocolVersion) const;
-	std::unique_ptr<RawMessage> RetrieveMessage(const Socket::Ptr& pSocket, const Peer& peer) const;
+	std::vector<uint8_t> BuildShakeMessage(const uint32_t protocolVersion) const;
 
 	ConnectionManager& m_connectionManager;
 	SyncStatusConstPtr m_pSyncStatus;
-};
\ No newline at end of file
+};
@@ -31,6 +31,7 @@ std::unique_ptr<Seeder> Seeder::Create(
     Locked<PeerManager> peerManager,
     const IBlockChain::Ptr& pBlockChain,
     std::shared_ptr<Pipeline> pPipeline,
+    const std::shared_ptr<CompactBlockRelay>& pCompactBlockRelay,
     SyncStatusConstPtr pSyncStatus)
 {
     auto pMessageProcessor = std::make_shared<MessageProcessor>(
@@ -38,6 +39,7 @@ std::unique_ptr<Seeder> Seeder::Create(
         peerManager,
         pBlockChain,
         pPipeline,
+        pCompactBlockRelay,
         pSyncStatus
     );
     std::unique_ptr<Seeder> pSeeder(new Seeder(
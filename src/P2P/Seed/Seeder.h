@@ -16,6 +16,7 @@
 // Forward Declarations
 class PeerManager;
 class Pipeline;
+class CompactBlockRelay;
 
 class Seeder
 {
@@ -25,6 +26,7 @@ public:
 		Locked<PeerManager> peerManager,
 		const IBlockChain::Ptr& pBlockChain,
 		std::shared_ptr<Pipeline> pPipeline,
+		const std::shared_ptr<CompactBlockRelay>& pCompactBlockRelay,
 		SyncStatusConstPtr pSyncStatus
 	);
 	~Seeder();
@@ -0,0 +1,303 @@
+#include "BlockDownloadScheduler.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace std::chrono;
+
+static const milliseconds INITIAL_RESPONSE_TIME = milliseconds(2000);
+static const milliseconds BANDWIDTH_PERIOD = milliseconds(1000);
+static const double DEFAULT_BLOCK_SIZE = 16.0 * 1024;
+
+// Windows are sized to twice the bandwidth-delay product, so a peer's queue never runs dry between responses.
+static const double WINDOW_GAIN = 2.0;
+
+bool BlockDownloadScheduler::OnBlockReceived(const PeerPtr& pPeer, const Hash& blockHash, const size_t numBytes, const Clock::time_point now)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto request_iter = m_requests.find(blockHash);
+	if (request_iter == m_requests.end() || !(request_iter->second.PEER_ADDRESS == pPeer->GetIPAddress())) {
+		return false;
+	}
+
+	auto stats_iter = m_peers.find(pPeer->GetIPAddress());
+	if (stats_iter == m_peers.end()) {
+		m_requests.erase(request_iter);
+		return false;
+	}
+
+	PeerStats& stats = stats_iter->second;
+
+	const milliseconds elapsed = (std::max)(
+		duration_cast<milliseconds>(now - request_iter->second.SENT),
+		milliseconds(1)
+	);
+	stats.RESPONSE_TIME = (stats.RESPONSE_TIME * 7 + elapsed) / 8;
+	stats.MIN_RESPONSE_TIME = (std::min)(stats.MIN_RESPONSE_TIME, elapsed);
+
+	m_avgBlockSize = m_avgBlockSize == 0.0 ? (double)numBytes : ((m_avgBlockSize * 15) + numBytes) / 16;
+
+	stats.PERIOD_BYTES += numBytes;
+	const auto period = now - stats.PERIOD_START;
+	if (period >= BANDWIDTH_PERIOD) {
+		const double sample = stats.PERIOD_BYTES / duration<double>(period).count();
+		stats.BANDWIDTH = stats.BANDWIDTH == 0.0 ? sample : ((stats.BANDWIDTH * 3) + sample) / 4;
+		stats.PERIOD_START = now;
+		stats.PERIOD_BYTES = 0;
+	}
+
+	// Grow by at most one request per block received, so the window at most doubles per round trip.
+	// Until there's a bandwidth estimate, keep growing.
+	if (stats.BANDWIDTH == 0.0) {
+		stats.WINDOW = (std::min)(stats.WINDOW + 1, MAX_WINDOW);
+	} else {
+		const double bdp = stats.BANDWIDTH * duration<double>(stats.MIN_RESPONSE_TIME).count() / m_avgBlockSize;
+		const double target = (std::clamp)(bdp * WINDOW_GAIN, MIN_WINDOW, MAX_WINDOW);
+		if (stats.WINDOW < target) {
+			stats.WINDOW = (std::min)(stats.WINDOW + 1, target);
+		} else {
+			stats.WINDOW = (std::max)(stats.WINDOW - (1 / stats.WINDOW), target);
+		}
+	}
+
+	if (stats.IN_FLIGHT > 0) {
+		--stats.IN_FLIGHT;
+	}
+
+	++stats.BLOCKS_RECEIVED;
+	m_requests.erase(request_iter);
+
+	return true;
+}
+
+void BlockDownloadScheduler::OnRequestFailed(const Hash& blockHash)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	RemoveRequest(blockHash);
+}
+
+void BlockDownloadScheduler::OnBlocksApplied(const uint64_t height)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	std::vector<Hash> applied;
+	for (const auto& request : m_requests) {
+		if (request.second.BLOCK_HEIGHT <= height) {
+			applied.push_back(request.first);
+		}
+	}
+
+	for (const Hash& hash : applied) {
+		RemoveRequest(hash);
+	}
+}
+
+std::vector<BlockDownloadScheduler::Assignment> BlockDownloadScheduler::Schedule(
+	const uint64_t chainHeight,
+	const std::vector<std::pair<uint64_t, Hash>>& blocksNeeded,
+	const std::vector<PeerPtr>& peers,
+	const Clock::time_point now)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	// Drop peers that disconnected, were banned, or no longer have the most work.
+	// Their outstanding requests are forgotten, so the blocks get reassigned below.
+	std::unordered_set<IPAddress> active;
+	for (const PeerPtr& pPeer : peers) {
+		if (!pPeer->IsBanned()) {
+			active.insert(pPeer->GetIPAddress());
+			GetOrCreateStats(pPeer, now);
+		}
+	}
+
+	for (auto iter = m_requests.begin(); iter != m_requests.end();) {
+		if (active.find(iter->second.PEER_ADDRESS) == active.end()) {
+			iter = m_requests.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+
+	for (auto iter = m_peers.begin(); iter != m_peers.end();) {
+		if (active.find(iter->first) == active.end()) {
+			iter = m_peers.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+
+	std::vector<Assignment> assignments;
+	for (const auto& block : blocksNeeded) {
+		const uint64_t height = block.first;
+		const Hash& hash = block.second;
+		if (height > chainHeight + MAX_LOOKAHEAD) {
+			break;
+		}
+
+		const bool urgent = height <= chainHeight + URGENT_BLOCKS;
+
+		auto request_iter = m_requests.find(hash);
+		if (request_iter != m_requests.end()) {
+			const Request& request = request_iter->second;
+			PeerStats& current = m_peers.at(request.PEER_ADDRESS);
+			if (now - request.SENT < GetStallTimeout(current, height, chainHeight)) {
+				continue;
+			}
+
+			PeerStats* pBest = ChooseBestPeer(&request.PEER_ADDRESS, urgent);
+			if (pBest == nullptr) {
+				pBest = ChooseBestPeer(nullptr, urgent);
+				if (pBest == nullptr) {
+					continue;
+				}
+			}
+
+			++current.STALLS;
+			current.WINDOW = (std::max)(current.WINDOW / 2, MIN_WINDOW);
+			RemoveRequest(hash);
+
+			AddRequest(*pBest, height, hash, now);
+			assignments.push_back(Assignment{ pBest->PEER, height, hash });
+			continue;
+		}
+
+		PeerStats* pBest = ChooseBestPeer(nullptr, urgent);
+		if (pBest == nullptr) {
+			if (urgent) {
+				continue;
+			}
+
+			// Every peer's window is full.
+			break;
+		}
+
+		AddRequest(*pBest, height, hash, now);
+		assignments.push_back(Assignment{ pBest->PEER, height, hash });
+	}
+
+	return assignments;
+}
+
+bool BlockDownloadScheduler::IsRequested(const Hash& blockHash) const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_requests.find(blockHash) != m_requests.end();
+}
+
+size_t BlockDownloadScheduler::GetNumInFlight() const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_requests.size();
+}
+
+std::unique_ptr<BlockDownloadScheduler::PeerStats> BlockDownloadScheduler::GetPeerStats(const IPAddress& address) const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto iter = m_peers.find(address);
+	if (iter != m_peers.end()) {
+		return std::make_unique<PeerStats>(iter->second);
+	}
+
+	return nullptr;
+}
+
+BlockDownloadScheduler::PeerStats& BlockDownloadScheduler::GetOrCreateStats(const PeerPtr& pPeer, const Clock::time_point now)
+{
+	auto iter = m_peers.find(pPeer->GetIPAddress());
+	if (iter != m_peers.end()) {
+		iter->second.PEER = pPeer;
+		return iter->second;
+	}
+
+	PeerStats stats;
+	stats.PEER = pPeer;
+	stats.RESPONSE_TIME = INITIAL_RESPONSE_TIME;
+	stats.MIN_RESPONSE_TIME = INITIAL_RESPONSE_TIME;
+	stats.BANDWIDTH = 0.0;
+	stats.WINDOW = INITIAL_WINDOW;
+	stats.IN_FLIGHT = 0;
+	stats.PERIOD_START = now;
+	stats.PERIOD_BYTES = 0;
+	stats.BLOCKS_RECEIVED = 0;
+	stats.STALLS = 0;
+
+	return m_peers.insert({ pPeer->GetIPAddress(), std::move(stats) }).first->second;
+}
+
+//
+// The smoothed response time already includes time spent queued behind the peer's other requests,
+// so it's a fair estimate for any block in its window. Blocks right after the apply point get a
+// much shorter leash, since nothing can be applied until they arrive.
+//
+milliseconds BlockDownloadScheduler::GetStallTimeout(const PeerStats& stats, const uint64_t height, const uint64_t chainHeight) const
+{
+	if (height <= chainHeight + URGENT_BLOCKS) {
+		return (std::clamp)(stats.RESPONSE_TIME * 2, milliseconds(1000), milliseconds(10'000));
+	}
+
+	return (std::clamp)(stats.RESPONSE_TIME * 4, milliseconds(3000), milliseconds(30'000));
+}
+
+//
+// Picks the peer expected to deliver one more block soonest.
+// Urgent blocks may go over a peer's window.
+//
+BlockDownloadScheduler::PeerStats* BlockDownloadScheduler::ChooseBestPeer(const IPAddress* pExclude, const bool ignoreWindow)
+{
+	const double blockSize = m_avgBlockSize == 0.0 ? DEFAULT_BLOCK_SIZE : m_avgBlockSize;
+
+	PeerStats* pBest = nullptr;
+	double bestTime = 0.0;
+	for (auto& entry : m_peers) {
+		PeerStats& stats = entry.second;
+		if (pExclude != nullptr && entry.first == *pExclude) {
+			continue;
+		}
+
+		if (!ignoreWindow && stats.IN_FLIGHT >= (size_t)stats.WINDOW) {
+			continue;
+		}
+
+		double expected = 0.0;
+		if (stats.BANDWIDTH > 0.0) {
+			expected = duration<double>(stats.MIN_RESPONSE_TIME).count() + ((stats.IN_FLIGHT + 1) * blockSize / stats.BANDWIDTH);
+		} else {
+			expected = duration<double>(stats.RESPONSE_TIME).count() * (1 + (stats.IN_FLIGHT / stats.WINDOW));
+		}
+
+		if (pBest == nullptr || expected < bestTime) {
+			pBest = &stats;
+			bestTime = expected;
+		}
+	}
+
+	return pBest;
+}
+
+void BlockDownloadScheduler::RemoveRequest(const Hash& blockHash)
+{
+	auto request_iter = m_requests.find(blockHash);
+	if (request_iter == m_requests.end()) {
+		return;
+	}
+
+	auto stats_iter = m_peers.find(request_iter->second.PEER_ADDRESS);
+	if (stats_iter != m_peers.end() && stats_iter->second.IN_FLIGHT > 0) {
+		--stats_iter->second.IN_FLIGHT;
+	}
+
+	m_requests.erase(request_iter);
+}
+
+void BlockDownloadScheduler::AddRequest(PeerStats& stats, const uint64_t height, const Hash& blockHash, const Clock::time_point now)
+{
+	if (stats.IN_FLIGHT == 0) {
+		stats.PERIOD_START = now;
+		stats.PERIOD_BYTES = 0;
+	}
+
+	++stats.IN_FLIGHT;
+	m_requests[blockHash] = Request{ height, stats.PEER->GetIPAddress(), now };
+}
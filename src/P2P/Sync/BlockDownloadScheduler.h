@@ -0,0 +1,127 @@
+#pragma once
+
+#include <P2P/Peer.h>
+#include <Crypto/Models/Hash.h>
+#include <Net/IPAddress.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//
+// Decides which blocks to request from which peers during block sync.
+//
+// Each peer gets its own window of in-flight requests, sized from the bandwidth and the minimum
+// response time measured for that peer (its bandwidth-delay product), so fast or far-away peers
+// are kept busy while slow ones are never flooded.
+// Requests that take much longer than the peer's usual response time are considered stalled.
+// Stalled requests are handed to another peer, and the stalling peer's window is halved.
+// Requests close to the apply point are reassigned sooner than ones far ahead of it,
+// since they hold up block processing.
+//
+// Thread-safe. Blocks are reported as received from the connection threads, and scheduled from the sync thread.
+//
+class BlockDownloadScheduler
+{
+public:
+	using Ptr = std::shared_ptr<BlockDownloadScheduler>;
+	using Clock = std::chrono::steady_clock;
+
+	// How far past the confirmed tip blocks may be requested.
+	static constexpr uint64_t MAX_LOOKAHEAD = 512;
+
+	// Blocks this close to the apply point are reassigned as soon as they look stalled.
+	static constexpr uint64_t URGENT_BLOCKS = 16;
+
+	static constexpr double MIN_WINDOW = 2.0;
+	static constexpr double INITIAL_WINDOW = 8.0;
+	static constexpr double MAX_WINDOW = 128.0;
+
+	struct Assignment
+	{
+		PeerPtr PEER;
+		uint64_t BLOCK_HEIGHT;
+		Hash BLOCK_HASH;
+	};
+
+	struct PeerStats
+	{
+		PeerPtr PEER;
+
+		// Smoothed and minimum time between requesting a block and receiving it.
+		std::chrono::milliseconds RESPONSE_TIME;
+		std::chrono::milliseconds MIN_RESPONSE_TIME;
+
+		// Smoothed rate at which the peer delivers block data, in bytes/second.
+		double BANDWIDTH;
+
+		// Number of requests allowed in flight. Kept fractional so it can grow by less than one per block.
+		double WINDOW;
+		size_t IN_FLIGHT;
+
+		// Bandwidth is sampled over periods of at least a second, starting when the peer becomes busy.
+		Clock::time_point PERIOD_START;
+		size_t PERIOD_BYTES;
+
+		uint64_t BLOCKS_RECEIVED;
+		uint64_t STALLS;
+	};
+
+	//
+	// Records that a block was received from the peer.
+	// Returns false if the block wasn't requested from that peer (unsolicited, or already reassigned).
+	//
+	bool OnBlockReceived(const PeerPtr& pPeer, const Hash& blockHash, const size_t numBytes, const Clock::time_point now = Clock::now());
+
+	//
+	// Forgets the request for a block that couldn't be sent.
+	//
+	void OnRequestFailed(const Hash& blockHash);
+
+	//
+	// Forgets requests for blocks at or below the given height, since they have been applied.
+	//
+	void OnBlocksApplied(const uint64_t height);
+
+	//
+	// Assigns the blocks needed (in height order) to the given peers, and records the assignments as in flight.
+	// Blocks that are already in flight are skipped, unless the request stalled.
+	// Requests to peers that are no longer in the list are reassigned.
+	//
+	std::vector<Assignment> Schedule(
+		const uint64_t chainHeight,
+		const std::vector<std::pair<uint64_t, Hash>>& blocksNeeded,
+		const std::vector<PeerPtr>& peers,
+		const Clock::time_point now = Clock::now()
+	);
+
+	bool IsRequested(const Hash& blockHash) const;
+	size_t GetNumInFlight() const;
+	std::unique_ptr<PeerStats> GetPeerStats(const IPAddress& address) const;
+
+private:
+	struct Request
+	{
+		uint64_t BLOCK_HEIGHT;
+		IPAddress PEER_ADDRESS;
+		Clock::time_point SENT;
+	};
+
+	PeerStats& GetOrCreateStats(const PeerPtr& pPeer, const Clock::time_point now);
+	std::chrono::milliseconds GetStallTimeout(const PeerStats& stats, const uint64_t height, const uint64_t chainHeight) const;
+	PeerStats* ChooseBestPeer(const IPAddress* pExclude, const bool ignoreWindow);
+	void RemoveRequest(const Hash& blockHash);
+	void AddRequest(PeerStats& stats, const uint64_t height, const Hash& blockHash, const Clock::time_point now);
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<IPAddress, PeerStats> m_peers;
+	std::unordered_map<Hash, Request> m_requests;
+
+	// Average size of the blocks received so far. Used to turn a byte window into a block window.
+	double m_avgBlockSize = 0.0;
+};
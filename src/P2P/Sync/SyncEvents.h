@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+
+//
+// Lets the sync and pipeline threads sleep until something they care about happens,
+// instead of waking up on a short poll interval.
+// Each waiter keeps its own Cursor, so an event is seen by every waiter, and events
+// that fire while a waiter is busy are picked up by its next wait instead of being lost.
+//
+class SyncEvents
+{
+public:
+	using Ptr = std::shared_ptr<SyncEvents>;
+
+	enum class EEvent : size_t
+	{
+		HEADERS_RECEIVED,
+		BLOCK_APPLIED,
+		PEER_CONNECTED,
+		PEER_DISCONNECTED,
+		STOPPING, // Wakes every waiter, regardless of the events it's waiting on.
+		COUNT
+	};
+
+	class Cursor
+	{
+		friend class SyncEvents;
+		std::array<uint64_t, (size_t)EEvent::COUNT> m_seen{};
+	};
+
+	void Notify(const EEvent event)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			++m_counts[(size_t)event];
+		}
+
+		m_condition.notify_all();
+	}
+
+	//
+	// Blocks until one of the given events fires (or already fired since this cursor last waited),
+	// or until the timeout expires. Returns true if woken by an event.
+	//
+	bool WaitFor(Cursor& cursor, const std::initializer_list<EEvent>& events, const std::chrono::milliseconds& timeout)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto fired = [this, &cursor, &events] {
+			if (HasFired(cursor, EEvent::STOPPING)) {
+				return true;
+			}
+
+			for (const EEvent event : events) {
+				if (HasFired(cursor, event)) {
+					return true;
+				}
+			}
+
+			return false;
+		};
+
+		const bool woken = m_condition.wait_for(lock, timeout, fired);
+
+		cursor.m_seen[(size_t)EEvent::STOPPING] = m_counts[(size_t)EEvent::STOPPING];
+		for (const EEvent event : events) {
+			cursor.m_seen[(size_t)event] = m_counts[(size_t)event];
+		}
+
+		return woken;
+	}
+
+private:
+	bool HasFired(const Cursor& cursor, const EEvent event) const
+	{
+		return m_counts[(size_t)event] != cursor.m_seen[(size_t)event];
+	}
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::array<uint64_t, (size_t)EEvent::COUNT> m_counts{};
+};
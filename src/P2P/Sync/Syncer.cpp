@@ -18,6 +18,7 @@ Syncer::Syncer(
     m_pBlockChain(pBlockChain),
     m_pPipeline(pPipeline),
     m_pSyncStatus(pSyncStatus),
+    m_pSyncEvents(pConnectionManager.lock()->GetSyncEvents()),
     m_terminate(false)
 {
 
@@ -26,6 +27,7 @@ Syncer::Syncer(
 Syncer::~Syncer()
 {
     m_terminate = true;
+    m_pSyncEvents->Notify(SyncEvents::EEvent::STOPPING);
     ThreadUtil::Join(m_syncThread);
 }
 
@@ -58,9 +60,26 @@ void Syncer::Thread_Sync(Syncer& syncer)
     bool blocks_synced = false;
     auto pStatus = syncer.m_pSyncStatus;
 
+    // Sleep until headers arrive, a block is applied, or peers come and go.
+    // The timeout only needs to cover request timeouts and changes in peer heights, which aren't signalled.
+    SyncEvents::Cursor cursor;
     while (!syncer.m_terminate && Global::IsRunning()) {
         try {
-            ThreadUtil::SleepFor(std::chrono::milliseconds(10));
+            const bool syncing = pStatus->GetStatus() != ESyncStatus::NOT_SYNCING;
+            syncer.m_pSyncEvents->WaitFor(
+                cursor,
+                {
+                    SyncEvents::EEvent::HEADERS_RECEIVED,
+                    SyncEvents::EEvent::BLOCK_APPLIED,
+                    SyncEvents::EEvent::PEER_CONNECTED,
+                    SyncEvents::EEvent::PEER_DISCONNECTED
+                },
+                syncing ? std::chrono::milliseconds(250) : std::chrono::milliseconds(2000)
+            );
+            if (syncer.m_terminate) {
+                break;
+            }
+
             syncer.UpdateSyncStatus();
 
             if (pStatus->GetNumActiveConnections() >= Global::GetConfig().GetMinSyncPeers()) {
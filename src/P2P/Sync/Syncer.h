@@ -2,6 +2,7 @@
 
 #include "../ConnectionManager.h"
 #include "../Pipeline/Pipeline.h"
+#include "SyncEvents.h"
 
 #include <P2P/SyncStatus.h>
 #include <BlockChain/BlockChain.h>
@@ -37,6 +38,7 @@ private:
 	IBlockChain::Ptr m_pBlockChain;
 	std::shared_ptr<Pipeline> m_pPipeline;
 	SyncStatusPtr m_pSyncStatus;
+	SyncEvents::Ptr m_pSyncEvents;
 
 	std::atomic<bool> m_terminate;
 	std::thread m_syncThread;
@@ -0,0 +1,121 @@
+#include "MMRHashCache.h"
+#include "MMRHashUtil.h"
+#include "MMRUtil.h"
+
+#include <PMMR/Common/LeafIndex.h>
+#include <algorithm>
+
+void MMRHashCache::Load(const HashFile& hashFile)
+{
+	m_size = hashFile.GetSize();
+	m_upper.clear();
+	m_tail.clear();
+
+	// Nodes at or above UPPER_HEIGHT are the parents added with every (2^UPPER_HEIGHT)th leaf.
+	const uint64_t leavesPerNode = (uint64_t)1 << UPPER_HEIGHT;
+	for (uint64_t numLeaves = leavesPerNode; LeafIndex::At(numLeaves).GetPosition() <= m_size; numLeaves += leavesPerNode) {
+		const uint64_t leafPosition = LeafIndex::At(numLeaves - 1).GetPosition();
+		for (Index mmr_idx = Index::At(leafPosition + 1); !mmr_idx.IsLeaf() && mmr_idx < m_size; mmr_idx++) {
+			if (mmr_idx.GetHeight() >= UPPER_HEIGHT) {
+				m_upper.push_back({ mmr_idx.Get(), Hash(hashFile.GetDataAt(mmr_idx.Get())) });
+			}
+		}
+	}
+
+	for (uint64_t position = m_size - (std::min)(m_size, TAIL_SIZE); position < m_size; position++) {
+		m_tail.push_back(Hash(hashFile.GetDataAt(position)));
+	}
+}
+
+void MMRHashCache::Add(const Hash& hash)
+{
+	if (Index::At(m_size).GetHeight() >= UPPER_HEIGHT) {
+		m_upper.push_back({ m_size, hash });
+	}
+
+	m_tail.push_back(hash);
+	if (m_tail.size() > TAIL_SIZE) {
+		m_tail.pop_front();
+	}
+
+	++m_size;
+}
+
+void MMRHashCache::Rewind(const HashFile& hashFile, const uint64_t size)
+{
+	if (size >= m_size) {
+		return;
+	}
+
+	auto upperIter = std::lower_bound(
+		m_upper.begin(),
+		m_upper.end(),
+		size,
+		[](const std::pair<uint64_t, Hash>& node, const uint64_t position) { return node.first < position; }
+	);
+	m_upper.erase(upperIter, m_upper.end());
+
+	const uint64_t numRemoved = (std::min)((uint64_t)m_tail.size(), m_size - size);
+	m_tail.erase(m_tail.end() - numRemoved, m_tail.end());
+	m_size = size;
+
+	// Top the tail back up with the hashes before it.
+	while (m_tail.size() < TAIL_SIZE && GetTailStart() > 0) {
+		m_tail.push_front(Hash(hashFile.GetDataAt(GetTailStart() - 1)));
+	}
+}
+
+const Hash* MMRHashCache::Find(const uint64_t position) const
+{
+	if (position >= m_size) {
+		return nullptr;
+	}
+
+	if (position >= GetTailStart()) {
+		return &m_tail[position - GetTailStart()];
+	}
+
+	auto iter = std::lower_bound(
+		m_upper.cbegin(),
+		m_upper.cend(),
+		position,
+		[](const std::pair<uint64_t, Hash>& node, const uint64_t pos) { return node.first < pos; }
+	);
+	if (iter != m_upper.cend() && iter->first == position) {
+		return &iter->second;
+	}
+
+	return nullptr;
+}
+
+Hash MMRHashCache::GetHashAt(const HashFile& hashFile, const uint64_t position) const
+{
+	const Hash* pHash = Find(position);
+	if (pHash != nullptr) {
+		return *pHash;
+	}
+
+	return Hash(hashFile.GetDataAt(position));
+}
+
+Hash MMRHashCache::Root(const HashFile& hashFile, const uint64_t size) const
+{
+	if (size == 0) {
+		return ZERO_HASH;
+	}
+
+	Hash hash = ZERO_HASH;
+	const std::vector<uint64_t> peakIndices = MMRUtil::GetPeakIndices(size);
+	for (auto iter = peakIndices.crbegin(); iter != peakIndices.crend(); iter++) {
+		const Hash peakHash = GetHashAt(hashFile, *iter);
+		if (peakHash != ZERO_HASH) {
+			if (hash == ZERO_HASH) {
+				hash = peakHash;
+			} else {
+				hash = MMRHashUtil::HashParentWithIndex(peakHash, hash, size);
+			}
+		}
+	}
+
+	return hash;
+}
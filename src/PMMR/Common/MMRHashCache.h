@@ -0,0 +1,60 @@
+#pragma once
+
+#include "HashFile.h"
+
+#include <Crypto/Models/Hash.h>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+//
+// Keeps the hashes an unpruned MMR needs for appending and for recent roots in memory, so neither reads the hash file.
+//
+// Every node at or above UPPER_HEIGHT is kept (about 1 per 2^UPPER_HEIGHT leaves), along with the last TAIL_SIZE hashes.
+// Each new parent's children are either upper nodes or within the tail, and so are the peaks of any size
+// in roughly the last TAIL_SIZE / 2 positions. Anything else is read from the hash file.
+//
+class MMRHashCache
+{
+public:
+	static const uint64_t UPPER_HEIGHT = 10;
+	static const uint64_t TAIL_SIZE = 4096;
+
+	MMRHashCache() = default;
+
+	//
+	// Reads the upper nodes and the tail of the hash file.
+	//
+	void Load(const HashFile& hashFile);
+
+	uint64_t GetSize() const noexcept { return m_size; }
+
+	//
+	// Appends the hash at position GetSize(). The caller adds it to the hash file too.
+	//
+	void Add(const Hash& hash);
+
+	//
+	// Drops everything from the given position on. The hash file must already be rewound, since the tail is refilled from it.
+	//
+	void Rewind(const HashFile& hashFile, const uint64_t size);
+
+	//
+	// Returns nullptr if the hash at the position isn't cached.
+	//
+	const Hash* Find(const uint64_t position) const;
+	Hash GetHashAt(const HashFile& hashFile, const uint64_t position) const;
+
+	//
+	// Bags the peaks of the MMR at the given size. Matches MMRHashUtil::Root without a prune list.
+	//
+	Hash Root(const HashFile& hashFile, const uint64_t size) const;
+
+private:
+	uint64_t GetTailStart() const noexcept { return m_size - m_tail.size(); }
+
+	uint64_t m_size{ 0 };
+	std::vector<std::pair<uint64_t, Hash>> m_upper; // (position, hash), in ascending order
+	std::deque<Hash> m_tail; // hashes at positions [GetTailStart(), m_size)
+};
@@ -39,9 +39,9 @@ public:
 		const uint64_t numHashes
 	);
 
+	static Hash HashLeafWithIndex(const std::vector<uint8_t>& serializedLeaf, const uint64_t mmrIndex);
 	static Hash HashParentWithIndex(const Hash& leftChild, const Hash& rightChild, const uint64_t parentIndex);
 
 private:
-	static Hash HashLeafWithIndex(const std::vector<uint8_t>& serializedLeaf, const uint64_t mmrIndex);
 	static uint64_t GetShiftedIndex(const Index& mmr_idx, const PruneList::CPtr& pPruneList);
 };
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "MMRPeaks.h"
+#include "MMRHashUtil.h"
+#include "MMRUtil.h"
+
+void MMRPeaks::SetSize(const MMR& mmr, const uint64_t size)
+{
+	if (size == m_size) {
+		return;
+	}
+
+	const std::vector<uint64_t> peakIndices = MMRUtil::GetPeakIndices(size);
+
+	// Both lists are in ascending order, so peaks that are still peaks are found in a single pass.
+	std::vector<std::pair<uint64_t, Hash>> peaks;
+	peaks.reserve(peakIndices.size());
+
+	auto iter = m_peaks.cbegin();
+	for (const uint64_t peakIndex : peakIndices) {
+		while (iter != m_peaks.cend() && iter->first < peakIndex) {
+			++iter;
+		}
+
+		if (iter != m_peaks.cend() && iter->first == peakIndex) {
+			peaks.push_back(*iter);
+		} else {
+			std::unique_ptr<Hash> pHash = mmr.GetHashAt(Index::At(peakIndex));
+			peaks.push_back({ peakIndex, pHash != nullptr ? *pHash : ZERO_HASH });
+		}
+	}
+
+	m_peaks = std::move(peaks);
+	m_size = size;
+}
+
+Hash MMRPeaks::Root() const
+{
+	Hash hash = ZERO_HASH;
+	for (auto iter = m_peaks.crbegin(); iter != m_peaks.crend(); iter++) {
+		const Hash& peakHash = iter->second;
+		if (peakHash != ZERO_HASH) {
+			if (hash == ZERO_HASH) {
+				hash = peakHash;
+			} else {
+				hash = MMRHashUtil::HashParentWithIndex(peakHash, hash, m_size);
+			}
+		}
+	}
+
+	return hash;
+}
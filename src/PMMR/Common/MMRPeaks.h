@@ -0,0 +1,37 @@
+#pragma once
+
+#include "MMR.h"
+
+#include <Crypto/Models/Hash.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//
+// The peaks of an MMR at a given size, kept in memory.
+// Moving to a new size only reads the peaks that weren't already peaks, so computing the root for every size
+// while walking an MMR from start to end costs a couple of reads per step, instead of one per peak.
+//
+// Peak hashes are read from the MMR, so they must not have been pruned (eg. kernel or header MMRs).
+//
+class MMRPeaks
+{
+public:
+	MMRPeaks() = default;
+
+	uint64_t GetSize() const noexcept { return m_size; }
+
+	//
+	// Moves to the given size, which can be larger or smaller than the current one.
+	//
+	void SetSize(const MMR& mmr, const uint64_t size);
+
+	//
+	// Bags the peaks. Matches MMR::Root(GetSize()).
+	//
+	Hash Root() const;
+
+private:
+	uint64_t m_size{ 0 };
+	std::vector<std::pair<uint64_t, Hash>> m_peaks; // (mmr index, hash), in ascending order
+};
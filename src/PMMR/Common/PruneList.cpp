@@ -2,6 +2,7 @@
 #include "MMRUtil.h"
 
 #include <Common/Util/FileUtil.h>
+#include <Core/Exceptions/FileException.h>
 
 #pragma warning(disable:4244)
 
@@ -46,6 +47,35 @@ void PruneList::Flush()
     }
 }
 
+void PruneList::WriteWithAdded(const std::vector<Index>& mmrIndices, const fs::path& filePath) const
+{
+    PruneList updated(*this);
+    updated.m_filePath = filePath;
+    for (const Index& mmr_idx : mmrIndices) {
+        updated.Add(mmr_idx);
+    }
+
+    updated.m_prunedRoots.runOptimize();
+
+    std::vector<unsigned char> buffer(updated.m_prunedRoots.getSizeInBytes());
+    updated.m_prunedRoots.write((char*)buffer.data());
+    FileUtil::SafeWriteToFile(filePath, buffer);
+}
+
+void PruneList::ReplaceWith(const fs::path& filePath)
+{
+    FileUtil::RenameFile(filePath, m_filePath);
+
+    std::vector<unsigned char> data;
+    if (!FileUtil::ReadFile(m_filePath, data)) {
+        throw FILE_EXCEPTION_F("Failed to read {}", m_filePath);
+    }
+
+    m_prunedRoots = Roaring::readSafe((const char*)data.data(), data.size());
+    BuildPrunedCache();
+    BuildShiftCaches();
+}
+
 // Push the node at the provided position in the prune list.
 // Compacts the list if pruning the additional node means a parent can get pruned as well.
 void PruneList::Add(const Index& position)
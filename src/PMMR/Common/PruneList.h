@@ -19,6 +19,14 @@ public:
 
 	void Flush();
 
+	// Writes the prune list that adding the given nodes would produce to filePath, without changing this one.
+	void WriteWithAdded(const std::vector<Index>& mmrIndices, const fs::path& filePath) const;
+
+	// Renames the prune list written by WriteWithAdded over this one's file, and reloads it.
+	void ReplaceWith(const fs::path& filePath);
+
+	const fs::path& GetPath() const noexcept { return m_filePath; }
+
 	// Adds the node to the prune list.
 	// Compacts if pruning the node means a parent can get pruned as well.
 	void Add(const Index& mmrIndex);
@@ -14,7 +14,10 @@
 #include <Core/Serialization/Serializer.h>
 #include <Core/Serialization/ByteBuffer.h>
 #include <Core/Traits/Lockable.h>
+#include <PMMR/TxHashSet.h>
 #include <Common/Logger.h>
+#include <Common/Util/FileUtil.h>
+#include <filesystem.h>
 
 template<size_t DATA_SIZE, class DATA_TYPE>
 class PruneableMMR : public MMR, public Traits::IBatchable
@@ -164,7 +167,177 @@ public:
 		m_pPruneList->Flush();
 	}
 
+	//
+	// Prunes spent leaves below numLeaves, removing them (and any parents that become prunable)
+	// from the hash and data files, then records the new pruned roots in the prune list.
+	// Leaves in leavesToKeep (leaf indices spent after the horizon) are skipped, since rewinding may still need them.
+	//
+	void Compact(const uint64_t numLeaves, const Roaring& leavesToKeep)
+	{
+		const std::optional<TxHashSetCompaction::Files> files = PrepareCompaction(numLeaves, leavesToKeep);
+		if (files.has_value()) {
+			ApplyCompaction(files.value());
+		}
+	}
+
+	//
+	// The first half of Compact. Writes the compacted hash and data files and the updated prune list next to the originals,
+	// without changing the PMMR. Returns how many hashes and data entries they were written from, or nullopt if there's nothing to prune.
+	//
+	std::optional<TxHashSetCompaction::Files> PrepareCompaction(const uint64_t numLeaves, const Roaring& leavesToKeep) const
+	{
+		if (IsDirty()) {
+			throw TXHASHSET_EXCEPTION("Unable to compact uncommitted MMR.");
+		}
+
+		// Find newly prunable leaves, and expand upwards to every node that pruning them makes prunable.
+		// Positions are stored with +1 offset, like in the PruneList.
+		std::vector<Index> leavesToPrune;
+		Roaring expanded;
+		for (LeafIndex leaf_idx = LeafIndex::At(0); leaf_idx < numLeaves; leaf_idx++) {
+			if (m_pLeafSet->Contains(leaf_idx) || leavesToKeep.contains((uint32_t)leaf_idx.Get()) || m_pPruneList->IsPruned(leaf_idx.GetIndex())) {
+				continue;
+			}
+
+			leavesToPrune.push_back(leaf_idx.GetIndex());
+			expanded.add(leaf_idx.GetPosition() + 1);
+
+			Index current_idx = leaf_idx.GetIndex();
+			while (true) {
+				const Index sibling_idx = current_idx.GetSibling();
+				const bool siblingPruned = m_pPruneList->IsPrunedRoot(sibling_idx);
+				if (siblingPruned) {
+					expanded.add(sibling_idx.GetPosition() + 1);
+				}
+
+				if (!siblingPruned && !expanded.contains(sibling_idx.GetPosition() + 1)) {
+					break;
+				}
+
+				current_idx = current_idx.GetParent();
+				expanded.add(current_idx.GetPosition() + 1);
+			}
+		}
+
+		if (leavesToPrune.empty()) {
+			LOG_DEBUG("Nothing to compact");
+			return std::nullopt;
+		}
+
+		// Roots of the newly pruned subtrees keep their hashes (and leaf data, for height 0 roots).
+		// Everything beneath them gets removed, using file positions from the current (pre-compaction) prune list.
+		std::vector<uint64_t> hashesToRemove;
+		std::vector<uint64_t> dataToRemove;
+		for (auto iter = expanded.begin(); iter != expanded.end(); iter++) {
+			const Index mmr_idx = Index::At(iter.i.current_value - 1);
+			if (!expanded.contains(mmr_idx.GetParent().GetPosition() + 1)) {
+				continue;
+			}
+
+			hashesToRemove.push_back(mmr_idx.Get() - m_pPruneList->GetShift(mmr_idx));
+			if (mmr_idx.IsLeaf()) {
+				dataToRemove.push_back(mmr_idx.GetLeafIndex() - m_pPruneList->GetLeafShift(mmr_idx));
+			}
+		}
+
+		LOG_INFO_F(
+			"Pruning {} leaves: removing {} hashes and {} data entries",
+			leavesToPrune.size(),
+			hashesToRemove.size(),
+			dataToRemove.size()
+		);
+
+		try {
+			m_pHashFile->WriteCompacted(hashesToRemove, GetCompactedPath(m_pHashFile->GetPath()));
+			m_pDataFile->WriteCompacted(dataToRemove, GetCompactedPath(m_pDataFile->GetPath()));
+			m_pPruneList->WriteWithAdded(leavesToPrune, GetCompactedPath(m_pPruneList->GetPath()));
+		} catch (...) {
+			DiscardCompaction();
+			throw;
+		}
+
+		return std::make_optional(TxHashSetCompaction::Files{ m_pHashFile->GetSize(), m_pDataFile->GetSize() });
+	}
+
+	//
+	// The second half of Compact. Appends any hashes and data added since PrepareCompaction to the compacted files, and swaps them in.
+	// The PMMR must not have been rewound below the sizes in files since then.
+	//
+	void ApplyCompaction(const TxHashSetCompaction::Files& files)
+	{
+		if (IsDirty()) {
+			DiscardCompaction();
+			throw TXHASHSET_EXCEPTION("Unable to compact uncommitted MMR.");
+		}
+
+		// Once the marker is written, the compaction is committed, and RecoverCompaction finishes any renames that a crash interrupts.
+		const fs::path hashPath = GetCompactedPath(m_pHashFile->GetPath());
+		const fs::path dataPath = GetCompactedPath(m_pDataFile->GetPath());
+		const fs::path prunePath = GetCompactedPath(m_pPruneList->GetPath());
+		const fs::path markerPath = m_pHashFile->GetPath().parent_path() / COMPACT_MARKER;
+
+		try {
+			m_pHashFile->AppendTailTo(files.numHashes, hashPath);
+			m_pDataFile->AppendTailTo(files.numData, dataPath);
+			FileUtil::SafeWriteToFile(markerPath, {});
+		} catch (...) {
+			DiscardCompaction();
+			throw;
+		}
+
+		m_pHashFile->ReplaceWith(hashPath);
+		m_pDataFile->ReplaceWith(dataPath);
+		m_pPruneList->ReplaceWith(prunePath);
+		FileUtil::RemoveFile(markerPath);
+	}
+
+	void DiscardCompaction() const
+	{
+		FileUtil::RemoveFile(GetCompactedPath(m_pHashFile->GetPath()));
+		FileUtil::RemoveFile(GetCompactedPath(m_pDataFile->GetPath()));
+		FileUtil::RemoveFile(GetCompactedPath(m_pPruneList->GetPath()));
+	}
+
+	//
+	// Must be called before loading the PMMR's files.
+	// Completes a compaction that was interrupted after its marker was written, or discards one that was interrupted before.
+	//
+	static void RecoverCompaction(const fs::path& pmmrPath)
+	{
+		const std::vector<fs::path> paths = {
+			pmmrPath / "pmmr_hash.bin",
+			pmmrPath / "pmmr_data.bin",
+			pmmrPath / "pmmr_prun.bin"
+		};
+
+		const fs::path markerPath = pmmrPath / COMPACT_MARKER;
+		const bool committed = FileUtil::Exists(markerPath);
+		for (const fs::path& path : paths) {
+			const fs::path compactedPath = GetCompactedPath(path);
+			if (!FileUtil::Exists(compactedPath)) {
+				continue;
+			}
+
+			if (committed) {
+				LOG_WARNING_F("Finishing interrupted compaction of {}", path);
+				FileUtil::RenameFile(compactedPath, path);
+			} else {
+				LOG_WARNING_F("Discarding incomplete compaction of {}", path);
+				FileUtil::RemoveFile(compactedPath);
+			}
+		}
+
+		FileUtil::RemoveFile(markerPath);
+	}
+
 private:
+	static constexpr const char* COMPACT_MARKER = "pmmr_compact.marker";
+
+	static fs::path GetCompactedPath(const fs::path& path)
+	{
+		return GrinStr(path.u8string() + ".compact").ToPath();
+	}
+
 	std::shared_ptr<HashFile> m_pHashFile;
 	std::shared_ptr<LeafSet> m_pLeafSet;
 	std::shared_ptr<PruneList> m_pPruneList;
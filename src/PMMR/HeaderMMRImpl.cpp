@@ -3,11 +3,12 @@
 #include "Common/MMRHashUtil.h"
 
 #include <Common/Logger.h>
+#include <Common/Tracing.h>
 #include <Core/Serialization/Serializer.h>
 #include <Core/Config.h>
 
-HeaderMMR::HeaderMMR(std::shared_ptr<Locked<HashFile>> pHashFile)
-	: m_pLockedHashFile(pHashFile)
+HeaderMMR::HeaderMMR(std::shared_ptr<Locked<HashFile>> pHashFile, MMRHashCache&& cache)
+	: m_pLockedHashFile(pHashFile), m_cache(cache), m_committedCache(std::move(cache))
 {
 
 }
@@ -15,17 +16,23 @@ HeaderMMR::HeaderMMR(std::shared_ptr<Locked<HashFile>> pHashFile)
 std::shared_ptr<HeaderMMR> HeaderMMR::Load(const fs::path& path)
 {
 	std::shared_ptr<HashFile> pHashFile = HashFile::Load(path);
+
+	MMRHashCache cache;
+	cache.Load(*pHashFile);
+
 	auto locked = std::make_shared<Locked<HashFile>>(pHashFile);
-	return std::make_shared<HeaderMMR>(HeaderMMR(locked));
+	return std::make_shared<HeaderMMR>(HeaderMMR(locked, std::move(cache)));
 }
 
 void HeaderMMR::Commit()
 {
+	TRACE_SPAN("header", "HeaderMMR::Commit");
 	if (IsDirty())
 	{
 		const uint64_t height = Index::At(m_batchDataOpt.value().hashFile->GetSize()).GetLeafIndex();
 		LOG_TRACE_F("Flushing - Height: {}, Size: {}", height, m_batchDataOpt.value().hashFile->GetSize());
 		m_batchDataOpt.value().hashFile->Commit();
+		m_committedCache = m_cache;
 		SetDirty(false);
 	}
 }
@@ -36,6 +43,7 @@ void HeaderMMR::Rollback() noexcept
 	{
 		LOG_DEBUG("Discarding changes.");
 		m_batchDataOpt.value().hashFile->Rollback();
+		m_cache = m_committedCache;
 		SetDirty(false);
 	}
 }
@@ -47,6 +55,7 @@ void HeaderMMR::Rewind(const uint64_t size)
 	{
 		LOG_DEBUG_F("Rewinding to height {} - {} hashes", size, mmrSize);
 		m_batchDataOpt.value().hashFile->Rewind(mmrSize);
+		m_cache.Rewind(*m_batchDataOpt.value().hashFile, mmrSize);
 		SetDirty(true);
 	}
 }
@@ -66,8 +75,22 @@ void HeaderMMR::AddHeader(const BlockHeader& header)
 	Serializer serializer;
 	header.GetProofOfWork().SerializeCycle(serializer);
 
-	// Add hashes
-	MMRHashUtil::AddHashes(hash_file.GetShared(), serializer.vec(), nullptr);
+	// Add hashes. The children of each new parent are always in the cache, so nothing is read back from the file.
+	const uint64_t position = hash_file->GetSize();
+	const Hash leafHash = MMRHashUtil::HashLeafWithIndex(serializer.vec(), position);
+	hash_file->AddData(leafHash);
+	m_cache.Add(leafHash);
+
+	for (Index mmr_idx = Index::At(position + 1); !mmr_idx.IsLeaf(); mmr_idx++) {
+		const Hash parentHash = MMRHashUtil::HashParentWithIndex(
+			m_cache.GetHashAt(*hash_file, mmr_idx.GetLeftChild().Get()),
+			m_cache.GetHashAt(*hash_file, mmr_idx.GetRightChild().Get()),
+			mmr_idx.Get()
+		);
+		hash_file->AddData(parentHash);
+		m_cache.Add(parentHash);
+	}
+
 	SetDirty(true);
 }
 
@@ -78,7 +101,7 @@ Hash HeaderMMR::Root(const uint64_t lastHeight) const
 		m_pLockedHashFile->Read().GetShared();
 
 	uint64_t position = LeafIndex::At(lastHeight + 1).GetPosition();
-	return MMRHashUtil::Root(hash_file, position, nullptr);
+	return m_cache.Root(*hash_file, position);
 }
 
 namespace HeaderMMRAPI
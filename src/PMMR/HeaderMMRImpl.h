@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common/HashFile.h"
+#include "Common/MMRHashCache.h"
 
 #include <PMMR/HeaderMMR.h>
 #include <Core/Models/BlockHeader.h>
@@ -20,10 +21,14 @@ public:
 	void Rollback() noexcept final;
 
 private:
-	HeaderMMR(std::shared_ptr<Locked<HashFile>> pHashFile);
+	HeaderMMR(std::shared_ptr<Locked<HashFile>> pHashFile, MMRHashCache&& cache);
 
 	std::shared_ptr<Locked<HashFile>> m_pLockedHashFile;
 
+	// Matches the hash file, including uncommitted changes. Restored from m_committedCache on rollback.
+	MMRHashCache m_cache;
+	MMRHashCache m_committedCache;
+
 	void OnInitWrite(const bool /*batch*/) final
 	{
 		SetDirty(false);
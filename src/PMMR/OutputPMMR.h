@@ -15,6 +15,8 @@ public:
 	{
 		const auto genesisOutput = OutputIdentifier::FromOutput(Global::GetGenesisBlock().GetOutputs().front());
 
+		RecoverCompaction(txHashSetPath / "output");
+
 		std::shared_ptr<HashFile> pHashFile = HashFile::Load(txHashSetPath / "output" / "pmmr_hash.bin");
 
 		if (!FileUtil::Exists(txHashSetPath / "output" / "pmmr_leafset.bin") && FileUtil::Exists(txHashSetPath / "output" / "pmmr_leaf.bin"))
@@ -13,6 +13,8 @@ class RangeProofPMMR : public PruneableMMR<RANGE_PROOF_SIZE, RangeProof>
 public:
 	static std::shared_ptr<RangeProofPMMR> Load(const fs::path& txHashSetPath)
 	{
+		RecoverCompaction(txHashSetPath / "rangeproof");
+
 		std::shared_ptr<HashFile> pHashFile = HashFile::Load(txHashSetPath / "rangeproof" / "pmmr_hash.bin");
 
 		if (!FileUtil::Exists(txHashSetPath / "rangeproof" / "pmmr_leafset.bin") && FileUtil::Exists(txHashSetPath / "rangeproof" / "pmmr_leaf.bin"))
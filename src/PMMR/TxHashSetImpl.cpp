@@ -10,8 +10,10 @@
 #include <BlockChain/BlockChain.h>
 #include <Database/BlockDb.h>
 #include <Common/Logger.h>
+#include <Common/Tracing.h>
 #include <P2P/SyncStatus.h>
 #include <thread>
+#include <future>
 
 TxHashSet::TxHashSet(
 	std::shared_ptr<KernelMMR> pKernelMMR,
@@ -97,6 +99,8 @@ std::unique_ptr<BlockSums> TxHashSet::ValidateTxHashSet(const BlockHeader& heade
 
 bool TxHashSet::ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock& block)
 {
+	TRACE_SPAN("txhashset", "TxHashSet::ApplyBlock");
+
 	// Validate inputs
 	const uint64_t maximumBlockHeight = Consensus::GetMaxCoinbaseHeight(block.GetHeight());
 
@@ -164,6 +168,7 @@ bool TxHashSet::ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock&
 
 bool TxHashSet::ValidateRoots(const BlockHeader& blockHeader) const
 {
+    TRACE_SPAN("txhashset", "TxHashSet::ValidateRoots");
     if (m_pKernelMMR->Root(blockHeader.GetKernelMMRSize()) != blockHeader.GetKernelRoot()) {
         LOG_ERROR_F("Kernel root not matching for header ({})", blockHeader);
         return false;
@@ -270,10 +275,18 @@ std::vector<Hash> TxHashSet::GetLastRangeProofHashes(const uint64_t numberOfRang
 	return m_pRangeProofPMMR->GetLastLeafHashes(numberOfRangeProofs);
 }
 
-OutputRange TxHashSet::GetOutputsByLeafIndex(std::shared_ptr<const IBlockDB> pBlockDB, const uint64_t startIndex, const uint64_t maxNumOutputs) const
+OutputRange TxHashSet::GetOutputsByLeafIndex(
+	const IBlockChain& blockChain,
+	const uint64_t startIndex,
+	const uint64_t maxNumOutputs) const
 {
 	const uint64_t outputSize = m_pOutputPMMR->GetSize();
 	
+	// Block heights are derived from the headers' output MMR sizes, instead of looking up every commitment in the DB.
+	// blockNumOutputs is the number of leaves through the end of the block at blockHeight.
+	uint64_t blockHeight = 0;
+	uint64_t blockNumOutputs = 0;
+
 	LeafIndex leaf_idx = LeafIndex::At(startIndex);
 	std::vector<OutputDTO> outputs;
 	outputs.reserve(maxNumOutputs);
@@ -285,13 +298,23 @@ OutputRange TxHashSet::GetOutputsByLeafIndex(std::shared_ptr<const IBlockDB> pBl
 
 		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(leaf_idx);
 		if (pOutput != nullptr) {
+			if (leaf_idx >= blockNumOutputs) {
+				blockHeight = FindBlockHeight(blockChain, leaf_idx, blockNumOutputs == 0 ? 0 : blockHeight + 1);
+				auto pHeader = blockChain.GetBlockHeaderByHeight(blockHeight, EChainType::CONFIRMED);
+				if (pHeader == nullptr) {
+					// The confirmed chain was rewound while reading, so end the range here.
+					break;
+				}
+
+				blockNumOutputs = pHeader->GetNumOutputs();
+			}
+
 			std::unique_ptr<RangeProof> pRangeProof = m_pRangeProofPMMR->GetAt(leaf_idx);
-			std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->GetOutputPosition(pOutput->GetCommitment());
-			if (pRangeProof == nullptr || pOutputPosition == nullptr || leaf_idx != pOutputPosition->GetLeafIndex()) {
+			if (pRangeProof == nullptr) {
 				throw TXHASHSET_EXCEPTION_F("Failed to build OutputDTO at {}", leaf_idx);
 			}
 
-			outputs.emplace_back(OutputDTO(false, *pOutput, *pOutputPosition, *pRangeProof));
+			outputs.emplace_back(OutputDTO(false, *pOutput, OutputLocation(leaf_idx, blockHeight), *pRangeProof));
 		}
 
 		++leaf_idx;
@@ -303,6 +326,37 @@ OutputRange TxHashSet::GetOutputsByLeafIndex(std::shared_ptr<const IBlockDB> pBl
 	return OutputRange(maxLeafIndex > 0 ? maxLeafIndex - 1 : 0, lastRetrievedIndex, std::move(outputs));
 }
 
+uint64_t TxHashSet::FindBlockHeight(const IBlockChain& blockChain, const LeafIndex& leaf_idx, const uint64_t minHeight) const
+{
+	auto get_num_outputs = [&blockChain](const uint64_t height) {
+		auto pHeader = blockChain.GetBlockHeaderByHeight(height, EChainType::CONFIRMED);
+		if (pHeader == nullptr) {
+			throw TXHASHSET_EXCEPTION_F("Header not found at height {}", height);
+		}
+
+		return pHeader->GetNumOutputs();
+	};
+
+	// Ranges are usually read sequentially, so check the next block before searching.
+	uint64_t low = minHeight;
+	uint64_t high = m_pBlockHeader->GetHeight();
+	if (low >= high || leaf_idx < get_num_outputs(low)) {
+		return std::min(low, high);
+	}
+
+	// Find the first block whose output MMR contains the leaf. Invariant: get_num_outputs(low) <= leaf_idx.
+	while (high - low > 1) {
+		const uint64_t mid = low + (high - low) / 2;
+		if (leaf_idx < get_num_outputs(mid)) {
+			high = mid;
+		} else {
+			low = mid;
+		}
+	}
+
+	return high;
+}
+
 std::vector<OutputDTO> TxHashSet::GetOutputsByMMRIndex(std::shared_ptr<const IBlockDB> pBlockDB, const uint64_t startIndex, const uint64_t lastIndex) const
 {
 	std::vector<OutputDTO> outputs;
@@ -338,6 +392,8 @@ OutputDTO TxHashSet::GetOutput(const OutputLocation& location) const
 
 void TxHashSet::Rewind(std::shared_ptr<IBlockDB> pBlockDB, const BlockHeader& header)
 {
+	TRACE_SPAN("txhashset", "TxHashSet::Rewind");
+
 	std::vector<uint64_t> leavesToAdd;
 	while (*m_pBlockHeader != header) {
 		auto pBlock = pBlockDB->GetBlock(m_pBlockHeader->GetHash());
@@ -369,10 +425,21 @@ void TxHashSet::Rewind(std::shared_ptr<IBlockDB> pBlockDB, const BlockHeader& he
 
 void TxHashSet::Commit()
 {
+	TRACE_SPAN("txhashset", "TxHashSet::Commit");
+
 	std::vector<std::thread> threads;
-	threads.emplace_back(std::thread([this] { this->m_pKernelMMR->Commit(); }));
-	threads.emplace_back(std::thread([this] { this->m_pOutputPMMR->Commit(); }));
-	threads.emplace_back(std::thread([this] { this->m_pRangeProofPMMR->Commit(); }));
+	threads.emplace_back(std::thread([this] {
+		TRACE_SPAN("txhashset", "KernelMMR::Commit");
+		this->m_pKernelMMR->Commit();
+	}));
+	threads.emplace_back(std::thread([this] {
+		TRACE_SPAN("txhashset", "OutputPMMR::Commit");
+		this->m_pOutputPMMR->Commit();
+	}));
+	threads.emplace_back(std::thread([this] {
+		TRACE_SPAN("txhashset", "RangeProofPMMR::Commit");
+		this->m_pRangeProofPMMR->Commit();
+	}));
 	ThreadUtil::JoinAll(threads);
 
 	m_pBlockHeaderBackup = m_pBlockHeader;
@@ -386,18 +453,87 @@ void TxHashSet::Rollback() noexcept
 	m_pBlockHeader = m_pBlockHeaderBackup;
 }
 
-void TxHashSet::Compact()
+void TxHashSet::Compact(std::shared_ptr<const IBlockDB> pBlockDB)
+{
+	ApplyCompaction(pBlockDB, PrepareCompaction(pBlockDB));
+}
+
+TxHashSetCompaction TxHashSet::PrepareCompaction(std::shared_ptr<const IBlockDB> pBlockDB) const
 {
 	LOG_INFO("Compacting TxHashSet");
 
-	// Ensure any pending changes are flushed so compaction runs on consistent data.
-	m_pKernelMMR->Commit();
-	m_pOutputPMMR->Commit();
-	m_pRangeProofPMMR->Commit();
+	// Outputs spent in blocks above the horizon must stay in the PMMRs, since those blocks can still be rewound.
+	const uint64_t horizonHeight = Consensus::GetHorizonHeight(m_pBlockHeader->GetHeight());
+	Roaring spentAfterHorizon;
+	BlockHeaderPtr pHeader = m_pBlockHeader;
+	while (pHeader->GetHeight() > horizonHeight) {
+		for (const auto& spent : pBlockDB->GetSpentPositions(pHeader->GetHash())) {
+			spentAfterHorizon.add((uint32_t)spent.second.GetLeafIndex().Get());
+		}
+
+		pHeader = pBlockDB->GetBlockHeader(pHeader->GetPreviousHash());
+		if (pHeader == nullptr) {
+			throw TXHASHSET_EXCEPTION("Failed to find horizon header");
+		}
+	}
+
+	const uint64_t numLeaves = pHeader->GetNumOutputs();
+	LOG_INFO_F("Pruning outputs spent before {}", *pHeader);
+
+	// Futures rather than raw threads, so a failed write surfaces as an exception instead of terminating.
+	auto outputFuture = std::async(std::launch::async, [this, numLeaves, &spentAfterHorizon] {
+		return m_pOutputPMMR->PrepareCompaction(numLeaves, spentAfterHorizon);
+	});
+	auto rangeProofFuture = std::async(std::launch::async, [this, numLeaves, &spentAfterHorizon] {
+		return m_pRangeProofPMMR->PrepareCompaction(numLeaves, spentAfterHorizon);
+	});
+	outputFuture.wait();
+	rangeProofFuture.wait();
+
+	TxHashSetCompaction compaction;
+	compaction.pHeader = m_pBlockHeader;
+	try {
+		compaction.output = outputFuture.get();
+		compaction.rangeProof = rangeProofFuture.get();
+	} catch (...) {
+		m_pOutputPMMR->DiscardCompaction();
+		m_pRangeProofPMMR->DiscardCompaction();
+		throw;
+	}
 
-	// Persist prune lists so subsequent reads honour pruned branches.
-	m_pOutputPMMR->FlushPruneList();
-	m_pRangeProofPMMR->FlushPruneList();
+	return compaction;
+}
+
+bool TxHashSet::ApplyCompaction(std::shared_ptr<const IBlockDB> pBlockDB, const TxHashSetCompaction& compaction)
+{
+	// The compacted copies only cover the files as they were at the prepared block, so that block must still be in the txhashset.
+	BlockHeaderPtr pHeader = m_pBlockHeader;
+	while (pHeader != nullptr && pHeader->GetHeight() > compaction.pHeader->GetHeight()) {
+		pHeader = pBlockDB->GetBlockHeader(pHeader->GetPreviousHash());
+	}
+
+	if (pHeader == nullptr || pHeader->GetHash() != compaction.pHeader->GetHash()) {
+		LOG_WARNING_F("TxHashSet was rewound past {}. Discarding compaction.", *compaction.pHeader);
+		m_pOutputPMMR->DiscardCompaction();
+		m_pRangeProofPMMR->DiscardCompaction();
+		return false;
+	}
+
+	auto outputFuture = std::async(std::launch::async, [this, &compaction] {
+		if (compaction.output.has_value()) {
+			m_pOutputPMMR->ApplyCompaction(compaction.output.value());
+		}
+	});
+	auto rangeProofFuture = std::async(std::launch::async, [this, &compaction] {
+		if (compaction.rangeProof.has_value()) {
+			m_pRangeProofPMMR->ApplyCompaction(compaction.rangeProof.value());
+		}
+	});
+	outputFuture.wait();
+	rangeProofFuture.wait();
+	outputFuture.get();
+	rangeProofFuture.get();
 
 	LOG_INFO("Finished compacting TxHashSet");
+	return true;
 }
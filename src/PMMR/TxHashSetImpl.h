@@ -32,20 +32,25 @@ public:
 	std::vector<Hash> GetLastKernelHashes(const uint64_t numberOfKernels) const final;
 	std::vector<Hash> GetLastOutputHashes(const uint64_t numberOfOutputs) const final;
 	std::vector<Hash> GetLastRangeProofHashes(const uint64_t numberOfRangeProofs) const final;
-	OutputRange GetOutputsByLeafIndex(std::shared_ptr<const IBlockDB> pBlockDB, const uint64_t startIndex, const uint64_t maxNumOutputs) const final;
+	OutputRange GetOutputsByLeafIndex(const IBlockChain& blockChain, const uint64_t startIndex, const uint64_t maxNumOutputs) const final;
 	std::vector<OutputDTO> GetOutputsByMMRIndex(std::shared_ptr<const IBlockDB> pBlockDB, const uint64_t startIndex, const uint64_t lastIndex) const final;
 	OutputDTO GetOutput(const OutputLocation& location) const final;
 
 	void Rewind(std::shared_ptr<IBlockDB> pBlockDB, const BlockHeader& header) final;
 	void Commit() final;
 	void Rollback() noexcept final;
-	void Compact() final;
+	void Compact(std::shared_ptr<const IBlockDB> pBlockDB) final;
+	TxHashSetCompaction PrepareCompaction(std::shared_ptr<const IBlockDB> pBlockDB) const final;
+	bool ApplyCompaction(std::shared_ptr<const IBlockDB> pBlockDB, const TxHashSetCompaction& compaction) final;
 
 	std::shared_ptr<KernelMMR> GetKernelMMR() { return m_pKernelMMR; }
 	std::shared_ptr<OutputPMMR> GetOutputPMMR() { return m_pOutputPMMR; }
 	std::shared_ptr<RangeProofPMMR> GetRangeProofPMMR() { return m_pRangeProofPMMR; }
 
 private:
+	// Returns the height of the first block (at or above minHeight) whose output MMR contains the leaf.
+	uint64_t FindBlockHeight(const IBlockChain& blockChain, const LeafIndex& leaf_idx, const uint64_t minHeight) const;
+
 	std::shared_ptr<KernelMMR> m_pKernelMMR;
 	std::shared_ptr<OutputPMMR> m_pOutputPMMR;
 	std::shared_ptr<RangeProofPMMR> m_pRangeProofPMMR;
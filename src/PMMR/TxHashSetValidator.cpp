@@ -4,15 +4,22 @@
 #include "Common/MMR.h"
 #include "Common/MMRUtil.h"
 #include "Common/MMRHashUtil.h"
+#include "Common/MMRPeaks.h"
 
 #include <Consensus.h>
 #include <Core/Validation/KernelSignatureValidator.h>
 #include <Core/Validation/KernelSumValidator.h>
+#include <Core/Validation/CommitmentSummer.h>
 #include <Common/Util/HexUtil.h>
 #include <Common/Logger.h>
 #include <BlockChain/BlockChain.h>
+#include <algorithm>
+#include <future>
 #include <thread>
 
+static const uint64_t KERNEL_HISTORY_BATCH_SIZE = 1000;
+static const uint64_t MAX_KERNEL_HISTORY_THREADS = 8;
+
 std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, SyncStatus& syncStatus) const
 {
 	std::shared_ptr<const KernelMMR> pKernelMMR = txHashSet.GetKernelMMR();
@@ -170,28 +177,86 @@ bool TxHashSetValidator::ValidateMMRHashes(std::shared_ptr<const MMR> pMMR) cons
 	return true;
 }
 
+//
+// Checks the kernel root of every header against the kernel MMR.
+// Heights are split into ranges, validated in parallel. Each range seeds its peaks from the MMR at its first header,
+// then keeps them in memory, so each header only costs the reads for its new peaks, plus bagging.
+//
 bool TxHashSetValidator::ValidateKernelHistory(const KernelMMR& kernelMMR, const BlockHeader& blockHeader, SyncStatus& syncStatus) const
 {
-	const uint64_t totalHeight = blockHeader.GetHeight();
-	for (uint64_t height = 0; height <= totalHeight; height++)
-	{
-		auto pHeader = m_blockChain.GetBlockHeaderByHeight(height, EChainType::CANDIDATE);
-		if (pHeader == nullptr)
-		{
-			LOG_ERROR_F("No header found at height ({})", height);
+	const uint64_t numHeaders = blockHeader.GetHeight() + 1;
+	const uint64_t numThreads = (std::max)((uint64_t)1, (std::min)((uint64_t)std::thread::hardware_concurrency(), MAX_KERNEL_HISTORY_THREADS));
+	const uint64_t rangeSize = (std::max)(KERNEL_HISTORY_BATCH_SIZE, (numHeaders + numThreads - 1) / numThreads);
+
+	std::atomic<uint64_t> numValidated = 0;
+	std::atomic_bool failed = false;
+
+	std::vector<std::future<bool>> futures;
+	for (uint64_t firstHeight = 0; firstHeight < numHeaders; firstHeight += rangeSize) {
+		const uint64_t lastHeight = (std::min)(firstHeight + rangeSize, numHeaders) - 1;
+		futures.push_back(std::async(std::launch::async, [this, &kernelMMR, firstHeight, lastHeight, &numValidated, &failed] {
+			try {
+				return ValidateKernelHistoryRange(kernelMMR, firstHeight, lastHeight, numValidated, failed);
+			}
+			catch (std::exception& e) {
+				LOG_ERROR_F("Exception thrown while validating kernel history: {}", e.what());
+				failed = true;
+				return false;
+			}
+		}));
+	}
+
+	bool valid = true;
+	for (auto& future : futures) {
+		while (future.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
+			syncStatus.UpdateProcessingStatus((uint8_t)(15 + ((10.0 * numValidated) / numHeaders)));
+		}
+
+		valid = future.get() && valid;
+	}
+
+	return valid;
+}
+
+bool TxHashSetValidator::ValidateKernelHistoryRange(
+	const KernelMMR& kernelMMR,
+	const uint64_t firstHeight,
+	const uint64_t lastHeight,
+	std::atomic<uint64_t>& numValidated,
+	std::atomic_bool& failed) const
+{
+	const uint64_t mmrSize = kernelMMR.GetSize();
+
+	MMRPeaks peaks;
+	for (uint64_t batchStart = firstHeight; batchStart <= lastHeight; batchStart += KERNEL_HISTORY_BATCH_SIZE) {
+		if (failed) {
 			return false;
 		}
-		
-		if (kernelMMR.Root(pHeader->GetKernelMMRSize()) != pHeader->GetKernelRoot())
-		{
-			LOG_ERROR_F("Kernel root not matching for header at height ({})", height);
+
+		const uint64_t batchEnd = (std::min)(batchStart + KERNEL_HISTORY_BATCH_SIZE - 1, lastHeight);
+		const std::vector<BlockHeaderPtr> headers = m_blockChain.GetBlockHeadersByHeight(batchStart, batchEnd, EChainType::CANDIDATE);
+		if (headers.size() != (batchEnd - batchStart + 1)) {
+			LOG_ERROR_F("No header found at height ({})", batchStart + headers.size());
+			failed = true;
 			return false;
 		}
 
-		if (height % 1000 == 0)
-		{
-			syncStatus.UpdateProcessingStatus((uint8_t)(15 + ((10.0 * height) / totalHeight)));
+		for (const BlockHeaderPtr& pHeader : headers) {
+			if (pHeader->GetKernelMMRSize() > mmrSize) {
+				LOG_ERROR_F("Kernel MMR size too large for header at height ({})", pHeader->GetHeight());
+				failed = true;
+				return false;
+			}
+
+			peaks.SetSize(kernelMMR, pHeader->GetKernelMMRSize());
+			if (peaks.Root() != pHeader->GetKernelRoot()) {
+				LOG_ERROR_F("Kernel root not matching for header at height ({})", pHeader->GetHeight());
+				failed = true;
+				return false;
+			}
 		}
+
+		numValidated += headers.size();
 	}
 
 	return true;
@@ -202,24 +267,42 @@ BlockSums TxHashSetValidator::ValidateKernelSums(TxHashSet& txHashSet, const Blo
 	// Calculate overage
 	const int64_t overage = 0 - (Consensus::REWARD * (1 + blockHeader.GetHeight()));
 
-	// Determine output commitments
+	// Sum output commitments, reading them straight from the output PMMR in chunks.
 	std::shared_ptr<const OutputPMMR> pOutputPMMR = txHashSet.GetOutputPMMR();
-	std::vector<Commitment> outputCommitments;
-	for (LeafIndex output_idx = LeafIndex::At(0); output_idx < blockHeader.GetNumOutputs(); output_idx++) {
-		std::unique_ptr<OutputIdentifier> pOutput = pOutputPMMR->GetAt(output_idx);
-		if (pOutput != nullptr) {
-			outputCommitments.push_back(pOutput->GetCommitment());
+	std::optional<Commitment> outputSum = CommitmentSummer::Sum(
+		blockHeader.GetNumOutputs(),
+		[&pOutputPMMR](const uint64_t begin, const uint64_t end, std::vector<Commitment>& commitments) {
+			for (LeafIndex output_idx = LeafIndex::At(begin); output_idx < end; output_idx++) {
+				std::unique_ptr<OutputIdentifier> pOutput = pOutputPMMR->GetAt(output_idx);
+				if (pOutput != nullptr) {
+					commitments.push_back(pOutput->GetCommitment());
+				}
+			}
 		}
-	}
+	);
 
-	// Determine kernel excess commitments
+	// Sum kernel excess commitments
 	std::shared_ptr<const KernelMMR> pKernelMMR = txHashSet.GetKernelMMR();
-	std::vector<Commitment> excessCommitments;
-	for (LeafIndex kernel_idx = LeafIndex::At(0); kernel_idx < blockHeader.GetNumKernels(); kernel_idx++) {
-		std::unique_ptr<TransactionKernel> pKernel = pKernelMMR->GetKernelAt(kernel_idx);
-		if (pKernel != nullptr) {
-			excessCommitments.push_back(pKernel->GetExcessCommitment());
+	std::optional<Commitment> excessSum = CommitmentSummer::Sum(
+		blockHeader.GetNumKernels(),
+		[&pKernelMMR](const uint64_t begin, const uint64_t end, std::vector<Commitment>& commitments) {
+			for (LeafIndex kernel_idx = LeafIndex::At(begin); kernel_idx < end; kernel_idx++) {
+				std::unique_ptr<TransactionKernel> pKernel = pKernelMMR->GetKernelAt(kernel_idx);
+				if (pKernel != nullptr) {
+					commitments.push_back(pKernel->GetExcessCommitment());
+				}
+			}
 		}
+	);
+
+	std::vector<Commitment> outputCommitments;
+	if (outputSum.has_value()) {
+		outputCommitments.push_back(outputSum.value());
+	}
+
+	std::vector<Commitment> excessCommitments;
+	if (excessSum.has_value()) {
+		excessCommitments.push_back(excessSum.value());
 	}
 
 	return KernelSumValidator::ValidateKernelSums(
@@ -5,6 +5,8 @@
 #include <P2P/SyncStatus.h>
 #include "Common/HashFile.h"
 
+#include <atomic>
+
 // Forward Declarations
 class TxHashSet;
 class KernelMMR;
@@ -34,6 +36,14 @@ private:
 		SyncStatus& syncStatus
 	) const;
 
+	bool ValidateKernelHistoryRange(
+		const KernelMMR& kernelMMR,
+		const uint64_t firstHeight,
+		const uint64_t lastHeight,
+		std::atomic<uint64_t>& numValidated,
+		std::atomic_bool& failed
+	) const;
+
 	BlockSums ValidateKernelSums(
 		TxHashSet& txHashSet,
 		const BlockHeader& blockHeader
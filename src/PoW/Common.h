@@ -5,6 +5,7 @@
 #include <ctime>
 
 #include "portable_endian.h"
+#include "SipHashBatch.h"
 
 #include <Common/Logger.h>
 
@@ -88,24 +89,17 @@ public:
     }
 };
 
-// fills buffer with EDGE_BLOCK_SIZE siphash outputs for block containing edge in cuckaroo graph
-// return siphash output for given edge
+// fills sips with the EDGE_BLOCK_SIZE siphash outputs for the block containing each edge in cuckaroo graph.
+// blocks are hashed several edges at a time, so sips must hold numEdges * EDGE_BLOCK_SIZE outputs.
 template <int rotE = 21>
-static uint64_t sipblock(siphash_keys& keys, const word_t edge, uint64_t* buf)
+static void sipblocks(const siphash_keys& keys, const word_t* edges, const size_t numEdges, uint64_t* sips)
 {
-    siphash_state<rotE> shs(keys);
-    word_t edge0 = edge & ~EDGE_BLOCK_MASK;
-    for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
-    {
-        shs.hash24(edge0 + i);
-        buf[i] = shs.xor_lanes();
-    }
-
-    const uint64_t last = buf[EDGE_BLOCK_MASK];
-    for (uint32_t i = 0; i < EDGE_BLOCK_MASK; i++)
-    {
-        buf[i] ^= last;
-    }
+    SipHashBatch::HashBlocks(keys, rotE, edges, sips, numEdges);
+}
 
-    return buf[edge & EDGE_BLOCK_MASK];
-}
\ No newline at end of file
+// return siphash output for given edge, from the outputs of its block
+static inline uint64_t sipblock(const uint64_t* block, const word_t edge)
+{
+    const uint32_t i = edge & EDGE_BLOCK_MASK;
+    return i == EDGE_BLOCK_MASK ? block[i] : block[i] ^ block[EDGE_BLOCK_MASK];
+}
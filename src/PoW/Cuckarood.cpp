@@ -18,7 +18,7 @@
 int verify_cuckarood(const word_t edges[PROOFSIZE], siphash_keys& keys)
 {
     word_t xor0 = 0, xor1 = 0;
-    uint64_t sips[EDGE_BLOCK_SIZE];
+    uint64_t sips[PROOFSIZE * EDGE_BLOCK_SIZE];
     word_t uvs[2 * PROOFSIZE];
     uint32_t ndir[2] = { 0, 0 };
 
@@ -30,7 +30,13 @@ int verify_cuckarood(const word_t edges[PROOFSIZE], siphash_keys& keys)
             return POW_TOO_BIG;
         if (n && edges[n] <= edges[n - 1])
             return POW_TOO_SMALL;
-        uint64_t edge = sipblock<25>(keys, edges[n], sips);
+        ndir[dir]++;
+    }
+    sipblocks<25>(keys, edges, PROOFSIZE, sips);
+    ndir[0] = ndir[1] = 0;
+    for (uint32_t n = 0; n < PROOFSIZE; n++) {
+        uint32_t dir = edges[n] & 1;
+        uint64_t edge = sipblock(sips + n * EDGE_BLOCK_SIZE, edges[n]);
         xor0 ^= uvs[4 * ndir[dir] + 2 * dir] = edge & NODE1MASK;
         // printf("%2d %8x\t", 4 * ndir[dir] + 2 * dir , edge        & NODE1MASK);
         xor1 ^= uvs[4 * ndir[dir] + 2 * dir + 1] = (edge >> 32) & NODE1MASK;
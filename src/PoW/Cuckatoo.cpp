@@ -3,12 +3,21 @@
 
 #include <Crypto/Hasher.h>
 
-// generate edge endpoint in cuck(at)oo graph without partition bit
-word_t sipnode(siphash_keys* keys, word_t edge, uint32_t uorv, const word_t edgeMask)
+// generate both endpoints of every edge in cuck(at)oo graph without partition bit, several at a time
+void sipnodes(const siphash_keys& keys, const word_t edges[PROOFSIZE], word_t uvs[2 * PROOFSIZE], const word_t edgeMask)
 {
-    siphash_state v(*keys);
-    v.hash24(2 * edge + uorv);
-    return v.xor_lanes() & edgeMask;
+    uint64_t nonces[2 * PROOFSIZE];
+    for (uint32_t n = 0; n < PROOFSIZE; n++)
+    {
+        nonces[2 * n] = 2 * edges[n];
+        nonces[2 * n + 1] = 2 * edges[n] + 1;
+    }
+
+    SipHashBatch::Hash24(keys, 21, nonces, uvs, 2 * PROOFSIZE);
+    for (uint32_t i = 0; i < 2 * PROOFSIZE; i++)
+    {
+        uvs[i] &= edgeMask;
+    }
 }
 
 // verify that edges are ascending and form a cycle in header-generated graph
@@ -32,9 +41,13 @@ int verify_cuckatoo(const word_t edges[PROOFSIZE], siphash_keys* keys, const uin
         if (n && edges[n] <= edges[n - 1]) {
             return POW_TOO_SMALL;
         }
+    }
 
-        xor0 ^= uvs[2 * n] = sipnode(keys, edges[n], 0, edgeMask);
-        xor1 ^= uvs[2 * n + 1] = sipnode(keys, edges[n], 1, edgeMask);
+    sipnodes(*keys, edges, uvs, edgeMask);
+    for (uint32_t n = 0; n < PROOFSIZE; n++)
+    {
+        xor0 ^= uvs[2 * n];
+        xor1 ^= uvs[2 * n + 1];
     }
 
     // optional check for obviously bad proofs
@@ -9,7 +9,26 @@
 #include "Cuckatoo.h"
 #include "uint128.h"
 
+#include <scheduler/ctpl_stl.h>
+#include <algorithm>
+#include <future>
+#include <thread>
+
+// Headers per task. Each cycle takes tens of microseconds to check, so small batches aren't worth handing off.
+static const size_t CYCLE_CHUNK_SIZE = 32;
+
+static ctpl::thread_pool& GetThreadPool()
+{
+    static ctpl::thread_pool threadPool((int)(std::max)(1u, std::thread::hardware_concurrency()));
+    return threadPool;
+}
+
 bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+    return IsDifficultyValid(header, previousHeader) && IsCycleValid(header);
+}
+
+bool PoWValidator::IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader) const
 {
     // Validate Total Difficulty
     if (header.GetTotalDifficulty() <= previousHeader.GetTotalDifficulty()) {
@@ -25,18 +44,29 @@ bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev
     }
 
     // Explicit check to ensure total_difficulty has increased by exactly the _network_ difficulty of the previous block.
-    const HeaderInfo nextHeaderInfo = DifficultyCalculator(m_pBlockDB).CalculateNextDifficulty(header);
-    if (targetDifficulty != nextHeaderInfo.GetDifficulty()) {
+    const NextDifficulty nextDifficulty = GetNextDifficulty(header);
+    if (targetDifficulty != nextDifficulty.difficulty) {
         LOG_WARNING_F("Target difficulty invalid for block {} with previous block {}", header, previousHeader);
         return false;
     }
 
     // Check the secondary PoW scaling factor if applicable.
-    if (header.GetScalingDifficulty() != nextHeaderInfo.GetSecondaryScaling()) {
+    if (header.GetScalingDifficulty() != nextDifficulty.secondaryScaling) {
         LOG_WARNING_F("Scaling difficulty invalid for block {}", header);
         return false;
     }
 
+    return true;
+}
+
+PoWValidator::NextDifficulty PoWValidator::GetNextDifficulty(const BlockHeader& header) const
+{
+    const HeaderInfo nextHeaderInfo = DifficultyCalculator(m_pBlockDB).CalculateNextDifficulty(header);
+    return NextDifficulty{ nextHeaderInfo.GetDifficulty(), nextHeaderInfo.GetSecondaryScaling() };
+}
+
+bool PoWValidator::IsCycleValid(const BlockHeader& header)
+{
     uint64_t header_version = header.GetVersion();
     if (header.GetEdgeBits() == 29) {
         if (header_version == 1) {
@@ -53,8 +83,40 @@ bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev
     }
 }
 
+std::vector<bool> PoWValidator::AreCyclesValid(const std::vector<BlockHeaderPtr>& headers)
+{
+    // Written as bytes, since neighbouring elements of a vector<bool> can't be set from different threads.
+    std::vector<uint8_t> valid(headers.size(), 0);
+    if (headers.size() <= CYCLE_CHUNK_SIZE) {
+        for (size_t i = 0; i < headers.size(); i++) {
+            valid[i] = IsCycleValid(*headers[i]);
+        }
+    } else {
+        std::vector<std::future<void>> futures;
+        for (size_t begin = 0; begin < headers.size(); begin += CYCLE_CHUNK_SIZE) {
+            const size_t end = (std::min)(begin + CYCLE_CHUNK_SIZE, headers.size());
+            futures.push_back(GetThreadPool().push([&headers, &valid, begin, end](int) {
+                for (size_t i = begin; i < end; i++) {
+                    valid[i] = IsCycleValid(*headers[i]);
+                }
+            }));
+        }
+
+        // Wait for every task before calling get(), since they reference the caller's headers.
+        for (auto& future : futures) {
+            future.wait();
+        }
+
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+
+    return std::vector<bool>(valid.cbegin(), valid.cend());
+}
+
 // Maximum difficulty this proof of work can achieve
-uint64_t PoWValidator::GetMaximumDifficulty(const BlockHeader& header) const
+uint64_t PoWValidator::GetMaximumDifficulty(const BlockHeader& header)
 {
     uint128_t scalingDifficulty = 0;
 
@@ -0,0 +1,328 @@
+#include "SipHashBatch.h"
+#include "Common.h"
+
+#include <Common/Logger.h>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define POW_SIPHASH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define POW_TARGET_AVX2
+#else
+#define POW_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+template <int rotE>
+static void Hash24Scalar(const siphash_keys& keys, const uint64_t* nonces, uint64_t* out, const size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		siphash_state<rotE> state(keys);
+		state.hash24(nonces[i]);
+		out[i] = state.xor_lanes();
+	}
+}
+
+template <int rotE>
+static void HashBlocksScalar(const siphash_keys& keys, const uint64_t* edges, uint64_t* out, const size_t count)
+{
+	for (size_t n = 0; n < count; n++)
+	{
+		siphash_state<rotE> state(keys);
+		const word_t edge0 = edges[n] & ~EDGE_BLOCK_MASK;
+		for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
+		{
+			state.hash24(edge0 + i);
+			out[n * EDGE_BLOCK_SIZE + i] = state.xor_lanes();
+		}
+	}
+}
+
+#ifdef POW_SIPHASH_X86
+
+//
+// SSE2 - 2 lanes. Always available on x86-64.
+//
+template <int b>
+static inline __m128i Rotl128(const __m128i x)
+{
+	if constexpr (b == 32) {
+		return _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+	} else {
+		return _mm_or_si128(_mm_slli_epi64(x, b), _mm_srli_epi64(x, 64 - b));
+	}
+}
+
+template <int rotE>
+static inline void SipRound128(__m128i& v0, __m128i& v1, __m128i& v2, __m128i& v3)
+{
+	v0 = _mm_add_epi64(v0, v1); v2 = _mm_add_epi64(v2, v3); v1 = Rotl128<13>(v1);
+	v3 = Rotl128<16>(v3); v1 = _mm_xor_si128(v1, v0); v3 = _mm_xor_si128(v3, v2);
+	v0 = Rotl128<32>(v0); v2 = _mm_add_epi64(v2, v1); v0 = _mm_add_epi64(v0, v3);
+	v1 = Rotl128<17>(v1); v3 = Rotl128<rotE>(v3);
+	v1 = _mm_xor_si128(v1, v2); v3 = _mm_xor_si128(v3, v0); v2 = Rotl128<32>(v2);
+}
+
+// Same as siphash_state::hash24 followed by xor_lanes.
+template <int rotE>
+static inline __m128i SipHash24x2(__m128i& v0, __m128i& v1, __m128i& v2, __m128i& v3, const __m128i nonce)
+{
+	v3 = _mm_xor_si128(v3, nonce);
+	SipRound128<rotE>(v0, v1, v2, v3); SipRound128<rotE>(v0, v1, v2, v3);
+	v0 = _mm_xor_si128(v0, nonce);
+	v2 = _mm_xor_si128(v2, _mm_set1_epi64x(0xff));
+	SipRound128<rotE>(v0, v1, v2, v3); SipRound128<rotE>(v0, v1, v2, v3);
+	SipRound128<rotE>(v0, v1, v2, v3); SipRound128<rotE>(v0, v1, v2, v3);
+	return _mm_xor_si128(_mm_xor_si128(v0, v1), _mm_xor_si128(v2, v3));
+}
+
+template <int rotE>
+static void Hash24SSE2(const siphash_keys& keys, const uint64_t* nonces, uint64_t* out, const size_t count)
+{
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128i v0 = _mm_set1_epi64x((int64_t)keys.k0);
+		__m128i v1 = _mm_set1_epi64x((int64_t)keys.k1);
+		__m128i v2 = _mm_set1_epi64x((int64_t)keys.k2);
+		__m128i v3 = _mm_set1_epi64x((int64_t)keys.k3);
+		const __m128i nonce = _mm_loadu_si128((const __m128i*)(nonces + i));
+		_mm_storeu_si128((__m128i*)(out + i), SipHash24x2<rotE>(v0, v1, v2, v3, nonce));
+	}
+
+	Hash24Scalar<rotE>(keys, nonces + i, out + i, count - i);
+}
+
+template <int rotE>
+static void HashBlocksSSE2(const siphash_keys& keys, const uint64_t* edges, uint64_t* out, const size_t count)
+{
+	size_t n = 0;
+	for (; n + 2 <= count; n += 2)
+	{
+		__m128i v0 = _mm_set1_epi64x((int64_t)keys.k0);
+		__m128i v1 = _mm_set1_epi64x((int64_t)keys.k1);
+		__m128i v2 = _mm_set1_epi64x((int64_t)keys.k2);
+		__m128i v3 = _mm_set1_epi64x((int64_t)keys.k3);
+		__m128i nonce = _mm_set_epi64x(
+			(int64_t)(edges[n + 1] & ~EDGE_BLOCK_MASK),
+			(int64_t)(edges[n] & ~EDGE_BLOCK_MASK)
+		);
+
+		alignas(16) uint64_t lanes[2];
+		for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
+		{
+			_mm_store_si128((__m128i*)lanes, SipHash24x2<rotE>(v0, v1, v2, v3, nonce));
+			out[n * EDGE_BLOCK_SIZE + i] = lanes[0];
+			out[(n + 1) * EDGE_BLOCK_SIZE + i] = lanes[1];
+			nonce = _mm_add_epi64(nonce, _mm_set1_epi64x(1));
+		}
+	}
+
+	HashBlocksScalar<rotE>(keys, edges + n, out + n * EDGE_BLOCK_SIZE, count - n);
+}
+
+//
+// AVX2 - 4 lanes. Compiled for AVX2 regardless of the build flags, and only called if the CPU supports it.
+//
+template <int b>
+POW_TARGET_AVX2 static inline __m256i Rotl256(const __m256i x)
+{
+	if constexpr (b == 32) {
+		return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+	} else {
+		return _mm256_or_si256(_mm256_slli_epi64(x, b), _mm256_srli_epi64(x, 64 - b));
+	}
+}
+
+template <int rotE>
+POW_TARGET_AVX2 static inline void SipRound256(__m256i& v0, __m256i& v1, __m256i& v2, __m256i& v3)
+{
+	v0 = _mm256_add_epi64(v0, v1); v2 = _mm256_add_epi64(v2, v3); v1 = Rotl256<13>(v1);
+	v3 = Rotl256<16>(v3); v1 = _mm256_xor_si256(v1, v0); v3 = _mm256_xor_si256(v3, v2);
+	v0 = Rotl256<32>(v0); v2 = _mm256_add_epi64(v2, v1); v0 = _mm256_add_epi64(v0, v3);
+	v1 = Rotl256<17>(v1); v3 = Rotl256<rotE>(v3);
+	v1 = _mm256_xor_si256(v1, v2); v3 = _mm256_xor_si256(v3, v0); v2 = Rotl256<32>(v2);
+}
+
+template <int rotE>
+POW_TARGET_AVX2 static inline __m256i SipHash24x4(__m256i& v0, __m256i& v1, __m256i& v2, __m256i& v3, const __m256i nonce)
+{
+	v3 = _mm256_xor_si256(v3, nonce);
+	SipRound256<rotE>(v0, v1, v2, v3); SipRound256<rotE>(v0, v1, v2, v3);
+	v0 = _mm256_xor_si256(v0, nonce);
+	v2 = _mm256_xor_si256(v2, _mm256_set1_epi64x(0xff));
+	SipRound256<rotE>(v0, v1, v2, v3); SipRound256<rotE>(v0, v1, v2, v3);
+	SipRound256<rotE>(v0, v1, v2, v3); SipRound256<rotE>(v0, v1, v2, v3);
+	return _mm256_xor_si256(_mm256_xor_si256(v0, v1), _mm256_xor_si256(v2, v3));
+}
+
+template <int rotE>
+POW_TARGET_AVX2 static void Hash24AVX2(const siphash_keys& keys, const uint64_t* nonces, uint64_t* out, const size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256i v0 = _mm256_set1_epi64x((int64_t)keys.k0);
+		__m256i v1 = _mm256_set1_epi64x((int64_t)keys.k1);
+		__m256i v2 = _mm256_set1_epi64x((int64_t)keys.k2);
+		__m256i v3 = _mm256_set1_epi64x((int64_t)keys.k3);
+		const __m256i nonce = _mm256_loadu_si256((const __m256i*)(nonces + i));
+		_mm256_storeu_si256((__m256i*)(out + i), SipHash24x4<rotE>(v0, v1, v2, v3, nonce));
+	}
+
+	Hash24SSE2<rotE>(keys, nonces + i, out + i, count - i);
+}
+
+template <int rotE>
+POW_TARGET_AVX2 static void HashBlocksAVX2(const siphash_keys& keys, const uint64_t* edges, uint64_t* out, const size_t count)
+{
+	size_t n = 0;
+	for (; n + 4 <= count; n += 4)
+	{
+		__m256i v0 = _mm256_set1_epi64x((int64_t)keys.k0);
+		__m256i v1 = _mm256_set1_epi64x((int64_t)keys.k1);
+		__m256i v2 = _mm256_set1_epi64x((int64_t)keys.k2);
+		__m256i v3 = _mm256_set1_epi64x((int64_t)keys.k3);
+		__m256i nonce = _mm256_set_epi64x(
+			(int64_t)(edges[n + 3] & ~EDGE_BLOCK_MASK),
+			(int64_t)(edges[n + 2] & ~EDGE_BLOCK_MASK),
+			(int64_t)(edges[n + 1] & ~EDGE_BLOCK_MASK),
+			(int64_t)(edges[n] & ~EDGE_BLOCK_MASK)
+		);
+
+		alignas(32) uint64_t lanes[4];
+		for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
+		{
+			_mm256_store_si256((__m256i*)lanes, SipHash24x4<rotE>(v0, v1, v2, v3, nonce));
+			for (size_t lane = 0; lane < 4; lane++)
+			{
+				out[(n + lane) * EDGE_BLOCK_SIZE + i] = lanes[lane];
+			}
+
+			nonce = _mm256_add_epi64(nonce, _mm256_set1_epi64x(1));
+		}
+	}
+
+	HashBlocksSSE2<rotE>(keys, edges + n, out + n * EDGE_BLOCK_SIZE, count - n);
+}
+
+static bool IsAVX2Supported() noexcept
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+
+	// The OS must also save the YMM registers on context switches.
+	__cpuid(info, 1);
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+		return false;
+	}
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+SipHashBatch::EImpl SipHashBatch::GetSupported() noexcept
+{
+#ifdef POW_SIPHASH_X86
+	static const EImpl supported = []() {
+		const EImpl impl = IsAVX2Supported() ? EImpl::AVX2 : EImpl::SSE2;
+		LOG_INFO_F("Using {} for cuckoo cycle verification", ToString(impl));
+		return impl;
+	}();
+
+	return supported;
+#else
+	return EImpl::SCALAR;
+#endif
+}
+
+const char* SipHashBatch::ToString(const EImpl impl) noexcept
+{
+	switch (impl)
+	{
+		case EImpl::SCALAR: return "scalar SipHash";
+		case EImpl::SSE2: return "SSE2 SipHash";
+		case EImpl::AVX2: return "AVX2 SipHash";
+	}
+
+	return "unknown";
+}
+
+template <int rotE>
+static void Hash24Impl(const SipHashBatch::EImpl impl, const siphash_keys& keys, const uint64_t* nonces, uint64_t* out, const size_t count)
+{
+	switch (impl)
+	{
+#ifdef POW_SIPHASH_X86
+		case SipHashBatch::EImpl::AVX2:
+			return Hash24AVX2<rotE>(keys, nonces, out, count);
+		case SipHashBatch::EImpl::SSE2:
+			return Hash24SSE2<rotE>(keys, nonces, out, count);
+#endif
+		default:
+			return Hash24Scalar<rotE>(keys, nonces, out, count);
+	}
+}
+
+template <int rotE>
+static void HashBlocksImpl(const SipHashBatch::EImpl impl, const siphash_keys& keys, const uint64_t* edges, uint64_t* out, const size_t count)
+{
+	switch (impl)
+	{
+#ifdef POW_SIPHASH_X86
+		case SipHashBatch::EImpl::AVX2:
+			return HashBlocksAVX2<rotE>(keys, edges, out, count);
+		case SipHashBatch::EImpl::SSE2:
+			return HashBlocksSSE2<rotE>(keys, edges, out, count);
+#endif
+		default:
+			return HashBlocksScalar<rotE>(keys, edges, out, count);
+	}
+}
+
+void SipHashBatch::Hash24(const siphash_keys& keys, const uint32_t rotE, const uint64_t* nonces, uint64_t* out, const size_t count)
+{
+	Hash24(GetSupported(), keys, rotE, nonces, out, count);
+}
+
+void SipHashBatch::HashBlocks(const siphash_keys& keys, const uint32_t rotE, const uint64_t* edges, uint64_t* out, const size_t count)
+{
+	HashBlocks(GetSupported(), keys, rotE, edges, out, count);
+}
+
+void SipHashBatch::Hash24(const EImpl impl, const siphash_keys& keys, const uint32_t rotE, const uint64_t* nonces, uint64_t* out, const size_t count)
+{
+	if (rotE == 21) {
+		Hash24Impl<21>(impl, keys, nonces, out, count);
+	} else if (rotE == 25) {
+		Hash24Impl<25>(impl, keys, nonces, out, count);
+	} else {
+		throw std::invalid_argument("Unsupported SipHash rotation");
+	}
+}
+
+void SipHashBatch::HashBlocks(const EImpl impl, const siphash_keys& keys, const uint32_t rotE, const uint64_t* edges, uint64_t* out, const size_t count)
+{
+	if (rotE == 21) {
+		HashBlocksImpl<21>(impl, keys, edges, out, count);
+	} else if (rotE == 25) {
+		HashBlocksImpl<25>(impl, keys, edges, out, count);
+	} else {
+		throw std::invalid_argument("Unsupported SipHash rotation");
+	}
+}
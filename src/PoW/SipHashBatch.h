@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Forward Declarations
+class siphash_keys;
+
+//
+// SipHash-2-4 of many nonces under the same keys, several lanes at a time.
+// The widest implementation the CPU supports is picked at runtime, so binaries built for baseline x86-64 still use AVX2.
+//
+class SipHashBatch
+{
+public:
+	enum class EImpl
+	{
+		SCALAR,
+		SSE2,
+		AVX2
+	};
+
+	// Widest implementation this CPU supports.
+	static EImpl GetSupported() noexcept;
+	static const char* ToString(const EImpl impl) noexcept;
+
+	//
+	// Sets out[i] to the xor of the 4 lanes after hashing nonces[i], the same as siphash_state<rotE>::hash24 followed by xor_lanes.
+	// rotE is 21 for every PoW except cuckarood, which uses 25.
+	//
+	static void Hash24(
+		const siphash_keys& keys,
+		const uint32_t rotE,
+		const uint64_t* nonces,
+		uint64_t* out,
+		const size_t count
+	);
+
+	//
+	// For each edge, fills out[EDGE_BLOCK_SIZE * n, EDGE_BLOCK_SIZE * (n + 1)) with the outputs of one siphash_state
+	// hashing every nonce of the block containing edges[n] in turn, as the cuckaroo variants do.
+	// Each output's state depends on the one before it, so the lanes run across edges rather than within a block.
+	//
+	static void HashBlocks(
+		const siphash_keys& keys,
+		const uint32_t rotE,
+		const uint64_t* edges,
+		uint64_t* out,
+		const size_t count
+	);
+
+	// Same as above, but with a specific implementation, which must be supported. Used by tests and benchmarks.
+	static void Hash24(
+		const EImpl impl,
+		const siphash_keys& keys,
+		const uint32_t rotE,
+		const uint64_t* nonces,
+		uint64_t* out,
+		const size_t count
+	);
+	static void HashBlocks(
+		const EImpl impl,
+		const siphash_keys& keys,
+		const uint32_t rotE,
+		const uint64_t* edges,
+		uint64_t* out,
+		const size_t count
+	);
+};
@@ -119,14 +119,20 @@ void Run(const ConfigPtr& pConfig, const Options& options)
 	}
 	else
 	{
-		const uint16_t &nodeAPIPort = pContext->GetConfig().GetRestAPIPort();
+		const Config& config = pContext->GetConfig();
+		const uint16_t &nodeAPIPort = config.GetRestAPIPort();
 		const EServerType serverType = options.public_node_api
     									? EServerType::PUBLIC      // -> 0.0.0.0
     									: EServerType::LOCAL;      // -> 127.0.0.1
 
-		ServerPtr pServer = Server::Create(serverType, std::make_optional<uint16_t>(nodeAPIPort));
+		ServerPtr pServer = Server::Create(serverType, std::make_optional<uint16_t>(nodeAPIPort), config.GetRestAPIOptions());
 
-		pNode = Node::Create(pContext, pServer);
+		ServerPtr pFastLaneServer = nullptr;
+		if (config.GetFastLanePort().has_value()) {
+			pFastLaneServer = Server::Create(serverType, config.GetFastLanePort(), config.GetFastLaneOptions());
+		}
+
+		pNode = Node::Create(pContext, pServer, pFastLaneServer);
 		pNodeClient = pNode->GetNodeClient();
 	}
 	IO::Out("RPC Node Client started.");
@@ -2,6 +2,8 @@
 #include "../NodeContext.h"
 
 #include <Net/Util/HTTPUtil.h>
+#include <Net/Util/HTTPChunkedWriter.h>
+#include <Core/Util/JsonWriter.h>
 #include <Core/Models/CompactBlock.h>
 #include <Common/Util/StringUtil.h>
 #include <Common/Logger.h>
@@ -33,7 +35,7 @@ int BlockAPI::GetBlock_Handler(struct mg_connection* conn, void* pNodeContext)
 					pBlockChain->GetCompactBlockByHash(pBlock->GetHash());
 				if (pCompactBlock != nullptr)
 				{
-					return HTTPUtil::BuildSuccessResponse(conn, pCompactBlock->ToJSON().toStyledString());
+					return HTTPUtil::BuildSuccessResponseJSON(conn, pCompactBlock->ToJSON());
 				}
 			}
 		}
@@ -42,7 +44,23 @@ int BlockAPI::GetBlock_Handler(struct mg_connection* conn, void* pNodeContext)
 			std::unique_ptr<FullBlock> pFullBlock = GetBlock(requestedBlock, pBlockChain);
 			if (pFullBlock != nullptr)
 			{
-				return HTTPUtil::BuildSuccessResponse(conn, pFullBlock->ToJSON().toStyledString());
+				HTTPChunkedWriter chunkedWriter(conn);
+				chunkedWriter.Begin();
+
+				try
+				{
+					JsonWriter writer([&chunkedWriter](const char* pData, const size_t length) { chunkedWriter.Write(pData, length); });
+					pFullBlock->WriteJSON(writer);
+					writer.Flush();
+
+					return chunkedWriter.End();
+				}
+				catch (std::exception& e)
+				{
+					// Headers are already sent, so an error response can't be written.
+					LOG_ERROR_F("Failed to stream block: {}", e.what());
+					return chunkedWriter.Abort();
+				}
 			}
 		}
 	}
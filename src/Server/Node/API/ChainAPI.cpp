@@ -2,6 +2,8 @@
 #include "../NodeContext.h"
 
 #include <Net/Util/HTTPUtil.h>
+#include <Net/Util/HTTPChunkedWriter.h>
+#include <Core/Util/JsonWriter.h>
 #include <Common/Util/StringUtil.h>
 #include <Crypto/Crypto.h>
 #include <json/json.h>
@@ -76,46 +78,58 @@ int ChainAPI::GetChainOutputsByHeight_Handler(struct mg_connection* conn, void*
 			endHeight = startHeight;
 		}
 
-		Json::Value json;
-
 		std::vector<BlockWithOutputs> blocksWithOutputs = pServer->m_pBlockChain->GetOutputsByHeight(startHeight, endHeight);
-		for (const BlockWithOutputs& block : blocksWithOutputs)
+
+		HTTPChunkedWriter chunkedWriter(conn);
+		chunkedWriter.Begin();
+
+		try
 		{
-			/*
-
-			"header": {
-			  "hash": "40adad0aec27797b48840aa9e00472015c21baea118ce7a2ff1a82c0f8f5bf82",
-			  "height": 0,
-			  "previous": "0000000000000000000000000000000000000000000000000000000000000000"
-			},
-			"outputs": [
-			  {
-				"output_type": "Coinbase",
-				"commit": "08b7e57c448db5ef25aa119dde2312c64d7ff1b890c416c6dda5ec73cbfed2edea",
-				"spent": false,
-				"proof": null,
-				"proof_hash": "6c301688d9186c3a99444f827bdfe3b858fe87fc314737a4dc1155d9884491d2",
-				"block_height": 0,
-				"merkle_proof": "00000000000000010000000000000000",
-				"mmr_index": 1
-			  }
-			]
-			*/
-			Json::Value blockJSON;
-			blockJSON["header"] = block.GetBlockIdentifier().ToJSON();
-
-			Json::Value outputsJSON;
-			for (const OutputDTO& output : block.GetOutputs())
+			JsonWriter writer([&chunkedWriter](const char* pData, const size_t length) { chunkedWriter.Write(pData, length); });
+			writer.BeginArray();
+			for (const BlockWithOutputs& block : blocksWithOutputs)
 			{
-				outputsJSON.append(output.ToJSON());
+				/*
+
+				"header": {
+				  "hash": "40adad0aec27797b48840aa9e00472015c21baea118ce7a2ff1a82c0f8f5bf82",
+				  "height": 0,
+				  "previous": "0000000000000000000000000000000000000000000000000000000000000000"
+				},
+				"outputs": [
+				  {
+					"output_type": "Coinbase",
+					"commit": "08b7e57c448db5ef25aa119dde2312c64d7ff1b890c416c6dda5ec73cbfed2edea",
+					"spent": false,
+					"proof": null,
+					"proof_hash": "6c301688d9186c3a99444f827bdfe3b858fe87fc314737a4dc1155d9884491d2",
+					"block_height": 0,
+					"merkle_proof": "00000000000000010000000000000000",
+					"mmr_index": 1
+				  }
+				]
+				*/
+				writer.BeginObject();
+				writer.Value("header", block.GetBlockIdentifier().ToJSON());
+				writer.Key("outputs").BeginArray();
+				for (const OutputDTO& output : block.GetOutputs())
+				{
+					output.WriteJSON(writer);
+				}
+				writer.EndArray();
+				writer.EndObject();
 			}
+			writer.EndArray();
+			writer.Flush();
 
-			blockJSON["outputs"] = outputsJSON;
-
-			json.append(blockJSON);
+			return chunkedWriter.End();
+		}
+		catch (std::exception& e)
+		{
+			// Headers are already sent, so an error response can't be written.
+			LOG_ERROR_F("Failed to stream outputs: {}", e.what());
+			return chunkedWriter.Abort();
 		}
-
-		return HTTPUtil::BuildSuccessResponse(conn, json.toStyledString());
 	}
 	catch (std::exception& e)
 	{
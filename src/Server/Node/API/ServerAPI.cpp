@@ -1,6 +1,7 @@
 #include "ServerAPI.h"
 #include "../NodeContext.h"
 
+#include <Common/Metrics.h>
 #include <Net/Util/HTTPUtil.h>
 #include <P2P/Common.h>
 #include <json/json.h>
@@ -139,4 +140,17 @@ int ServerAPI::ResyncChain_Handler(struct mg_connection* conn, void* pNodeContex
 	pServer->m_pP2PServer->UnbanAllPeers();
 
 	return HTTPUtil::BuildSuccessResponse(conn, "");
-}
\ No newline at end of file
+}
+
+//
+// Serves every registered metric in the Prometheus text format, for scraping.
+//
+int ServerAPI::GetMetrics_Handler(struct mg_connection* conn, void*)
+{
+	if (HTTPUtil::GetHTTPMethod(conn) != HTTP::EHTTPMethod::GET)
+	{
+		return HTTPUtil::BuildBadRequestResponse(conn, "GET expected");
+	}
+
+	return HTTPUtil::BuildSuccessResponse(conn, Metrics::Registry::Get().Format(), "text/plain; version=0.0.4; charset=utf-8");
+}
@@ -12,6 +12,7 @@ public:
 	static int V1_Handler(struct mg_connection* conn, void* pVoid);
 	static int GetStatus_Handler(struct mg_connection* conn, void* pNodeContext);
 	static int ResyncChain_Handler(struct mg_connection* conn, void* pNodeContext);
+	static int GetMetrics_Handler(struct mg_connection* conn, void* pNodeContext);
 
 private:
 	static std::string GetStatusString(const SyncStatus& syncStatus);
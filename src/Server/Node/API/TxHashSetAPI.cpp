@@ -2,7 +2,9 @@
 #include "../NodeContext.h"
 
 #include <Net/Util/HTTPUtil.h>
+#include <Net/Util/HTTPChunkedWriter.h>
 #include <Common/Util/StringUtil.h>
+#include <Core/Util/JsonWriter.h>
 #include <Crypto/Hasher.h>
 #include <json/json.h>
 
@@ -236,35 +238,35 @@ int TxHashSetAPI::GetOutputs_Handler(struct mg_connection* conn, void* pNodeCont
 		auto pTxHashSet = pServer->m_pTxHashSetManager->GetTxHashSet();
 		if (pTxHashSet != nullptr)
 		{
-			Json::Value rootNode;
+			OutputRange range = pTxHashSet->GetOutputsByLeafIndex(*pServer->m_pBlockChain, startIndex, max);
 
-			auto pBlockDB = pServer->m_pDatabase->GetBlockDB()->Read();
-			OutputRange range = pTxHashSet->GetOutputsByLeafIndex(pBlockDB.GetShared(), startIndex, max);
-			rootNode["highest_index"] = range.GetHighestIndex();
-			rootNode["last_retrieved_index"] = range.GetLastRetrievedIndex();
+			// Outputs are encoded one at a time, rather than building one large json document.
+			HTTPChunkedWriter chunkedWriter(conn);
+			chunkedWriter.Begin();
 
-			Json::Value outputsNode;
-			for (const OutputDTO& info : range.GetOutputs())
+			try
 			{
-				Json::Value outputNode;
-				outputNode["output_type"] = OutputFeatures::ToString(info.GetIdentifier().GetFeatures());
-				outputNode["commit"] = info.GetIdentifier().GetCommitment().ToHex();
-				outputNode["spent"] = info.IsSpent();
-				outputNode["proof"] = info.GetRangeProof().Format();
-
-				Serializer proofSerializer;
-				info.GetRangeProof().Serialize(proofSerializer);
-				outputNode["proof_hash"] = Hasher::Blake2b(proofSerializer.GetBytes()).ToHex();
-
-				outputNode["block_height"] = info.GetLocation().GetBlockHeight();
-				outputNode["merkle_proof"] = Json::nullValue;
-				outputNode["mmr_index"] = info.GetLeafIndex().GetPosition() + 1;
-				outputsNode.append(outputNode);
-			}
-
-			rootNode["outputs"] = outputsNode;
+				JsonWriter writer([&chunkedWriter](const char* pData, const size_t length) { chunkedWriter.Write(pData, length); });
+				writer.BeginObject();
+				writer.UInt64("highest_index", range.GetHighestIndex());
+				writer.UInt64("last_retrieved_index", range.GetLastRetrievedIndex());
+				writer.Key("outputs").BeginArray();
+				for (const OutputDTO& info : range.GetOutputs())
+				{
+					info.WriteJSON(writer);
+				}
+				writer.EndArray();
+				writer.EndObject();
+				writer.Flush();
 
-			return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+				return chunkedWriter.End();
+			}
+			catch (std::exception& e)
+			{
+				// Headers are already sent, so an error response can't be written.
+				LOG_ERROR_F("Failed to stream outputs: {}", e.what());
+				return chunkedWriter.Abort();
+			}
 		}
 	}
 	catch (std::exception& e)
@@ -0,0 +1,107 @@
+#include "BlockTemplateBuilder.h"
+
+#include <Consensus.h>
+#include <Common/Logger.h>
+#include <Common/Metrics.h>
+#include <Common/Tracing.h>
+
+// How often the template picks up new mempool txs. New blocks always trigger a rebuild right away.
+static const std::chrono::seconds TX_REFRESH_INTERVAL(5);
+
+std::shared_ptr<const FullBlock> BlockTemplateBuilder::GetTemplate()
+{
+	BlockHeaderPtr pTip = m_pBlockChain->GetTipBlockHeader(EChainType::CONFIRMED);
+	if (pTip == nullptr)
+	{
+		return nullptr;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	const uint64_t poolVersion = m_pTransactionPool->GetMemPoolVersion();
+	if (m_pTemplate != nullptr && m_pTemplate->GetHeader()->GetPreviousHash() == pTip->GetHash())
+	{
+		const bool poolChanged = poolVersion != m_poolVersion;
+		if (!poolChanged || std::chrono::steady_clock::now() < m_builtAt + TX_REFRESH_INTERVAL)
+		{
+			return m_pTemplate;
+		}
+	}
+
+	std::shared_ptr<const FullBlock> pTemplate = BuildTemplate(*pTip);
+	if (pTemplate != nullptr)
+	{
+		m_pTemplate = pTemplate;
+		m_poolVersion = poolVersion;
+		m_builtAt = std::chrono::steady_clock::now();
+	}
+	else if (m_pTemplate != nullptr && m_pTemplate->GetHeader()->GetPreviousHash() != pTip->GetHash())
+	{
+		m_pTemplate = nullptr;
+	}
+
+	return m_pTemplate;
+}
+
+std::shared_ptr<const FullBlock> BlockTemplateBuilder::BuildTemplate(const BlockHeader& tip)
+{
+	static Metrics::Histogram& s_buildTime = Metrics::Registry::Get().AddHistogram(
+		"grinpp_mining_template_build_seconds",
+		"Time spent building a block template"
+	);
+
+	TRACE_SPAN("mining", "BlockTemplateBuilder::BuildTemplate");
+	Metrics::ScopedTimer timer(s_buildTime);
+
+	// Leave room for the coinbase output and kernel.
+	const uint64_t maxWeight = Consensus::MAX_BLOCK_WEIGHT - Consensus::CalculateWeightV5(0, 1, 1);
+	std::vector<TransactionPtr> transactions = m_pTransactionPool->GetTransactionsForBlock(maxWeight);
+
+	// Pool txs are revalidated on every block, so a failure here is rare. Mining an empty block beats not mining at all.
+	for (int attempt = 0; attempt < 2; attempt++)
+	{
+		uint64_t fees = 0;
+		for (const TransactionPtr& pTransaction : transactions)
+		{
+			fees += pTransaction->CalcFee();
+		}
+
+		std::optional<Coinbase> coinbaseOpt = m_pCoinbaseProvider->GetCoinbase(tip.GetHeight() + 1, fees);
+		if (!coinbaseOpt.has_value())
+		{
+			return nullptr;
+		}
+
+		std::unique_ptr<FullBlock> pBlock = m_pBlockChain->BuildBlockTemplate(
+			transactions,
+			coinbaseOpt.value().output,
+			coinbaseOpt.value().kernel
+		);
+		if (pBlock != nullptr)
+		{
+			// A new block arrived in the meantime. The next call builds on it instead.
+			if (pBlock->GetHeader()->GetPreviousHash() != tip.GetHash())
+			{
+				return nullptr;
+			}
+
+			LOG_DEBUG_F(
+				"Built template for block {} with {} txs and {} in fees",
+				pBlock->GetHeader()->GetHeight(),
+				transactions.size(),
+				fees
+			);
+			return std::shared_ptr<const FullBlock>(std::move(pBlock));
+		}
+
+		if (transactions.empty())
+		{
+			break;
+		}
+
+		LOG_WARNING_F("Failed to build template for block {} with {} txs. Retrying without txs.", tip.GetHeight() + 1, transactions.size());
+		transactions.clear();
+	}
+
+	return nullptr;
+}
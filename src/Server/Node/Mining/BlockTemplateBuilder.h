@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoinbaseProvider.h"
+
+#include <BlockChain/BlockChain.h>
+#include <TxPool/TransactionPool.h>
+#include <Core/Models/FullBlock.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+//
+// Keeps a block template on top of the confirmed tip, ready to hand out to miners.
+//
+// The template is cached, and only rebuilt when it goes stale: right away when the tip changes,
+// and at most every few seconds when the mempool changes, so a busy mempool doesn't keep
+// the chain locked with rebuilds that only add a little in fees.
+//
+class BlockTemplateBuilder
+{
+public:
+	BlockTemplateBuilder(
+		const IBlockChain::Ptr& pBlockChain,
+		const ITransactionPool::Ptr& pTransactionPool,
+		std::unique_ptr<CoinbaseProvider>&& pCoinbaseProvider
+	) : m_pBlockChain(pBlockChain),
+		m_pTransactionPool(pTransactionPool),
+		m_pCoinbaseProvider(std::move(pCoinbaseProvider)) { }
+
+	//
+	// Returns the current template, or nullptr if one can't be built, eg. because no coinbase is available.
+	// The header's nonce and proof of work are left for the miner to fill in.
+	//
+	std::shared_ptr<const FullBlock> GetTemplate();
+
+private:
+	std::shared_ptr<const FullBlock> BuildTemplate(const BlockHeader& tip);
+
+	IBlockChain::Ptr m_pBlockChain;
+	ITransactionPool::Ptr m_pTransactionPool;
+	std::unique_ptr<CoinbaseProvider> m_pCoinbaseProvider;
+
+	std::mutex m_mutex;
+	std::shared_ptr<const FullBlock> m_pTemplate;
+	uint64_t m_poolVersion{ 0 };
+	std::chrono::steady_clock::time_point m_builtAt;
+};
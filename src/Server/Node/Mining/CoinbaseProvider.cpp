@@ -0,0 +1,108 @@
+#include "CoinbaseProvider.h"
+
+#include <Consensus.h>
+#include <Common/Logger.h>
+#include <Core/Util/JsonUtil.h>
+#include <Crypto/Crypto.h>
+#include <Crypto/CSPRNG.h>
+#include <Crypto/Hasher.h>
+
+std::optional<Coinbase> CoinbaseProvider::GetCoinbase(const uint64_t height, const uint64_t fees)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (m_lastCoinbase.has_value() && m_lastHeight == height && m_lastFees == fees)
+	{
+		return m_lastCoinbase;
+	}
+
+	try
+	{
+		if (m_config.GetMiningWalletPort().has_value())
+		{
+			m_lastCoinbase = std::make_optional(RequestFromWallet(height, fees));
+		}
+		else if (m_config.ShouldBurnMiningReward())
+		{
+			LOG_WARNING_F("No mining wallet configured. Burning reward for block {}", height);
+			m_lastCoinbase = std::make_optional(BuildBurnCoinbase(fees));
+		}
+		else
+		{
+			LOG_ERROR("No mining wallet configured, and burning rewards is disabled");
+			return std::nullopt;
+		}
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Failed to build coinbase for block {}: {}", height, e.what());
+		m_lastCoinbase = std::nullopt;
+		return std::nullopt;
+	}
+
+	m_lastHeight = height;
+	m_lastFees = fees;
+	return m_lastCoinbase;
+}
+
+Coinbase CoinbaseProvider::RequestFromWallet(const uint64_t height, const uint64_t fees)
+{
+	Json::Value params;
+	params["session_token"] = m_config.GetMiningWalletSessionToken();
+	params["fees"] = fees;
+	params["height"] = height;
+	params["key_id"] = Json::nullValue;
+
+	const RPC::Request request = RPC::Request::BuildRequest("build_coinbase", params);
+	const RPC::Response response = m_pRPCClient->Invoke(
+		m_config.GetMiningWalletHost(),
+		"/v2/foreign",
+		m_config.GetMiningWalletPort().value(),
+		request
+	);
+
+	if (response.GetError().has_value())
+	{
+		throw RPC_EXCEPTION(response.GetError().value().GetMsg(), std::nullopt);
+	}
+
+	const Json::Value coinbaseJSON = JsonUtil::GetRequiredField(response.GetResult().value_or(Json::Value()), "Ok");
+	return Coinbase{
+		TransactionOutput::FromJSON(JsonUtil::GetRequiredField(coinbaseJSON, "output")),
+		TransactionKernel::FromJSON(JsonUtil::GetRequiredField(coinbaseJSON, "kernel"))
+	};
+}
+
+// Same as the wallet's coinbase, but with a random blinding factor that's thrown away.
+Coinbase CoinbaseProvider::BuildBurnCoinbase(const uint64_t fees)
+{
+	const uint64_t amount = Consensus::REWARD + fees;
+	const SecretKey blindingFactor = CSPRNG::GenerateRandom32();
+	Commitment commitment = Crypto::CommitBlinded(amount, BlindingFactor(blindingFactor.GetBytes()));
+
+	RangeProof rangeProof = Crypto::GenerateRangeProof(
+		amount,
+		blindingFactor,
+		CSPRNG::GenerateRandom32(),
+		CSPRNG::GenerateRandom32(),
+		ProofMessage()
+	);
+
+	Commitment kernelCommitment = Crypto::AddCommitments(
+		{ commitment },
+		{ Crypto::CommitTransparent(amount) }
+	);
+
+	Serializer serializer;
+	serializer.Append<uint8_t>((uint8_t)EKernelFeatures::COINBASE_KERNEL);
+
+	auto pSignature = Crypto::BuildCoinbaseSignature(
+		blindingFactor,
+		kernelCommitment,
+		Hasher::Blake2b(serializer.GetBytes())
+	);
+
+	return Coinbase{
+		TransactionOutput(EOutputFeatures::COINBASE_OUTPUT, std::move(commitment), std::move(rangeProof)),
+		TransactionKernel(EKernelFeatures::COINBASE_KERNEL, Fee(), 0, std::move(kernelCommitment), Signature(*pSignature))
+	};
+}
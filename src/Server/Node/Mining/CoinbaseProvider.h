@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Core/Config.h>
+#include <Core/Models/TransactionOutput.h>
+#include <Core/Models/TransactionKernel.h>
+#include <Net/Clients/RPC/RPCClient.h>
+#include <mutex>
+#include <optional>
+
+struct Coinbase
+{
+	TransactionOutput output;
+	TransactionKernel kernel;
+};
+
+//
+// Builds the coinbase output and kernel paying the block reward plus fees.
+// The wallet's foreign API builds them, so the node never needs the wallet's keys.
+// Without a wallet, the reward can be burned instead, by paying it to a random key nobody keeps.
+//
+class CoinbaseProvider
+{
+public:
+	CoinbaseProvider(const Config& config)
+		: m_config(config), m_pRPCClient(std::make_shared<HttpRpcClient>()) { }
+
+	//
+	// Returns nullopt if the wallet can't be reached, and burning rewards isn't enabled.
+	// The last coinbase is reused while the height and fees stay the same, since the wallet uses a new key for every call.
+	//
+	std::optional<Coinbase> GetCoinbase(const uint64_t height, const uint64_t fees);
+
+private:
+	Coinbase RequestFromWallet(const uint64_t height, const uint64_t fees);
+	static Coinbase BuildBurnCoinbase(const uint64_t fees);
+
+	const Config& m_config;
+	HttpRpcClient::Ptr m_pRPCClient;
+
+	std::mutex m_mutex;
+	uint64_t m_lastHeight{ 0 };
+	uint64_t m_lastFees{ 0 };
+	std::optional<Coinbase> m_lastCoinbase;
+};
@@ -0,0 +1,484 @@
+#include "StratumServer.h"
+
+#include <Consensus.h>
+#include <Common/Logger.h>
+#include <Common/Metrics.h>
+#include <Common/Util/HexUtil.h>
+#include <Common/Util/ThreadUtil.h>
+#include <Core/Global.h>
+#include <Core/Util/JsonUtil.h>
+#include <PoW/PoWValidator.h>
+#include <functional>
+
+// Error codes used by grin's stratum server, which miners already know how to handle.
+static const int ERROR_SYNCING = -32000;
+static const int ERROR_NOT_LOGGED_IN = -32500;
+static const int ERROR_LOW_DIFFICULTY = -32501;
+static const int ERROR_INVALID_SOLUTION = -32502;
+static const int ERROR_TOO_LATE = -32503;
+static const int ERROR_INVALID_REQUEST = -32600;
+static const int ERROR_METHOD_NOT_FOUND = -32601;
+
+static const size_t MAX_LINE_BYTES = 64 * 1024;
+static const size_t MAX_JOBS = 32;
+
+class StratumSession : public std::enable_shared_from_this<StratumSession>
+{
+public:
+	StratumSession(StratumServer& server, const std::shared_ptr<asio::ip::tcp::socket>& pSocket)
+		: m_server(server), m_pSocket(pSocket), m_buffer(MAX_LINE_BYTES) { }
+
+	void Start() { Read(); }
+
+	// Must be called on the asio thread.
+	void Send(const std::string& line)
+	{
+		m_writeQueue.push_back(line + "\n");
+		if (m_writeQueue.size() == 1)
+		{
+			Write();
+		}
+	}
+
+	void Close()
+	{
+		asio::error_code ignoreError;
+		m_pSocket->close(ignoreError);
+	}
+
+	bool IsLoggedIn() const noexcept { return m_loggedIn; }
+	const std::string& GetLogin() const noexcept { return m_login; }
+	void Login(const std::string& login)
+	{
+		m_login = login;
+		m_loggedIn = true;
+	}
+
+	uint64_t accepted{ 0 };
+	uint64_t rejected{ 0 };
+	uint64_t stale{ 0 };
+
+private:
+	void Read()
+	{
+		auto pSelf = shared_from_this();
+		asio::async_read_until(*m_pSocket, m_buffer, '\n', [pSelf](const asio::error_code& ec, const size_t numBytes) {
+			pSelf->OnRead(ec, numBytes);
+		});
+	}
+
+	void OnRead(const asio::error_code& ec, const size_t numBytes)
+	{
+		if (ec)
+		{
+			m_server.RemoveSession(shared_from_this());
+			return;
+		}
+
+		std::string line(asio::buffers_begin(m_buffer.data()), asio::buffers_begin(m_buffer.data()) + numBytes);
+		m_buffer.consume(numBytes);
+
+		std::optional<std::string> responseOpt = m_server.HandleRequest(*this, line);
+		if (responseOpt.has_value())
+		{
+			Send(responseOpt.value());
+		}
+
+		Read();
+	}
+
+	void Write()
+	{
+		auto pSelf = shared_from_this();
+		asio::async_write(*m_pSocket, asio::buffer(m_writeQueue.front()), [pSelf](const asio::error_code& ec, const size_t) {
+			if (ec)
+			{
+				pSelf->m_server.RemoveSession(pSelf);
+				return;
+			}
+
+			pSelf->m_writeQueue.pop_front();
+			if (!pSelf->m_writeQueue.empty())
+			{
+				pSelf->Write();
+			}
+		});
+	}
+
+	StratumServer& m_server;
+	std::shared_ptr<asio::ip::tcp::socket> m_pSocket;
+	asio::streambuf m_buffer;
+	std::deque<std::string> m_writeQueue;
+
+	bool m_loggedIn{ false };
+	std::string m_login;
+};
+
+static Metrics::Counter& GetShareCounter(const std::string& result)
+{
+	static Metrics::Counter& s_accepted = Metrics::Registry::Get().AddCounter(
+		"grinpp_stratum_shares_total", "Shares submitted by stratum miners, by result", { { "result", "accepted" } }
+	);
+	static Metrics::Counter& s_rejected = Metrics::Registry::Get().AddCounter(
+		"grinpp_stratum_shares_total", "Shares submitted by stratum miners, by result", { { "result", "rejected" } }
+	);
+	static Metrics::Counter& s_stale = Metrics::Registry::Get().AddCounter(
+		"grinpp_stratum_shares_total", "Shares submitted by stratum miners, by result", { { "result", "stale" } }
+	);
+
+	if (result == "accepted")
+	{
+		return s_accepted;
+	}
+
+	return result == "stale" ? s_stale : s_rejected;
+}
+
+StratumServer::StratumServer(const Config& config, const std::shared_ptr<NodeContext>& pNodeContext)
+	: m_config(config),
+	m_pNodeContext(pNodeContext),
+	m_templateBuilder(pNodeContext->m_pBlockChain, pNodeContext->m_pTransactionPool, std::make_unique<CoinbaseProvider>(config)),
+	m_pAsioContext(std::make_shared<asio::io_service>()),
+	m_pWork(std::make_unique<asio::io_service::work>(*m_pAsioContext))
+{
+
+}
+
+StratumServer::~StratumServer()
+{
+	LOG_INFO("Shutting down stratum server");
+	m_terminate = true;
+
+	m_pWork.reset();
+	m_pAsioContext->stop();
+
+	ThreadUtil::Join(m_jobThread);
+	ThreadUtil::Join(m_asioThread);
+}
+
+StratumServer::UPtr StratumServer::Create(const Config& config, const std::shared_ptr<NodeContext>& pNodeContext)
+{
+	std::unique_ptr<StratumServer> pServer(new StratumServer(config, pNodeContext));
+
+	// Local miners only, like grin's default.
+	pServer->m_pAcceptor = std::make_shared<asio::ip::tcp::acceptor>(
+		*pServer->m_pAsioContext,
+		asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), config.GetStratumPort())
+	);
+	pServer->m_pSocket = std::make_shared<asio::ip::tcp::socket>(*pServer->m_pAsioContext);
+	pServer->m_pAcceptor->async_accept(*pServer->m_pSocket, std::bind(&StratumServer::Accept, pServer.get(), std::placeholders::_1));
+
+	pServer->m_asioThread = std::thread(Thread_Asio, std::ref(*pServer));
+	pServer->m_jobThread = std::thread(Thread_Jobs, std::ref(*pServer));
+
+	LOG_INFO_F("Stratum server listening on port {}", config.GetStratumPort());
+	return pServer;
+}
+
+void StratumServer::Thread_Asio(StratumServer& server)
+{
+	LoggerAPI::SetThreadName("STRATUM");
+
+	while (!server.m_terminate) {
+		asio::error_code ec;
+		server.m_pAsioContext->run(ec);
+	}
+}
+
+//
+// Updates the job as soon as the tip or the mempool changes, which the tx pool signals for both.
+// The timeout picks up a mempool change once the template builder's tx refresh interval has passed, and checks for shutdown.
+//
+void StratumServer::Thread_Jobs(StratumServer& server)
+{
+	LoggerAPI::SetThreadName("STRATUM_JOBS");
+
+	uint64_t lastChange = 0;
+	while (!server.m_terminate && Global::IsRunning()) {
+		try {
+			server.UpdateJob();
+		}
+		catch (std::exception& e) {
+			LOG_WARNING_F("Exception thrown: {}", e.what());
+		}
+
+		lastChange = server.m_pNodeContext->m_pTransactionPool->WaitForChange(lastChange, std::chrono::seconds(1));
+	}
+}
+
+void StratumServer::Accept(const asio::error_code& ec)
+{
+	if (ec) {
+		return;
+	}
+
+	auto pSession = std::make_shared<StratumSession>(*this, m_pSocket);
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_sessions.insert(pSession);
+	}
+	pSession->Start();
+
+	m_pSocket = std::make_shared<asio::ip::tcp::socket>(*m_pAsioContext);
+	m_pAcceptor->async_accept(*m_pSocket, std::bind(&StratumServer::Accept, this, std::placeholders::_1));
+}
+
+void StratumServer::RemoveSession(const std::shared_ptr<StratumSession>& pSession)
+{
+	pSession->Close();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_sessions.erase(pSession);
+}
+
+void StratumServer::UpdateJob()
+{
+	if (IsSyncing()) {
+		return;
+	}
+
+	std::shared_ptr<const FullBlock> pTemplate = m_templateBuilder.GetTemplate();
+	if (pTemplate == nullptr) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (!m_jobs.empty() && m_jobs.back().pBlock == pTemplate) {
+		return;
+	}
+
+	BlockHeaderPtr pPrevious = m_pNodeContext->m_pBlockChain->GetBlockHeaderByHash(pTemplate->GetHeader()->GetPreviousHash());
+	if (pPrevious == nullptr) {
+		return;
+	}
+
+	// Jobs for earlier heights can never become blocks anymore.
+	if (!m_jobs.empty() && m_jobs.back().pBlock->GetHeader()->GetHeight() != pTemplate->GetHeader()->GetHeight()) {
+		m_jobs.clear();
+	}
+
+	m_jobs.push_back(Job{
+		m_nextJobId++,
+		pTemplate,
+		pTemplate->GetHeader()->GetTotalDifficulty() - pPrevious->GetTotalDifficulty()
+	});
+	while (m_jobs.size() > MAX_JOBS) {
+		m_jobs.pop_front();
+	}
+
+	Json::Value notification;
+	notification["id"] = "Stratum";
+	notification["jsonrpc"] = "2.0";
+	notification["method"] = "job";
+	notification["params"] = ToJSON(m_jobs.back());
+	const std::string line = JsonUtil::WriteCondensed(notification);
+
+	for (const auto& pSession : m_sessions) {
+		m_pAsioContext->post([pSession, line]() {
+			if (pSession->IsLoggedIn()) {
+				pSession->Send(line);
+			}
+		});
+	}
+}
+
+std::optional<std::string> StratumServer::HandleRequest(StratumSession& session, const std::string& line)
+{
+	Json::Value request;
+	if (!JsonUtil::Parse(line, request) || !request.isObject() || !request.isMember("method")) {
+		Json::Value response;
+		response["id"] = Json::nullValue;
+		response["jsonrpc"] = "2.0";
+		response["error"]["code"] = ERROR_INVALID_REQUEST;
+		response["error"]["message"] = "Invalid Request";
+		return JsonUtil::WriteCondensed(response);
+	}
+
+	const std::string method = request["method"].asString();
+	const Json::Value params = request.get("params", Json::Value());
+
+	Json::Value response;
+	response["id"] = request.get("id", Json::Value());
+	response["jsonrpc"] = "2.0";
+	response["method"] = method;
+
+	const auto setError = [&response](const int code, const std::string& message) {
+		response["result"] = Json::nullValue;
+		response["error"]["code"] = code;
+		response["error"]["message"] = message;
+	};
+
+	try {
+		if (method == "login") {
+			session.Login(params.get("login", "").asString());
+			LOG_INFO_F("Miner logged in: {}", session.GetLogin());
+			response["result"] = "ok";
+		} else if (method == "keepalive") {
+			response["result"] = "ok";
+		} else if (method == "getjobtemplate") {
+			std::optional<Json::Value> jobOpt = GetCurrentJob();
+			if (IsSyncing() || !jobOpt.has_value()) {
+				setError(ERROR_SYNCING, "Node is syncing - Please wait");
+			} else {
+				response["result"] = jobOpt.value();
+			}
+		} else if (method == "submit") {
+			if (!session.IsLoggedIn()) {
+				setError(ERROR_NOT_LOGGED_IN, "Login first");
+			} else if (IsSyncing()) {
+				setError(ERROR_SYNCING, "Node is syncing - Please wait");
+			} else {
+				Json::Value error = Submit(session, params);
+				if (error.isNull()) {
+					response["result"] = "ok";
+				} else {
+					response["result"] = Json::nullValue;
+					response["error"] = error;
+				}
+			}
+		} else if (method == "status") {
+			Json::Value status;
+			status["id"] = session.GetLogin();
+			status["height"] = m_pNodeContext->m_pBlockChain->GetHeight(EChainType::CONFIRMED);
+			status["difficulty"] = m_config.GetShareDifficulty();
+			status["accepted"] = session.accepted;
+			status["rejected"] = session.rejected;
+			status["stale"] = session.stale;
+			response["result"] = status;
+		} else {
+			setError(ERROR_METHOD_NOT_FOUND, "Method not found");
+		}
+	}
+	catch (std::exception& e) {
+		LOG_WARNING_F("Failed to handle stratum request {}: {}", method, e.what());
+		setError(ERROR_INVALID_REQUEST, "Invalid Request");
+	}
+
+	return JsonUtil::WriteCondensed(response);
+}
+
+// Returns the error, or a null value if the share was accepted.
+Json::Value StratumServer::Submit(StratumSession& session, const Json::Value& params)
+{
+	const auto error = [](const int code, const std::string& message) {
+		Json::Value errorJSON;
+		errorJSON["code"] = code;
+		errorJSON["message"] = message;
+		return errorJSON;
+	};
+
+	const uint64_t jobId = JsonUtil::GetRequiredUInt64(params, "job_id");
+	const uint64_t height = JsonUtil::GetRequiredUInt64(params, "height");
+	const uint64_t nonce = JsonUtil::GetRequiredUInt64(params, "nonce");
+	const uint8_t edgeBits = JsonUtil::GetRequiredUInt8(params, "edge_bits");
+
+	std::vector<uint64_t> proofNonces;
+	for (const Json::Value& proofNonce : JsonUtil::GetRequiredArray(params, "pow")) {
+		proofNonces.push_back(JsonUtil::ConvertToUInt64(proofNonce));
+	}
+
+	std::optional<Job> jobOpt;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (const Job& job : m_jobs) {
+			if (job.id == jobId && job.pBlock->GetHeader()->GetHeight() == height) {
+				jobOpt = std::make_optional(job);
+			}
+		}
+	}
+
+	if (!jobOpt.has_value()) {
+		session.stale++;
+		GetShareCounter("stale").Increment();
+		return error(ERROR_TOO_LATE, "Solution submitted too late");
+	}
+
+	if (proofNonces.size() != Consensus::PROOFSIZE) {
+		session.rejected++;
+		GetShareCounter("rejected").Increment();
+		return error(ERROR_INVALID_SOLUTION, "Failed to validate solution");
+	}
+
+	const BlockHeader& tmpl = *jobOpt.value().pBlock->GetHeader();
+	auto pHeader = std::make_shared<BlockHeader>(
+		tmpl.GetVersion(),
+		tmpl.GetHeight(),
+		tmpl.GetTimestamp(),
+		Hash(tmpl.GetPreviousHash()),
+		Hash(tmpl.GetPreviousRoot()),
+		Hash(tmpl.GetOutputRoot()),
+		Hash(tmpl.GetRangeProofRoot()),
+		Hash(tmpl.GetKernelRoot()),
+		BlindingFactor(tmpl.GetTotalKernelOffset()),
+		tmpl.GetOutputMMRSize(),
+		tmpl.GetKernelMMRSize(),
+		tmpl.GetTotalDifficulty(),
+		tmpl.GetScalingDifficulty(),
+		nonce,
+		ProofOfWork(edgeBits, std::move(proofNonces))
+	);
+
+	if (!PoWValidator::IsCycleValid(*pHeader)) {
+		session.rejected++;
+		GetShareCounter("rejected").Increment();
+		return error(ERROR_INVALID_SOLUTION, "Failed to validate solution");
+	}
+
+	const uint64_t shareDifficulty = PoWValidator::GetMaximumDifficulty(*pHeader);
+	if (shareDifficulty < m_config.GetShareDifficulty()) {
+		session.rejected++;
+		GetShareCounter("rejected").Increment();
+		return error(ERROR_LOW_DIFFICULTY, "Share rejected due to low difficulty");
+	}
+
+	session.accepted++;
+	GetShareCounter("accepted").Increment();
+
+	if (shareDifficulty >= jobOpt.value().networkDifficulty) {
+		static Metrics::Counter& s_blocksFound = Metrics::Registry::Get().AddCounter(
+			"grinpp_mining_blocks_found_total",
+			"Blocks mined by stratum miners and accepted by the chain"
+		);
+
+		const FullBlock block(pHeader, TransactionBody(jobOpt.value().pBlock->GetTransactionBody()));
+		const EBlockChainStatus status = m_pNodeContext->m_pBlockChain->AddBlock(block);
+		if (status == EBlockChainStatus::SUCCESS) {
+			LOG_INFO_F("Mined block {} at height {}", *pHeader, pHeader->GetHeight());
+			s_blocksFound.Increment();
+			m_pNodeContext->m_pP2PServer->BroadcastBlock(pHeader);
+		} else {
+			LOG_WARNING_F("Mined block {} was not accepted by the chain", *pHeader);
+		}
+	}
+
+	return Json::Value();
+}
+
+std::optional<Json::Value> StratumServer::GetCurrentJob() const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (m_jobs.empty()) {
+		return std::nullopt;
+	}
+
+	return std::make_optional(ToJSON(m_jobs.back()));
+}
+
+Json::Value StratumServer::ToJSON(const Job& job) const
+{
+	// The pre-proof-of-work ends with the nonce, which miners append themselves.
+	std::vector<uint8_t> prePoW = job.pBlock->GetHeader()->GetPreProofOfWork();
+	prePoW.resize(prePoW.size() - sizeof(uint64_t));
+
+	Json::Value jobJSON;
+	jobJSON["difficulty"] = m_config.GetShareDifficulty();
+	jobJSON["height"] = job.pBlock->GetHeader()->GetHeight();
+	jobJSON["job_id"] = job.id;
+	jobJSON["pre_pow"] = HexUtil::ConvertToHex(prePoW);
+	return jobJSON;
+}
+
+bool StratumServer::IsSyncing() const
+{
+	return m_pNodeContext->m_pP2PServer->GetSyncStatus()->IsSyncing();
+}
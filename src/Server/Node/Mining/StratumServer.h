@@ -0,0 +1,79 @@
+#pragma once
+
+#include "BlockTemplateBuilder.h"
+#include "../NodeContext.h"
+
+#include <Core/Config.h>
+#include <asio.hpp>
+#include <json/json.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+// Forward Declarations
+class StratumSession;
+
+//
+// Local stratum server, speaking the same line-delimited JSON-RPC protocol as grin's, so existing miners work with it.
+//
+// Methods: login, getjobtemplate, submit, keepalive and status.
+// New jobs are pushed to logged in miners whenever the block template changes.
+// Shares meeting the network difficulty are added to the chain and broadcast as blocks.
+//
+class StratumServer
+{
+public:
+	using UPtr = std::unique_ptr<StratumServer>;
+
+	static UPtr Create(const Config& config, const std::shared_ptr<NodeContext>& pNodeContext);
+	~StratumServer();
+
+	//
+	// Handles a single request line. Returns the response line, if the request gets one.
+	//
+	std::optional<std::string> HandleRequest(StratumSession& session, const std::string& line);
+
+	void RemoveSession(const std::shared_ptr<StratumSession>& pSession);
+
+private:
+	struct Job
+	{
+		uint64_t id;
+		std::shared_ptr<const FullBlock> pBlock;
+		uint64_t networkDifficulty;
+	};
+
+	StratumServer(const Config& config, const std::shared_ptr<NodeContext>& pNodeContext);
+
+	static void Thread_Asio(StratumServer& server);
+	static void Thread_Jobs(StratumServer& server);
+
+	void Accept(const asio::error_code& ec);
+	void UpdateJob();
+
+	Json::Value Submit(StratumSession& session, const Json::Value& params);
+	std::optional<Json::Value> GetCurrentJob() const;
+	Json::Value ToJSON(const Job& job) const;
+	bool IsSyncing() const;
+
+	const Config& m_config;
+	std::shared_ptr<NodeContext> m_pNodeContext;
+	BlockTemplateBuilder m_templateBuilder;
+
+	std::shared_ptr<asio::io_service> m_pAsioContext;
+	std::unique_ptr<asio::io_service::work> m_pWork;
+	std::shared_ptr<asio::ip::tcp::acceptor> m_pAcceptor;
+	std::shared_ptr<asio::ip::tcp::socket> m_pSocket;
+
+	mutable std::mutex m_mutex;
+	std::set<std::shared_ptr<StratumSession>> m_sessions;
+	std::deque<Job> m_jobs; // Oldest first. Older jobs are kept briefly, so late shares can still be checked.
+	uint64_t m_nextJobId{ 0 };
+
+	std::atomic_bool m_terminate{ false };
+	std::thread m_asioThread;
+	std::thread m_jobThread;
+};
@@ -18,10 +18,12 @@
 Node::Node(
 	const Context::Ptr& pContext,
 	std::unique_ptr<NodeRPCServer>&& pNodeRPCServer,
-	std::shared_ptr<DefaultNodeClient> pNodeClient)
+	std::shared_ptr<DefaultNodeClient> pNodeClient,
+	StratumServer::UPtr&& pStratumServer)
 	: m_pContext(pContext),
 	m_pNodeRPCServer(std::move(pNodeRPCServer)),
-	m_pNodeClient(pNodeClient)
+	m_pNodeClient(pNodeClient),
+	m_pStratumServer(std::move(pStratumServer))
 {
 
 }
@@ -29,21 +31,36 @@ Node::Node(
 Node::~Node()
 {
 	LOG_INFO("Shutting down node daemon");
+	m_pStratumServer.reset();
 }
 
-std::unique_ptr<Node> Node::Create(const Context::Ptr& pContext, const ServerPtr& pServer)
+std::unique_ptr<Node> Node::Create(const Context::Ptr& pContext, const ServerPtr& pServer, const ServerPtr& pFastLaneServer)
 {
     auto pNodeClient = DefaultNodeClient::Create(pContext);
     auto pNodeRPCServer = NodeRPCServer::Create(
         pServer,
+        pFastLaneServer,
         pNodeClient->GetNodeContext()
     );
 
+	StratumServer::UPtr pStratumServer = nullptr;
+	if (pContext->GetConfig().IsStratumEnabled())
+	{
+		try
+		{
+			pStratumServer = StratumServer::Create(pContext->GetConfig(), pNodeClient->GetNodeContext());
+		}
+		catch (std::exception& e)
+		{
+			LOG_ERROR_F("Failed to start stratum server: {}", e.what());
+		}
+	}
 
 	return std::make_unique<Node>(
 		pContext,
 		std::move(pNodeRPCServer),
-		pNodeClient
+		pNodeClient,
+		std::move(pStratumServer)
 	);
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "NodeRPCServer.h"
+#include "Mining/StratumServer.h"
 
 #include <Core/Config.h>
 #include <Wallet/NodeClient.h>
@@ -14,12 +15,17 @@ class DefaultNodeClient;
 class Node
 {
 public:
-	static std::unique_ptr<Node> Create(const std::shared_ptr<Context>& pContext, const ServerPtr& pServer);
+	static std::unique_ptr<Node> Create(
+		const std::shared_ptr<Context>& pContext,
+		const ServerPtr& pServer,
+		const ServerPtr& pFastLaneServer
+	);
 
 	Node(
 		const std::shared_ptr<Context>& pContext,
 		std::unique_ptr<NodeRPCServer>&& pNodeRPCServer,
-		std::shared_ptr<DefaultNodeClient> pNodeClient
+		std::shared_ptr<DefaultNodeClient> pNodeClient,
+		StratumServer::UPtr&& pStratumServer
 	);
 	~Node();
 
@@ -31,4 +37,5 @@ private:
 	std::shared_ptr<Context> m_pContext;
 	std::unique_ptr<NodeRPCServer> m_pNodeRPCServer;
 	std::shared_ptr<DefaultNodeClient> m_pNodeClient;
+	StratumServer::UPtr m_pStratumServer;
 };
\ No newline at end of file
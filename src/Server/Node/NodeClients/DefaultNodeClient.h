@@ -42,6 +42,15 @@ public:
 			pTransactionPool,
 			pHeaderMMR
 		);
+
+		// Restored before any peers connect, so compact blocks can be hydrated from the start.
+		auto pTipHeader = pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED);
+		auto pTxHashSet = pTxHashSetManager->GetTxHashSet();
+		if (pTipHeader != nullptr && pTxHashSet != nullptr) {
+			auto pBlockDB = pDatabase->GetBlockDB()->Read();
+			pTransactionPool->LoadSnapshot(pBlockDB.GetShared(), pTxHashSet, *pTipHeader);
+		}
+
 		auto pP2PServer = P2PAPI::StartP2PServer(
 			pContext,
 			pBlockChainServer,
@@ -114,9 +123,8 @@ public:
 			return std::unique_ptr<OutputRange>(nullptr);
 		}
 
-		auto pBlockDB = m_pDatabase->GetBlockDB()->Read();
 		return std::make_unique<OutputRange>(
-			pTxHashSet->GetOutputsByLeafIndex(pBlockDB.GetShared(), startIndex, maxNumOutputs)
+			pTxHashSet->GetOutputsByLeafIndex(*m_pBlockChain, startIndex, maxNumOutputs)
 		);
 	}
 
@@ -5,6 +5,7 @@
 #include <Core/Exceptions/UnimplementedException.h>
 #include <Common/Macros.h>
 #include <memory>
+#include <set>
 
 // TODO: Implement caching & retry policies
 class RPCNodeClient : public INodeClient
@@ -22,7 +23,7 @@ public:
 	static INodeClientPtr Create(const std::string& host, const uint16_t port)
 	{
 		auto pConnection = HttpConnection::Connect(host, port);
-		auto response = pConnection->Invoke("get_version", "/v2/foreign");
+		auto response = pConnection->Invoke("/v2/foreign", "get_version");
 		if (!response.GetResult().has_value()) {
 			throw std::exception();
 		}
@@ -64,25 +65,64 @@ public:
 		return BlockHeader::FromJSON(Invoke("get_header", params));
 	}
 
+	//
+	// Returns the headers of the confirmed blocks at the given heights, requested as a single batch.
+	//
+	std::map<uint64_t, BlockHeaderPtr> GetBlockHeaders(const std::set<uint64_t>& heights) const final
+	{
+		std::vector<RPC::Request> requests;
+		for (const uint64_t height : heights)
+		{
+			Json::Value params = Json::Value(Json::arrayValue);
+			params.append(Json::UInt64(height));
+			params.append(Json::nullValue);
+			params.append(Json::nullValue);
+
+			requests.push_back(RPC::Request::BuildRequest("get_header", params));
+		}
+
+		std::vector<RPC::Response> responses = m_pConnection->InvokeBatch("/v2/foreign", requests);
+
+		std::map<uint64_t, BlockHeaderPtr> headers;
+		auto heightIter = heights.cbegin();
+		for (const RPC::Response& response : responses)
+		{
+			const uint64_t height = *heightIter++;
+
+			// Heights beyond the tip come back as an "Err" result.
+			if (response.GetResult().has_value() && response.GetResult().value().isMember("Ok"))
+			{
+				headers.insert({ height, BlockHeader::FromJSON(response.GetResult().value()["Ok"]) });
+			}
+		}
+
+		return headers;
+	}
+
 	//
 	// Returns the location (block height and mmr index) of each requested output, if it is *unspent*.
 	//
 	std::map<Commitment, OutputLocation> GetOutputsByCommitment(const std::vector<Commitment>& commitments) const final
 	{
-		Json::Value commitsJson;
+		if (commitments.empty())
+		{
+			return {};
+		}
+
+		Json::Value commitsJson(Json::arrayValue);
 		for (const Commitment& commit : commitments)
 		{
 			commitsJson.append(commit.ToHex());
 		}
 
-		Json::Value params;
+		Json::Value params(Json::arrayValue);
 		params.append(commitsJson);
 		params.append(Json::nullValue);
 		params.append(Json::nullValue);
 		params.append(false);
 		params.append(false);
 
-		auto response = Invoke("get_outputs");
+		auto response = Invoke("get_outputs", params);
 
 		std::map<Commitment, OutputLocation> outputsByCommitment;
 		for (const auto& output : response)
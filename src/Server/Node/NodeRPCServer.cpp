@@ -18,9 +18,13 @@ static int Shutdown_Handler(struct mg_connection* conn, void*)
 	return HTTPUtil::BuildSuccessResponse(conn, "");
 }
 
-NodeRPCServer::UPtr NodeRPCServer::Create(const ServerPtr& pServer, std::shared_ptr<NodeContext> pNodeContext)
+NodeRPCServer::UPtr NodeRPCServer::Create(
+	const ServerPtr& pServer,
+	const ServerPtr& pFastLaneServer,
+	std::shared_ptr<NodeContext> pNodeContext)
 {
 	NodeServer::UPtr pServerV2 = NodeServer::Create(pServer,
+													pFastLaneServer,
 													pNodeContext->m_pBlockChain,
 													pNodeContext->m_pP2PServer,
 													pNodeContext->m_pTxHashSetManager->GetTxHashSet(),
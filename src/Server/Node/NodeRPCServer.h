@@ -13,7 +13,11 @@ public:
 		: m_pNodeContext(pNodeContext), m_pNodeServer(std::move(pNodeServer)) { }
 	~NodeRPCServer() = default;
 
-	static NodeRPCServer::UPtr Create(const ServerPtr& pServer, std::shared_ptr<NodeContext> pNodeContext);
+	static NodeRPCServer::UPtr Create(
+		const ServerPtr& pServer,
+		const ServerPtr& pFastLaneServer,
+		std::shared_ptr<NodeContext> pNodeContext
+	);
 
 private:
 	std::shared_ptr<NodeContext> m_pNodeContext;
@@ -21,9 +21,10 @@ static int Shutdown_Handler(struct mg_connection* conn, void*)
 NodeRestServer::UPtr NodeRestServer::Create(const Config& config, std::shared_ptr<NodeContext> pNodeContext)
 {
 	const uint16_t port = config.GetRestAPIPort();
-	ServerPtr pServer = Server::Create(EServerType::LOCAL, std::make_optional<uint16_t>(port));
+	ServerPtr pServer = Server::Create(EServerType::LOCAL, std::make_optional<uint16_t>(port), config.GetRestAPIOptions());
 	NodeServer::UPtr pV2Server = NodeServer::Create(
 		pServer,
+		nullptr,
 		pNodeContext->m_pBlockChain,
 		pNodeContext->m_pP2PServer,
 		pNodeContext->m_pTxHashSetManager->GetTxHashSet(),
@@ -47,6 +48,7 @@ NodeRestServer::UPtr NodeRestServer::Create(const Config& config, std::shared_pt
 	pServer->AddListener("/v1/txhashset/lastrangeproofs", TxHashSetAPI::GetLastRangeproofs_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/txhashset/outputs", TxHashSetAPI::GetOutputs_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/shutdown", Shutdown_Handler, pNodeContext.get());
+	pServer->AddListener("/metrics", ServerAPI::GetMetrics_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/", ServerAPI::V1_Handler, pNodeContext.get());
 
 	return std::make_unique<NodeRestServer>(pNodeContext, std::move(pV2Server));
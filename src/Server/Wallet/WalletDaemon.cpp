@@ -28,7 +28,8 @@ std::unique_ptr<WalletDaemon> WalletDaemon::Create(
 
 	auto pOwnerServer = OwnerServer::Create(
 		pTorProcess,
-		pWalletManager
+		pWalletManager,
+		config.GetOwnerAPIOptions()
 	);
 
 	return std::make_unique<WalletDaemon>(
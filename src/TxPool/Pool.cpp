@@ -1,17 +1,47 @@
 #include "Pool.h"
 #include "ValidTransactionFinder.h"
 
+#include <Consensus.h>
 #include <Core/Util/TransactionUtil.h>
+#include <Core/Serialization/Serializer.h>
 #include <Common/Logger.h>
 #include <algorithm>
 #include <unordered_map>
+#include <unordered_set>
 #include <chrono>
 
+// Rough memory used by an entry beyond its serialized tx: the tx object itself, the entry and its index nodes.
+static const uint64_t ENTRY_OVERHEAD_BYTES = sizeof(Transaction) + sizeof(TxPoolEntry) + 256;
+
+uint64_t Pool::CalculateWeight(const Transaction& transaction)
+{
+	return Consensus::CalculateWeightV5(
+		transaction.GetInputs().size(),
+		transaction.GetOutputs().size(),
+		transaction.GetKernels().size()
+	);
+}
+
+uint64_t Pool::EstimateBytes(const Transaction& transaction)
+{
+	Serializer serializer;
+	transaction.Serialize(serializer);
+	return serializer.size() + ENTRY_OVERHEAD_BYTES;
+}
+
+double Pool::CalculateFeeRate(const Transaction& transaction, const uint64_t weight)
+{
+	// The fee shift lowers a tx's priority, the same way it lowers the fee it needs to pay.
+	const uint64_t fee = transaction.CalcFee() >> transaction.GetFeeShift();
+	return (double)fee / (double)(std::max)(weight, (uint64_t)1);
+}
+
 std::vector<TransactionPtr> Pool::GetTransactionsByShortId(const Hash& hash, const uint64_t nonce, const std::set<ShortId>& missingShortIds) const
 {
 	std::vector<TransactionPtr> transactionsFound;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const auto& entry : m_transactions)
 	{
+		const TxPoolEntry& txPoolEntry = entry.second;
 		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
 		{
 			const ShortId shortId = ShortId::Create(kernel.GetHash(), hash, nonce);
@@ -30,32 +60,87 @@ std::vector<TransactionPtr> Pool::GetTransactionsByShortId(const Hash& hash, con
 	return transactionsFound;
 }
 
-void Pool::AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status)
+std::vector<TransactionPtr> Pool::AddTransaction(
+	TransactionPtr pTransaction,
+	const EDandelionStatus status,
+	const std::optional<std::chrono::system_clock::time_point>& timestampOpt)
 {
+	if (m_sequenceByHash.find(pTransaction->GetHash()) != m_sequenceByHash.end())
+	{
+		LOG_DEBUG_F("Transaction already in pool: {}", pTransaction->GetHash());
+		return {};
+	}
+
 	LOG_DEBUG_F("Transaction added: {}", pTransaction->GetHash());
 
-	const auto now = std::chrono::system_clock::now();
-	m_transactions.emplace_back(TxPoolEntry(pTransaction, status, now));
+	const auto timestamp = timestampOpt.value_or(std::chrono::system_clock::now());
+	const uint64_t weight = CalculateWeight(*pTransaction);
+	const uint64_t numBytes = EstimateBytes(*pTransaction);
+	const double feeRate = CalculateFeeRate(*pTransaction, weight);
+	AddEntry(m_nextSequence++, TxPoolEntry(pTransaction, status, timestamp, weight, numBytes, feeRate));
+
+	std::vector<TransactionPtr> evicted;
+	while ((m_totalWeight > m_maxWeight || m_totalBytes > m_maxBytes) && !m_byFeeRate.empty())
+	{
+		for (const uint64_t sequence : GetDescendants(m_byFeeRate.begin()->sequence))
+		{
+			auto iter = m_transactions.find(sequence);
+			if (iter != m_transactions.end())
+			{
+				LOG_DEBUG_F("Evicting transaction {} with fee rate {}", iter->second.GetTransaction()->GetHash(), iter->second.GetFeeRate());
+				evicted.push_back(iter->second.GetTransaction());
+				RemoveEntry(iter);
+			}
+		}
+	}
+
+	return evicted;
 }
 
-bool Pool::ContainsTransaction(const Transaction& transaction) const
+bool Pool::MeetsEvictionFloor(const Transaction& transaction) const
 {
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	const uint64_t weight = CalculateWeight(transaction);
+	const uint64_t numBytes = EstimateBytes(transaction);
+	if (weight > m_maxWeight || numBytes > m_maxBytes)
+	{
+		return false;
+	}
+
+	uint64_t freeWeight = m_maxWeight - (std::min)(m_totalWeight, m_maxWeight);
+	uint64_t freeBytes = m_maxBytes - (std::min)(m_totalBytes, m_maxBytes);
+
+	const double feeRate = CalculateFeeRate(transaction, weight);
+	for (const PriorityKey& key : m_byFeeRate)
 	{
-		if (*txPoolEntry.GetTransaction() == transaction)
+		if (freeWeight >= weight && freeBytes >= numBytes)
 		{
 			return true;
 		}
+
+		if (key.feeRate >= feeRate)
+		{
+			return false;
+		}
+
+		const TxPoolEntry& entry = m_transactions.at(key.sequence);
+		freeWeight += entry.GetWeight();
+		freeBytes += entry.GetNumBytes();
 	}
 
-	return false;
+	return freeWeight >= weight && freeBytes >= numBytes;
+}
+
+bool Pool::ContainsTransaction(const Transaction& transaction) const
+{
+	return m_sequenceByHash.find(transaction.GetHash()) != m_sequenceByHash.end();
 }
 
 std::vector<TransactionPtr> Pool::FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const
 {
 	std::set<TransactionPtr> transactionSet;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const auto& entry : m_transactions)
 	{
+		const TxPoolEntry& txPoolEntry = entry.second;
 		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
 		{
 			if (kernels.count(kernel) > 0)
@@ -73,8 +158,9 @@ std::vector<TransactionPtr> Pool::FindTransactionsByKernel(const std::set<Transa
 
 TransactionPtr Pool::FindTransactionByKernelHash(const Hash& kernelHash) const
 {
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const auto& entry : m_transactions)
 	{
+		const TxPoolEntry& txPoolEntry = entry.second;
 		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
 		{
 			if (kernel.GetHash() == kernelHash)
@@ -90,11 +176,11 @@ TransactionPtr Pool::FindTransactionByKernelHash(const Hash& kernelHash) const
 std::vector<TransactionPtr> Pool::FindTransactionsByStatus(const EDandelionStatus status) const
 {
 	std::vector<TransactionPtr> transactions;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const TxPoolEntry* pEntry : GetEntriesByPriority())
 	{
-		if (txPoolEntry.GetStatus() == status)
+		if (pEntry->GetStatus() == status)
 		{
-			transactions.push_back(txPoolEntry.GetTransaction());
+			transactions.push_back(pEntry->GetTransaction());
 		}
 	}
 
@@ -106,8 +192,9 @@ std::vector<TransactionPtr> Pool::GetExpiredTransactions(const uint16_t embargoS
 	const auto cutoff = std::chrono::system_clock::now() - std::chrono::seconds(embargoSeconds);
 
 	std::vector<TransactionPtr> transactions;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const auto& entry : m_transactions)
 	{
+		const TxPoolEntry& txPoolEntry = entry.second;
 		if (txPoolEntry.GetTimestamp() < cutoff)
 		{
 			transactions.push_back(txPoolEntry.GetTransaction());
@@ -117,18 +204,58 @@ std::vector<TransactionPtr> Pool::GetExpiredTransactions(const uint16_t embargoS
 	return transactions;
 }
 
-void Pool::RemoveTransaction(const Transaction& transaction)
+std::vector<TransactionPtr> Pool::SelectForBlock(const uint64_t maxWeight) const
 {
-	auto iter = m_transactions.begin();
-	while (iter != m_transactions.end())
+	std::vector<TransactionPtr> selected;
+	std::set<uint64_t> selectedSequences;
+	std::unordered_set<Commitment> spent;
+	uint64_t totalWeight = 0;
+
+	for (const TxPoolEntry* pEntry : GetEntriesByPriority())
 	{
-		if (transaction == *iter->GetTransaction())
+		// Cut-through can only lower the weight of the aggregate, so this never overshoots.
+		if (totalWeight + pEntry->GetWeight() > maxWeight)
+		{
+			continue;
+		}
+
+		const std::vector<TransactionInput>& inputs = pEntry->GetTransaction()->GetInputs();
+		const bool canInclude = std::all_of(
+			inputs.cbegin(), inputs.cend(),
+			[this, &spent, &selectedSequences](const TransactionInput& input) {
+				if (spent.count(input.GetCommitment()) > 0)
+				{
+					return false;
+				}
+
+				auto output_iter = m_outputs.find(input.GetCommitment());
+				return output_iter == m_outputs.end() || selectedSequences.count(output_iter->second) > 0;
+			}
+		);
+		if (!canInclude)
 		{
-			m_transactions.erase(iter);
-			break;
+			continue;
 		}
 
-		++iter;
+		for (const TransactionInput& input : inputs)
+		{
+			spent.insert(input.GetCommitment());
+		}
+
+		selected.push_back(pEntry->GetTransaction());
+		selectedSequences.insert(m_sequenceByHash.at(pEntry->GetTransaction()->GetHash()));
+		totalWeight += pEntry->GetWeight();
+	}
+
+	return selected;
+}
+
+void Pool::RemoveTransaction(const Transaction& transaction)
+{
+	auto sequence_iter = m_sequenceByHash.find(transaction.GetHash());
+	if (sequence_iter != m_sequenceByHash.end())
+	{
+		RemoveEntry(m_transactions.find(sequence_iter->second));
 	}
 }
 
@@ -137,22 +264,26 @@ void Pool::RemoveTransaction(const Transaction& transaction)
 void Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block, TransactionPtr pMemPoolAggTx)
 {
 	std::vector<TransactionPtr> filteredTransactions;
-	std::unordered_map<Hash, TxPoolEntry> filteredEntriesByHash;
+	std::unordered_map<Hash, std::pair<uint64_t, TxPoolEntry>> filteredEntriesByHash;
 
 	// Filter txs in the pool based on the latest block.
 	// Reject any txs where we see a matching tx kernel in the block.
 	// Also reject any txs where we see a conflicting tx,
 	// where an input is spent in a different tx.
-	for (auto& txPoolEntry : m_transactions)
+	// Txs are checked highest fee rate first, so when two txs in the pool conflict, the better paying one is kept.
+	for (const TxPoolEntry* pEntry : GetEntriesByPriority())
 	{
-		if (!ShouldEvict(*txPoolEntry.GetTransaction(), block))
+		if (!ShouldEvict(*pEntry->GetTransaction(), block))
 		{
-			filteredTransactions.push_back(txPoolEntry.GetTransaction());
-			filteredEntriesByHash.insert(std::pair<Hash, TxPoolEntry>(txPoolEntry.GetTransaction()->GetHash(), txPoolEntry));
+			filteredTransactions.push_back(pEntry->GetTransaction());
+			filteredEntriesByHash.insert({
+				pEntry->GetTransaction()->GetHash(),
+				{ m_sequenceByHash.at(pEntry->GetTransaction()->GetHash()), *pEntry }
+			});
 		}
 	}
 
-	m_transactions.clear();
+	Clear();
 
 	std::vector<TransactionPtr> validTransactions = ValidTransactionFinder::FindValidTransactions(
 		pBlockDB,
@@ -162,22 +293,19 @@ void Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetCo
 	);
 	for (auto& pTransaction : validTransactions)
 	{
-		const TxPoolEntry& txPoolEntry = filteredEntriesByHash.at(pTransaction->GetHash());
-		m_transactions.push_back(txPoolEntry);
+		auto& entry = filteredEntriesByHash.at(pTransaction->GetHash());
+		AddEntry(entry.first, std::move(entry.second));
 	}
 }
 
 void Pool::ChangeStatus(const std::vector<TransactionPtr>& transactions, const EDandelionStatus status)
 {
-	for (auto& txPoolEntry : m_transactions)
+	for (auto& pTransaction : transactions)
 	{
-		for (auto& transaction : transactions)
+		auto sequence_iter = m_sequenceByHash.find(pTransaction->GetHash());
+		if (sequence_iter != m_sequenceByHash.end())
 		{
-			if (txPoolEntry.GetTransaction() == transaction)
-			{
-				txPoolEntry.SetStatus(status);
-				break;
-			}
+			m_transactions.at(sequence_iter->second).SetStatus(status);
 		}
 	}
 }
@@ -215,10 +343,201 @@ TransactionPtr Pool::Aggregate() const
 	LOG_INFO_F("Aggregating {} transactions", m_transactions.size());
 
 	std::vector<TransactionPtr> transactions;
-	for (const TxPoolEntry& entry : m_transactions)
+	for (const auto& entry : m_transactions)
 	{
-		transactions.push_back(entry.GetTransaction());
+		transactions.push_back(entry.second.GetTransaction());
 	}
 
 	return TransactionUtil::Aggregate(transactions);
 }
+
+void Pool::Clear()
+{
+	m_transactions.clear();
+	m_sequenceByHash.clear();
+	m_byFeeRate.clear();
+	m_outputs.clear();
+	m_spenders.clear();
+	m_totalWeight = 0;
+	m_totalBytes = 0;
+	m_version++;
+}
+
+std::vector<TxPoolEntry> Pool::GetEntries() const
+{
+	std::vector<TxPoolEntry> entries;
+	entries.reserve(m_transactions.size());
+	for (const auto& entry : m_transactions)
+	{
+		entries.push_back(entry.second);
+	}
+
+	return entries;
+}
+
+void Pool::AddEntry(const uint64_t sequence, TxPoolEntry&& entry)
+{
+	TransactionPtr pTransaction = entry.GetTransaction();
+
+	m_totalWeight += entry.GetWeight();
+	m_totalBytes += entry.GetNumBytes();
+	m_version++;
+	m_byFeeRate.insert(PriorityKey{ entry.GetFeeRate(), sequence });
+	m_sequenceByHash[pTransaction->GetHash()] = sequence;
+
+	for (const TransactionOutput& output : pTransaction->GetOutputs())
+	{
+		m_outputs.insert({ output.GetCommitment(), sequence });
+	}
+
+	for (const TransactionInput& input : pTransaction->GetInputs())
+	{
+		m_spenders.insert({ input.GetCommitment(), sequence });
+	}
+
+	m_transactions.insert({ sequence, std::move(entry) });
+}
+
+void Pool::RemoveEntry(EntryMap::iterator iter)
+{
+	const uint64_t sequence = iter->first;
+	const TxPoolEntry& entry = iter->second;
+
+	m_totalWeight -= entry.GetWeight();
+	m_totalBytes -= entry.GetNumBytes();
+	m_version++;
+	m_byFeeRate.erase(PriorityKey{ entry.GetFeeRate(), sequence });
+	m_sequenceByHash.erase(entry.GetTransaction()->GetHash());
+
+	for (const TransactionOutput& output : entry.GetTransaction()->GetOutputs())
+	{
+		auto output_iter = m_outputs.find(output.GetCommitment());
+		if (output_iter != m_outputs.end() && output_iter->second == sequence)
+		{
+			m_outputs.erase(output_iter);
+		}
+	}
+
+	for (const TransactionInput& input : entry.GetTransaction()->GetInputs())
+	{
+		auto range = m_spenders.equal_range(input.GetCommitment());
+		for (auto spender_iter = range.first; spender_iter != range.second; ++spender_iter)
+		{
+			if (spender_iter->second == sequence)
+			{
+				m_spenders.erase(spender_iter);
+				break;
+			}
+		}
+	}
+
+	m_transactions.erase(iter);
+}
+
+std::vector<uint64_t> Pool::GetChildren(const TxPoolEntry& entry) const
+{
+	std::vector<uint64_t> children;
+	for (const TransactionOutput& output : entry.GetTransaction()->GetOutputs())
+	{
+		auto range = m_spenders.equal_range(output.GetCommitment());
+		for (auto iter = range.first; iter != range.second; ++iter)
+		{
+			children.push_back(iter->second);
+		}
+	}
+
+	return children;
+}
+
+// The tx itself, followed by every tx spending its outputs, directly or indirectly.
+std::vector<uint64_t> Pool::GetDescendants(const uint64_t sequence) const
+{
+	std::vector<uint64_t> descendants{ sequence };
+	std::set<uint64_t> visited{ sequence };
+	for (size_t i = 0; i < descendants.size(); i++)
+	{
+		for (const uint64_t child : GetChildren(m_transactions.at(descendants[i])))
+		{
+			if (visited.insert(child).second)
+			{
+				descendants.push_back(child);
+			}
+		}
+	}
+
+	return descendants;
+}
+
+//
+// Highest fee rate first, except that a tx spending the outputs of another tx in the pool always comes after it,
+// since a child is only valid once its parent is.
+//
+std::vector<const TxPoolEntry*> Pool::GetEntriesByPriority() const
+{
+	std::unordered_map<uint64_t, size_t> numParents;
+	std::set<PriorityKey> ready;
+	for (const auto& iter : m_transactions)
+	{
+		const uint64_t sequence = iter.first;
+		const TxPoolEntry& entry = iter.second;
+
+		size_t parents = 0;
+		for (const TransactionInput& input : entry.GetTransaction()->GetInputs())
+		{
+			auto output_iter = m_outputs.find(input.GetCommitment());
+			if (output_iter != m_outputs.end() && output_iter->second != sequence)
+			{
+				parents++;
+			}
+		}
+
+		if (parents == 0)
+		{
+			ready.insert(PriorityKey{ entry.GetFeeRate(), sequence });
+		}
+		else
+		{
+			numParents[sequence] = parents;
+		}
+	}
+
+	std::vector<const TxPoolEntry*> entries;
+	entries.reserve(m_transactions.size());
+	std::set<uint64_t> added;
+	while (!ready.empty())
+	{
+		// PriorityKey sorts eviction candidates first, so the best tx is at the end.
+		auto best = std::prev(ready.end());
+		const uint64_t sequence = best->sequence;
+		ready.erase(best);
+
+		const TxPoolEntry& entry = m_transactions.at(sequence);
+		entries.push_back(&entry);
+		added.insert(sequence);
+
+		for (const uint64_t child : GetChildren(entry))
+		{
+			auto parents_iter = numParents.find(child);
+			if (parents_iter != numParents.end() && --parents_iter->second == 0)
+			{
+				const TxPoolEntry& childEntry = m_transactions.at(child);
+				ready.insert(PriorityKey{ childEntry.GetFeeRate(), child });
+				numParents.erase(parents_iter);
+			}
+		}
+	}
+
+	// Only reachable with txs that spend each other's outputs, which can't all be valid anyway.
+	if (entries.size() < m_transactions.size())
+	{
+		for (const auto& iter : m_transactions)
+		{
+			if (added.count(iter.first) == 0)
+			{
+				entries.push_back(&iter.second);
+			}
+		}
+	}
+
+	return entries;
+}
@@ -9,16 +9,42 @@
 #include <Core/Models/ShortId.h>
 #include <Core/Config.h>
 #include <PMMR/TxHashSetManager.h>
+#include <Crypto/Models/Commitment.h>
 #include <Crypto/Models/Hash.h>
+#include <map>
+#include <optional>
 #include <set>
+#include <unordered_map>
 
+//
+// Txs are indexed by fee rate (fee per unit of weight), and the pool is kept under a max total weight and
+// a max estimated memory size. Once either is exceeded, the lowest fee-rate txs are evicted,
+// along with any txs spending their outputs, since those can no longer be valid on their own.
+//
 class Pool
 {
 public:
-	Pool() = default;
+	Pool(const uint64_t maxWeight, const uint64_t maxBytes)
+		: m_maxWeight(maxWeight), m_maxBytes(maxBytes) { }
 	~Pool() = default;
 
-	void AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status);
+	//
+	// Adds the tx, then evicts the lowest fee-rate txs until the pool is back under its limits.
+	// Returns the evicted txs, which can include the one just added.
+	// The timestamp is only given for txs restored from a snapshot. Otherwise, it's the time it was added.
+	//
+	std::vector<TransactionPtr> AddTransaction(
+		TransactionPtr pTransaction,
+		const EDandelionStatus status,
+		const std::optional<std::chrono::system_clock::time_point>& timestampOpt = std::nullopt
+	);
+
+	//
+	// False if there's no room for the tx without evicting txs paying the same or a higher fee rate.
+	// Cheap compared to validation, so it's checked first to turn away floods of low-fee txs.
+	//
+	bool MeetsEvictionFloor(const Transaction& transaction) const;
+
 	bool ContainsTransaction(const Transaction& transaction) const;
 	void RemoveTransaction(const Transaction& transaction);
 	void ReconcileBlock(
@@ -36,18 +62,72 @@ public:
 	) const;
 	std::vector<TransactionPtr> FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const;
 	TransactionPtr FindTransactionByKernelHash(const Hash& kernelHash) const;
+
+	// Highest fee rate first, but never before a tx whose outputs it spends.
 	std::vector<TransactionPtr> FindTransactionsByStatus(const EDandelionStatus status) const;
 	std::vector<TransactionPtr> GetExpiredTransactions(const uint16_t embargoSeconds) const;
 
+	//
+	// Picks the txs to mine, highest fee rate first, up to a total weight of maxWeight.
+	// Txs conflicting with an already picked one, or spending outputs of a tx that wasn't picked, are skipped.
+	//
+	std::vector<TransactionPtr> SelectForBlock(const uint64_t maxWeight) const;
+
 	TransactionPtr Aggregate() const;
-	void Clear() { m_transactions.clear(); }
+	void Clear();
 
 	size_t Size() const noexcept { return m_transactions.size(); }
+	uint64_t GetTotalWeight() const noexcept { return m_totalWeight; }
+	uint64_t GetTotalBytes() const noexcept { return m_totalBytes; }
+
+	// Changes whenever a tx is added or removed, so callers can tell when their view of the pool is stale.
+	uint64_t GetVersion() const noexcept { return m_version; }
+
+	// In the order they were added.
+	std::vector<TxPoolEntry> GetEntries() const;
 
-	std::vector<TxPoolEntry> GetEntries() const { return m_transactions; }
+	static uint64_t CalculateWeight(const Transaction& transaction);
+	static uint64_t EstimateBytes(const Transaction& transaction);
+	static double CalculateFeeRate(const Transaction& transaction, const uint64_t weight);
 
 private:
+	// Ordered from the first tx to evict to the last: lowest fee rate, then most recently added.
+	struct PriorityKey
+	{
+		double feeRate;
+		uint64_t sequence;
+
+		bool operator<(const PriorityKey& other) const noexcept
+		{
+			if (feeRate != other.feeRate) {
+				return feeRate < other.feeRate;
+			}
+
+			return sequence > other.sequence;
+		}
+	};
+
+	// Keyed by sequence number, so iterating visits txs in the order they were added.
+	using EntryMap = std::map<uint64_t, TxPoolEntry>;
+
+	void AddEntry(const uint64_t sequence, TxPoolEntry&& entry);
+	void RemoveEntry(EntryMap::iterator iter);
+	std::vector<uint64_t> GetChildren(const TxPoolEntry& entry) const;
+	std::vector<uint64_t> GetDescendants(const uint64_t sequence) const;
+	std::vector<const TxPoolEntry*> GetEntriesByPriority() const;
 	bool ShouldEvict(const Transaction& transaction, const FullBlock& block) const;
 
-	std::vector<TxPoolEntry> m_transactions;
+	uint64_t m_maxWeight;
+	uint64_t m_maxBytes;
+
+	uint64_t m_nextSequence{ 0 };
+	uint64_t m_totalWeight{ 0 };
+	uint64_t m_totalBytes{ 0 };
+	uint64_t m_version{ 0 };
+
+	EntryMap m_transactions;
+	std::unordered_map<Hash, uint64_t> m_sequenceByHash;
+	std::set<PriorityKey> m_byFeeRate;
+	std::unordered_map<Commitment, uint64_t> m_outputs; // Output commitment -> tx creating it.
+	std::unordered_multimap<Commitment, uint64_t> m_spenders; // Input commitment -> txs spending it.
 };
@@ -7,8 +7,12 @@
 #include <Database/BlockDb.h>
 #include <Crypto/CSPRNG.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
+#include <Common/Tracing.h>
 #include <Core/Util/FeeUtil.h>
 #include <Core/Validation/TransactionValidator.h>
+#include <Common/Util/ThreadUtil.h>
+#include <future>
 
 std::vector<TransactionPtr> TransactionPool::GetTransactionsByShortId(const Hash& hash, const uint64_t nonce, const std::set<ShortId>& missingShortIds) const
 {
@@ -17,12 +21,87 @@ std::vector<TransactionPtr> TransactionPool::GetTransactionsByShortId(const Hash
 	return m_memPool.GetTransactionsByShortId(hash, nonce, missingShortIds);
 }
 
+static Metrics::Counter& GetOutcomeCounter(const EPoolType poolType, const EAddTransactionStatus status)
+{
+	static const std::vector<std::pair<EAddTransactionStatus, std::string>> OUTCOMES = {
+		{ EAddTransactionStatus::ADDED, "added" },
+		{ EAddTransactionStatus::DUPL_TX, "duplicate" },
+		{ EAddTransactionStatus::LOW_FEE, "low_fee" },
+		{ EAddTransactionStatus::TX_INVALID, "invalid" },
+		{ EAddTransactionStatus::NOT_ADDED, "not_added" },
+		{ EAddTransactionStatus::POOL_FULL, "pool_full" }
+	};
+
+	// Registered up front, so recording an outcome never touches the registry lock.
+	static const std::map<std::pair<EPoolType, EAddTransactionStatus>, Metrics::Counter*> counters = []() {
+		std::map<std::pair<EPoolType, EAddTransactionStatus>, Metrics::Counter*> counters;
+		for (const EPoolType pool : { EPoolType::MEMPOOL, EPoolType::STEMPOOL }) {
+			for (const auto& outcome : OUTCOMES) {
+				counters[{ pool, outcome.first }] = &Metrics::Registry::Get().AddCounter(
+					"grinpp_txpool_add_total",
+					"Transactions submitted to the pool, by pool and outcome",
+					{ { "pool", pool == EPoolType::MEMPOOL ? "mempool" : "stempool" }, { "outcome", outcome.second } }
+				);
+			}
+		}
+
+		return counters;
+	}();
+
+	return *counters.at({ poolType, status });
+}
+
+static void RecordEvictions(const EPoolType poolType, const std::vector<TransactionPtr>& evicted)
+{
+	static Metrics::Counter& s_mempoolEvicted = Metrics::Registry::Get().AddCounter(
+		"grinpp_txpool_evicted_total",
+		"Transactions evicted to keep the pool under its size limits",
+		{ { "pool", "mempool" } }
+	);
+	static Metrics::Counter& s_stempoolEvicted = Metrics::Registry::Get().AddCounter(
+		"grinpp_txpool_evicted_total",
+		"Transactions evicted to keep the pool under its size limits",
+		{ { "pool", "stempool" } }
+	);
+
+	if (!evicted.empty())
+	{
+		LOG_INFO_F("Evicted {} low fee-rate transactions from the {}", evicted.size(), poolType == EPoolType::MEMPOOL ? "mempool" : "stempool");
+		(poolType == EPoolType::MEMPOOL ? s_mempoolEvicted : s_stempoolEvicted).Increment(evicted.size());
+	}
+}
+
 EAddTransactionStatus TransactionPool::AddTransaction(
 	std::shared_ptr<const IBlockDB> pBlockDB,
 	ITxHashSetConstPtr pTxHashSet,
 	TransactionPtr pTransaction,
 	const EPoolType poolType,
 	const BlockHeader& lastConfirmedBlock)
+{
+	static Metrics::Histogram& s_latency = Metrics::Registry::Get().AddHistogram(
+		"grinpp_txpool_add_seconds",
+		"Time spent validating and adding a transaction to the pool"
+	);
+
+	TRACE_SPAN("txpool", "TransactionPool::AddTransaction");
+	Metrics::ScopedTimer timer(s_latency);
+	const EAddTransactionStatus status = AddTransactionInternal(pBlockDB, pTxHashSet, pTransaction, poolType, lastConfirmedBlock);
+	if (status == EAddTransactionStatus::ADDED && poolType == EPoolType::MEMPOOL)
+	{
+		NotifyChanged();
+	}
+
+	GetOutcomeCounter(poolType, status).Increment();
+	return status;
+}
+
+EAddTransactionStatus TransactionPool::AddTransactionInternal(
+	std::shared_ptr<const IBlockDB> pBlockDB,
+	ITxHashSetConstPtr pTxHashSet,
+	TransactionPtr pTransaction,
+	const EPoolType poolType,
+	const BlockHeader& lastConfirmedBlock,
+	const TxPoolSnapshot::Entry* pRestored)
 {
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 	const uint64_t next_block_height = lastConfirmedBlock.GetHeight() + 1;
@@ -39,6 +118,14 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 		LOG_WARNING_F("Fee too low for transaction ({})", *pTransaction);
 		return EAddTransactionStatus::LOW_FEE;
 	}
+
+	// Checked before validating, so a flood of low fee-rate txs is turned away cheaply once the pool is full.
+	const Pool& targetPool = (poolType == EPoolType::MEMPOOL) ? m_memPool : m_stemPool;
+	if (!targetPool.MeetsEvictionFloor(*pTransaction))
+	{
+		LOG_DEBUG_F("Pool full, and fee rate too low for transaction ({})", *pTransaction);
+		return EAddTransactionStatus::POOL_FULL;
+	}
 	
 	// Verify lock time
 	for (const TransactionKernel& kernel : pTransaction->GetKernels())
@@ -50,14 +137,18 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 		}
 	}
 
-	try
-	{
-		TransactionValidator().Validate(*pTransaction, next_block_height);
-	}
-	catch (std::exception& e)
+	// Restored txs were already validated, in parallel and outside of the lock.
+	if (pRestored == nullptr)
 	{
-		LOG_WARNING_F("Invalid transaction ({}). Error: ({})", *pTransaction, e.what());
-		return EAddTransactionStatus::TX_INVALID;
+		try
+		{
+			TransactionValidator().Validate(*pTransaction, next_block_height);
+		}
+		catch (std::exception& e)
+		{
+			LOG_WARNING_F("Invalid transaction ({}). Error: ({})", *pTransaction, e.what());
+			return EAddTransactionStatus::TX_INVALID;
+		}
 	}
 
 	// Check all inputs are in current UTXO set & all outputs unique in current UTXO set
@@ -67,23 +158,34 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 		return EAddTransactionStatus::NOT_ADDED;
 	}
 
+	std::optional<std::chrono::system_clock::time_point> timestampOpt = std::nullopt;
+	if (pRestored != nullptr)
+	{
+		timestampOpt = std::make_optional(pRestored->timestamp);
+	}
+
 	if (poolType == EPoolType::MEMPOOL)
 	{
-		m_memPool.AddTransaction(pTransaction, EDandelionStatus::FLUFFED);
+		RecordEvictions(poolType, m_memPool.AddTransaction(pTransaction, EDandelionStatus::FLUFFED, timestampOpt));
 		m_stemPool.RemoveTransaction(*pTransaction);
 	}
+	else if (pRestored != nullptr)
+	{
+		// Keeps its place in the dandelion cycle, and its embargo timer.
+		RecordEvictions(poolType, m_stemPool.AddTransaction(pTransaction, pRestored->status, timestampOpt));
+	}
 	else if (poolType == EPoolType::STEMPOOL)
 	{
 		const uint8_t random = (uint8_t)CSPRNG::GenerateRandom(0, 100);
 		if (random <= Global::GetConfig().GetStemProbability())
 		{
 			LOG_INFO_F("Stemming transaction ({})", *pTransaction);
-			m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_STEM);
+			RecordEvictions(poolType, m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_STEM));
 		}
 		else
 		{
 			LOG_INFO_F("Fluffing transaction ({})", *pTransaction);
-			m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_FLUFF);
+			RecordEvictions(poolType, m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_FLUFF));
 		}
 	}
 
@@ -127,6 +229,35 @@ std::vector<TransactionPoolEntry> TransactionPool::GetTransactions(const EPoolTy
 	return result;
 }
 
+std::vector<TransactionPtr> TransactionPool::GetTransactionsForBlock(const uint64_t maxWeight) const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	return m_memPool.SelectForBlock(maxWeight);
+}
+
+uint64_t TransactionPool::GetMemPoolVersion() const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	return m_memPool.GetVersion();
+}
+
+uint64_t TransactionPool::WaitForChange(const uint64_t lastChange, const std::chrono::milliseconds& timeout) const
+{
+	std::unique_lock<std::mutex> lock(m_changeMutex);
+	m_changeCondition.wait_for(lock, timeout, [this, lastChange] { return m_numChanges != lastChange; });
+	return m_numChanges;
+}
+
+void TransactionPool::NotifyChanged()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_changeMutex);
+		++m_numChanges;
+	}
+
+	m_changeCondition.notify_all();
+}
+
 TransactionPtr TransactionPool::FindTransactionByKernelHash(const Hash& kernelHash) const
 {
 	std::shared_lock<std::shared_mutex> readLock(m_mutex);
@@ -142,6 +273,7 @@ TransactionPtr TransactionPool::FindTransactionByKernelHash(const Hash& kernelHa
 
 void TransactionPool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block)
 {
+	TRACE_SPAN("txpool", "TransactionPool::ReconcileBlock");
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 
 	// First reconcile the txpool.
@@ -150,6 +282,9 @@ void TransactionPool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, I
 	// Now reconcile our stempool, accounting for the updated txpool txs.
 	auto pMemPoolAggTx = m_memPool.Aggregate();
 	m_stemPool.ReconcileBlock(pBlockDB, pTxHashSet, block, pMemPoolAggTx);
+
+	// Also signals a new tip, since every applied block is reconciled.
+	NotifyChanged();
 }
 
 TransactionPtr TransactionPool::GetTransactionToStem(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet)
@@ -207,11 +342,12 @@ TransactionPtr TransactionPool::GetTransactionToFluff(std::shared_ptr<const IBlo
 
 	TransactionPtr pTransactionToFluff = TransactionUtil::Aggregate(validTransactionsToFluff);
 
-	m_memPool.AddTransaction(pTransactionToFluff, EDandelionStatus::FLUFFED);
+	RecordEvictions(EPoolType::MEMPOOL, m_memPool.AddTransaction(pTransactionToFluff, EDandelionStatus::FLUFFED));
 	for (auto& pTransaction : validTransactionsToFluff)
 	{
 		m_stemPool.RemoveTransaction(*pTransaction);
 	}
+	NotifyChanged();
 
 	return pTransactionToFluff;
 }
@@ -224,10 +360,202 @@ std::vector<TransactionPtr> TransactionPool::GetExpiredTransactions() const
 	return m_stemPool.GetExpiredTransactions(embargoSeconds);
 }
 
+TransactionPool::~TransactionPool()
+{
+	m_terminate = true;
+	ThreadUtil::Join(m_snapshotThread);
+
+	SaveSnapshot();
+}
+
+void TransactionPool::SaveSnapshot() const
+{
+	TRACE_SPAN("txpool", "TransactionPool::SaveSnapshot");
+
+	std::vector<TxPoolSnapshot::Entry> entries;
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+		// Mempool entries are kept in the order they were added, so txs are always restored after the txs they spend.
+		for (const EPoolType poolType : { EPoolType::MEMPOOL, EPoolType::STEMPOOL })
+		{
+			const Pool& pool = (poolType == EPoolType::MEMPOOL) ? m_memPool : m_stemPool;
+			for (const TxPoolEntry& entry : pool.GetEntries())
+			{
+				entries.push_back(TxPoolSnapshot::Entry{ poolType, entry.GetStatus(), entry.GetTimestamp(), entry.GetTransaction() });
+			}
+		}
+	}
+
+	try
+	{
+		std::unique_lock<std::mutex> snapshotLock(m_snapshotMutex);
+		TxPoolSnapshot::Write(m_snapshotPath, entries);
+		LOG_DEBUG_F("Saved {} transactions to {}", entries.size(), m_snapshotPath);
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Failed to save snapshot to {}. Error: {}", m_snapshotPath, e.what());
+	}
+}
+
+//
+// Validating range proofs and kernel signatures is by far the most expensive part of adding a tx,
+// so for restored txs it's spread across threads. Returns whether each tx is valid, in order.
+//
+static std::vector<uint8_t> ValidateRestored(const std::vector<TxPoolSnapshot::Entry>& entries, const uint64_t nextBlockHeight)
+{
+	std::vector<uint8_t> valid(entries.size(), 0);
+
+	const size_t numThreads = (std::max)((size_t)1, (std::min)((size_t)std::thread::hardware_concurrency(), entries.size()));
+
+	std::vector<std::future<void>> futures;
+	for (size_t thread = 0; thread < numThreads; thread++)
+	{
+		futures.push_back(std::async(std::launch::async, [&entries, &valid, nextBlockHeight, numThreads, thread] {
+			for (size_t i = thread; i < entries.size(); i += numThreads)
+			{
+				try
+				{
+					TransactionValidator().Validate(*entries[i].pTransaction, nextBlockHeight);
+					valid[i] = 1;
+				}
+				catch (std::exception& e)
+				{
+					LOG_DEBUG_F("Dropping invalid transaction ({}). Error: ({})", *entries[i].pTransaction, e.what());
+				}
+			}
+		}));
+	}
+
+	for (auto& future : futures)
+	{
+		future.get();
+	}
+
+	return valid;
+}
+
+size_t TransactionPool::LoadSnapshot(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const BlockHeader& lastConfirmedBlock)
+{
+	TRACE_SPAN("txpool", "TransactionPool::LoadSnapshot");
+
+	std::vector<TxPoolSnapshot::Entry> entries;
+	try
+	{
+		std::unique_lock<std::mutex> snapshotLock(m_snapshotMutex);
+		entries = TxPoolSnapshot::Read(m_snapshotPath);
+	}
+	catch (std::exception& e)
+	{
+		LOG_WARNING_F("Ignoring unreadable snapshot {}. Error: {}", m_snapshotPath, e.what());
+		return 0;
+	}
+
+	if (entries.empty())
+	{
+		return 0;
+	}
+
+	const std::vector<uint8_t> valid = ValidateRestored(entries, lastConfirmedBlock.GetHeight() + 1);
+
+	size_t numRestored = 0;
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		if (valid[i] == 0)
+		{
+			continue;
+		}
+
+		const TxPoolSnapshot::Entry& entry = entries[i];
+		const EAddTransactionStatus status = AddTransactionInternal(
+			pBlockDB,
+			pTxHashSet,
+			entry.pTransaction,
+			entry.poolType,
+			lastConfirmedBlock,
+			&entry
+		);
+		if (status == EAddTransactionStatus::ADDED)
+		{
+			++numRestored;
+		}
+	}
+
+	if (numRestored > 0)
+	{
+		NotifyChanged();
+	}
+
+	LOG_INFO_F("Restored {} of {} transactions from {}", numRestored, entries.size(), m_snapshotPath);
+	return numRestored;
+}
+
+// Periodically snapshots the pools, whenever they've changed since the last snapshot.
+void TransactionPool::Thread_Snapshot(TransactionPool& txPool)
+{
+	LoggerAPI::SetThreadName("TXPOOL_SNAPSHOT");
+	LOG_DEBUG("BEGIN");
+
+	auto lastSnapshotTime = std::chrono::steady_clock::now();
+	std::pair<uint64_t, uint64_t> lastSnapshotVersions = { 0, 0 };
+
+	while (!txPool.m_terminate && Global::IsRunning())
+	{
+		ThreadUtil::SleepFor(std::chrono::seconds(1));
+
+		const auto now = std::chrono::steady_clock::now();
+		if (now - lastSnapshotTime < std::chrono::seconds(txPool.m_snapshotIntervalSeconds))
+		{
+			continue;
+		}
+
+		lastSnapshotTime = now;
+
+		std::pair<uint64_t, uint64_t> versions;
+		{
+			std::shared_lock<std::shared_mutex> readLock(txPool.m_mutex);
+			versions = { txPool.m_memPool.GetVersion(), txPool.m_stemPool.GetVersion() };
+		}
+
+		if (versions != lastSnapshotVersions)
+		{
+			txPool.SaveSnapshot();
+			lastSnapshotVersions = versions;
+		}
+	}
+
+	LOG_DEBUG("END");
+}
+
 namespace TxPoolAPI
 {
 	TX_POOL_API std::shared_ptr<ITransactionPool> CreateTransactionPool(const Config& config)
 	{
-		return std::shared_ptr<TransactionPool>(new TransactionPool(config));
+		auto pTransactionPool = std::shared_ptr<TransactionPool>(new TransactionPool(config));
+
+		std::weak_ptr<TransactionPool> pWeak = pTransactionPool;
+		pTransactionPool->m_pMetricsCollector = Metrics::Registry::Get().AddCollector([pWeak](Metrics::Writer& writer) {
+			auto pPool = pWeak.lock();
+			if (pPool == nullptr) {
+				return;
+			}
+
+			std::shared_lock<std::shared_mutex> readLock(pPool->m_mutex);
+			for (const EPoolType poolType : { EPoolType::MEMPOOL, EPoolType::STEMPOOL }) {
+				const Pool& pool = (poolType == EPoolType::MEMPOOL) ? pPool->m_memPool : pPool->m_stemPool;
+				const Metrics::Labels labels = { { "pool", poolType == EPoolType::MEMPOOL ? "mempool" : "stempool" } };
+				writer.AddGauge("grinpp_txpool_transactions", "Transactions in the pool", labels, (double)pool.Size());
+				writer.AddGauge("grinpp_txpool_weight", "Total weight of the transactions in the pool", labels, (double)pool.GetTotalWeight());
+				writer.AddGauge("grinpp_txpool_bytes", "Estimated memory used by the transactions in the pool", labels, (double)pool.GetTotalBytes());
+			}
+		});
+
+		if (pTransactionPool->m_snapshotIntervalSeconds > 0)
+		{
+			pTransactionPool->m_snapshotThread = std::thread(TransactionPool::Thread_Snapshot, std::ref(*pTransactionPool));
+		}
+
+		return pTransactionPool;
 	}
 }
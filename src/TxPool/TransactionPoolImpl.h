@@ -1,20 +1,30 @@
 #pragma once
 
 #include "Pool.h"
+#include "TxPoolSnapshot.h"
 
 #include <TxPool/TransactionPool.h>
 #include <Core/Models/Transaction.h>
 #include <Core/Models/ShortId.h>
+#include <Common/Metrics.h>
 #include <Crypto/Models/Hash.h>
 #include <shared_mutex>
+#include <condition_variable>
+#include <mutex>
+#include <atomic>
+#include <thread>
 #include <set>
 
 class TransactionPool : public ITransactionPool
 {
 public:
 	TransactionPool(const Config& config)
-		: m_config(config), m_memPool(), m_stemPool() { }
-    virtual ~TransactionPool() = default;
+		: m_config(config),
+		m_memPool(config.GetMaxPoolWeight(), config.GetMaxPoolBytes()),
+		m_stemPool(config.GetMaxStemPoolWeight(), config.GetMaxStemPoolBytes()),
+		m_snapshotPath(config.GetTxPoolSnapshotPath()),
+		m_snapshotIntervalSeconds(config.GetTxPoolSnapshotIntervalSeconds()) { }
+	virtual ~TransactionPool();
 
 	std::vector<TransactionPtr> GetTransactionsByShortId(const Hash& hash, const uint64_t nonce, const std::set<ShortId>& missingShortIds) const final;
 	EAddTransactionStatus AddTransaction(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, TransactionPtr pTransaction, const EPoolType poolType, const BlockHeader& lastConfirmedBlock) final;
@@ -25,16 +35,49 @@ public:
 	size_t GetPoolSize() const final;
 	size_t GetStemPoolSize() const final;
 	std::vector<TransactionPoolEntry> GetTransactions(const EPoolType poolType) const final;
+	std::vector<TransactionPtr> GetTransactionsForBlock(const uint64_t maxWeight) const final;
+	uint64_t GetMemPoolVersion() const final;
+	uint64_t WaitForChange(const uint64_t lastChange, const std::chrono::milliseconds& timeout) const final;
 
 	// Dandelion
 	TransactionPtr GetTransactionToStem(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet) final;
 	TransactionPtr GetTransactionToFluff(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet) final;
 	std::vector<TransactionPtr> GetExpiredTransactions() const final;
 
+	void SaveSnapshot() const final;
+	size_t LoadSnapshot(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const BlockHeader& lastConfirmedBlock) final;
+
 private:
+	friend ITransactionPool::Ptr TxPoolAPI::CreateTransactionPool(const Config& config);
+
+	EAddTransactionStatus AddTransactionInternal(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		TransactionPtr pTransaction,
+		const EPoolType poolType,
+		const BlockHeader& lastConfirmedBlock,
+		const TxPoolSnapshot::Entry* pRestored = nullptr
+	);
+
+	static void Thread_Snapshot(TransactionPool& txPool);
+
+	void NotifyChanged();
+
 	const Config& m_config;
 	mutable std::shared_mutex m_mutex;
 
 	Pool m_memPool;
 	Pool m_stemPool;
+
+	std::shared_ptr<Metrics::Collector> m_pMetricsCollector;
+
+	mutable std::mutex m_changeMutex;
+	mutable std::condition_variable m_changeCondition;
+	uint64_t m_numChanges{ 0 };
+
+	fs::path m_snapshotPath;
+	uint32_t m_snapshotIntervalSeconds;
+	mutable std::mutex m_snapshotMutex;
+	std::atomic_bool m_terminate{ false };
+	std::thread m_snapshotThread;
 };
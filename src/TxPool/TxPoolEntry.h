@@ -10,8 +10,19 @@ public:
 	//
 	// Constructors
 	//
-	TxPoolEntry(TransactionPtr pTransaction, const EDandelionStatus status, std::chrono::system_clock::time_point timestamp)
-		: m_pTransaction(pTransaction), m_status(status), m_timestamp(std::move(timestamp))
+	TxPoolEntry(
+		TransactionPtr pTransaction,
+		const EDandelionStatus status,
+		std::chrono::system_clock::time_point timestamp,
+		const uint64_t weight,
+		const uint64_t numBytes,
+		const double feeRate)
+		: m_pTransaction(pTransaction),
+		m_status(status),
+		m_timestamp(std::move(timestamp)),
+		m_weight(weight),
+		m_numBytes(numBytes),
+		m_feeRate(feeRate)
 	{
 
 	}
@@ -40,6 +51,9 @@ public:
 	inline TransactionPtr GetTransaction() const { return m_pTransaction; }
 	inline EDandelionStatus GetStatus() const { return m_status; }
 	inline std::chrono::system_clock::time_point GetTimestamp() const { return m_timestamp; }
+	inline uint64_t GetWeight() const { return m_weight; }
+	inline uint64_t GetNumBytes() const { return m_numBytes; } // Estimated memory used by the entry.
+	inline double GetFeeRate() const { return m_feeRate; } // Fee per unit of weight, after the fee shift.
 
 	//
 	// Setters
@@ -50,4 +64,7 @@ private:
 	TransactionPtr m_pTransaction;
 	EDandelionStatus m_status;
 	std::chrono::system_clock::time_point m_timestamp;
+	uint64_t m_weight;
+	uint64_t m_numBytes;
+	double m_feeRate;
 };
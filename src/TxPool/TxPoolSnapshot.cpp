@@ -0,0 +1,123 @@
+#include "TxPoolSnapshot.h"
+
+#include <Core/Exceptions/DeserializationException.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Serialization/Serializer.h>
+#include <Common/Util/FileUtil.h>
+#include <Common/Util/TimeUtil.h>
+#include <Crypto/Hasher.h>
+
+static const uint32_t SNAPSHOT_MAGIC = 0x47545850; // "GTXP"
+static const uint32_t SNAPSHOT_VERSION = 1;
+static const EProtocolVersion TX_PROTOCOL_VERSION = EProtocolVersion::V2;
+
+// Magic, version, and number of entries.
+static const size_t HEADER_SIZE = 16;
+static const size_t CHECKSUM_SIZE = 32;
+
+// Pool type, status, timestamp, and tx size.
+static const size_t ENTRY_HEADER_SIZE = 18;
+
+std::vector<uint8_t> TxPoolSnapshot::Serialize(const std::vector<Entry>& entries)
+{
+	Serializer serializer(TX_PROTOCOL_VERSION);
+	serializer.Append<uint32_t>(SNAPSHOT_MAGIC);
+	serializer.Append<uint32_t>(SNAPSHOT_VERSION);
+	serializer.Append<uint64_t>(entries.size());
+
+	for (const Entry& entry : entries)
+	{
+		Serializer txSerializer(TX_PROTOCOL_VERSION);
+		entry.pTransaction->Serialize(txSerializer);
+
+		serializer.Append<uint8_t>((uint8_t)entry.poolType);
+		serializer.Append<uint8_t>((uint8_t)entry.status);
+		serializer.Append<int64_t>(TimeUtil::ToInt64(entry.timestamp));
+		serializer.Append<uint64_t>(txSerializer.size());
+		serializer.AppendByteVector(txSerializer.GetBytes());
+	}
+
+	const Hash checksum = Hasher::Blake2b(serializer.data(), serializer.size());
+	serializer.AppendBigInteger(checksum);
+
+	return serializer.GetBytes();
+}
+
+std::vector<TxPoolSnapshot::Entry> TxPoolSnapshot::Deserialize(const std::vector<uint8_t>& bytes)
+{
+	if (bytes.size() < HEADER_SIZE + CHECKSUM_SIZE)
+	{
+		throw DESERIALIZATION_EXCEPTION("Snapshot truncated");
+	}
+
+	const size_t contentSize = bytes.size() - CHECKSUM_SIZE;
+	const Hash checksum(bytes.data() + contentSize);
+	if (Hasher::Blake2b(bytes.data(), contentSize) != checksum)
+	{
+		throw DESERIALIZATION_EXCEPTION("Snapshot checksum mismatch");
+	}
+
+	ByteBuffer byteBuffer(std::vector<uint8_t>(bytes.cbegin(), bytes.cbegin() + contentSize), TX_PROTOCOL_VERSION);
+	if (byteBuffer.ReadU32() != SNAPSHOT_MAGIC)
+	{
+		throw DESERIALIZATION_EXCEPTION("Not a tx pool snapshot");
+	}
+
+	const uint32_t version = byteBuffer.ReadU32();
+	if (version != SNAPSHOT_VERSION)
+	{
+		throw DESERIALIZATION_EXCEPTION_F("Unsupported snapshot version {}", version);
+	}
+
+	const uint64_t numEntries = byteBuffer.ReadU64();
+	if (numEntries > byteBuffer.GetRemainingSize() / ENTRY_HEADER_SIZE)
+	{
+		throw DESERIALIZATION_EXCEPTION_F("Snapshot can't hold {} entries", numEntries);
+	}
+
+	std::vector<Entry> entries;
+	entries.reserve((size_t)numEntries);
+	for (uint64_t i = 0; i < numEntries; i++)
+	{
+		const uint8_t poolType = byteBuffer.ReadU8();
+		const uint8_t status = byteBuffer.ReadU8();
+		if (poolType > (uint8_t)EPoolType::MEMPOOL || status > (uint8_t)EDandelionStatus::FLUFFED)
+		{
+			throw DESERIALIZATION_EXCEPTION("Invalid snapshot entry");
+		}
+
+		const int64_t timestamp = byteBuffer.Read64();
+
+		ByteBuffer txBuffer(byteBuffer.ReadVector(byteBuffer.ReadU64()), TX_PROTOCOL_VERSION);
+		TransactionPtr pTransaction = std::make_shared<Transaction>(Transaction::Deserialize(txBuffer));
+		if (txBuffer.GetRemainingSize() != 0)
+		{
+			throw DESERIALIZATION_EXCEPTION("Invalid snapshot entry");
+		}
+
+		entries.push_back(Entry{ (EPoolType)poolType, (EDandelionStatus)status, TimeUtil::ToTimePoint(timestamp), pTransaction });
+	}
+
+	if (byteBuffer.GetRemainingSize() != 0)
+	{
+		throw DESERIALIZATION_EXCEPTION("Unexpected data after snapshot entries");
+	}
+
+	return entries;
+}
+
+void TxPoolSnapshot::Write(const fs::path& path, const std::vector<Entry>& entries)
+{
+	FileUtil::SafeWriteToFile(path, Serialize(entries));
+}
+
+std::vector<TxPoolSnapshot::Entry> TxPoolSnapshot::Read(const fs::path& path)
+{
+	std::vector<uint8_t> bytes;
+	if (!FileUtil::ReadFile(path, bytes))
+	{
+		return {};
+	}
+
+	return Deserialize(bytes);
+}
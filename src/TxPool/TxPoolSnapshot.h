@@ -0,0 +1,40 @@
+#pragma once
+
+#include <TxPool/DandelionStatus.h>
+#include <TxPool/PoolType.h>
+#include <Core/Models/Transaction.h>
+#include <filesystem.h>
+#include <chrono>
+#include <vector>
+
+//
+// Compact binary snapshot of the mempool and stempool, so a restarted node doesn't start with empty pools.
+//
+// Format: magic | version (u32) | num entries (u64) | entries | Blake2b of everything before it.
+// Each entry is: pool type (u8) | dandelion status (u8) | timestamp in ms (i64) | tx size (u64) | tx.
+// Txs are serialized with protocol version 2, so inputs keep their features and can be read back without a UTXO lookup.
+//
+class TxPoolSnapshot
+{
+public:
+	struct Entry
+	{
+		EPoolType poolType;
+		EDandelionStatus status;
+		std::chrono::system_clock::time_point timestamp;
+		TransactionPtr pTransaction;
+	};
+
+	static std::vector<uint8_t> Serialize(const std::vector<Entry>& entries);
+
+	//
+	// Throws a DeserializationException if the snapshot is truncated, corrupt, or from an unknown version.
+	//
+	static std::vector<Entry> Deserialize(const std::vector<uint8_t>& bytes);
+
+	// Written to a temporary file first, and then renamed, so a crash mid-write never leaves a partial snapshot behind.
+	static void Write(const fs::path& path, const std::vector<Entry>& entries);
+
+	// Returns no entries if there's no snapshot.
+	static std::vector<Entry> Read(const fs::path& path);
+};
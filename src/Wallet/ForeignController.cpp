@@ -14,8 +14,8 @@ struct ForeignController::Context
 	ForeignServer::UPtr m_pServer;
 };
 
-ForeignController::ForeignController(IWalletManager& walletManager)
-	: m_walletManager(walletManager)
+ForeignController::ForeignController(IWalletManager& walletManager, const ServerOptions& serverOptions)
+	: m_walletManager(walletManager), m_serverOptions(serverOptions)
 {
 
 }
@@ -52,7 +52,8 @@ std::pair<uint16_t, std::optional<TorAddress>> ForeignController::StartListener(
 		pTorProcess,
 		m_walletManager,
 		token,
-		currentAddressIndex
+		currentAddressIndex,
+		m_serverOptions
 	);
 
 	auto response = std::make_pair(pServer->GetPortNumber(), pServer->GetTorAddress());
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Net/Tor/TorProcess.h>
+#include <Net/Servers/ServerOptions.h>
 #include <unordered_map>
 #include <optional>
 #include <string>
@@ -14,7 +15,7 @@ class KeyChain;
 class ForeignController
 {
 public:
-	ForeignController(IWalletManager& walletManager);
+	ForeignController(IWalletManager& walletManager, const ServerOptions& serverOptions);
 	~ForeignController();
 
 	std::pair<uint16_t, std::optional<TorAddress>> StartListener(
@@ -32,6 +33,7 @@ private:
 	struct Context;
 
 	IWalletManager& m_walletManager;
+	ServerOptions m_serverOptions;
 
 	mutable std::mutex m_contextsMutex;
 	std::unordered_map<std::string, std::unique_ptr<Context>> m_contextsByUsername;
@@ -10,8 +10,10 @@
 #include <Wallet/Exceptions/KeyChainException.h>
 #include <Core/Exceptions/UnimplementedException.h>
 
-KeyChain::KeyChain(PrivateExtKey&& masterKey, SecretKey&& bulletProofNonce)
-	: m_masterKey(std::move(masterKey)), m_bulletProofNonce(std::move(bulletProofNonce))
+KeyChain::KeyChain(PrivateExtKey&& masterKey, SecretKey&& bulletProofNonce, SecretKey&& rewindNonceHash)
+	: m_masterKey(std::move(masterKey)),
+	m_bulletProofNonce(std::move(bulletProofNonce)),
+	m_rewindNonceHash(std::move(rewindNonceHash))
 {
 
 }
@@ -20,7 +22,11 @@ KeyChain KeyChain::FromSeed(const SecureVector& masterSeed)
 {
 	PrivateExtKey masterKey = KeyGenerator(Global::GetConfig()).GenerateMasterKey(masterSeed);
 	SecretKey bulletProofNonce = Crypto::BlindSwitch(masterKey.GetPrivateKey(), 0);
-	return KeyChain(std::move(masterKey), std::move(bulletProofNonce));
+
+	PublicKey masterPublicKey = Crypto::CalculatePublicKey(masterKey.GetPrivateKey());
+	SecretKey rewindNonceHash = Hasher::Blake2b(masterPublicKey.GetCompressedVec());
+
+	return KeyChain(std::move(masterKey), std::move(bulletProofNonce), std::move(rewindNonceHash));
 }
 
 KeyChain KeyChain::FromRandom()
@@ -64,11 +70,7 @@ std::unique_ptr<RewoundProof> KeyChain::RewindRangeProof(const Commitment& commi
 	}
 	else if (bulletproofType == EBulletproofType::ENHANCED)
 	{
-		PublicKey masterPublicKey = Crypto::CalculatePublicKey(m_masterKey.GetPrivateKey());
-
-		const SecretKey rewindNonceHash = Hasher::Blake2b(masterPublicKey.GetCompressedVec());
-
-		return Crypto::RewindRangeProof(commitment, rangeProof, CreateNonce(commitment, rewindNonceHash));
+		return Crypto::RewindRangeProof(commitment, rangeProof, CreateNonce(commitment, m_rewindNonceHash));
 	}
 
 	throw UNIMPLEMENTED_EXCEPTION;
@@ -93,10 +95,7 @@ RangeProof KeyChain::GenerateRangeProof(
 	{
 		const SecretKey privateNonceHash = Hasher::Blake2b(m_masterKey.GetPrivateKey().GetVec());
 
-		PublicKey masterPublicKey = Crypto::CalculatePublicKey(m_masterKey.GetPrivateKey());
-		const SecretKey rewindNonceHash = Hasher::Blake2b(masterPublicKey.GetCompressedVec());
-
-		return Crypto::GenerateRangeProof(amount, blindingFactor, CreateNonce(commitment, privateNonceHash), CreateNonce(commitment, rewindNonceHash), proofMessage);
+		return Crypto::GenerateRangeProof(amount, blindingFactor, CreateNonce(commitment, privateNonceHash), CreateNonce(commitment, m_rewindNonceHash), proofMessage);
 	}
 	
 	throw UNIMPLEMENTED_EXCEPTION;
@@ -5,29 +5,36 @@
 #include <Wallet/Keychain/KeyChain.h>
 #include <Wallet/WalletUtil.h>
 #include <Common/Logger.h>
+#include <algorithm>
+#include <future>
+#include <iterator>
 
 static const uint64_t NUM_OUTPUTS_PER_BATCH = 1000;
 
+// Batches smaller than this are rewound on the calling thread.
+static const size_t MIN_OUTPUTS_PER_TASK = 50;
+
 std::vector<OutputDataEntity> OutputRestorer::FindAndRewindOutputs(const std::shared_ptr<IWalletDB>& pBatch, const bool fromGenesis) const
 {
     uint64_t nextLeafIndex = fromGenesis ? 0 : pBatch->GetRestoreLeafIndex() + 1;
     uint64_t highestIndex = 0;
 
+    auto fetch_range = [this](const uint64_t startIndex) {
+        return m_pNodeClient->GetOutputsByLeafIndex(startIndex, NUM_OUTPUTS_PER_BATCH);
+    };
+
+    const int numThreads = (int)std::max(1u, std::thread::hardware_concurrency());
+    ctpl::thread_pool threadPool(numThreads);
+
     std::vector<OutputDataEntity> walletOutputs;
+    std::future<std::unique_ptr<OutputRange>> nextRange = std::async(std::launch::async, fetch_range, nextLeafIndex);
     while (true) {
-        std::unique_ptr<OutputRange> pOutputRange = m_pNodeClient->GetOutputsByLeafIndex(nextLeafIndex, NUM_OUTPUTS_PER_BATCH);
+        std::unique_ptr<OutputRange> pOutputRange = nextRange.get();
         if (pOutputRange == nullptr || pOutputRange->GetLastRetrievedIndex() == 0) {
             // No new outputs since last restore
             return std::vector<OutputDataEntity>();
         }
 
-        for (const OutputDTO& output : pOutputRange->GetOutputs()) {
-            std::unique_ptr<OutputDataEntity> pOutputDataEntity = GetWalletOutput(output);
-            if (pOutputDataEntity != nullptr) {
-                walletOutputs.emplace_back(*pOutputDataEntity);
-            }
-        }
-
         if (highestIndex == 0) {
             // Cache this, rather than use the new response from pOutputRange.
             // Otherwise, pOutputRange->GetHighestIndex() could continue to rise slowly during sync, tying up this thread.
@@ -35,7 +42,17 @@ std::vector<OutputDataEntity> OutputRestorer::FindAndRewindOutputs(const std::sh
         }
 
         nextLeafIndex = pOutputRange->GetLastRetrievedIndex() + 1;
-        if (nextLeafIndex > highestIndex) {
+        const bool lastRange = nextLeafIndex > highestIndex;
+
+        // Prefetch the next range while the current one is being rewound.
+        if (!lastRange) {
+            nextRange = std::async(std::launch::async, fetch_range, nextLeafIndex);
+        }
+
+        std::vector<OutputDataEntity> rewound = RewindOutputs(threadPool, pOutputRange->GetOutputs());
+        std::move(rewound.begin(), rewound.end(), std::back_inserter(walletOutputs));
+
+        if (lastRange) {
             break;
         }
     }
@@ -45,6 +62,54 @@ std::vector<OutputDataEntity> OutputRestorer::FindAndRewindOutputs(const std::sh
     return walletOutputs;
 }
 
+std::vector<OutputDataEntity> OutputRestorer::RewindOutputs(ctpl::thread_pool& threadPool, const std::vector<OutputDTO>& outputs) const
+{
+    // Rewinding only needs the shared (read) lock on the bulletproof context, so chunks can be rewound concurrently.
+    const size_t numTasks = std::min((size_t)threadPool.size(), outputs.size() / MIN_OUTPUTS_PER_TASK);
+    if (numTasks <= 1) {
+        std::vector<OutputDataEntity> walletOutputs;
+        for (const OutputDTO& output : outputs) {
+            std::unique_ptr<OutputDataEntity> pOutputDataEntity = GetWalletOutput(output);
+            if (pOutputDataEntity != nullptr) {
+                walletOutputs.emplace_back(*pOutputDataEntity);
+            }
+        }
+
+        return walletOutputs;
+    }
+
+    const size_t chunkSize = (outputs.size() + numTasks - 1) / numTasks;
+
+    std::vector<std::future<std::vector<OutputDataEntity>>> tasks;
+    for (size_t begin = 0; begin < outputs.size(); begin += chunkSize) {
+        const size_t end = std::min(begin + chunkSize, outputs.size());
+        tasks.push_back(threadPool.push([this, &outputs, begin, end](int) {
+            std::vector<OutputDataEntity> chunkOutputs;
+            for (size_t i = begin; i < end; i++) {
+                std::unique_ptr<OutputDataEntity> pOutputDataEntity = GetWalletOutput(outputs[i]);
+                if (pOutputDataEntity != nullptr) {
+                    chunkOutputs.emplace_back(*pOutputDataEntity);
+                }
+            }
+
+            return chunkOutputs;
+        }));
+    }
+
+    // Wait on every task before rethrowing, since they reference outputs.
+    for (auto& task : tasks) {
+        task.wait();
+    }
+
+    std::vector<OutputDataEntity> walletOutputs;
+    for (auto& task : tasks) {
+        std::vector<OutputDataEntity> chunkOutputs = task.get();
+        std::move(chunkOutputs.begin(), chunkOutputs.end(), std::back_inserter(walletOutputs));
+    }
+
+    return walletOutputs;
+}
+
 std::unique_ptr<OutputDataEntity> OutputRestorer::GetWalletOutput(const OutputDTO& output) const
 {
     EBulletproofType type = EBulletproofType::ORIGINAL;
@@ -5,6 +5,7 @@
 #include <Wallet/WalletDB/Models/OutputDataEntity.h>
 #include <Core/Models/DTOs/OutputDTO.h>
 #include <Crypto/BulletproofType.h>
+#include <scheduler/ctpl_stl.h>
 
 // Forward Declarations
 class KeyChain;
@@ -22,6 +23,11 @@ public:
 	) const;
 
 private:
+	std::vector<OutputDataEntity> RewindOutputs(
+		ctpl::thread_pool& threadPool,
+		const std::vector<OutputDTO>& outputs
+	) const;
+
 	std::unique_ptr<OutputDataEntity> GetWalletOutput(
 		const OutputDTO& output
 	) const;
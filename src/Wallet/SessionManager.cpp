@@ -36,7 +36,7 @@ Locked<SessionManager> SessionManager::Create(
 	const std::shared_ptr<IWalletStore>& pWalletDB,
 	IWalletManager& walletManager)
 {
-	auto pForeignController = std::make_unique<ForeignController>(walletManager);
+	auto pForeignController = std::make_unique<ForeignController>(walletManager, config.GetForeignAPIOptions());
 	auto pSessionManager = std::make_shared<SessionManager>(
 		config,
 		pNodeClient,
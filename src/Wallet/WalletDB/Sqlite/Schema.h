@@ -1,3 +1,3 @@
 #pragma once
 
-static const int LATEST_SCHEMA_VERSION = 4;
\ No newline at end of file
+static const int LATEST_SCHEMA_VERSION = 5;
\ No newline at end of file
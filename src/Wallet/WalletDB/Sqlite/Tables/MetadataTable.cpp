@@ -10,41 +10,65 @@
 // next_tx_id: INTEGER NOT NULL
 // refresh_block_height: BLOB NOT NULL
 // restore_leaf_index: INTEGER NOT NULL
+// refresh_block_hash: TEXT NOT NULL (hex, or empty if not known)
 void MetadataTable::CreateTable(SqliteDB& database)
 {
-	std::string table_creation_cmd = "create table metadata(id INTEGER PRIMARY KEY, next_tx_id INTEGER NOT NULL, refresh_block_height INTEGER NOT NULL, restore_leaf_index INTEGER NOT NULL);";
-	table_creation_cmd += "insert into metadata values(1, 0, 0, 0);";
+	std::string table_creation_cmd = "create table metadata(id INTEGER PRIMARY KEY, next_tx_id INTEGER NOT NULL, refresh_block_height INTEGER NOT NULL, restore_leaf_index INTEGER NOT NULL, refresh_block_hash TEXT DEFAULT '' NOT NULL);";
+	table_creation_cmd += "insert into metadata values(1, 0, 0, 0, '');";
 	
 	database.Execute(table_creation_cmd);
 }
 
 void MetadataTable::UpdateSchema(SqliteDB& database, const int previousVersion)
 {
+	if (previousVersion < 5 && !HasRefreshBlockHash(database)) {
+		std::string alter_table_cmd = "ALTER TABLE metadata ADD refresh_block_hash TEXT DEFAULT '' NOT NULL;";
+		database.Execute(alter_table_cmd);
+	}
+
 	if (previousVersion == 0)
 	{
 		UserMetadata metadata = MetadataTable::GetMetadata(database);
 		UserMetadata newMetadata(
 			metadata.GetNextTxId(),
 			metadata.GetRefreshBlockHeight(),
+			metadata.GetRefreshBlockHash(),
 			0
 		);
 		SaveMetadata(database, newMetadata);
 	}
+}
 
-	return;
+// Checked instead of relying on the version alone, so a wallet that already has the column can still be upgraded.
+bool MetadataTable::HasRefreshBlockHash(SqliteDB& database)
+{
+	auto pStatement = database.Query("PRAGMA table_info(metadata);");
+	while (pStatement->Step()) {
+		if (pStatement->GetColumnString(1) == "refresh_block_hash") {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 UserMetadata MetadataTable::GetMetadata(SqliteDB& database)
 {
-	std::string get_metadata_query = "SELECT next_tx_id, refresh_block_height, restore_leaf_index FROM metadata WHERE ID=1";
+	std::string get_metadata_query = "SELECT next_tx_id, refresh_block_height, restore_leaf_index, refresh_block_hash FROM metadata WHERE ID=1";
 	auto pStatement = database.Query(get_metadata_query);
 
 	if (pStatement->Step()) {
 		const uint32_t nextTxId = (uint32_t)pStatement->GetColumnInt(0);
 		const uint64_t refreshBlockHeight = (uint64_t)pStatement->GetColumnInt64(1);
 		const uint64_t restoreLeafIndex = (uint64_t)pStatement->GetColumnInt64(2);
+		const std::string refreshBlockHash = pStatement->GetColumnString(3);
 
-		return UserMetadata(nextTxId, refreshBlockHeight, restoreLeafIndex);
+		return UserMetadata(
+			nextTxId,
+			refreshBlockHeight,
+			refreshBlockHash.empty() ? ZERO_HASH : Hash::FromHex(refreshBlockHash),
+			restoreLeafIndex
+		);
 	} else {
 		WALLET_ERROR_F("Error while performing sql: {}", database.GetError());
 		throw WALLET_STORE_EXCEPTION("No metadata found.");
@@ -54,10 +78,11 @@ UserMetadata MetadataTable::GetMetadata(SqliteDB& database)
 void MetadataTable::SaveMetadata(SqliteDB& database, const UserMetadata& userMetadata)
 {
 	std::string update_metadata_cmd = StringUtil::Format(
-		"update metadata set next_tx_id={}, refresh_block_height={}, restore_leaf_index={} where id=1;",
+		"update metadata set next_tx_id={}, refresh_block_height={}, restore_leaf_index={}, refresh_block_hash='{}' where id=1;",
 		userMetadata.GetNextTxId(),
 		userMetadata.GetRefreshBlockHeight(),
-		userMetadata.GetRestoreLeafIndex()
+		userMetadata.GetRestoreLeafIndex(),
+		userMetadata.GetRefreshBlockHash() == ZERO_HASH ? "" : userMetadata.GetRefreshBlockHash().ToHex()
 	);
 	database.Execute(update_metadata_cmd);
 }
\ No newline at end of file
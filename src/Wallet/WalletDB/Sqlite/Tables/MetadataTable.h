@@ -11,4 +11,7 @@ public:
 
 	static UserMetadata GetMetadata(SqliteDB& database);
 	static void SaveMetadata(SqliteDB& database, const UserMetadata& userMetadata);
+
+private:
+	static bool HasRefreshBlockHash(SqliteDB& database);
 };
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Wallet/WalletDB/Models/OutputDataEntity.h>
+#include <Wallet/WalletTx.h>
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+//
+// In-memory copy of a logged-in user's decrypted outputs and transactions.
+// The cache only ever holds committed data. Writes made inside an open batch are
+// passed in as "pending" overlays by WalletSqlite, and only applied once the batch commits.
+//
+class WalletCache
+{
+public:
+	using UPtr = std::unique_ptr<WalletCache>;
+
+	WalletCache(std::vector<OutputDataEntity>&& outputs, std::vector<WalletTx>&& transactions)
+	{
+		AddOutputs(outputs);
+		AddTransactions(transactions);
+	}
+
+	std::vector<OutputDataEntity> GetOutputs(const std::vector<OutputDataEntity>& pending) const
+	{
+		std::vector<OutputDataEntity> outputs = m_outputs;
+		std::unordered_map<Commitment, size_t> indices;
+
+		for (const OutputDataEntity& output : pending) {
+			auto iter = m_outputIndices.find(output.GetCommitment());
+			if (iter != m_outputIndices.cend()) {
+				outputs[iter->second] = output;
+				continue;
+			}
+
+			auto pending_iter = indices.find(output.GetCommitment());
+			if (pending_iter != indices.cend()) {
+				outputs[pending_iter->second] = output;
+			} else {
+				indices.insert({ output.GetCommitment(), outputs.size() });
+				outputs.push_back(output);
+			}
+		}
+
+		return outputs;
+	}
+
+	std::vector<WalletTx> GetTransactions(const std::vector<WalletTx>& pending) const
+	{
+		std::map<uint32_t, WalletTx> transactions = m_transactions;
+		for (const WalletTx& walletTx : pending) {
+			transactions.insert_or_assign(walletTx.GetId(), walletTx);
+		}
+
+		std::vector<WalletTx> result;
+		result.reserve(transactions.size());
+		for (auto& entry : transactions) {
+			result.emplace_back(std::move(entry.second));
+		}
+
+		return result;
+	}
+
+	std::unique_ptr<WalletTx> GetTransactionById(const std::vector<WalletTx>& pending, const uint32_t walletTxId) const
+	{
+		for (auto iter = pending.crbegin(); iter != pending.crend(); iter++) {
+			if (iter->GetId() == walletTxId) {
+				return std::make_unique<WalletTx>(*iter);
+			}
+		}
+
+		auto iter = m_transactions.find(walletTxId);
+		if (iter != m_transactions.cend()) {
+			return std::make_unique<WalletTx>(iter->second);
+		}
+
+		return nullptr;
+	}
+
+	void AddOutputs(const std::vector<OutputDataEntity>& outputs)
+	{
+		for (const OutputDataEntity& output : outputs) {
+			auto iter = m_outputIndices.find(output.GetCommitment());
+			if (iter != m_outputIndices.cend()) {
+				m_outputs[iter->second] = output;
+			} else {
+				m_outputIndices.insert({ output.GetCommitment(), m_outputs.size() });
+				m_outputs.push_back(output);
+			}
+		}
+	}
+
+	void AddTransactions(const std::vector<WalletTx>& transactions)
+	{
+		for (const WalletTx& walletTx : transactions) {
+			m_transactions.insert_or_assign(walletTx.GetId(), walletTx);
+		}
+	}
+
+private:
+	std::vector<OutputDataEntity> m_outputs;
+	std::unordered_map<Commitment, size_t> m_outputIndices;
+	std::map<uint32_t, WalletTx> m_transactions;
+};
@@ -22,12 +22,26 @@ void WalletSqlite::Commit()
 {
 	m_pTransaction->Commit();
 	SetDirty(false);
+
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	ApplyPendingToCache();
 }
 
 void WalletSqlite::Rollback() noexcept
 {
 	m_pTransaction->Rollback();
 	SetDirty(false);
+
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+
+	// A cache loaded mid-batch may contain rows that were just rolled back.
+	if (m_cacheLoadedInBatch) {
+		m_pCache.reset();
+	}
+
+	m_pendingOutputs.clear();
+	m_pendingTransactions.clear();
+	m_cacheLoadedInBatch = false;
 }
 
 void WalletSqlite::OnInitWrite(const bool /*batch*/)
@@ -40,6 +54,10 @@ void WalletSqlite::OnInitWrite(const bool /*batch*/)
 void WalletSqlite::OnEndWrite()
 {
 	m_pTransaction.reset();
+
+	// Anything written after the batch was committed went through in autocommit mode.
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	ApplyPendingToCache();
 }
 
 KeyChainPath WalletSqlite::GetNextChildPath(const KeyChainPath& parentPath)
@@ -97,26 +115,35 @@ void WalletSqlite::SaveSlateContext(const SecureVector& masterSeed, const uuids:
 void WalletSqlite::AddOutputs(const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs)
 {
 	OutputsTable::AddOutputs(*m_pDatabase, masterSeed, outputs);
+
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	m_pendingOutputs.insert(m_pendingOutputs.end(), outputs.cbegin(), outputs.cend());
 }
 
 std::vector<OutputDataEntity> WalletSqlite::GetOutputs(const SecureVector& masterSeed) const
 {
-	return OutputsTable::GetOutputs(*m_pDatabase, masterSeed);
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	return GetCache(masterSeed).GetOutputs(m_pendingOutputs);
 }
 
 void WalletSqlite::AddTransaction(const SecureVector& masterSeed, const WalletTx& walletTx)
 {
 	TransactionsTable::AddTransactions(*m_pDatabase, masterSeed, std::vector<WalletTx>({ walletTx }));
+
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	m_pendingTransactions.push_back(walletTx);
 }
 
 std::vector<WalletTx> WalletSqlite::GetTransactions(const SecureVector& masterSeed) const
 {
-	return TransactionsTable::GetTransactions(*m_pDatabase, masterSeed);
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	return GetCache(masterSeed).GetTransactions(m_pendingTransactions);
 }
 
 std::unique_ptr<WalletTx> WalletSqlite::GetTransactionById(const SecureVector& masterSeed, const uint32_t walletTxId) const
 {
-	return TransactionsTable::GetTransactionById(*m_pDatabase, masterSeed, walletTxId);
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	return GetCache(masterSeed).GetTransactionById(m_pendingTransactions, walletTxId);
 }
 
 uint32_t WalletSqlite::GetNextTransactionId()
@@ -124,7 +151,7 @@ uint32_t WalletSqlite::GetNextTransactionId()
 	UserMetadata metadata = GetMetadata();
 
 	const uint32_t nextTxId = metadata.GetNextTxId();
-	const UserMetadata updatedMetadata(nextTxId + 1, metadata.GetRefreshBlockHeight(), metadata.GetRestoreLeafIndex());
+	const UserMetadata updatedMetadata(nextTxId + 1, metadata.GetRefreshBlockHeight(), metadata.GetRefreshBlockHash(), metadata.GetRestoreLeafIndex());
 	SaveMetadata(updatedMetadata);
 
 	return nextTxId;
@@ -135,11 +162,16 @@ uint64_t WalletSqlite::GetRefreshBlockHeight() const
 	return GetMetadata().GetRefreshBlockHeight();
 }
 
-void WalletSqlite::UpdateRefreshBlockHeight(const uint64_t refreshBlockHeight)
+Hash WalletSqlite::GetRefreshBlockHash() const
+{
+	return GetMetadata().GetRefreshBlockHash();
+}
+
+void WalletSqlite::UpdateRefreshBlock(const uint64_t refreshBlockHeight, const Hash& refreshBlockHash)
 {
 	UserMetadata metadata = GetMetadata();
 
-	SaveMetadata(UserMetadata(metadata.GetNextTxId(), refreshBlockHeight, metadata.GetRestoreLeafIndex()));
+	SaveMetadata(UserMetadata(metadata.GetNextTxId(), refreshBlockHeight, refreshBlockHash, metadata.GetRestoreLeafIndex()));
 }
 
 uint64_t WalletSqlite::GetRestoreLeafIndex() const
@@ -151,7 +183,7 @@ void WalletSqlite::UpdateRestoreLeafIndex(const uint64_t lastLeafIndex)
 {
 	UserMetadata metadata = GetMetadata();
 
-	SaveMetadata(UserMetadata{ metadata.GetNextTxId(), metadata.GetRefreshBlockHeight(), lastLeafIndex });
+	SaveMetadata(UserMetadata{ metadata.GetNextTxId(), metadata.GetRefreshBlockHeight(), metadata.GetRefreshBlockHash(), lastLeafIndex });
 }
 
 UserMetadata WalletSqlite::GetMetadata() const
@@ -163,3 +195,29 @@ void WalletSqlite::SaveMetadata(const UserMetadata& userMetadata)
 {
 	MetadataTable::SaveMetadata(*m_pDatabase, userMetadata);
 }
+
+void WalletSqlite::ApplyPendingToCache()
+{
+	if (m_pCache != nullptr) {
+		m_pCache->AddOutputs(m_pendingOutputs);
+		m_pCache->AddTransactions(m_pendingTransactions);
+	}
+
+	m_pendingOutputs.clear();
+	m_pendingTransactions.clear();
+	m_cacheLoadedInBatch = false;
+}
+
+const WalletCache& WalletSqlite::GetCache(const SecureVector& masterSeed) const
+{
+	if (m_pCache == nullptr) {
+		WALLET_DEBUG_F("Loading wallet cache for user: {}", m_username);
+
+		std::vector<OutputDataEntity> outputs = OutputsTable::GetOutputs(*m_pDatabase, masterSeed);
+		std::vector<WalletTx> transactions = TransactionsTable::GetTransactions(*m_pDatabase, masterSeed);
+		m_pCache = std::make_unique<WalletCache>(std::move(outputs), std::move(transactions));
+		m_cacheLoadedInBatch = (m_pTransaction != nullptr);
+	}
+
+	return *m_pCache;
+}
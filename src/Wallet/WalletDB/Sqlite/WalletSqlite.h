@@ -3,16 +3,18 @@
 #include "../UserMetadata.h"
 #include "SqliteTransaction.h"
 #include "SqliteDB.h"
+#include "WalletCache.h"
 
 #include <Wallet/WalletDB/WalletDB.h>
 #include <Wallet/WalletDB/Models/SlateContextEntity.h>
 #include <unordered_map>
+#include <mutex>
 
 class WalletSqlite : public IWalletDB
 {
 public:
 	explicit WalletSqlite(const fs::path& walletDirectory, const std::string& username, const SqliteDB::Ptr& pDatabase)
-		: m_walletDirectory(walletDirectory), m_username(username), m_pDatabase(pDatabase), m_pTransaction(nullptr) { }
+		: m_walletDirectory(walletDirectory), m_username(username), m_pDatabase(pDatabase), m_pTransaction(nullptr), m_pCache(nullptr), m_cacheLoadedInBatch(false) { }
 	virtual ~WalletSqlite() = default;
 
 	void Commit() final;
@@ -62,7 +64,8 @@ public:
 
 	uint32_t GetNextTransactionId() final;
 	uint64_t GetRefreshBlockHeight() const final;
-	void UpdateRefreshBlockHeight(const uint64_t refreshBlockHeight) final;
+	Hash GetRefreshBlockHash() const final;
+	void UpdateRefreshBlock(const uint64_t refreshBlockHeight, const Hash& refreshBlockHash) final;
 	uint64_t GetRestoreLeafIndex() const final;
 	void UpdateRestoreLeafIndex(const uint64_t lastLeafIndex) final;
 
@@ -71,8 +74,20 @@ private:
 	UserMetadata GetMetadata() const;
 	void SaveMetadata(const UserMetadata& userMetadata);
 
+	// Loads the decrypted outputs and transactions on first use. Caller must hold m_cacheMutex.
+	const WalletCache& GetCache(const SecureVector& masterSeed) const;
+	void ApplyPendingToCache();
+
 	fs::path m_walletDirectory;
 	std::string m_username;
 	SqliteDB::Ptr m_pDatabase;
 	std::unique_ptr<SqliteTransaction> m_pTransaction;
+
+	// Decrypted copies of committed outputs & txs, kept for the lifetime of the login session.
+	// Writes are persisted to sqlite immediately, and applied to the cache when the batch commits.
+	mutable std::mutex m_cacheMutex;
+	mutable WalletCache::UPtr m_pCache;
+	mutable bool m_cacheLoadedInBatch;
+	std::vector<OutputDataEntity> m_pendingOutputs;
+	std::vector<WalletTx> m_pendingTransactions;
 };
@@ -2,18 +2,20 @@
 
 #include <Core/Serialization/Serializer.h>
 #include <Core/Serialization/ByteBuffer.h>
+#include <Crypto/Models/Hash.h>
 #include <cstdint>
 
-static const uint8_t USER_METADATA_FORMAT = 0;
+static const uint8_t USER_METADATA_FORMAT = 1;
 
 class UserMetadata
 {
 public:
-	UserMetadata(const uint32_t nextTxId, const uint64_t refreshBlockHeight, const uint64_t restoreLeafIndex)
-		: m_nextTxId(nextTxId), m_refreshBlockHeight(refreshBlockHeight), m_restoreLeafIndex(restoreLeafIndex) { }
+	UserMetadata(const uint32_t nextTxId, const uint64_t refreshBlockHeight, const Hash& refreshBlockHash, const uint64_t restoreLeafIndex)
+		: m_nextTxId(nextTxId), m_refreshBlockHeight(refreshBlockHeight), m_refreshBlockHash(refreshBlockHash), m_restoreLeafIndex(restoreLeafIndex) { }
 
 	uint32_t GetNextTxId() const noexcept { return m_nextTxId; }
 	uint64_t GetRefreshBlockHeight() const noexcept { return m_refreshBlockHeight; }
+	const Hash& GetRefreshBlockHash() const noexcept { return m_refreshBlockHash; }
 	uint64_t GetRestoreLeafIndex() const noexcept { return m_restoreLeafIndex; }
 
 	void Serialize(Serializer& serializer) const
@@ -22,12 +24,13 @@ public:
 		serializer.Append<uint32_t>(m_nextTxId);
 		serializer.Append<uint64_t>(m_refreshBlockHeight);
 		serializer.Append<uint64_t>(m_restoreLeafIndex);
+		serializer.AppendBigInteger(m_refreshBlockHash);
 	}
 
 	static UserMetadata Deserialize(ByteBuffer& byteBuffer)
 	{
 		const uint8_t format = byteBuffer.ReadU8();
-		if (format != USER_METADATA_FORMAT)
+		if (format > USER_METADATA_FORMAT)
 		{
 			throw DESERIALIZATION_EXCEPTION_F("Expected format {}, but was {}", USER_METADATA_FORMAT, format);
 		}
@@ -35,11 +38,13 @@ public:
 		const uint32_t nextTxId = byteBuffer.ReadU32();
 		const uint64_t refreshBlockHeight = byteBuffer.ReadU64();
 		const uint64_t restoreLeafIndex = byteBuffer.ReadU64();
-		return UserMetadata(nextTxId, refreshBlockHeight, restoreLeafIndex);
+		const Hash refreshBlockHash = format >= 1 ? byteBuffer.ReadBigInteger<32>() : ZERO_HASH;
+		return UserMetadata(nextTxId, refreshBlockHeight, refreshBlockHash, restoreLeafIndex);
 	}
 
 private:
 	uint32_t m_nextTxId;
 	uint64_t m_refreshBlockHeight;
+	Hash m_refreshBlockHash; // ZERO_HASH if not known
 	uint64_t m_restoreLeafIndex;
 };
\ No newline at end of file
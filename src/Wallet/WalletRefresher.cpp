@@ -6,9 +6,14 @@
 #include <Wallet/WalletUtil.h>
 #include <Wallet/NodeClient.h>
 #include <Wallet/WalletDB/WalletDB.h>
+#include <algorithm>
+#include <set>
 #include <unordered_map>
 
-// TODO: Rewrite this && use cache - Shouldn't refresh when block height = same
+// Decrypted outputs & txs are cached per session by the wallet DB (see WalletCache),
+// and refreshing is skipped entirely when the chain tip hasn't changed since the last refresh.
+//
+// TODO: Rewrite this
 // 0. Initial login after upgrade - for every output, find matching WalletTx and update OutputDataEntity TxId. If none found, create new WalletTx.
 //
 // 1. Check for own outputs in new blocks.
@@ -20,11 +25,25 @@ std::vector<OutputDataEntity> WalletRefresher::Refresh(const SecureVector& maste
 {
     auto pBatch = walletDB.BatchWrite();
 
-    if (m_pNodeClient->GetChainHeight() < pBatch->GetRefreshBlockHeight()) {
+    auto pTip = m_pNodeClient->GetTipHeader();
+    if (pTip == nullptr) {
+        throw std::runtime_error("Tip header not received");
+    }
+
+    const uint64_t chainHeight = pTip->GetHeight();
+    const uint64_t refreshHeight = pBatch->GetRefreshBlockHeight();
+    if (chainHeight < refreshHeight) {
         WALLET_TRACE("Skipping refresh since node is resyncing.");
         return std::vector<OutputDataEntity>();
     }
 
+    // Outputs can only be confirmed or spent by new blocks, so there's nothing to refresh.
+    // A reorg to a chain of the same height still changes the tip, so the hash must match too.
+    if (!fromGenesis && chainHeight == refreshHeight && refreshHeight > 0 && pTip->GetHash() == pBatch->GetRefreshBlockHash()) {
+        WALLET_TRACE_F("Already refreshed at height {}", refreshHeight);
+        return pBatch->GetOutputs(masterSeed);
+    }
+
     std::vector<OutputDataEntity> walletOutputs = pBatch->GetOutputs(masterSeed);
     std::vector<WalletTx> walletTransactions = pBatch->GetTransactions(masterSeed);
 
@@ -32,10 +51,22 @@ std::vector<OutputDataEntity> WalletRefresher::Refresh(const SecureVector& maste
     std::vector<OutputDataEntity> new_outputs = FindNewOutputs(masterSeed, pBatch.GetShared(), walletOutputs, fromGenesis);
 
     // 2. Create a new WalletTx for each newly received output, and add the output & tx to the database.
+    // The headers (for block times) are fetched up front, so a remote node is asked for all of them at once.
+    std::set<uint64_t> newOutputHeights;
+    for (const OutputDataEntity& new_output : new_outputs) {
+        if (new_output.GetBlockHeight().has_value()) {
+            newOutputHeights.insert(new_output.GetBlockHeight().value());
+        }
+    }
+
+    const std::map<uint64_t, BlockHeaderPtr> headers = newOutputHeights.empty()
+        ? std::map<uint64_t, BlockHeaderPtr>()
+        : m_pNodeClient->GetBlockHeaders(newOutputHeights);
+
     for (OutputDataEntity& new_output : new_outputs) {
         WALLET_INFO_F("Restoring unknown output: {}", new_output);
 
-        auto blockTimeOpt = GetBlockTime(new_output);
+        auto blockTimeOpt = GetBlockTime(new_output, headers);
 
         // If no output found, create new WalletTx and OutputDataEntity.
         const uint32_t walletTxId = pBatch->GetNextTransactionId();
@@ -64,7 +95,7 @@ std::vector<OutputDataEntity> WalletRefresher::Refresh(const SecureVector& maste
     }
 
     // 3. Refresh status for all wallet outputs
-    RefreshOutputs(masterSeed, pBatch, walletOutputs);
+    RefreshOutputs(masterSeed, pBatch, *pTip, walletOutputs);
 
     // 4. For all wallet outputs, update matching WalletTx status.
     RefreshTransactions(masterSeed, pBatch, walletOutputs, walletTransactions);
@@ -101,17 +132,21 @@ std::vector<OutputDataEntity> WalletRefresher::FindNewOutputs(
     return new_outputs;
 }
 
-void WalletRefresher::RefreshOutputs(const SecureVector& masterSeed, Writer<IWalletDB> pBatch, std::vector<OutputDataEntity>& walletOutputs)
+void WalletRefresher::RefreshOutputs(
+    const SecureVector& masterSeed,
+    Writer<IWalletDB> pBatch,
+    const BlockHeader& tip,
+    std::vector<OutputDataEntity>& walletOutputs)
 {
+    // SPENT outputs are included, since a reorg can drop the spending tx and put them back in the UTXO set.
+    // When and in which block an output was spent isn't tracked, so there's no narrower reorg horizon to filter by.
     std::vector<Commitment> commitments;
     std::transform(
-        walletOutputs.begin(), walletOutputs.end(),
+        walletOutputs.cbegin(), walletOutputs.cend(),
         std::back_inserter(commitments),
         [](const OutputDataEntity& output) { return output.GetCommitment(); }
     );
 
-    const uint64_t lastConfirmedHeight = m_pNodeClient->GetChainHeight();
-
     const std::map<Commitment, OutputLocation> outputLocations = m_pNodeClient->GetOutputsByCommitment(commitments);
     for (OutputDataEntity& outputData : walletOutputs) {
         const EOutputStatus current_status = outputData.GetStatus();
@@ -144,7 +179,7 @@ void WalletRefresher::RefreshOutputs(const SecureVector& masterSeed, Writer<IWal
                 continue;
             }
 
-            // TODO: Check if (lastConfirmedHeight > outputData.GetConfirmedHeight)
+            // TODO: Check if (tip.GetHeight() > outputData.GetConfirmedHeight)
             WALLET_DEBUG_F("Marking output as spent: {}", outputData);
 
             outputData.SetStatus(EOutputStatus::SPENT);
@@ -152,7 +187,7 @@ void WalletRefresher::RefreshOutputs(const SecureVector& masterSeed, Writer<IWal
         }
     }
 
-    pBatch->UpdateRefreshBlockHeight(lastConfirmedHeight);
+    pBatch->UpdateRefreshBlock(tip.GetHeight(), tip.GetHash());
 }
 
 void WalletRefresher::RefreshTransactions(
@@ -211,12 +246,14 @@ void WalletRefresher::RefreshTransactions(
     }
 }
 
-std::optional<std::chrono::system_clock::time_point> WalletRefresher::GetBlockTime(const OutputDataEntity& output) const
+std::optional<std::chrono::system_clock::time_point> WalletRefresher::GetBlockTime(
+    const OutputDataEntity& output,
+    const std::map<uint64_t, BlockHeaderPtr>& headers) const
 {
     if (output.GetBlockHeight().has_value()) {
-        auto pHeader = m_pNodeClient->GetBlockHeader(output.GetBlockHeight().value());
-        if (pHeader != nullptr) {
-            return std::make_optional(TimeUtil::ToTimePoint(pHeader->GetTimestamp() * 1000));
+        auto iter = headers.find(output.GetBlockHeight().value());
+        if (iter != headers.cend() && iter->second != nullptr) {
+            return std::make_optional(TimeUtil::ToTimePoint(iter->second->GetTimestamp() * 1000));
         }
     }
 
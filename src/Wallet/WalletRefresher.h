@@ -34,9 +34,11 @@ private:
 		const bool fromGenesis
 	);
 
+	// tip is the chain tip the refresh started at, and is saved as the new refresh block.
 	void RefreshOutputs(
 		const SecureVector& masterSeed,
 		Writer<IWalletDB> pBatch,
+		const BlockHeader& tip,
 		std::vector<OutputDataEntity>& walletOutputs
 	);
 
@@ -47,7 +49,10 @@ private:
 		std::vector<WalletTx>& walletTransactions
 	);
 
-	std::optional<std::chrono::system_clock::time_point> GetBlockTime(const OutputDataEntity& output) const;
+	std::optional<std::chrono::system_clock::time_point> GetBlockTime(
+		const OutputDataEntity& output,
+		const std::map<uint64_t, BlockHeaderPtr>& headers
+	) const;
 
 	std::unique_ptr<OutputDataEntity> FindOutput(
 		const std::vector<OutputDataEntity>& walletOutputs,
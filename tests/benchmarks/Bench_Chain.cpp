@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+#include "BenchmarkFixtures.h"
+
+#include <Database/BlockDb.h>
+#include <PMMR/TxHashSetManager.h>
+#include <TxPool/Pool.h>
+
+#include <limits>
+#include <utility>
+
+//
+// Applies the fixtures' next block (half of the pool transactions) on top of the fixture chain state.
+// Each iteration gets fresh batches, which are rolled back (untimed) once the iteration ends.
+//
+BENCHMARK_GROUP("TxHashSet::ApplyBlock")
+{
+	BenchmarkFixtures& fixtures = BenchmarkFixtures::Get();
+	const FullBlock& block = fixtures.GetNextBlock();
+	const TestServer::Ptr& pServer = fixtures.GetServer();
+
+	state.MeasureWithSetup(
+		StringUtil::Format("{} inputs, {} outputs", block.GetInputs().size(), block.GetOutputs().size()),
+		[&pServer]() {
+			return std::make_pair(pServer->GetBlockDB()->BatchWrite(), pServer->GetTxHashSetManager()->BatchWrite());
+		},
+		[&block](std::pair<Writer<IBlockDB>, Writer<TxHashSetManager>>& batch) {
+			if (!batch.second->GetTxHashSet()->ApplyBlock(batch.first.GetShared(), block)) {
+				throw std::runtime_error("Failed to apply block");
+			}
+		},
+		block.GetKernels().size()
+	);
+}
+
+//
+// Reconciles a pool holding every fixture transaction with the next block,
+// which evicts the half of the transactions that were included in the block.
+//
+BENCHMARK_GROUP("Pool::ReconcileBlock")
+{
+	BenchmarkFixtures& fixtures = BenchmarkFixtures::Get();
+	const FullBlock& block = fixtures.GetNextBlock();
+
+	// No limits, so every fixture tx stays in the pool.
+	Pool basePool(std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::max());
+	for (const TransactionPtr& pTransaction : fixtures.GetPoolTransactions()) {
+		basePool.AddTransaction(pTransaction, EDandelionStatus::FLUFFED);
+	}
+
+	auto pBlockDB = fixtures.GetServer()->GetBlockDB()->Read();
+	auto pTxHashSetManager = fixtures.GetServer()->GetTxHashSetManager()->Read();
+
+	state.MeasureWithSetup(
+		StringUtil::Format("{} txs, {} in block", basePool.Size(), block.GetKernels().size()),
+		[&basePool]() { return Pool(basePool); },
+		[&](Pool& pool) {
+			pool.ReconcileBlock(pBlockDB.GetShared(), pTxHashSetManager->GetTxHashSet(), block, nullptr);
+		},
+		basePool.Size()
+	);
+}
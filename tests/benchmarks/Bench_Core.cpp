@@ -0,0 +1,29 @@
+#include "Benchmark.h"
+#include "BenchmarkFixtures.h"
+
+#include <Core/Models/TransactionBody.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Serialization/Serializer.h>
+
+BENCHMARK_GROUP("TransactionBody::Deserialize")
+{
+	const TransactionBody& body = BenchmarkFixtures::Get().GetNextBlock().GetTransactionBody();
+
+	Serializer serializer;
+	body.Serialize(serializer);
+	const std::vector<uint8_t>& serialized = serializer.GetBytes();
+
+	const std::string variant = StringUtil::Format(
+		"{} inputs, {} outputs, {} kernels",
+		body.GetInputs().size(),
+		body.GetOutputs().size(),
+		body.GetKernels().size()
+	);
+
+	// Copying the bytes into the ByteBuffer isn't part of deserializing, so it's done in the setup.
+	state.MeasureWithSetup(
+		variant,
+		[&serialized]() { return ByteBuffer(serialized); },
+		[](ByteBuffer& byteBuffer) { Benchmark::DoNotOptimize(TransactionBody::Deserialize(byteBuffer)); }
+	);
+}
@@ -0,0 +1,51 @@
+#include "Benchmark.h"
+#include "BenchmarkFixtures.h"
+
+#include <Crypto/Bulletproofs.h>
+#include <Core/Validation/KernelSignatureValidator.h>
+
+//
+// Bulletproofs keeps a cache of proofs it already verified, so every iteration uses a new instance.
+// Constructing the instance (and its generators) happens outside the timed section.
+//
+BENCHMARK_GROUP("Bulletproofs::VerifyBulletproofs")
+{
+	const std::vector<TransactionOutput>& outputs = BenchmarkFixtures::Get().GetOutputs();
+
+	for (const size_t batchSize : { 1, 10, 100, 200 }) {
+		std::vector<std::pair<Commitment, RangeProof>> rangeProofs;
+		for (size_t i = 0; i < batchSize && i < outputs.size(); i++) {
+			rangeProofs.push_back({ outputs[i].GetCommitment(), outputs[i].GetRangeProof() });
+		}
+
+		state.MeasureWithSetup(
+			"batch " + std::to_string(rangeProofs.size()),
+			[]() { return std::make_unique<Bulletproofs>(); },
+			[&rangeProofs](std::unique_ptr<Bulletproofs>& pBulletproofs) {
+				if (!pBulletproofs->VerifyBulletproofs(rangeProofs)) {
+					throw std::runtime_error("Bulletproof verification failed");
+				}
+			},
+			rangeProofs.size()
+		);
+	}
+}
+
+BENCHMARK_GROUP("KernelSignatureValidator::BatchVerify")
+{
+	const std::vector<TransactionPtr>& transactions = BenchmarkFixtures::Get().GetPoolTransactions();
+
+	for (const size_t batchSize : { 1, 10, 100 }) {
+		std::vector<TransactionKernel> kernels;
+		for (size_t i = 0; i < batchSize && i < transactions.size(); i++) {
+			const auto& txKernels = transactions[i]->GetKernels();
+			kernels.insert(kernels.end(), txKernels.cbegin(), txKernels.cend());
+		}
+
+		state.Measure("batch " + std::to_string(kernels.size()), [&kernels]() {
+			if (!KernelSignatureValidator::BatchVerify(kernels)) {
+				throw std::runtime_error("Kernel signature verification failed");
+			}
+		}, kernels.size());
+	}
+}
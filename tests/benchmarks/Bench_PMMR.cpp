@@ -0,0 +1,98 @@
+#include "Benchmark.h"
+
+#include <TestFileUtil.h>
+
+#include <PMMR/Common/Index.h>
+#include <PMMR/Common/LeafIndex.h>
+#include <PMMR/Common/MMRHashUtil.h>
+#include <PMMR/Common/PruneList.h>
+
+#include <cstring>
+#include <random>
+
+static const uint64_t NUM_LEAVES = 100'000;
+
+// Builds (and commits) an MMR of NUM_LEAVES leaves, each a distinct 32-byte value.
+static HashFile::Ptr BuildHashFile(const fs::path& path, const PruneList::CPtr& pPruneList)
+{
+	HashFile::Ptr pHashFile = HashFile::Load(path);
+
+	std::vector<uint8_t> leaf(32, 0);
+	for (uint64_t i = 0; i < NUM_LEAVES; i++) {
+		std::memcpy(leaf.data(), &i, sizeof(i));
+		MMRHashUtil::AddHashes(pHashFile, leaf, pPruneList);
+	}
+
+	pHashFile->Commit();
+	return pHashFile;
+}
+
+BENCHMARK_GROUP("MMRHashUtil::AddHashes")
+{
+	auto pHashTemp = TestFileUtil::CreateTempFile();
+	auto pPruneTemp = TestFileUtil::CreateTempFile();
+	PruneList::CPtr pPruneList = PruneList::Load(pPruneTemp->GetPath());
+	HashFile::Ptr pHashFile = BuildHashFile(pHashTemp->GetPath(), pPruneList);
+
+	for (const uint64_t numLeaves : { 1, 100, 1000 }) {
+		state.MeasureWithSetup(
+			std::to_string(numLeaves) + " leaves",
+			[&pHashFile]() { pHashFile->Rollback(); return pHashFile; },
+			[&pPruneList, numLeaves](HashFile::Ptr& pFile) {
+				std::vector<uint8_t> leaf(32, 0xFF);
+				for (uint64_t i = 0; i < numLeaves; i++) {
+					std::memcpy(leaf.data(), &i, sizeof(i));
+					MMRHashUtil::AddHashes(pFile, leaf, pPruneList);
+				}
+			},
+			numLeaves
+		);
+	}
+
+	pHashFile->Rollback();
+}
+
+BENCHMARK_GROUP("MMRHashUtil::Root")
+{
+	auto pHashTemp = TestFileUtil::CreateTempFile();
+	auto pPruneTemp = TestFileUtil::CreateTempFile();
+	PruneList::CPtr pPruneList = PruneList::Load(pPruneTemp->GetPath());
+	HashFile::CPtr pHashFile = BuildHashFile(pHashTemp->GetPath(), pPruneList);
+
+	const uint64_t size = pHashFile->GetSize();
+	state.Measure(std::to_string(NUM_LEAVES) + " leaves", [&]() {
+		Benchmark::DoNotOptimize(MMRHashUtil::Root(pHashFile, size, pPruneList));
+	});
+}
+
+BENCHMARK_GROUP("PruneList::GetShift")
+{
+	auto pPruneTemp = TestFileUtil::CreateTempFile();
+	PruneList::Ptr pPruneList = PruneList::Load(pPruneTemp->GetPath());
+
+	// Spend (and prune) a pseudo-random half of the leaves, so the list has a mix of compacted subtrees
+	// and isolated pruned leaves, similar to an output MMR.
+	std::mt19937_64 rng(1234);
+	for (uint64_t i = 0; i < NUM_LEAVES; i++) {
+		if (rng() % 2 == 0) {
+			pPruneList->Add(LeafIndex::At(i).GetIndex());
+		}
+	}
+
+	pPruneList->Flush();
+
+	const uint64_t numNodes = LeafIndex::At(NUM_LEAVES).GetPosition();
+	std::vector<Index> queries;
+	for (size_t i = 0; i < 1000; i++) {
+		queries.push_back(Index::At(rng() % numNodes));
+	}
+
+	state.Measure("1000 lookups", [&]() {
+		uint64_t total = 0;
+		for (const Index& index : queries) {
+			total += pPruneList->GetShift(index);
+		}
+
+		Benchmark::DoNotOptimize(total);
+	}, queries.size());
+}
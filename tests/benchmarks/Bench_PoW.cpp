@@ -0,0 +1,74 @@
+#include "Benchmark.h"
+
+#include <Core/Global.h>
+#include <Core/Models/BlockHeader.h>
+#include <PoW/Cuckarooz.h>
+#include <PoW/Cuckatoo.h>
+#include <PoW/PoWValidator.h>
+
+#include <algorithm>
+#include <random>
+
+//
+// There are no real cuckatoo or cuckarooz solutions to test against, so these use headers with
+// 42 random (but ascending, in-range) nonces. Verification still hashes every edge before the
+// cycle check rejects the proof, and that hashing is what dominates the cost of a valid proof.
+//
+static BlockHeader BuildHeader(const uint8_t edgeBits, const uint64_t seed)
+{
+	std::mt19937_64 rng(seed);
+
+	std::vector<uint64_t> proofNonces;
+	while (proofNonces.size() < 42) {
+		proofNonces.push_back(rng() & ((1ull << edgeBits) - 1));
+		std::sort(proofNonces.begin(), proofNonces.end());
+		proofNonces.erase(std::unique(proofNonces.begin(), proofNonces.end()), proofNonces.end());
+	}
+
+	BlockHeaderPtr pGenesis = Global::GetGenesisHeader();
+	return BlockHeader(
+		pGenesis->GetVersion(),
+		pGenesis->GetHeight() + 1,
+		pGenesis->GetTimestamp(),
+		Hash(pGenesis->GetHash()),
+		Hash(pGenesis->GetPreviousRoot()),
+		Hash(pGenesis->GetOutputRoot()),
+		Hash(pGenesis->GetRangeProofRoot()),
+		Hash(pGenesis->GetKernelRoot()),
+		BlindingFactor(pGenesis->GetTotalKernelOffset()),
+		pGenesis->GetOutputMMRSize(),
+		pGenesis->GetKernelMMRSize(),
+		pGenesis->GetTotalDifficulty(),
+		pGenesis->GetScalingDifficulty(),
+		seed,
+		ProofOfWork(edgeBits, std::move(proofNonces))
+	);
+}
+
+BENCHMARK_GROUP("Cuckatoo::Validate")
+{
+	const BlockHeader header = BuildHeader(31, 1);
+	state.Measure("C31 (rejected after hashing)", [&header]() {
+		Benchmark::DoNotOptimize(Cuckatoo::Validate(header));
+	});
+}
+
+BENCHMARK_GROUP("Cuckarooz::Validate")
+{
+	const BlockHeader header = BuildHeader(29, 2);
+	state.Measure("C29 (rejected after hashing)", [&header]() {
+		Benchmark::DoNotOptimize(Cuckarooz::Validate(header));
+	});
+}
+
+BENCHMARK_GROUP("PoWValidator::AreCyclesValid")
+{
+	std::vector<BlockHeaderPtr> headers;
+	for (uint64_t i = 0; i < 512; i++) {
+		headers.push_back(std::make_shared<const BlockHeader>(BuildHeader(29, i)));
+	}
+
+	state.Measure("512 x C29 (one sync chunk)", [&headers]() {
+		Benchmark::DoNotOptimize(PoWValidator::AreCyclesValid(headers));
+	});
+}
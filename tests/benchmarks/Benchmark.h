@@ -0,0 +1,212 @@
+#pragma once
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+//
+// Minimal benchmark harness for the consensus-critical paths.
+//
+// Each BENCHMARK_GROUP registers a function that builds (or reuses) its fixtures,
+// and then calls State::Measure once per variant, ex. once per batch size.
+// Every measurement is reported as "<group>/<variant>", with timings per iteration.
+//
+// Ex:
+//     BENCHMARK_GROUP("Hasher::Blake2b")
+//     {
+//         std::vector<uint8_t> data(1024, 0x01);
+//         state.Measure("1KB", [&data]() { Benchmark::DoNotOptimize(Hasher::Blake2b(data)); });
+//     }
+//
+namespace Benchmark
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Options
+	{
+		// Minimum total time to spend timing each measurement.
+		std::chrono::milliseconds minTime{ 1000 };
+
+		// Minimum number of samples to collect for each measurement.
+		size_t minSamples{ 5 };
+	};
+
+	struct Result
+	{
+		std::string name;
+		uint64_t iterations;
+		size_t samples;
+
+		// Nanoseconds per iteration, across samples.
+		double mean_ns;
+		double median_ns;
+		double min_ns;
+		double stddev_ns;
+
+		// Items processed per iteration (ex. proofs in a batch). Zero when not applicable.
+		uint64_t items;
+
+		Json::Value ToJSON() const
+		{
+			Json::Value json;
+			json["name"] = name;
+			json["iterations"] = Json::UInt64(iterations);
+			json["samples"] = Json::UInt64(samples);
+			json["mean_ns"] = mean_ns;
+			json["median_ns"] = median_ns;
+			json["min_ns"] = min_ns;
+			json["stddev_ns"] = stddev_ns;
+			if (items > 0) {
+				json["items_per_iteration"] = Json::UInt64(items);
+				json["items_per_second"] = (items * 1e9) / median_ns;
+			}
+
+			return json;
+		}
+	};
+
+	// Keeps the compiler from discarding a result that is otherwise unused.
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#if defined(__GNUC__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	class State
+	{
+	public:
+		State(const std::string& group, const Options& options)
+			: m_group(group), m_options(options) { }
+
+		//
+		// Times repeated calls to body.
+		// Iterations are grouped into samples long enough to be measured accurately.
+		//
+		void Measure(const std::string& variant, const std::function<void()>& body, const uint64_t items = 0)
+		{
+			// Warm up, and estimate how many iterations fit in a sample.
+			const auto warmupStart = Clock::now();
+			body();
+			const double estimate_ns = (std::max)(ElapsedNs(warmupStart), 1.0);
+
+			const double sampleTarget_ns = ToNs(m_options.minTime) / 20;
+			const uint64_t itersPerSample = (std::max)((uint64_t)1, (uint64_t)(sampleTarget_ns / estimate_ns));
+
+			std::vector<double> samples;
+			uint64_t iterations = 0;
+			const auto start = Clock::now();
+			while (samples.size() < m_options.minSamples || ElapsedNs(start) < ToNs(m_options.minTime)) {
+				const auto sampleStart = Clock::now();
+				for (uint64_t i = 0; i < itersPerSample; i++) {
+					body();
+				}
+
+				samples.push_back(ElapsedNs(sampleStart) / itersPerSample);
+				iterations += itersPerSample;
+			}
+
+			AddResult(variant, std::move(samples), iterations, items);
+		}
+
+		//
+		// Times body once per iteration, calling setup (untimed) before each one.
+		// For operations that consume or mutate their fixture, like applying a block.
+		//
+		template<typename Setup, typename Body>
+		void MeasureWithSetup(const std::string& variant, const Setup& setup, const Body& body, const uint64_t items = 0)
+		{
+			std::vector<double> samples;
+			const auto start = Clock::now();
+			while (samples.size() < m_options.minSamples || ElapsedNs(start) < ToNs(m_options.minTime)) {
+				auto fixture = setup();
+
+				const auto iterationStart = Clock::now();
+				body(fixture);
+				samples.push_back(ElapsedNs(iterationStart));
+			}
+
+			const uint64_t iterations = samples.size();
+			AddResult(variant, std::move(samples), iterations, items);
+		}
+
+		const std::vector<Result>& GetResults() const noexcept { return m_results; }
+
+	private:
+		static double ToNs(const Clock::duration& duration)
+		{
+			return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+		}
+
+		static double ElapsedNs(const Clock::time_point& start) { return ToNs(Clock::now() - start); }
+
+		void AddResult(const std::string& variant, std::vector<double>&& samples, const uint64_t iterations, const uint64_t items)
+		{
+			std::sort(samples.begin(), samples.end());
+
+			const double mean = std::accumulate(samples.cbegin(), samples.cend(), 0.0) / samples.size();
+			double variance = 0.0;
+			for (const double sample : samples) {
+				variance += (sample - mean) * (sample - mean);
+			}
+
+			Result result;
+			result.name = variant.empty() ? m_group : m_group + "/" + variant;
+			result.iterations = iterations;
+			result.samples = samples.size();
+			result.mean_ns = mean;
+			result.median_ns = samples[samples.size() / 2];
+			result.min_ns = samples.front();
+			result.stddev_ns = samples.size() > 1 ? std::sqrt(variance / (samples.size() - 1)) : 0.0;
+			result.items = items;
+
+			m_results.push_back(std::move(result));
+		}
+
+		std::string m_group;
+		Options m_options;
+		std::vector<Result> m_results;
+	};
+
+	struct Group
+	{
+		std::string name;
+		std::function<void(State&)> func;
+	};
+
+	inline std::vector<Group>& GetGroups()
+	{
+		static std::vector<Group> groups;
+		return groups;
+	}
+
+	struct Registrar
+	{
+		Registrar(const std::string& name, const std::function<void(State&)>& func)
+		{
+			GetGroups().push_back(Group{ name, func });
+		}
+	};
+}
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+
+#define BENCHMARK_GROUP_IMPL(name, func) \
+	static void func(Benchmark::State& state); \
+	static const Benchmark::Registrar BENCHMARK_CONCAT(func, _registrar)(name, func); \
+	static void func(Benchmark::State& state)
+
+#define BENCHMARK_GROUP(name) BENCHMARK_GROUP_IMPL(name, BENCHMARK_CONCAT(Benchmark_, __LINE__))
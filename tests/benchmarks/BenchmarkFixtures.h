@@ -0,0 +1,129 @@
+#pragma once
+
+#include <TestServer.h>
+#include <TxBuilder.h>
+
+#include <Consensus.h>
+#include <Core/Global.h>
+#include <Core/Models/FullBlock.h>
+#include <Core/Util/FeeUtil.h>
+#include <Core/Util/TransactionUtil.h>
+#include <Database/BlockDb.h>
+#include <PMMR/TxHashSetManager.h>
+#include <Wallet/Keychain/KeyChain.h>
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+//
+// Synthetic chain state shared by the benchmarks that need a node.
+// Built once, on first use, from a fixed wallet seed, so every run works on fixtures of the same shape.
+// (Blinding factors and proof nonces are still random, so the bytes differ between runs.)
+//
+// Block 1 is applied straight to the TxHashSet, skipping validation, and creates NUM_OUTPUTS plain outputs.
+// Each pool transaction spends one of those outputs into a new one.
+// The "next" block (height 2, not applied) aggregates the first half of the pool transactions.
+//
+class BenchmarkFixtures
+{
+public:
+	static constexpr size_t NUM_OUTPUTS = 200;
+	static constexpr uint64_t OUTPUT_AMOUNT = 1'000'000'000;
+
+	static BenchmarkFixtures& Get()
+	{
+		static std::unique_ptr<BenchmarkFixtures> pFixtures;
+		static std::once_flag initialized;
+		std::call_once(initialized, []() { pFixtures = std::unique_ptr<BenchmarkFixtures>(new BenchmarkFixtures()); });
+		return *pFixtures;
+	}
+
+	const TestServer::Ptr& GetServer() const noexcept { return m_pServer; }
+	const std::vector<TransactionOutput>& GetOutputs() const noexcept { return m_outputs; }
+	const std::vector<TransactionPtr>& GetPoolTransactions() const noexcept { return m_poolTransactions; }
+	const FullBlock& GetNextBlock() const noexcept { return m_nextBlock; }
+
+	static FullBlock BuildBlock(const uint64_t height, TransactionBody&& body)
+	{
+		BlockHeaderPtr pGenesis = Global::GetGenesisHeader();
+
+		// The header hash comes from the proof, so vary it by height.
+		std::vector<uint64_t> proofNonces = pGenesis->GetProofNonces();
+		proofNonces[0] += height;
+
+		auto pHeader = std::make_shared<const BlockHeader>(
+			pGenesis->GetVersion(),
+			height,
+			pGenesis->GetTimestamp() + (height * Consensus::BLOCK_TIME_SEC),
+			Hash(pGenesis->GetHash()),
+			Hash(ZERO_HASH),
+			Hash(ZERO_HASH),
+			Hash(ZERO_HASH),
+			Hash(ZERO_HASH),
+			BlindingFactor(ZERO_HASH),
+			0,
+			0,
+			pGenesis->GetTotalDifficulty() + height,
+			pGenesis->GetScalingDifficulty(),
+			height,
+			ProofOfWork(pGenesis->GetEdgeBits(), std::move(proofNonces))
+		);
+
+		return FullBlock(pHeader, std::move(body));
+	}
+
+private:
+	BenchmarkFixtures()
+		: m_pServer(TestServer::Create()),
+		m_keyChain(KeyChain::FromSeed(SecureVector(32, 0x42)))
+	{
+		std::cout << "Building benchmark fixtures..." << std::endl;
+
+		TxBuilder txBuilder(m_keyChain);
+
+		std::vector<Test::Input> inputs;
+		for (uint32_t i = 0; i < NUM_OUTPUTS; i++) {
+			Test::Output output{ KeyChainPath({ 1, i }), OUTPUT_AMOUNT };
+			m_outputs.push_back(txBuilder.BuildOutput(output, EOutputFeatures::DEFAULT).second);
+			inputs.push_back(Test::Input{
+				TransactionInput(EOutputFeatures::DEFAULT, m_outputs.back().GetCommitment()),
+				output.path,
+				output.amount
+			});
+		}
+
+		FullBlock block1 = BuildBlock(1, TransactionBody({}, std::vector<TransactionOutput>(m_outputs), {}));
+		{
+			auto pBlockDB = m_pServer->GetBlockDB()->BatchWrite();
+			auto pTxHashSetManager = m_pServer->GetTxHashSetManager()->BatchWrite();
+			if (!pTxHashSetManager->GetTxHashSet()->ApplyBlock(pBlockDB.GetShared(), block1)) {
+				throw std::runtime_error("Failed to apply fixture block");
+			}
+
+			pTxHashSetManager->Commit();
+			pBlockDB->Commit();
+		}
+
+		const uint64_t fee = FeeUtil::CalculateFee(500'000, 1, 1, 1);
+		for (uint32_t i = 0; i < NUM_OUTPUTS; i++) {
+			TxBuilder::Criteria criteria;
+			criteria.inputs = { inputs[i] };
+			criteria.outputs = { Test::Output{ KeyChainPath({ 2, i }), OUTPUT_AMOUNT - fee } };
+			m_poolTransactions.push_back(std::make_shared<Transaction>(txBuilder.BuildTx(criteria)));
+		}
+
+		std::vector<TransactionPtr> blockTransactions(
+			m_poolTransactions.cbegin(),
+			m_poolTransactions.cbegin() + (NUM_OUTPUTS / 2)
+		);
+		m_nextBlock = BuildBlock(2, TransactionBody(TransactionUtil::Aggregate(blockTransactions)->GetBody()));
+	}
+
+	TestServer::Ptr m_pServer;
+	KeyChain m_keyChain;
+
+	std::vector<TransactionOutput> m_outputs;
+	std::vector<TransactionPtr> m_poolTransactions;
+	FullBlock m_nextBlock;
+};
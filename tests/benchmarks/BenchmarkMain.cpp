@@ -0,0 +1,102 @@
+#include "Benchmark.h"
+
+#include <Core/Global.h>
+#include <Core/Context.h>
+#include <Common/Logger.h>
+#include <Common/Util/FileUtil.h>
+#include <Common/Util/TimeUtil.h>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+//
+// Usage: Benchmarks [--filter <substring>] [--min-time <ms>] [--json <file>] [--list]
+//
+// Results are printed as a table, and optionally written as JSON for tracking over time.
+//
+int main(int argc, char* argv[])
+{
+    std::string filter;
+    std::string jsonPath;
+    bool listOnly = false;
+    Benchmark::Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--json" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.minTime = std::chrono::milliseconds(std::stoull(argv[++i]));
+        } else if (arg == "--list") {
+            listOnly = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--filter <substring>] [--min-time <ms>] [--json <file>] [--list]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (listOnly) {
+        for (const auto& group : Benchmark::GetGroups()) {
+            std::cout << group.name << std::endl;
+        }
+
+        return 0;
+    }
+
+    FileUtil::RemoveFile(Config::DefaultDataDir(Environment::AUTOMATED_TESTING));
+
+    ConfigPtr pConfig = Config::Default(Environment::AUTOMATED_TESTING);
+    Context::Ptr pContext = Context::Create(Environment::AUTOMATED_TESTING, pConfig);
+    Global::Init(pContext);
+    LoggerAPI::Initialize(pConfig->GetLogDirectory(), pConfig->GetLogLevel());
+
+    std::vector<Benchmark::Result> results;
+    for (const auto& group : Benchmark::GetGroups()) {
+        if (!filter.empty() && group.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        Benchmark::State state(group.name, options);
+        group.func(state);
+
+        for (const Benchmark::Result& result : state.GetResults()) {
+            std::cout
+                << std::left << std::setw(56) << result.name
+                << std::right << std::setw(16) << std::fixed << std::setprecision(0) << result.median_ns << " ns"
+                << std::setw(12) << result.iterations << " iters";
+            if (result.items > 0) {
+                std::cout << std::setw(14) << std::setprecision(1) << (result.items * 1e9) / result.median_ns << " items/s";
+            }
+
+            std::cout << std::endl;
+            results.push_back(result);
+        }
+    }
+
+    if (!jsonPath.empty()) {
+        Json::Value json;
+        json["context"]["timestamp"] = Json::Int64(TimeUtil::Now());
+        json["context"]["num_cpus"] = Json::UInt(std::thread::hardware_concurrency());
+#ifdef NDEBUG
+        json["context"]["build_type"] = "release";
+#else
+        json["context"]["build_type"] = "debug";
+#endif
+        json["context"]["min_time_ms"] = Json::UInt64(options.minTime.count());
+
+        json["benchmarks"] = Json::Value(Json::arrayValue);
+        for (const Benchmark::Result& result : results) {
+            json["benchmarks"].append(result.ToJSON());
+        }
+
+        std::ofstream file(jsonPath, std::ios::out | std::ios::trunc);
+        file << json.toStyledString();
+    }
+
+    Global::Shutdown();
+    return 0;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Core/Models/CompactBlock.h>
+#include <Core/Models/FullBlock.h>
+#include <Core/Models/Transaction.h>
+#include <Core/Models/Fee.h>
+#include <memory>
+#include <vector>
+
+//
+// Builds txs and blocks with the right shape, but without valid commitments, proofs, signatures, or proof of work.
+// Useful for testing code that never validates them, like the tx and orphan pools and p2p messages.
+//
+class FakeModels
+{
+public:
+    static TransactionPtr CreateTx(
+        const std::vector<uint8_t>& inputs,
+        const std::vector<uint8_t>& outputs,
+        const uint64_t fee,
+        const EOutputFeatures inputFeatures = EOutputFeatures::DEFAULT)
+    {
+        std::vector<TransactionInput> txInputs;
+        for (const uint8_t input : inputs) {
+            txInputs.push_back(TransactionInput(inputFeatures, Commitment(CBigInteger<33>::ValueOf(input))));
+        }
+
+        std::vector<TransactionOutput> txOutputs;
+        for (const uint8_t output : outputs) {
+            txOutputs.push_back(TransactionOutput(
+                EOutputFeatures::DEFAULT,
+                Commitment(CBigInteger<33>::ValueOf(output)),
+                RangeProof(std::vector<unsigned char>(675, output))
+            ));
+        }
+
+        std::vector<TransactionKernel> kernels;
+        kernels.push_back(TransactionKernel(
+            EKernelFeatures::DEFAULT_KERNEL,
+            Fee::From(fee),
+            0,
+            Commitment(CBigInteger<33>::ValueOf(outputs.empty() ? 0 : outputs.front())),
+            Signature()
+        ));
+
+        return std::make_shared<Transaction>(
+            BlindingFactor(),
+            TransactionBody(std::move(txInputs), std::move(txOutputs), std::move(kernels))
+        );
+    }
+
+    // Spends seed, and creates seed + 1.
+    static TransactionPtr CreateTx(const uint8_t seed, const uint64_t fee, const EOutputFeatures inputFeatures = EOutputFeatures::DEFAULT)
+    {
+        return CreateTx({ seed }, { (uint8_t)(seed + 1) }, fee, inputFeatures);
+    }
+
+    // The seed keeps headers at the same height and with the same parent distinct.
+    static BlockHeaderPtr CreateHeader(const uint64_t height, const Hash& previousHash, const uint64_t seed)
+    {
+        return std::make_shared<BlockHeader>(
+            (uint16_t)2,
+            height,
+            (int64_t)1600000000 + height,
+            Hash(previousHash),
+            Hash(),
+            Hash(),
+            Hash(),
+            Hash(),
+            BlindingFactor(),
+            0,
+            0,
+            height,
+            1,
+            seed,
+            ProofOfWork(29, std::vector<uint64_t>(42, 0), Hash::ValueOf(seed))
+        );
+    }
+
+    static FullBlock CreateBlock(const uint64_t height, const Hash& previousHash, const uint64_t seed, const size_t numOutputs = 1)
+    {
+        std::vector<TransactionOutput> outputs;
+        for (size_t i = 0; i < numOutputs; i++) {
+            outputs.push_back(TransactionOutput(
+                EOutputFeatures::DEFAULT,
+                Commitment(CBigInteger<33>::ValueOf((uint8_t)i)),
+                RangeProof(std::vector<unsigned char>(675, (uint8_t)i))
+            ));
+        }
+
+        return FullBlock(CreateHeader(height, previousHash, seed), TransactionBody({}, std::move(outputs), {}));
+    }
+
+    // Has a short id for each kernel of the given txs.
+    static CompactBlock CreateCompactBlock(const BlockHeaderPtr& pHeader, const uint64_t nonce, const std::vector<TransactionPtr>& transactions)
+    {
+        std::vector<ShortId> shortIds;
+        for (const TransactionPtr& pTransaction : transactions) {
+            for (const TransactionKernel& kernel : pTransaction->GetKernels()) {
+                shortIds.push_back(ShortId::Create(kernel.GetHash(), pHeader->GetHash(), nonce));
+            }
+        }
+
+        return CompactBlock(pHeader, nonce, {}, {}, std::move(shortIds));
+    }
+};
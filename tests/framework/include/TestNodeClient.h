@@ -68,8 +68,7 @@ public:
 			return std::unique_ptr<OutputRange>(nullptr);
 		}
 
-		auto pBlockDB = m_pDatabase->GetBlockDB()->Read();
-		return std::make_unique<OutputRange>(pTxHashSet->GetOutputsByLeafIndex(pBlockDB.GetShared(), startIndex, maxNumOutputs));
+		return std::make_unique<OutputRange>(pTxHashSet->GetOutputsByLeafIndex(*m_pBlockChain, startIndex, maxNumOutputs));
 	}
 
 	bool PostTransaction(TransactionPtr pTransaction, const EPoolType poolType) final
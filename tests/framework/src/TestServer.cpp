@@ -98,7 +98,11 @@ TestServer::Ptr TestServer::CreateWithWallet()
 	));
 
 	pServer->m_pWalletManager = WalletAPI::CreateWalletManager(Global::GetConfig(), pNodeClient);
-	pServer->m_pOwnerServer = OwnerServer::Create(TorProcessManager::GetProcess(0), pServer->m_pWalletManager);
+	pServer->m_pOwnerServer = OwnerServer::Create(
+		TorProcessManager::GetProcess(0),
+		pServer->m_pWalletManager,
+		Global::GetConfig().GetOwnerAPIOptions()
+	);
 
 	return pServer;
 }
@@ -0,0 +1,114 @@
+#include <catch.hpp>
+
+#include <BlockChain/BlockHydrator.h>
+#include <TxPool/TransactionPool.h>
+#include <FakeModels.h>
+#include <stdexcept>
+
+// A mempool holding the given txs. Only short id lookups are supported.
+class FakeTransactionPool : public ITransactionPool
+{
+public:
+	explicit FakeTransactionPool(const std::vector<TransactionPtr>& transactions)
+		: m_transactions(transactions) { }
+
+	std::vector<TransactionPtr> GetTransactionsByShortId(
+		const Hash& hash,
+		const uint64_t nonce,
+		const std::set<ShortId>& missingShortIds) const final
+	{
+		m_numLookedUp += missingShortIds.size();
+
+		std::vector<TransactionPtr> found;
+		for (const TransactionPtr& pTransaction : m_transactions)
+		{
+			for (const TransactionKernel& kernel : pTransaction->GetKernels())
+			{
+				if (missingShortIds.count(ShortId::Create(kernel.GetHash(), hash, nonce)) > 0)
+				{
+					found.push_back(pTransaction);
+					break;
+				}
+			}
+		}
+
+		return found;
+	}
+
+	size_t GetNumLookedUp() const noexcept { return m_numLookedUp; }
+
+	EAddTransactionStatus AddTransaction(std::shared_ptr<const IBlockDB>, ITxHashSetConstPtr, TransactionPtr, const EPoolType, const BlockHeader&) final
+	{
+		throw std::logic_error("Not supported");
+	}
+
+	std::vector<TransactionPtr> FindTransactionsByKernel(const std::set<TransactionKernel>&) const final { return {}; }
+	TransactionPtr FindTransactionByKernelHash(const Hash&) const final { return nullptr; }
+	void ReconcileBlock(std::shared_ptr<const IBlockDB>, ITxHashSetConstPtr, const FullBlock&) final { }
+	size_t GetPoolSize() const final { return m_transactions.size(); }
+	size_t GetStemPoolSize() const final { return 0; }
+	std::vector<TransactionPoolEntry> GetTransactions(const EPoolType) const final { return {}; }
+	std::vector<TransactionPtr> GetTransactionsForBlock(const uint64_t) const final { return {}; }
+	uint64_t GetMemPoolVersion() const final { return 0; }
+	uint64_t WaitForChange(const uint64_t lastChange, const std::chrono::milliseconds&) const final { return lastChange; }
+	TransactionPtr GetTransactionToStem(std::shared_ptr<const IBlockDB>, ITxHashSetConstPtr) final { return nullptr; }
+	TransactionPtr GetTransactionToFluff(std::shared_ptr<const IBlockDB>, ITxHashSetConstPtr) final { return nullptr; }
+	std::vector<TransactionPtr> GetExpiredTransactions() const final { return {}; }
+	void SaveSnapshot() const final { }
+	size_t LoadSnapshot(std::shared_ptr<const IBlockDB>, ITxHashSetConstPtr, const BlockHeader&) final { return 0; }
+
+private:
+	std::vector<TransactionPtr> m_transactions;
+	mutable size_t m_numLookedUp{ 0 };
+};
+
+TEST_CASE("BlockHydrator")
+{
+	TransactionPtr pTx1 = FakeModels::CreateTx(1, 1000);
+	TransactionPtr pTx2 = FakeModels::CreateTx(10, 1000);
+	TransactionPtr pTx3 = FakeModels::CreateTx(20, 1000);
+	TransactionPtr pUnrelated = FakeModels::CreateTx(30, 1000);
+
+	// Spends pTx1's output, so the two are cut through.
+	TransactionPtr pChild = FakeModels::CreateTx({ 2 }, { 40 }, 1000);
+
+	const BlockHeaderPtr pHeader = FakeModels::CreateHeader(10, Hash::ValueOf(9), 10);
+	const CompactBlock compactBlock = FakeModels::CreateCompactBlock(pHeader, 123, { pTx1, pTx2, pTx3, pChild });
+
+	auto pPool = std::make_shared<FakeTransactionPool>(std::vector<TransactionPtr>{ pTx3, pUnrelated });
+	BlockHydrator hydrator(pPool);
+
+	SECTION("Given txs, then the mempool")
+	{
+		std::unique_ptr<FullBlock> pBlock = hydrator.Hydrate(compactBlock, { pTx1, pUnrelated, pTx2, pChild });
+		REQUIRE(pBlock != nullptr);
+		REQUIRE(pBlock->GetHash() == pHeader->GetHash());
+
+		// Only the short id that wasn't matched by the given txs is looked up.
+		REQUIRE(pPool->GetNumLookedUp() == 1);
+
+		// pUnrelated isn't in the block, even though it was given and is in the mempool.
+		REQUIRE(pBlock->GetKernels().size() == 4);
+		REQUIRE(pBlock->GetInputs().size() == 3);
+		REQUIRE(pBlock->GetOutputs().size() == 3);
+		for (const TransactionOutput& output : pBlock->GetOutputs())
+		{
+			REQUIRE(output.GetCommitment() != pTx1->GetOutputs().front().GetCommitment());
+		}
+	}
+
+	SECTION("Missing txs")
+	{
+		REQUIRE(hydrator.Hydrate(compactBlock, { pTx1, pChild }) == nullptr);
+		REQUIRE(pPool->GetNumLookedUp() == 2);
+	}
+
+	SECTION("No short ids")
+	{
+		const CompactBlock empty = FakeModels::CreateCompactBlock(pHeader, 123, {});
+		std::unique_ptr<FullBlock> pBlock = hydrator.Hydrate(empty, { pTx1 });
+		REQUIRE(pBlock != nullptr);
+		REQUIRE(pBlock->GetKernels().empty());
+		REQUIRE(pPool->GetNumLookedUp() == 0);
+	}
+}
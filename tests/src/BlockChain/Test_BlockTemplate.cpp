@@ -0,0 +1,38 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestChain.h>
+#include <TxBuilder.h>
+
+#include <BlockChain/BlockChain.h>
+
+TEST_CASE("Block Template")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	KeyChain keyChain = KeyChain::FromRandom();
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChain = pTestServer->GetBlockChain();
+
+	TestChain chain(pBlockChain);
+	MinedBlock block_a = chain.AddNextBlock({ txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 1 })) });
+	REQUIRE(pBlockChain->AddBlock(block_a.block) == EBlockChainStatus::SUCCESS);
+
+	Test::Tx coinbase = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 2 }));
+	std::unique_ptr<FullBlock> pTemplate = pBlockChain->BuildBlockTemplate(
+		{},
+		coinbase.pTransaction->GetOutputs().front(),
+		coinbase.pTransaction->GetKernels().front()
+	);
+	REQUIRE(pTemplate != nullptr);
+	REQUIRE(pTemplate->GetHeight() == 2);
+	REQUIRE(pTemplate->GetPreviousHash() == block_a.block.GetHash());
+	REQUIRE(pTemplate->GetTotalDifficulty() > block_a.block.GetTotalDifficulty());
+
+	// Building the template must not touch the chain.
+	REQUIRE(pBlockChain->GetHeight(EChainType::CONFIRMED) == 1);
+	REQUIRE(pBlockChain->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == block_a.block.GetHash());
+
+	// Proof of work isn't validated while testing, so the template is accepted as is, roots and all.
+	REQUIRE(pBlockChain->AddBlock(*pTemplate) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChain->GetHeight(EChainType::CONFIRMED) == 2);
+}
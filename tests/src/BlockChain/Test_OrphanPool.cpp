@@ -0,0 +1,76 @@
+#include <catch.hpp>
+
+#include <BlockChain/OrphanPool/OrphanPool.h>
+#include <FakeModels.h>
+
+TEST_CASE("OrphanPool - Indexed by hash and previous hash")
+{
+	OrphanPool pool;
+
+	const FullBlock block10 = FakeModels::CreateBlock(10, Hash::ValueOf(9), 10);
+	const FullBlock block11a = FakeModels::CreateBlock(11, block10.GetHash(), 111);
+	const FullBlock block11b = FakeModels::CreateBlock(11, block10.GetHash(), 112);
+	const FullBlock block12 = FakeModels::CreateBlock(12, block11a.GetHash(), 12);
+
+	for (const FullBlock* pBlock : { &block10, &block11a, &block11b, &block12 })
+	{
+		pool.AddOrphanBlock(*pBlock, 5);
+	}
+
+	// Duplicates are ignored
+	const uint64_t totalBytes = pool.GetTotalBytes();
+	pool.AddOrphanBlock(block12, 5);
+	REQUIRE(pool.GetNumOrphans() == 4);
+	REQUIRE(pool.GetTotalBytes() == totalBytes);
+
+	REQUIRE(pool.IsOrphan(block11b.GetHash()));
+	REQUIRE(pool.GetOrphanBlock(block12.GetHash())->GetHash() == block12.GetHash());
+	REQUIRE(pool.GetOrphanBlock(Hash::ValueOf(9)) == nullptr);
+
+	REQUIRE(pool.GetChildren(block10.GetHash()).size() == 2);
+	REQUIRE(pool.GetChildren(block11a.GetHash()).front()->GetHash() == block12.GetHash());
+	REQUIRE(pool.GetChildren(block12.GetHash()).empty());
+
+	pool.RemoveOrphan(block11b.GetHash());
+	REQUIRE_FALSE(pool.IsOrphan(block11b.GetHash()));
+	REQUIRE(pool.GetChildren(block10.GetHash()).size() == 1);
+
+	// Everything building on block10 goes with it.
+	pool.RemoveOrphanAndDescendants(block10.GetHash());
+	REQUIRE(pool.GetNumOrphans() == 0);
+	REQUIRE(pool.GetTotalBytes() == 0);
+	REQUIRE(pool.GetChildren(block10.GetHash()).empty());
+}
+
+TEST_CASE("OrphanPool - Evicts furthest from tip")
+{
+	const FullBlock stale = FakeModels::CreateBlock(90, Hash::ValueOf(89), 90);
+	const FullBlock next = FakeModels::CreateBlock(101, Hash::ValueOf(100), 101);
+	const FullBlock ahead = FakeModels::CreateBlock(150, Hash::ValueOf(149), 150);
+	const FullBlock farAhead = FakeModels::CreateBlock(500, Hash::ValueOf(499), 500);
+
+	// Room for exactly 3 of the (equally sized) blocks.
+	OrphanPool pool(OrphanPool::EstimateBytes(next) * 3);
+
+	pool.AddOrphanBlock(stale, 100);
+	pool.AddOrphanBlock(next, 100);
+	pool.AddOrphanBlock(farAhead, 100);
+	REQUIRE(pool.GetNumOrphans() == 3);
+
+	pool.AddOrphanBlock(ahead, 100);
+	REQUIRE(pool.GetNumOrphans() == 3);
+	REQUIRE_FALSE(pool.IsOrphan(farAhead.GetHash()));
+
+	// Once the tip moves on, the stale fork block is the furthest.
+	pool.AddOrphanBlock(farAhead, 400);
+	REQUIRE(pool.GetNumOrphans() == 3);
+	REQUIRE_FALSE(pool.IsOrphan(stale.GetHash()));
+	REQUIRE(pool.IsOrphan(farAhead.GetHash()));
+	REQUIRE(pool.GetTotalBytes() <= OrphanPool::EstimateBytes(next) * 3);
+
+	// A block bigger than the whole pool isn't kept, and doesn't evict anything.
+	const FullBlock huge = FakeModels::CreateBlock(401, Hash::ValueOf(400), 401, 20);
+	pool.AddOrphanBlock(huge, 400);
+	REQUIRE_FALSE(pool.IsOrphan(huge.GetHash()));
+	REQUIRE(pool.GetNumOrphans() == 3);
+}
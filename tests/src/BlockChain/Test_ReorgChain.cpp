@@ -449,4 +449,46 @@ TEST_CASE("Reorg Chain")
 	REQUIRE(pBlockChain->GetBlockByHeight(31)->GetHash() == block31b.GetHash());
 
 	// TODO: Assert unspent positions in leafset and in database.
-}
\ No newline at end of file
+}
+
+//
+// a - b - c
+//
+// Process in the following order -
+// 1. block_a
+// 2. block_c - orphaned, and its header isn't on the candidate chain
+// 3. block_b
+// 4. Process orphans - block_c is found as a child of the new tip
+//
+TEST_CASE("Orphan connects when its parent is applied")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	KeyChain keyChain = KeyChain::FromRandom();
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChain = pTestServer->GetBlockChain();
+
+	TestChain chain1(pBlockChain);
+
+	Test::Tx coinbase_a = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 1 }));
+	MinedBlock block_a = chain1.AddNextBlock({ coinbase_a });
+
+	Test::Tx coinbase_b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 2 }));
+	MinedBlock block_b = chain1.AddNextBlock({ coinbase_b });
+
+	Test::Tx coinbase_c = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 3 }));
+	MinedBlock block_c = chain1.AddNextBlock({ coinbase_c });
+
+	REQUIRE(pBlockChain->AddBlock(block_a.block) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChain->AddBlock(block_c.block) == EBlockChainStatus::ORPHANED);
+	REQUIRE(pBlockChain->HasOrphan(block_c.block.GetHash()));
+
+	REQUIRE(pBlockChain->AddBlock(block_b.block) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChain->GetHeight(EChainType::CANDIDATE) == 2);
+
+	REQUIRE(pBlockChain->ProcessNextOrphanBlock());
+
+	REQUIRE(pBlockChain->GetHeight(EChainType::CONFIRMED) == 3);
+	REQUIRE(pBlockChain->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == block_c.block.GetHash());
+	REQUIRE(!pBlockChain->HasOrphan(block_c.block.GetHash()));
+	REQUIRE(!pBlockChain->ProcessNextOrphanBlock());
+}
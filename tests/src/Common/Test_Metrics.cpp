@@ -0,0 +1,70 @@
+#include <catch.hpp>
+
+#include <Common/Metrics.h>
+
+TEST_CASE("Metrics::Registry - Counters and gauges")
+{
+	Metrics::Registry& registry = Metrics::Registry::Get();
+
+	Metrics::Counter& added = registry.AddCounter("test_metrics_txs_total", "Transactions", { { "result", "added" } });
+	Metrics::Counter& rejected = registry.AddCounter("test_metrics_txs_total", "Transactions", { { "result", "rejected" } });
+	added.Increment();
+	added.Increment(2);
+	rejected.Increment();
+
+	// Registering the same name and labels again returns the same metric.
+	REQUIRE(&registry.AddCounter("test_metrics_txs_total", "Transactions", { { "result", "added" } }) == &added);
+	REQUIRE(added.Get() == 3);
+
+	Metrics::Gauge& depth = registry.AddGauge("test_metrics_depth", "Depth");
+	depth.Set(5);
+	depth.Add(-2);
+	REQUIRE(depth.Get() == 3);
+
+	REQUIRE_THROWS(registry.AddGauge("test_metrics_txs_total", "Transactions"));
+
+	const std::string formatted = registry.Format();
+	REQUIRE(formatted.find("# TYPE test_metrics_txs_total counter\n") != std::string::npos);
+	REQUIRE(formatted.find("test_metrics_txs_total{result=\"added\"} 3\n") != std::string::npos);
+	REQUIRE(formatted.find("test_metrics_txs_total{result=\"rejected\"} 1\n") != std::string::npos);
+	REQUIRE(formatted.find("# TYPE test_metrics_depth gauge\ntest_metrics_depth 3\n") != std::string::npos);
+}
+
+TEST_CASE("Metrics::Histogram")
+{
+	Metrics::Histogram& histogram = Metrics::Registry::Get().AddHistogram("test_metrics_latency_seconds", "Latency");
+	histogram.Observe(std::chrono::microseconds(5));
+	histogram.Observe(std::chrono::milliseconds(3));
+	histogram.Observe(std::chrono::seconds(60));
+
+	const Metrics::Histogram::Snapshot snapshot = histogram.GetSnapshot();
+	REQUIRE(snapshot.count == 3);
+	REQUIRE(snapshot.cumulative.size() == snapshot.bounds.size() + 1);
+	REQUIRE(snapshot.cumulative.front() == 1);
+	REQUIRE(snapshot.cumulative[snapshot.bounds.size() - 1] == 2);
+	REQUIRE(snapshot.cumulative.back() == 3);
+	REQUIRE(snapshot.sum == Approx(60.003005));
+
+	const std::string formatted = Metrics::Registry::Get().Format();
+	REQUIRE(formatted.find("test_metrics_latency_seconds_bucket{le=\"1e-05\"} 1\n") != std::string::npos);
+	REQUIRE(formatted.find("test_metrics_latency_seconds_bucket{le=\"+Inf\"} 3\n") != std::string::npos);
+	REQUIRE(formatted.find("test_metrics_latency_seconds_count 3\n") != std::string::npos);
+}
+
+TEST_CASE("Metrics::Registry - Collectors")
+{
+	auto pCollector = Metrics::Registry::Get().AddCollector([](Metrics::Writer& writer) {
+		writer.AddGauge("test_metrics_peer_bytes", "Bytes per peer", { { "peer", "1.2.3.4" } }, 100);
+		writer.AddGauge("test_metrics_peer_bytes", "Bytes per peer", { { "peer", "5.6.7.8" } }, 200);
+	});
+
+	std::string formatted = Metrics::Registry::Get().Format();
+	REQUIRE(formatted.find("# TYPE test_metrics_peer_bytes gauge\n") != std::string::npos);
+	REQUIRE(formatted.find("test_metrics_peer_bytes{peer=\"1.2.3.4\"} 100\n") != std::string::npos);
+	REQUIRE(formatted.find("test_metrics_peer_bytes{peer=\"5.6.7.8\"} 200\n") != std::string::npos);
+
+	// Dropping the collector unregisters it.
+	pCollector.reset();
+	formatted = Metrics::Registry::Get().Format();
+	REQUIRE(formatted.find("test_metrics_peer_bytes") == std::string::npos);
+}
@@ -0,0 +1,70 @@
+#include <catch.hpp>
+
+#include <Common/Tracing.h>
+#include <thread>
+
+static size_t CountOccurrences(const std::string& str, const std::string& substr)
+{
+	size_t count = 0;
+	for (size_t pos = str.find(substr); pos != std::string::npos; pos = str.find(substr, pos + substr.size())) {
+		count++;
+	}
+
+	return count;
+}
+
+TEST_CASE("Tracing - Spans are only recorded while enabled")
+{
+	Tracing::Start();
+	Tracing::Stop();
+	{
+		TRACE_SPAN("test", "Test_Tracing::Disabled");
+	}
+
+	Tracing::Start();
+	{
+		TRACE_SPAN("test", "Test_Tracing::Outer");
+		TRACE_SPAN("test", "Test_Tracing::Inner");
+	}
+
+	std::thread([]() {
+		Tracing::SetThreadName("TRACE_TEST");
+		TRACE_SPAN("test", "Test_Tracing::OtherThread");
+	}).join();
+	Tracing::Stop();
+
+	const std::string trace = Tracing::ExportChromeTrace();
+	REQUIRE(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+	REQUIRE(trace.substr(trace.size() - 2) == "]}");
+	REQUIRE(trace.find("Test_Tracing::Disabled") == std::string::npos);
+	REQUIRE(CountOccurrences(trace, "\"name\":\"Test_Tracing::Outer\",\"cat\":\"test\",\"ph\":\"X\"") == 1);
+	REQUIRE(CountOccurrences(trace, "\"name\":\"Test_Tracing::Inner\",\"cat\":\"test\",\"ph\":\"X\"") == 1);
+	REQUIRE(CountOccurrences(trace, "\"name\":\"Test_Tracing::OtherThread\"") == 1);
+	REQUIRE(trace.find("\"name\":\"thread_name\",\"ph\":\"M\"") != std::string::npos);
+	REQUIRE(trace.find("\"args\":{\"name\":\"TRACE_TEST\"}") != std::string::npos);
+
+	// Restarting discards the previous events.
+	Tracing::Start();
+	Tracing::Stop();
+	REQUIRE(Tracing::ExportChromeTrace().find("Test_Tracing::Outer") == std::string::npos);
+}
+
+TEST_CASE("Tracing - Oldest events are overwritten once a thread's buffer is full")
+{
+	Tracing::Start();
+	for (size_t i = 0; i < Tracing::EVENTS_PER_THREAD; i++) {
+		TRACE_SPAN("test", "Test_Tracing::Old");
+	}
+
+	for (size_t i = 0; i < 10; i++) {
+		TRACE_SPAN("test", "Test_Tracing::New");
+	}
+	Tracing::Stop();
+
+	const std::string trace = Tracing::ExportChromeTrace();
+	REQUIRE(CountOccurrences(trace, "\"name\":\"Test_Tracing::Old\"") == Tracing::EVENTS_PER_THREAD - 10);
+	REQUIRE(CountOccurrences(trace, "\"name\":\"Test_Tracing::New\"") == 10);
+
+	// Events are exported oldest first.
+	REQUIRE(trace.rfind("Test_Tracing::Old") < trace.find("Test_Tracing::New"));
+}
@@ -30,4 +30,36 @@ TEST_CASE("DataFile")
     pDataFile->Commit();
 
     REQUIRE(pDataFile->GetSize() == 4);
-}
\ No newline at end of file
+}
+
+TEST_CASE("DataFile - Compact")
+{
+    auto pFile = TestFileUtil::CreateTempFile();
+
+    auto pDataFile = DataFile<32>::Load(pFile->GetPath());
+
+    std::vector<CBigInteger<32>> entries;
+    for (size_t i = 0; i < 6; i++)
+    {
+        entries.push_back(CSPRNG::GenerateRandom32());
+        pDataFile->AddData(entries.back());
+    }
+
+    REQUIRE_THROWS(pDataFile->Compact({ 1 }));
+
+    pDataFile->Commit();
+    pDataFile->Compact({ 0, 2, 3 });
+
+    REQUIRE(pDataFile->GetSize() == 3);
+    REQUIRE(pDataFile->GetDataAt(0) == entries[1].GetData());
+    REQUIRE(pDataFile->GetDataAt(1) == entries[4].GetData());
+    REQUIRE(pDataFile->GetDataAt(2) == entries[5].GetData());
+
+    // Compacted file should be on disk, and appending should continue after it.
+    pDataFile->AddData(entries[0]);
+    pDataFile->Commit();
+
+    auto pReloaded = DataFile<32>::Load(pFile->GetPath());
+    REQUIRE(pReloaded->GetSize() == 4);
+    REQUIRE(pReloaded->GetDataAt(3) == entries[0].GetData());
+}
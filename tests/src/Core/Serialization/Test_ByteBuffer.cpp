@@ -0,0 +1,67 @@
+#include <catch.hpp>
+
+#include <Core/Genesis.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Serialization/Serializer.h>
+#include <limits>
+
+TEST_CASE("ByteBuffer - Integers")
+{
+	Serializer serializer;
+	serializer.Append<uint8_t>(0x12);
+	serializer.Append<uint16_t>(0x3456);
+	serializer.Append<uint32_t>(0x789ABCDE);
+	serializer.Append<uint64_t>(0x0123456789ABCDEF);
+	serializer.AppendLittleEndian<uint64_t>(0x0123456789ABCDEF);
+	serializer.AppendVarStr("grin");
+	REQUIRE(serializer.size() == 1 + 2 + 4 + 8 + 8 + 8 + 4);
+
+	ByteBuffer byteBuffer(serializer.GetBytes());
+	REQUIRE(byteBuffer.ReadU8() == 0x12);
+	REQUIRE(byteBuffer.ReadU16() == 0x3456);
+	REQUIRE(byteBuffer.ReadU32() == 0x789ABCDE);
+	REQUIRE(byteBuffer.ReadU64() == 0x0123456789ABCDEF);
+	REQUIRE(byteBuffer.ReadU64_LE() == 0x0123456789ABCDEF);
+	REQUIRE(byteBuffer.ReadVarStr() == "grin");
+	REQUIRE(byteBuffer.GetRemainingSize() == 0);
+	REQUIRE_THROWS(byteBuffer.ReadU8());
+}
+
+TEST_CASE("ByteBuffer - Lengths past the end")
+{
+	Serializer serializer;
+	serializer.Append<uint64_t>(std::numeric_limits<uint64_t>::max());
+	serializer.Append<uint64_t>(0);
+
+	// Would wrap around if added to the index.
+	ByteBuffer byteBuffer(serializer.GetBytes());
+	REQUIRE_THROWS(byteBuffer.ReadVector(byteBuffer.ReadU64()));
+	REQUIRE_THROWS(byteBuffer.ReadSlice(std::numeric_limits<uint64_t>::max()));
+}
+
+TEST_CASE("ByteBuffer - Slices reference the shared buffer")
+{
+	const FullBlock& genesis = Genesis::FLOONET_GENESIS;
+	auto pBytes = std::make_shared<const std::vector<uint8_t>>(genesis.Serialized());
+
+	ByteSlice proofBytes;
+	{
+		ByteBuffer byteBuffer(pBytes);
+		FullBlock block = FullBlock::Deserialize(byteBuffer);
+		REQUIRE(block.GetHash() == genesis.GetHash());
+		REQUIRE(block.Serialized() == *pBytes);
+
+		proofBytes = block.GetOutputs().front().GetRangeProof().GetProofBytes();
+		REQUIRE(proofBytes == genesis.GetOutputs().front().GetRangeProof().GetProofBytes());
+	}
+
+	// The proof points into the buffer it was read from, and keeps it alive after the block is gone.
+	REQUIRE(proofBytes.data() > pBytes->data());
+	REQUIRE(proofBytes.end() <= pBytes->data() + pBytes->size());
+	REQUIRE(pBytes.use_count() == 2);
+
+	ByteSlice moved = std::move(proofBytes);
+	REQUIRE(proofBytes.empty());
+	REQUIRE(moved.size() == MAX_PROOF_SIZE);
+	REQUIRE(moved.ToVector() == genesis.GetOutputs().front().GetRangeProof().GetProofBytes().ToVector());
+}
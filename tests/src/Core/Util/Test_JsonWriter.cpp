@@ -0,0 +1,75 @@
+#include <catch.hpp>
+
+#include <Core/Genesis.h>
+#include <Core/Util/JsonUtil.h>
+#include <Core/Util/JsonWriter.h>
+
+TEST_CASE("JsonWriter - Compact output")
+{
+	const std::string json = JsonWriter::ToString([](JsonWriter& writer) {
+		writer.BeginObject();
+		writer.UInt64("height", 18446744073709551615ull);
+		writer.Int64("offset", -5);
+		writer.String("text", "a\"b\\c\n\x01");
+		writer.Bool("flag", true);
+		writer.Null("empty");
+		writer.Key("list").BeginArray();
+		writer.UInt64(1).UInt64(2);
+		writer.BeginObject().EndObject();
+		writer.BeginArray().EndArray();
+		writer.EndArray();
+		writer.EndObject();
+	});
+
+	REQUIRE(json == "{\"height\":18446744073709551615,\"offset\":-5,\"text\":\"a\\\"b\\\\c\\n\\u0001\",\"flag\":true,\"empty\":null,\"list\":[1,2,{},[]]}");
+
+	Json::Value parsed;
+	REQUIRE(JsonUtil::Parse(json, parsed));
+	REQUIRE(parsed["text"].asString() == "a\"b\\c\n\x01");
+	REQUIRE(parsed["height"].asUInt64() == 18446744073709551615ull);
+}
+
+TEST_CASE("JsonWriter - Flushes in pieces")
+{
+	std::vector<size_t> pieces;
+	std::string output;
+	JsonWriter writer([&pieces, &output](const char* pData, const size_t length) {
+		pieces.push_back(length);
+		output.append(pData, length);
+	}, 64);
+
+	writer.BeginArray();
+	for (uint64_t i = 0; i < 100; i++)
+	{
+		writer.UInt64(i);
+	}
+	writer.EndArray();
+	writer.Flush();
+
+	REQUIRE(pieces.size() > 1);
+
+	Json::Value parsed;
+	REQUIRE(JsonUtil::Parse(output, parsed));
+	REQUIRE(parsed.size() == 100);
+	REQUIRE(parsed[99].asUInt64() == 99);
+}
+
+TEST_CASE("JsonWriter - FullBlock matches ToJSON")
+{
+	const FullBlock& genesis = Genesis::MAINNET_GENESIS;
+
+	Json::Value streamed;
+	REQUIRE(JsonUtil::Parse(JsonWriter::ToString([&genesis](JsonWriter& writer) { genesis.WriteJSON(writer); }), streamed));
+
+	const Json::Value expected = genesis.ToJSON();
+	REQUIRE(streamed["header"] == expected["header"]);
+	REQUIRE(streamed["outputs"] == expected["outputs"]);
+	REQUIRE(streamed["kernels"] == expected["kernels"]);
+	REQUIRE(streamed["inputs"].isArray());
+	REQUIRE(streamed["inputs"].empty());
+
+	Json::Value withoutProofs;
+	REQUIRE(JsonUtil::Parse(JsonWriter::ToString([&genesis](JsonWriter& writer) { genesis.WriteJSON(writer, false); }), withoutProofs));
+	REQUIRE(!withoutProofs["outputs"][0].isMember("proof"));
+	REQUIRE(withoutProofs["outputs"][0]["commit"] == expected["outputs"][0]["commit"]);
+}
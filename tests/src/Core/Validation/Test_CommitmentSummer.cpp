@@ -0,0 +1,110 @@
+#include <catch.hpp>
+
+#include <Core/Validation/CommitmentSummer.h>
+#include <Crypto/Crypto.h>
+#include <Crypto/CSPRNG.h>
+
+TEST_CASE("CommitmentSummer")
+{
+	std::vector<Commitment> positive;
+	for (size_t i = 0; i < 2500; i++)
+	{
+		positive.push_back(Crypto::CommitBlinded(i, CSPRNG::GenerateRandom32()));
+	}
+
+	std::vector<Commitment> negative;
+	for (size_t i = 0; i < 1200; i++)
+	{
+		negative.push_back(Crypto::CommitBlinded(i, CSPRNG::GenerateRandom32()));
+	}
+
+	const Commitment expected = Crypto::AddCommitments(positive, negative);
+	REQUIRE(CommitmentSummer::Sum(positive, negative) == expected);
+
+	// Small inputs are summed directly
+	const std::vector<Commitment> small(positive.cbegin(), positive.cbegin() + 10);
+	REQUIRE(CommitmentSummer::Sum(small, {}) == Crypto::AddCommitments(small, {}));
+
+	// Streamed, skipping every 3rd commitment
+	std::vector<Commitment> filtered;
+	for (size_t i = 0; i < positive.size(); i++)
+	{
+		if (i % 3 != 0) {
+			filtered.push_back(positive[i]);
+		}
+	}
+
+	std::optional<Commitment> streamed = CommitmentSummer::Sum(
+		positive.size(),
+		[&positive](const uint64_t begin, const uint64_t end, std::vector<Commitment>& commitments) {
+			for (uint64_t i = begin; i < end; i++)
+			{
+				if (i % 3 != 0) {
+					commitments.push_back(positive[i]);
+				}
+			}
+		}
+	);
+	REQUIRE(streamed.has_value());
+	REQUIRE(streamed.value() == Crypto::AddCommitments(filtered, {}));
+
+	std::optional<Commitment> empty = CommitmentSummer::Sum(
+		100,
+		[](const uint64_t, const uint64_t, std::vector<Commitment>&) { }
+	);
+	REQUIRE_FALSE(empty.has_value());
+}
+
+TEST_CASE("CommitmentSummer - Chunk sums to zero")
+{
+	// The whole second chunk cancels out: each commit(0, r) is followed by commit(0, -r).
+	std::vector<Commitment> commitments;
+	std::vector<Commitment> nonCancelling;
+	for (size_t i = 0; i < 2500; i++)
+	{
+		if (i >= CommitmentSummer::CHUNK_SIZE && i < 2 * CommitmentSummer::CHUNK_SIZE) {
+			const BlindingFactor blind = CSPRNG::GenerateRandom32();
+			commitments.push_back(Crypto::CommitBlinded(0, blind));
+			commitments.push_back(Crypto::CommitBlinded(0, Crypto::AddBlindingFactors({}, { blind })));
+			i++;
+		} else {
+			commitments.push_back(Crypto::CommitBlinded(i, CSPRNG::GenerateRandom32()));
+			nonCancelling.push_back(commitments.back());
+		}
+	}
+
+	const Commitment expected = Crypto::AddCommitments(nonCancelling, {});
+	REQUIRE(CommitmentSummer::Sum(commitments, {}) == expected);
+
+	std::optional<Commitment> streamed = CommitmentSummer::Sum(
+		commitments.size(),
+		[&commitments](const uint64_t begin, const uint64_t end, std::vector<Commitment>& chunk) {
+			chunk.insert(chunk.end(), commitments.cbegin() + begin, commitments.cbegin() + end);
+		}
+	);
+	REQUIRE(streamed.has_value());
+	REQUIRE(streamed.value() == expected);
+
+	// Only the cancelling chunk
+	const std::vector<Commitment> cancelling(
+		commitments.cbegin() + CommitmentSummer::CHUNK_SIZE,
+		commitments.cbegin() + 2 * CommitmentSummer::CHUNK_SIZE
+	);
+	std::optional<Commitment> zero = CommitmentSummer::Sum(
+		cancelling.size(),
+		[&cancelling](const uint64_t begin, const uint64_t end, std::vector<Commitment>& chunk) {
+			chunk.insert(chunk.end(), cancelling.cbegin() + begin, cancelling.cbegin() + end);
+		}
+	);
+	REQUIRE_FALSE(zero.has_value());
+
+	// A tail chunk of excesses E and -E on the negative side.
+	const BlindingFactor excess = CSPRNG::GenerateRandom32();
+	std::vector<Commitment> negative(nonCancelling.cbegin(), nonCancelling.cbegin() + CommitmentSummer::CHUNK_SIZE);
+	negative.push_back(Crypto::CommitBlinded(0, excess));
+	negative.push_back(Crypto::CommitBlinded(0, Crypto::AddBlindingFactors({}, { excess })));
+	REQUIRE(CommitmentSummer::Sum(commitments, negative) == Crypto::AddCommitments(
+		nonCancelling,
+		std::vector<Commitment>(nonCancelling.cbegin(), nonCancelling.cbegin() + CommitmentSummer::CHUNK_SIZE)
+	));
+}
@@ -0,0 +1,148 @@
+#include <catch.hpp>
+
+#include <Net/Servers/RPC/RPCServer.h>
+#include <Net/Clients/RPC/RPCClient.h>
+#include <future>
+#include <stdexcept>
+
+class EchoMethod : public RPCMethod
+{
+public:
+	RPC::Response Handle(const RPC::Request& request) const final
+	{
+		return request.BuildResult(request.GetParams().value_or(Json::nullValue));
+	}
+
+	bool ContainsSecrets() const noexcept final { return false; }
+};
+
+// Sent with chunked transfer encoding.
+class CountMethod : public RPCMethod
+{
+public:
+	RPC::Response Handle(const RPC::Request& request) const final
+	{
+		const uint64_t count = request.GetParams().value()[0].asUInt64();
+		return request.BuildStreamingResult([count](JsonWriter& writer) {
+			writer.BeginArray();
+			for (uint64_t i = 0; i < count; i++)
+			{
+				writer.UInt64(i);
+			}
+			writer.EndArray();
+		});
+	}
+
+	bool ContainsSecrets() const noexcept final { return false; }
+};
+
+// Fails after the response has started.
+class FailMethod : public RPCMethod
+{
+public:
+	RPC::Response Handle(const RPC::Request& request) const final
+	{
+		return request.BuildStreamingResult([](JsonWriter& writer) {
+			writer.BeginArray();
+			throw std::runtime_error("Failed part way through");
+		});
+	}
+
+	bool ContainsSecrets() const noexcept final { return false; }
+};
+
+static RPCServerPtr CreateServer()
+{
+	RPCServerPtr pServer = RPCServer::Create(EServerType::LOCAL, std::nullopt, "/v2", LoggerAPI::LogFile::WALLET);
+	pServer->AddMethod("echo", std::make_shared<EchoMethod>());
+	pServer->AddMethod("count", std::make_shared<CountMethod>());
+	pServer->AddMethod("fail", std::make_shared<FailMethod>());
+	return pServer;
+}
+
+static Json::Value Params(const uint64_t value)
+{
+	Json::Value params(Json::arrayValue);
+	params.append(Json::UInt64(value));
+	return params;
+}
+
+TEST_CASE("HttpRpcClient - Keep-alive")
+{
+	RPCServerPtr pServer = CreateServer();
+	HttpRpcClient client;
+
+	for (uint64_t i = 0; i < 5; i++)
+	{
+		RPC::Response response = client.Invoke("127.0.0.1", "/v2", pServer->GetPortNumber(), RPC::Request::BuildRequest("echo", Params(i)));
+		REQUIRE(response.GetResult().value()[0].asUInt64() == i);
+	}
+
+	// Large enough to span multiple chunks.
+	RPC::Response streamed = client.Invoke("127.0.0.1", "/v2", pServer->GetPortNumber(), RPC::Request::BuildRequest("count", Params(50'000)));
+	REQUIRE(streamed.GetResult().value().size() == 50'000);
+	REQUIRE(streamed.GetResult().value()[49'999].asUInt64() == 49'999);
+}
+
+TEST_CASE("HttpRpcClient - Batch")
+{
+	RPCServerPtr pServer = CreateServer();
+	HttpRpcClient client;
+
+	std::vector<RPC::Request> requests;
+	requests.push_back(RPC::Request::BuildRequest("echo", Params(1)));
+	requests.push_back(RPC::Request::BuildRequest("missing_method"));
+	requests.push_back(RPC::Request::BuildRequest("count", Params(3)));
+	requests.push_back(RPC::Request::BuildRequest("fail"));
+
+	std::vector<RPC::Response> responses = client.InvokeBatch("127.0.0.1", "/v2", pServer->GetPortNumber(), requests);
+	REQUIRE(responses.size() == 4);
+	REQUIRE(responses[0].GetId() == requests[0].GetId());
+	REQUIRE(responses[0].GetResult().value()[0].asUInt64() == 1);
+	REQUIRE(responses[1].GetError().value().GetCode() == RPC::ErrorCode::METHOD_NOT_FOUND);
+	REQUIRE(responses[2].GetResult().value().size() == 3);
+	REQUIRE(responses[3].GetId() == requests[3].GetId());
+	REQUIRE(responses[3].GetError().value().GetCode() == RPC::ErrorCode::INTERNAL_ERROR);
+
+	REQUIRE(client.InvokeBatch("127.0.0.1", "/v2", pServer->GetPortNumber(), {}).empty());
+}
+
+TEST_CASE("HTTPClient - Pipelined")
+{
+	RPCServerPtr pServer = CreateServer();
+	HTTPClient client;
+
+	std::vector<HTTP::Request> requests;
+	for (uint64_t i = 0; i < 10; i++)
+	{
+		const std::string body = RPC::Request::BuildRequest("echo", Params(i)).ToString();
+		requests.push_back(HTTP::Request(HTTP::EHTTPMethod::POST, "/v2", "127.0.0.1", pServer->GetPortNumber(), body));
+	}
+
+	std::vector<HTTP::Response> responses = client.InvokePipelined(requests);
+	REQUIRE(responses.size() == 10);
+	for (uint64_t i = 0; i < 10; i++)
+	{
+		REQUIRE(RPC::Response::Parse(responses[i].GetBody()).GetResult().value()[0].asUInt64() == i);
+	}
+}
+
+TEST_CASE("HttpRpcClient - Concurrent")
+{
+	RPCServerPtr pServer = CreateServer();
+	HttpRpcClient client(2);
+
+	std::vector<std::future<uint64_t>> futures;
+	for (uint64_t i = 0; i < 8; i++)
+	{
+		futures.push_back(std::async(std::launch::async, [&client, &pServer, i]() {
+			RPC::Response response = client.Invoke("127.0.0.1", "/v2", pServer->GetPortNumber(), RPC::Request::BuildRequest("echo", Params(i)));
+			return response.GetResult().value()[0].asUInt64();
+		}));
+	}
+
+	for (uint64_t i = 0; i < 8; i++)
+	{
+		REQUIRE(futures[i].get() == i);
+	}
+}
@@ -0,0 +1,98 @@
+#include <catch.hpp>
+
+#include <Net/SendQueue.h>
+
+using namespace std::chrono_literals;
+
+static std::vector<uint8_t> Bytes(const size_t size, const uint8_t tag)
+{
+	return std::vector<uint8_t>(size, tag);
+}
+
+TEST_CASE("TokenBucket")
+{
+	const auto now = TokenBucket::Clock::now();
+	TokenBucket bucket(1000, 500);
+	REQUIRE(bucket.HasTokens(now));
+	REQUIRE(bucket.GetWaitTime(now) == TokenBucket::Clock::duration::zero());
+
+	// Larger than the burst, but still allowed, since the bucket isn't empty. Puts it 700 bytes in debt.
+	bucket.Consume(1200, now);
+	REQUIRE_FALSE(bucket.HasTokens(now));
+	REQUIRE(bucket.GetWaitTime(now) > 700ms);
+	REQUIRE(bucket.GetWaitTime(now) < 710ms);
+
+	REQUIRE_FALSE(bucket.HasTokens(now + 600ms));
+	REQUIRE(bucket.HasTokens(now + 800ms));
+
+	// Never refills past the burst size.
+	REQUIRE(bucket.HasTokens(now + 10s));
+	bucket.Consume(500, now + 10s);
+	REQUIRE_FALSE(bucket.HasTokens(now + 10s));
+}
+
+TEST_CASE("SendQueue - Priorities")
+{
+	const auto now = SendQueue::Clock::now();
+	SendQueue queue(std::make_shared<TokenBucket>(SendQueue::SHARED_BULK_BYTES_PER_SECOND, SendQueue::SHARED_BULK_BURST_BYTES));
+	REQUIRE(queue.IsEmpty());
+
+	queue.Push(Bytes(100, 1), ESendPriority::BULK);
+	queue.Push(Bytes(10, 2), ESendPriority::TRANSACTION);
+	queue.Push(Bytes(20, 3), ESendPriority::LATENCY);
+	queue.Push(Bytes(30, 4), ESendPriority::CONTROL);
+	queue.Push(Bytes(40, 5), ESendPriority::LATENCY);
+	REQUIRE(queue.GetQueuedBytes() == 200);
+	REQUIRE(queue.GetQueuedBytes(ESendPriority::LATENCY) == 60);
+
+	// Highest priority first, and FIFO within a priority.
+	std::vector<uint8_t> order;
+	SendQueue::Clock::duration waitTime;
+	while (auto entry = queue.Pop(now, waitTime)) {
+		order.push_back(entry->bytes.front());
+	}
+
+	REQUIRE(order == std::vector<uint8_t>{ 4, 3, 5, 2, 1 });
+	REQUIRE(queue.IsEmpty());
+	REQUIRE(queue.GetQueuedBytes() == 0);
+}
+
+TEST_CASE("SendQueue - Throttling")
+{
+	const auto now = SendQueue::Clock::now();
+	auto pShared = std::make_shared<TokenBucket>(1000, 1000);
+	SendQueue queue(pShared);
+
+	// The first bulk message empties the shared bucket, so the second has to wait for it.
+	queue.Push(Bytes(5000, 1), ESendPriority::BULK, false);
+	queue.Push(Bytes(5000, 2), ESendPriority::BULK);
+
+	SendQueue::Clock::duration waitTime;
+	auto entry = queue.Pop(now, waitTime);
+	REQUIRE(entry.has_value());
+	REQUIRE(entry->priority == ESendPriority::BULK);
+	REQUIRE_FALSE(entry->isMessage);
+
+	REQUIRE_FALSE(queue.Pop(now, waitTime).has_value());
+	REQUIRE(waitTime > 4s);
+	REQUIRE(waitTime < 5s);
+
+	// Throttled bulk doesn't hold up anything else.
+	queue.Push(Bytes(100, 3), ESendPriority::LATENCY);
+	queue.Push(Bytes(100, 4), ESendPriority::TRANSACTION);
+	entry = queue.Pop(now, waitTime);
+	REQUIRE(entry->bytes.front() == 3);
+	entry = queue.Pop(now, waitTime);
+	REQUIRE(entry->bytes.front() == 4);
+	REQUIRE_FALSE(queue.Pop(now, waitTime).has_value());
+
+	// Other connections share the bulk budget.
+	SendQueue other(pShared);
+	other.Push(Bytes(10, 5), ESendPriority::BULK);
+	REQUIRE_FALSE(other.Pop(now, waitTime).has_value());
+
+	entry = queue.Pop(now + waitTime, waitTime);
+	REQUIRE(entry.has_value());
+	REQUIRE(entry->bytes.front() == 2);
+	REQUIRE(entry->isMessage);
+}
@@ -0,0 +1,92 @@
+#include <catch.hpp>
+
+#include <P2P/Sync/BlockDownloadScheduler.h>
+#include <Crypto/CSPRNG.h>
+
+using namespace std::chrono_literals;
+
+static std::vector<std::pair<uint64_t, Hash>> GenerateBlocks(const uint64_t firstHeight, const size_t numBlocks)
+{
+	std::vector<std::pair<uint64_t, Hash>> blocks;
+	for (size_t i = 0; i < numBlocks; i++) {
+		blocks.push_back({ firstHeight + i, CSPRNG::GenerateRandom32() });
+	}
+
+	return blocks;
+}
+
+TEST_CASE("BlockDownloadScheduler")
+{
+	BlockDownloadScheduler scheduler;
+	auto now = BlockDownloadScheduler::Clock::now();
+
+	PeerPtr pFast = std::make_shared<Peer>(IPAddress::Parse("10.0.0.1"));
+	PeerPtr pSlow = std::make_shared<Peer>(IPAddress::Parse("10.0.0.2"));
+	std::vector<PeerPtr> peers{ pFast, pSlow };
+
+	const std::vector<std::pair<uint64_t, Hash>> blocks = GenerateBlocks(101, 200);
+
+	// Each peer starts with the initial window.
+	auto assignments = scheduler.Schedule(100, blocks, peers, now);
+	REQUIRE(assignments.size() == 2 * (size_t)BlockDownloadScheduler::INITIAL_WINDOW);
+	REQUIRE(assignments.front().BLOCK_HEIGHT == 101);
+	REQUIRE(scheduler.GetPeerStats(pFast->GetIPAddress())->IN_FLIGHT == (size_t)BlockDownloadScheduler::INITIAL_WINDOW);
+	REQUIRE(scheduler.GetPeerStats(pSlow->GetIPAddress())->IN_FLIGHT == (size_t)BlockDownloadScheduler::INITIAL_WINDOW);
+
+	// Nothing new to schedule until blocks arrive.
+	REQUIRE(scheduler.Schedule(100, blocks, peers, now).empty());
+
+	// Blocks only count when they come from the peer they were requested from.
+	for (const auto& assignment : assignments) {
+		if (assignment.PEER == pSlow) {
+			REQUIRE_FALSE(scheduler.OnBlockReceived(pFast, assignment.BLOCK_HASH, 1000, now + 50ms));
+		}
+	}
+
+	// The fast peer delivers everything, and its window grows.
+	for (const auto& assignment : assignments) {
+		if (assignment.PEER == pFast) {
+			REQUIRE(scheduler.OnBlockReceived(pFast, assignment.BLOCK_HASH, 1000, now + 50ms));
+		}
+	}
+
+	auto pFastStats = scheduler.GetPeerStats(pFast->GetIPAddress());
+	REQUIRE(pFastStats->IN_FLIGHT == 0);
+	REQUIRE(pFastStats->BLOCKS_RECEIVED == 8);
+	REQUIRE(pFastStats->WINDOW > BlockDownloadScheduler::INITIAL_WINDOW);
+	REQUIRE(pFastStats->RESPONSE_TIME < 2000ms);
+
+	// Freed slots go to the fast peer, which is expected to deliver sooner.
+	assignments = scheduler.Schedule(100, blocks, peers, now + 100ms);
+	REQUIRE(assignments.size() == (size_t)pFastStats->WINDOW);
+	for (const auto& assignment : assignments) {
+		REQUIRE(assignment.PEER == pFast);
+		REQUIRE(scheduler.OnBlockReceived(pFast, assignment.BLOCK_HASH, 1000, now + 150ms));
+	}
+
+	// The slow peer stalls, so its blocks near the apply point are moved to the fast peer, and its window shrinks.
+	assignments = scheduler.Schedule(100, blocks, peers, now + 5s);
+	REQUIRE_FALSE(assignments.empty());
+	for (const auto& assignment : assignments) {
+		if (assignment.BLOCK_HEIGHT <= 100 + BlockDownloadScheduler::URGENT_BLOCKS) {
+			REQUIRE(assignment.PEER == pFast);
+		}
+	}
+
+	auto pSlowStats = scheduler.GetPeerStats(pSlow->GetIPAddress());
+	REQUIRE(pSlowStats->STALLS > 0);
+	REQUIRE(pSlowStats->WINDOW < BlockDownloadScheduler::INITIAL_WINDOW);
+
+	// Applied blocks are forgotten.
+	const size_t inFlight = scheduler.GetNumInFlight();
+	scheduler.OnBlocksApplied(102);
+	REQUIRE(scheduler.GetNumInFlight() == inFlight - 2);
+	REQUIRE_FALSE(scheduler.IsRequested(blocks[0].second));
+
+	// Requests to disconnected peers are dropped and reassigned.
+	assignments = scheduler.Schedule(102, blocks, { pSlow }, now + 5s);
+	REQUIRE(scheduler.GetPeerStats(pFast->GetIPAddress()) == nullptr);
+	for (const auto& assignment : assignments) {
+		REQUIRE(assignment.PEER == pSlow);
+	}
+}
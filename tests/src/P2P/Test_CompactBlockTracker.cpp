@@ -0,0 +1,136 @@
+#include <catch.hpp>
+
+#include <P2P/CompactBlockTracker.h>
+#include <P2P/CompactBlockRelay.h>
+#include <FakeModels.h>
+
+using Peer = CompactBlockTracker::Peer;
+
+static CompactBlock CreateCompactBlock(const uint64_t seed)
+{
+	return FakeModels::CreateCompactBlock(FakeModels::CreateHeader(10, Hash::ValueOf(9), seed), seed, {});
+}
+
+static const std::vector<Peer> PEERS{ { 1, true }, { 2, false }, { 3, true }, { 4, true } };
+
+TEST_CASE("CompactBlockTracker - High-bandwidth peers")
+{
+	CompactBlockTracker tracker(2);
+
+	// No deliverers yet, so the first capable peers are picked.
+	REQUIRE(tracker.GetHighBandwidthPeers(PEERS) == std::vector<uint64_t>{ 1, 3 });
+
+	tracker.SelectValidated(Hash::ValueOf(1), 4, PEERS);
+	REQUIRE(tracker.GetHighBandwidthPeers(PEERS) == std::vector<uint64_t>{ 4, 1 });
+
+	tracker.SelectValidated(Hash::ValueOf(2), 3, PEERS);
+	REQUIRE(tracker.GetHighBandwidthPeers(PEERS) == std::vector<uint64_t>{ 3, 4 });
+
+	// Peers without the capability are never picked, even after delivering a block.
+	tracker.SelectValidated(Hash::ValueOf(3), 2, PEERS);
+	REQUIRE(tracker.GetHighBandwidthPeers(PEERS) == std::vector<uint64_t>{ 3, 4 });
+
+	REQUIRE(CompactBlockTracker(0).GetHighBandwidthPeers(PEERS).empty());
+}
+
+TEST_CASE("CompactBlockTracker - Relayed once")
+{
+	CompactBlockTracker tracker(2);
+	const CompactBlock compactBlock = CreateCompactBlock(1);
+
+	SECTION("Early, then validated")
+	{
+		// The source is never sent its own block.
+		REQUIRE(tracker.SelectEarly(compactBlock, 1, PEERS) == std::vector<uint64_t>{ 3 });
+		REQUIRE(tracker.SelectEarly(compactBlock, 1, PEERS).empty());
+
+		CompactBlockTracker::ValidatedTargets targets = tracker.SelectValidated(compactBlock.GetHash(), 1, PEERS);
+		REQUIRE(targets.compact.empty());
+		REQUIRE(targets.headers == std::vector<uint64_t>{ 2, 4 });
+		REQUIRE(targets.blocks.empty());
+	}
+
+	SECTION("Validated only")
+	{
+		CompactBlockTracker::ValidatedTargets targets = tracker.SelectValidated(compactBlock.GetHash(), 0, PEERS);
+		REQUIRE(targets.compact == std::vector<uint64_t>{ 1, 3 });
+		REQUIRE(targets.headers == std::vector<uint64_t>{ 2, 4 });
+
+		tracker.MarkSentCompact(compactBlock.GetHash(), compactBlock.GetNonce(), targets.compact);
+		targets = tracker.SelectValidated(compactBlock.GetHash(), 0, PEERS);
+		REQUIRE(targets.compact.empty());
+		REQUIRE(targets.headers == std::vector<uint64_t>{ 2, 4 });
+	}
+}
+
+TEST_CASE("CompactBlockTracker - Block requests while validating")
+{
+	CompactBlockTracker tracker(2);
+	const CompactBlock compactBlock = CreateCompactBlock(1);
+	tracker.SelectEarly(compactBlock, 1, PEERS);
+
+	// Only peers that were sent the block early are answered later.
+	REQUIRE(tracker.QueueBlockRequest(compactBlock.GetHash(), 3));
+	REQUIRE_FALSE(tracker.QueueBlockRequest(compactBlock.GetHash(), 2));
+	REQUIRE_FALSE(tracker.QueueBlockRequest(Hash::ValueOf(1), 3));
+
+	CompactBlockTracker::ValidatedTargets targets = tracker.SelectValidated(compactBlock.GetHash(), 1, PEERS);
+	REQUIRE(targets.blocks == std::vector<uint64_t>{ 3 });
+
+	// Once validated, the block can be looked up instead.
+	REQUIRE_FALSE(tracker.QueueBlockRequest(compactBlock.GetHash(), 3));
+	REQUIRE(tracker.SelectValidated(compactBlock.GetHash(), 1, PEERS).blocks.empty());
+}
+
+TEST_CASE("CompactBlockTracker - Pending")
+{
+	CompactBlockTracker tracker(2);
+	const CompactBlock compactBlock = CreateCompactBlock(1);
+	tracker.AddPending(compactBlock, 2);
+
+	REQUIRE_FALSE(tracker.TakePending(compactBlock.GetHash(), 3).has_value());
+	REQUIRE_FALSE(tracker.TakePending(Hash::ValueOf(1), 2).has_value());
+
+	std::optional<CompactBlock> pending = tracker.TakePending(compactBlock.GetHash(), 2);
+	REQUIRE(pending.has_value());
+	REQUIRE(pending.value().GetHash() == compactBlock.GetHash());
+
+	REQUIRE_FALSE(tracker.TakePending(compactBlock.GetHash(), 2).has_value());
+}
+
+TEST_CASE("CompactBlockTracker - Cached transactions")
+{
+	CompactBlockTracker tracker(2);
+	const CompactBlock compactBlock = CreateCompactBlock(1);
+	const TransactionPtr pTransaction = FakeModels::CreateTx(1, 1000);
+	tracker.CacheTransactions(compactBlock, { pTransaction });
+
+	std::vector<TransactionPtr> transactions;
+	REQUIRE(tracker.GetCachedTransactions(compactBlock.GetHash(), transactions) == std::make_optional<uint64_t>(1));
+	REQUIRE(transactions == std::vector<TransactionPtr>{ pTransaction });
+	REQUIRE_FALSE(tracker.GetCachedTransactions(Hash::ValueOf(1), transactions).has_value());
+
+	// Only the most recent blocks are kept.
+	for (uint64_t seed = 2; seed <= 17; seed++)
+	{
+		tracker.CacheTransactions(CreateCompactBlock(seed), {});
+	}
+
+	REQUIRE_FALSE(tracker.GetCachedTransactions(compactBlock.GetHash(), transactions).has_value());
+	REQUIRE(tracker.GetCachedTransactions(CreateCompactBlock(2).GetHash(), transactions).has_value());
+}
+
+TEST_CASE("CompactBlockRelay - Missing short ids")
+{
+	TransactionPtr pTx1 = FakeModels::CreateTx(1, 1000);
+	TransactionPtr pTx2 = FakeModels::CreateTx(10, 1000);
+	TransactionPtr pUnrelated = FakeModels::CreateTx(20, 1000);
+
+	const CompactBlock compactBlock = FakeModels::CreateCompactBlock(FakeModels::CreateHeader(10, Hash::ValueOf(9), 1), 123, { pTx1, pTx2 });
+
+	const std::set<ShortId> missing = CompactBlockRelay::GetMissingShortIds(compactBlock, { pTx1, pUnrelated });
+	REQUIRE(missing.size() == 1);
+	REQUIRE(missing.count(ShortId::Create(pTx2->GetKernels().front().GetHash(), compactBlock.GetHash(), 123)) == 1);
+
+	REQUIRE(CompactBlockRelay::GetMissingShortIds(compactBlock, { pTx1, pTx2 }).empty());
+}
@@ -0,0 +1,58 @@
+#include <catch.hpp>
+
+#include <P2P/Messages/GetCompactTransactionsMessage.h>
+#include <P2P/Messages/CompactTransactionsMessage.h>
+#include <FakeModels.h>
+
+static std::vector<uint8_t> SerializeBody(const IMessage& message)
+{
+	Serializer serializer(EProtocolVersion::V2);
+	message.SerializeBody(serializer);
+	return serializer.GetBytes();
+}
+
+TEST_CASE("GetCompactTransactionsMessage")
+{
+	const Hash blockHash = Hash::ValueOf(7);
+	std::set<ShortId> shortIds = {
+		ShortId::Create(Hash::ValueOf(1), blockHash, 123),
+		ShortId::Create(Hash::ValueOf(2), blockHash, 123)
+	};
+
+	const GetCompactTransactionsMessage message(blockHash, std::set<ShortId>(shortIds));
+	std::vector<uint8_t> bytes = SerializeBody(message);
+	REQUIRE(bytes.size() == 32 + 8 + 2 * 6);
+
+	ByteBuffer byteBuffer(std::vector<uint8_t>(bytes), EProtocolVersion::V2);
+	const GetCompactTransactionsMessage deserialized = GetCompactTransactionsMessage::Deserialize(byteBuffer);
+	REQUIRE(deserialized.GetBlockHash() == blockHash);
+	REQUIRE(deserialized.GetShortIds().size() == 2);
+	REQUIRE(deserialized.GetShortIds().begin()->GetId() == shortIds.begin()->GetId());
+	REQUIRE(deserialized.GetShortIds().rbegin()->GetId() == shortIds.rbegin()->GetId());
+
+	// A count the payload can't possibly hold is rejected before allocating anything.
+	bytes[32 + 7] = 0xFF;
+	ByteBuffer oversized(std::vector<uint8_t>(bytes), EProtocolVersion::V2);
+	REQUIRE_THROWS_AS(GetCompactTransactionsMessage::Deserialize(oversized), DeserializationException);
+}
+
+TEST_CASE("CompactTransactionsMessage")
+{
+	const Hash blockHash = Hash::ValueOf(7);
+	std::vector<TransactionPtr> transactions = { FakeModels::CreateTx(1, 1000), FakeModels::CreateTx(10, 1000) };
+
+	const CompactTransactionsMessage message(blockHash, std::vector<TransactionPtr>(transactions));
+	std::vector<uint8_t> bytes = SerializeBody(message);
+
+	ByteBuffer byteBuffer(std::vector<uint8_t>(bytes), EProtocolVersion::V2);
+	const CompactTransactionsMessage deserialized = CompactTransactionsMessage::Deserialize(byteBuffer);
+	REQUIRE(deserialized.GetBlockHash() == blockHash);
+	REQUIRE(deserialized.GetTransactions().size() == 2);
+	REQUIRE(deserialized.GetTransactions()[0]->GetHash() == transactions[0]->GetHash());
+	REQUIRE(deserialized.GetTransactions()[1]->GetHash() == transactions[1]->GetHash());
+
+	// Empty responses are allowed, when none of the requested txs were found.
+	const CompactTransactionsMessage empty(blockHash, {});
+	ByteBuffer emptyBuffer(SerializeBody(empty), EProtocolVersion::V2);
+	REQUIRE(CompactTransactionsMessage::Deserialize(emptyBuffer).GetTransactions().empty());
+}
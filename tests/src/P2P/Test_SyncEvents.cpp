@@ -0,0 +1,38 @@
+#include <catch.hpp>
+
+#include <P2P/Sync/SyncEvents.h>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("SyncEvents")
+{
+	SyncEvents events;
+	SyncEvents::Cursor cursor;
+
+	// Nothing has fired
+	REQUIRE_FALSE(events.WaitFor(cursor, { SyncEvents::EEvent::BLOCK_APPLIED }, 10ms));
+
+	// Events fired before waiting aren't lost
+	events.Notify(SyncEvents::EEvent::BLOCK_APPLIED);
+	REQUIRE(events.WaitFor(cursor, { SyncEvents::EEvent::BLOCK_APPLIED }, 10ms));
+	REQUIRE_FALSE(events.WaitFor(cursor, { SyncEvents::EEvent::BLOCK_APPLIED }, 10ms));
+
+	// Events the waiter isn't interested in are ignored
+	events.Notify(SyncEvents::EEvent::PEER_CONNECTED);
+	REQUIRE_FALSE(events.WaitFor(cursor, { SyncEvents::EEvent::BLOCK_APPLIED }, 10ms));
+
+	// Each cursor sees every event
+	SyncEvents::Cursor cursor2;
+	events.Notify(SyncEvents::EEvent::HEADERS_RECEIVED);
+	REQUIRE(events.WaitFor(cursor, { SyncEvents::EEvent::HEADERS_RECEIVED }, 10ms));
+	REQUIRE(events.WaitFor(cursor2, { SyncEvents::EEvent::HEADERS_RECEIVED }, 10ms));
+
+	// Wakes a blocked waiter, and STOPPING wakes everyone
+	std::thread notifier([&events] {
+		std::this_thread::sleep_for(20ms);
+		events.Notify(SyncEvents::EEvent::STOPPING);
+	});
+	REQUIRE(events.WaitFor(cursor, { SyncEvents::EEvent::BLOCK_APPLIED }, 10s));
+	notifier.join();
+}
@@ -0,0 +1,88 @@
+#include <catch.hpp>
+
+#include <TestFileUtil.h>
+
+#include <PMMR/Common/MMRHashCache.h>
+#include <PMMR/Common/MMRHashUtil.h>
+#include <PMMR/Common/MMRUtil.h>
+#include <PMMR/Common/LeafIndex.h>
+#include <cstring>
+
+static void AddLeaf(const HashFile::Ptr& pHashFile, MMRHashCache& cache, const uint64_t i)
+{
+	std::vector<uint8_t> leaf(32, 0);
+	std::memcpy(leaf.data(), &i, sizeof(i));
+
+	const uint64_t position = pHashFile->GetSize();
+	MMRHashUtil::AddHashes(pHashFile, leaf, nullptr);
+
+	// Every hash needed to add the leaf's parents is cached.
+	for (uint64_t pos = position; pos < pHashFile->GetSize(); pos++) {
+		const Index mmr_idx = Index::At(pos);
+		if (!mmr_idx.IsLeaf()) {
+			REQUIRE(cache.Find(mmr_idx.GetLeftChild().Get()) != nullptr);
+			REQUIRE(cache.Find(mmr_idx.GetRightChild().Get()) != nullptr);
+		}
+
+		cache.Add(pHashFile->GetDataAt(pos));
+	}
+}
+
+static void RequireSameHashes(const MMRHashCache& cache1, const MMRHashCache& cache2)
+{
+	REQUIRE(cache1.GetSize() == cache2.GetSize());
+	for (uint64_t position = 0; position < cache1.GetSize(); position++) {
+		const Hash* pHash1 = cache1.Find(position);
+		const Hash* pHash2 = cache2.Find(position);
+		REQUIRE((pHash1 == nullptr) == (pHash2 == nullptr));
+		if (pHash1 != nullptr) {
+			REQUIRE(*pHash1 == *pHash2);
+		}
+	}
+}
+
+TEST_CASE("MMRHashCache")
+{
+	auto pTempFile = TestFileUtil::CreateTempFile();
+	HashFile::Ptr pHashFile = HashFile::Load(pTempFile->GetPath());
+
+	// Enough leaves for a few upper nodes, and for the tail to be full.
+	MMRHashCache cache;
+	for (uint64_t i = 0; i < 5000; i++) {
+		AddLeaf(pHashFile, cache, i);
+	}
+
+	REQUIRE(cache.GetSize() == pHashFile->GetSize());
+	for (uint64_t size = 1; size <= pHashFile->GetSize(); size++) {
+		REQUIRE(cache.Root(*pHashFile, size) == MMRHashUtil::Root(pHashFile, size, nullptr));
+	}
+
+	// The peaks of recent sizes are all cached.
+	for (uint64_t size = pHashFile->GetSize() - (MMRHashCache::TAIL_SIZE / 2); size <= pHashFile->GetSize(); size++) {
+		for (const uint64_t peakIndex : MMRUtil::GetPeakIndices(size)) {
+			REQUIRE(cache.Find(peakIndex) != nullptr);
+		}
+	}
+
+	// Loading the file caches the same hashes as building it up.
+	MMRHashCache loaded;
+	loaded.Load(*pHashFile);
+	RequireSameHashes(cache, loaded);
+
+	// Rewinding further back than the tail refills it from the file.
+	const uint64_t rewindSize = LeafIndex::At(2500).GetPosition();
+	pHashFile->Rewind(rewindSize);
+	cache.Rewind(*pHashFile, rewindSize);
+
+	MMRHashCache reloaded;
+	reloaded.Load(*pHashFile);
+	RequireSameHashes(cache, reloaded);
+
+	for (uint64_t i = 2500; i < 3000; i++) {
+		AddLeaf(pHashFile, cache, i + 1000000);
+	}
+
+	for (uint64_t size = rewindSize; size <= pHashFile->GetSize(); size++) {
+		REQUIRE(cache.Root(*pHashFile, size) == MMRHashUtil::Root(pHashFile, size, nullptr));
+	}
+}
@@ -0,0 +1,74 @@
+#include <catch.hpp>
+
+#include <TestFileUtil.h>
+
+#include <PMMR/Common/MMRPeaks.h>
+#include <PMMR/Common/MMRHashUtil.h>
+#include <PMMR/Common/MMRUtil.h>
+#include <cstring>
+
+// Minimal unpruned MMR over a hash file.
+class TestMMR : public MMR
+{
+public:
+	explicit TestMMR(const HashFile::Ptr& pHashFile) : m_pHashFile(pHashFile) { }
+
+	uint64_t GetSize() const final { return m_pHashFile->GetSize(); }
+	Hash Root(const uint64_t size) const final { return MMRHashUtil::Root(m_pHashFile, size, nullptr); }
+
+	std::unique_ptr<Hash> GetHashAt(const Index& mmrIndex) const final
+	{
+		m_numReads++;
+		return std::make_unique<Hash>(m_pHashFile->GetDataAt(mmrIndex.Get()));
+	}
+
+	std::vector<Hash> GetLastLeafHashes(const uint64_t) const final { return {}; }
+	void Commit() final { }
+	void Rollback() noexcept final { }
+
+	mutable size_t m_numReads{ 0 };
+
+private:
+	HashFile::Ptr m_pHashFile;
+};
+
+TEST_CASE("MMRPeaks")
+{
+	auto pTempFile = TestFileUtil::CreateTempFile();
+	HashFile::Ptr pHashFile = HashFile::Load(pTempFile->GetPath());
+
+	std::vector<uint64_t> sizes;
+	std::vector<uint8_t> leaf(32, 0);
+	for (uint64_t i = 0; i < 300; i++) {
+		std::memcpy(leaf.data(), &i, sizeof(i));
+		MMRHashUtil::AddHashes(pHashFile, leaf, nullptr);
+		sizes.push_back(pHashFile->GetSize());
+	}
+
+	TestMMR mmr(pHashFile);
+
+	// Walking forwards matches the root calculated from scratch at every size.
+	MMRPeaks peaks;
+	REQUIRE(peaks.Root() == ZERO_HASH);
+	for (const uint64_t size : sizes) {
+		peaks.SetSize(mmr, size);
+		REQUIRE(peaks.GetSize() == size);
+		REQUIRE(peaks.Root() == mmr.Root(size));
+	}
+
+	// Only new peaks are read, which is at most one per leaf.
+	REQUIRE(mmr.m_numReads <= sizes.size());
+
+	// Sizes can repeat, and can go backwards.
+	peaks.SetSize(mmr, sizes.back());
+	REQUIRE(peaks.Root() == mmr.Root(sizes.back()));
+	peaks.SetSize(mmr, sizes[10]);
+	REQUIRE(peaks.Root() == mmr.Root(sizes[10]));
+
+	// Seeding from scratch at an arbitrary size.
+	MMRPeaks seeded;
+	seeded.SetSize(mmr, sizes[200]);
+	REQUIRE(seeded.Root() == mmr.Root(sizes[200]));
+	seeded.SetSize(mmr, sizes[201]);
+	REQUIRE(seeded.Root() == mmr.Root(sizes[201]));
+}
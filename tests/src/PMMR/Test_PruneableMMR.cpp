@@ -0,0 +1,201 @@
+#include <catch.hpp>
+
+#include <PMMR/Common/PruneableMMR.h>
+#include <Core/Models/OutputIdentifier.h>
+#include <Common/Util/FileUtil.h>
+#include <uuid.h>
+#include <algorithm>
+
+using TestMMR = PruneableMMR<34, OutputIdentifier>;
+
+static std::shared_ptr<TestMMR> LoadMMR(const fs::path& dir)
+{
+	TestMMR::RecoverCompaction(dir);
+
+	return std::make_shared<TestMMR>(
+		HashFile::Load(dir / "pmmr_hash.bin"),
+		LeafSet::Load(dir / "pmmr_leafset.bin"),
+		PruneList::Load(dir / "pmmr_prun.bin"),
+		DataFile<34>::Load(dir / "pmmr_data.bin")
+	);
+}
+
+static OutputIdentifier CreateOutput(const uint8_t i)
+{
+	return OutputIdentifier(EOutputFeatures::DEFAULT, Commitment(CBigInteger<33>::ValueOf(i)));
+}
+
+static void RequireLeaves(const TestMMR& mmr, const uint64_t numLeaves, const std::vector<uint64_t>& spent)
+{
+	for (uint64_t i = 0; i < numLeaves; i++) {
+		const bool isSpent = std::find(spent.cbegin(), spent.cend(), i) != spent.cend();
+		auto pOutput = mmr.GetAt(LeafIndex::At(i));
+		REQUIRE(mmr.IsUnpruned(LeafIndex::At(i)) == !isSpent);
+		if (isSpent) {
+			REQUIRE(pOutput == nullptr);
+		} else {
+			REQUIRE(pOutput != nullptr);
+			REQUIRE(*pOutput == CreateOutput((uint8_t)i));
+		}
+	}
+}
+
+TEST_CASE("PruneableMMR - Compact")
+{
+	const fs::path dir = fs::temp_directory_path() / uuids::to_string(uuids::uuid_system_generator()());
+	const fs::path copyDir = fs::temp_directory_path() / uuids::to_string(uuids::uuid_system_generator()());
+	FileUtil::CreateDirectories(dir);
+	FileUtil::CreateDirectories(copyDir);
+
+	// 16 leaves, with 0, 1, 2 and 5 spent before the horizon, and 9 spent after it.
+	auto pMMR = LoadMMR(dir);
+	for (uint8_t i = 0; i < 16; i++) {
+		pMMR->Append(CreateOutput(i));
+	}
+	for (uint64_t i : { 0, 1, 2, 5 }) {
+		pMMR->Remove(LeafIndex::At(i));
+	}
+	pMMR->Commit();
+
+	const uint64_t horizonSize = pMMR->GetSize();
+	const Hash horizonRoot = pMMR->Root(horizonSize);
+	const Hash horizonUBMTRoot = pMMR->UBMTRoot(16);
+
+	pMMR->Append(CreateOutput(16));
+	pMMR->Remove(LeafIndex::At(9));
+	pMMR->Commit();
+
+	const uint64_t size = pMMR->GetSize();
+	const Hash root = pMMR->Root(size);
+	const std::vector<uint64_t> spent = { 0, 1, 2, 5, 9 };
+	fs::copy(dir, copyDir, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
+
+	Roaring leavesToKeep;
+	leavesToKeep.add(9);
+	pMMR->Compact(16, leavesToKeep);
+
+	SECTION("Roots and leaves are unchanged")
+	{
+		REQUIRE(FileUtil::GetFileSize(dir / "pmmr_hash.bin") < FileUtil::GetFileSize(copyDir / "pmmr_hash.bin"));
+		REQUIRE(FileUtil::GetFileSize(dir / "pmmr_data.bin") < FileUtil::GetFileSize(copyDir / "pmmr_data.bin"));
+
+		REQUIRE(pMMR->GetSize() == size);
+		REQUIRE(pMMR->Root(size) == root);
+		RequireLeaves(*pMMR, 17, spent);
+
+		// Hashes of pruned roots are kept, but the nodes beneath them are gone.
+		REQUIRE(pMMR->IsCompacted(LeafIndex::At(0).GetIndex()));
+		REQUIRE(pMMR->GetHashAt(LeafIndex::At(0).GetIndex()) == nullptr);
+		REQUIRE(pMMR->GetHashAt(LeafIndex::At(9).GetIndex()) != nullptr);
+
+		auto pReloaded = LoadMMR(dir);
+		REQUIRE(pReloaded->GetSize() == size);
+		REQUIRE(pReloaded->Root(size) == root);
+		RequireLeaves(*pReloaded, 17, spent);
+	}
+
+	SECTION("Rewind after compact")
+	{
+		pMMR->Rewind(16, { 9 });
+		pMMR->Commit();
+
+		REQUIRE(pMMR->GetSize() == horizonSize);
+		REQUIRE(pMMR->Root(horizonSize) == horizonRoot);
+		REQUIRE(pMMR->UBMTRoot(16) == horizonUBMTRoot);
+		RequireLeaves(*pMMR, 16, { 0, 1, 2, 5 });
+
+		pMMR->Append(CreateOutput(16));
+		pMMR->Remove(LeafIndex::At(9));
+		pMMR->Commit();
+		REQUIRE(pMMR->Root(size) == root);
+	}
+
+	SECTION("Interrupted after marker is written")
+	{
+		// Stage the compacted files in the uncompacted copy, as if the renames never happened.
+		for (const std::string& filename : { "pmmr_hash.bin", "pmmr_data.bin", "pmmr_prun.bin" }) {
+			fs::copy_file(dir / filename, copyDir / (filename + ".compact"));
+		}
+		FileUtil::SafeWriteToFile(copyDir / "pmmr_compact.marker", {});
+
+		auto pRecovered = LoadMMR(copyDir);
+		REQUIRE(!FileUtil::Exists(copyDir / "pmmr_compact.marker"));
+		REQUIRE(FileUtil::GetFileSize(copyDir / "pmmr_hash.bin") == FileUtil::GetFileSize(dir / "pmmr_hash.bin"));
+		REQUIRE(pRecovered->Root(size) == root);
+		RequireLeaves(*pRecovered, 17, spent);
+	}
+
+	SECTION("Interrupted before marker is written")
+	{
+		const uint64_t hashFileSize = FileUtil::GetFileSize(copyDir / "pmmr_hash.bin");
+		fs::copy_file(dir / "pmmr_hash.bin", copyDir / "pmmr_hash.bin.compact");
+
+		auto pRecovered = LoadMMR(copyDir);
+		REQUIRE(!FileUtil::Exists(copyDir / "pmmr_hash.bin.compact"));
+		REQUIRE(FileUtil::GetFileSize(copyDir / "pmmr_hash.bin") == hashFileSize);
+		REQUIRE(pRecovered->Root(size) == root);
+		RequireLeaves(*pRecovered, 17, spent);
+	}
+
+	pMMR.reset();
+	std::error_code ec;
+	fs::remove_all(dir, ec);
+	fs::remove_all(copyDir, ec);
+}
+
+TEST_CASE("PruneableMMR - Prepare, then apply compaction")
+{
+	const fs::path dir = fs::temp_directory_path() / uuids::to_string(uuids::uuid_system_generator()());
+	FileUtil::CreateDirectories(dir);
+
+	auto pMMR = LoadMMR(dir);
+	for (uint8_t i = 0; i < 16; i++) {
+		pMMR->Append(CreateOutput(i));
+	}
+	for (uint64_t i : { 0, 1, 2, 5 }) {
+		pMMR->Remove(LeafIndex::At(i));
+	}
+	pMMR->Commit();
+
+	const uint64_t hashFileSize = FileUtil::GetFileSize(dir / "pmmr_hash.bin");
+	auto files = pMMR->PrepareCompaction(16, Roaring());
+	REQUIRE(files.has_value());
+	REQUIRE(FileUtil::Exists(dir / "pmmr_hash.bin.compact"));
+	REQUIRE(FileUtil::GetFileSize(dir / "pmmr_hash.bin") == hashFileSize);
+
+	SECTION("Appended in between")
+	{
+		pMMR->Append(CreateOutput(16));
+		pMMR->Append(CreateOutput(17));
+		pMMR->Remove(LeafIndex::At(9));
+		pMMR->Commit();
+
+		const uint64_t size = pMMR->GetSize();
+		const Hash root = pMMR->Root(size);
+		const std::vector<uint64_t> spent = { 0, 1, 2, 5, 9 };
+
+		pMMR->ApplyCompaction(files.value());
+		REQUIRE(!FileUtil::Exists(dir / "pmmr_hash.bin.compact"));
+		REQUIRE(!FileUtil::Exists(dir / "pmmr_compact.marker"));
+		REQUIRE(pMMR->GetSize() == size);
+		REQUIRE(pMMR->Root(size) == root);
+		RequireLeaves(*pMMR, 18, spent);
+
+		auto pReloaded = LoadMMR(dir);
+		REQUIRE(pReloaded->Root(size) == root);
+		RequireLeaves(*pReloaded, 18, spent);
+	}
+
+	SECTION("Discarded")
+	{
+		pMMR->DiscardCompaction();
+		REQUIRE(!FileUtil::Exists(dir / "pmmr_hash.bin.compact"));
+		REQUIRE(!FileUtil::Exists(dir / "pmmr_data.bin.compact"));
+		REQUIRE(!FileUtil::Exists(dir / "pmmr_prun.bin.compact"));
+		REQUIRE(FileUtil::GetFileSize(dir / "pmmr_hash.bin") == hashFileSize);
+	}
+
+	pMMR.reset();
+	std::error_code ec;
+	fs::remove_all(dir, ec);
+}
@@ -0,0 +1,48 @@
+#include <catch.hpp>
+
+#include <Core/Genesis.h>
+#include <PoW/PoWValidator.h>
+
+TEST_CASE("PoWValidator::AreCyclesValid")
+{
+	const BlockHeaderPtr pFloonet = Genesis::FLOONET_GENESIS.GetHeader();
+	const BlockHeaderPtr pMainnet = Genesis::MAINNET_GENESIS.GetHeader();
+	REQUIRE(PoWValidator::IsCycleValid(*pFloonet));
+	REQUIRE(PoWValidator::IsCycleValid(*pMainnet));
+
+	// Same header with one nonce changed.
+	std::vector<uint64_t> proofNonces = pMainnet->GetProofOfWork().GetProofNonces();
+	proofNonces[20]++;
+	auto pInvalid = std::make_shared<const BlockHeader>(
+		pMainnet->GetVersion(),
+		pMainnet->GetHeight(),
+		pMainnet->GetTimestamp(),
+		Hash(pMainnet->GetPreviousHash()),
+		Hash(pMainnet->GetPreviousRoot()),
+		Hash(pMainnet->GetOutputRoot()),
+		Hash(pMainnet->GetRangeProofRoot()),
+		Hash(pMainnet->GetKernelRoot()),
+		BlindingFactor(pMainnet->GetTotalKernelOffset()),
+		pMainnet->GetOutputMMRSize(),
+		pMainnet->GetKernelMMRSize(),
+		pMainnet->GetTotalDifficulty(),
+		pMainnet->GetScalingDifficulty(),
+		pMainnet->GetNonce(),
+		ProofOfWork(pMainnet->GetEdgeBits(), std::move(proofNonces))
+	);
+	REQUIRE_FALSE(PoWValidator::IsCycleValid(*pInvalid));
+
+	// Enough headers to be split across the thread pool.
+	std::vector<BlockHeaderPtr> headers;
+	for (size_t i = 0; i < 100; i++) {
+		headers.push_back(i % 3 == 0 ? pFloonet : (i % 3 == 1 ? pMainnet : pInvalid));
+	}
+
+	const std::vector<bool> valid = PoWValidator::AreCyclesValid(headers);
+	REQUIRE(valid.size() == headers.size());
+	for (size_t i = 0; i < headers.size(); i++) {
+		REQUIRE(valid[i] == (i % 3 != 2));
+	}
+
+	REQUIRE(PoWValidator::AreCyclesValid({}).empty());
+}
@@ -0,0 +1,94 @@
+#include <catch.hpp>
+
+#include <PoW/Common.h>
+#include <PoW/SipHashBatch.h>
+
+#include <random>
+
+static std::vector<SipHashBatch::EImpl> GetSupportedImpls()
+{
+	std::vector<SipHashBatch::EImpl> impls({ SipHashBatch::EImpl::SCALAR });
+	if (SipHashBatch::GetSupported() != SipHashBatch::EImpl::SCALAR) {
+		impls.push_back(SipHashBatch::EImpl::SSE2);
+	}
+
+	if (SipHashBatch::GetSupported() == SipHashBatch::EImpl::AVX2) {
+		impls.push_back(SipHashBatch::EImpl::AVX2);
+	}
+
+	return impls;
+}
+
+template <int rotE>
+static uint64_t Hash24(const siphash_keys& keys, const uint64_t nonce)
+{
+	siphash_state<rotE> state(keys);
+	state.hash24(nonce);
+	return state.xor_lanes();
+}
+
+TEST_CASE("SipHashBatch - Hash24 matches siphash_state")
+{
+	std::mt19937_64 rng(42);
+	uint64_t keybuf[4] = { rng(), rng(), rng(), rng() };
+	const siphash_keys keys((const char*)keybuf);
+
+	// Odd count, so every implementation also hashes a tail narrower than its lanes.
+	std::vector<uint64_t> nonces;
+	for (size_t i = 0; i < 2 * PROOFSIZE + 3; i++) {
+		nonces.push_back(rng() & 0xffffffff);
+	}
+
+	for (const SipHashBatch::EImpl impl : GetSupportedImpls())
+	{
+		INFO(SipHashBatch::ToString(impl));
+
+		std::vector<uint64_t> out21(nonces.size());
+		SipHashBatch::Hash24(impl, keys, 21, nonces.data(), out21.data(), nonces.size());
+
+		std::vector<uint64_t> out25(nonces.size());
+		SipHashBatch::Hash24(impl, keys, 25, nonces.data(), out25.data(), nonces.size());
+
+		for (size_t i = 0; i < nonces.size(); i++)
+		{
+			REQUIRE(out21[i] == Hash24<21>(keys, nonces[i]));
+			REQUIRE(out25[i] == Hash24<25>(keys, nonces[i]));
+		}
+	}
+
+	REQUIRE_THROWS(SipHashBatch::Hash24(keys, 22, nonces.data(), nonces.data(), nonces.size()));
+}
+
+TEST_CASE("SipHashBatch - HashBlocks matches chained siphash_state")
+{
+	std::mt19937_64 rng(7);
+	uint64_t keybuf[4] = { rng(), rng(), rng(), rng() };
+	const siphash_keys keys((const char*)keybuf);
+
+	std::vector<uint64_t> edges;
+	for (size_t i = 0; i < 7; i++) {
+		edges.push_back(rng() & ((1ull << 29) - 1));
+	}
+
+	for (const uint32_t rotE : { 21, 25 })
+	{
+		std::vector<uint64_t> expected(edges.size() * EDGE_BLOCK_SIZE);
+		SipHashBatch::HashBlocks(SipHashBatch::EImpl::SCALAR, keys, rotE, edges.data(), expected.data(), edges.size());
+
+		// The first output of each block is a plain hash of the block's first nonce.
+		for (size_t n = 0; n < edges.size(); n++)
+		{
+			const uint64_t edge0 = edges[n] & ~(uint64_t)EDGE_BLOCK_MASK;
+			REQUIRE(expected[n * EDGE_BLOCK_SIZE] == (rotE == 21 ? Hash24<21>(keys, edge0) : Hash24<25>(keys, edge0)));
+		}
+
+		for (const SipHashBatch::EImpl impl : GetSupportedImpls())
+		{
+			INFO(SipHashBatch::ToString(impl));
+
+			std::vector<uint64_t> out(edges.size() * EDGE_BLOCK_SIZE);
+			SipHashBatch::HashBlocks(impl, keys, rotE, edges.data(), out.data(), edges.size());
+			REQUIRE(out == expected);
+		}
+	}
+}
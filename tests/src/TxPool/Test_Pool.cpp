@@ -0,0 +1,159 @@
+#include <catch.hpp>
+
+#include <TxPool/Pool.h>
+#include <FakeModels.h>
+#include <limits>
+
+static const uint64_t UNLIMITED = std::numeric_limits<uint64_t>::max();
+
+TEST_CASE("Pool - Weight and fee rate")
+{
+	// 1 input, 1 output, 1 kernel
+	TransactionPtr pTx = FakeModels::CreateTx({ 1 }, { 2 }, 2500);
+	REQUIRE(Pool::CalculateWeight(*pTx) == 25);
+	REQUIRE(Pool::CalculateFeeRate(*pTx, 25) == 100.0);
+	REQUIRE(Pool::EstimateBytes(*pTx) > 675);
+
+	Pool pool(UNLIMITED, UNLIMITED);
+	REQUIRE(pool.AddTransaction(pTx, EDandelionStatus::FLUFFED).empty());
+	REQUIRE(pool.Size() == 1);
+	REQUIRE(pool.GetTotalWeight() == 25);
+	REQUIRE(pool.GetTotalBytes() == Pool::EstimateBytes(*pTx));
+
+	// Adding it again is a no-op.
+	REQUIRE(pool.AddTransaction(pTx, EDandelionStatus::FLUFFED).empty());
+	REQUIRE(pool.Size() == 1);
+
+	pool.RemoveTransaction(*pTx);
+	REQUIRE(pool.Size() == 0);
+	REQUIRE(pool.GetTotalWeight() == 0);
+	REQUIRE(pool.GetTotalBytes() == 0);
+}
+
+TEST_CASE("Pool - Evicts lowest fee rate")
+{
+	// Room for 3 txs of weight 25.
+	Pool pool(75, UNLIMITED);
+
+	TransactionPtr pTx100 = FakeModels::CreateTx({ 1 }, { 2 }, 100);
+	TransactionPtr pTx300 = FakeModels::CreateTx({ 3 }, { 4 }, 300);
+	TransactionPtr pTx200 = FakeModels::CreateTx({ 5 }, { 6 }, 200);
+	REQUIRE(pool.AddTransaction(pTx100, EDandelionStatus::FLUFFED).empty());
+	REQUIRE(pool.AddTransaction(pTx300, EDandelionStatus::FLUFFED).empty());
+	REQUIRE(pool.AddTransaction(pTx200, EDandelionStatus::FLUFFED).empty());
+
+	// Pool is full, so only txs paying more than the lowest fee rate get in.
+	REQUIRE_FALSE(pool.MeetsEvictionFloor(*FakeModels::CreateTx({ 7 }, { 8 }, 50)));
+	REQUIRE_FALSE(pool.MeetsEvictionFloor(*FakeModels::CreateTx({ 7 }, { 8 }, 100)));
+
+	TransactionPtr pTx400 = FakeModels::CreateTx({ 7 }, { 8 }, 400);
+	REQUIRE(pool.MeetsEvictionFloor(*pTx400));
+
+	const std::vector<TransactionPtr> evicted = pool.AddTransaction(pTx400, EDandelionStatus::FLUFFED);
+	REQUIRE(evicted.size() == 1);
+	REQUIRE(evicted.front() == pTx100);
+	REQUIRE(pool.Size() == 3);
+	REQUIRE(pool.GetTotalWeight() == 75);
+	REQUIRE_FALSE(pool.ContainsTransaction(*pTx100));
+
+	// The floor is now the 200 fee tx.
+	REQUIRE_FALSE(pool.MeetsEvictionFloor(*FakeModels::CreateTx({ 9 }, { 10 }, 150)));
+	REQUIRE(pool.MeetsEvictionFloor(*FakeModels::CreateTx({ 9 }, { 10 }, 250)));
+
+	// Txs larger than the whole pool never get in.
+	REQUIRE_FALSE(pool.MeetsEvictionFloor(*FakeModels::CreateTx({ 9 }, { 10, 11, 12, 13 }, 1'000'000)));
+}
+
+TEST_CASE("Pool - Evicts dependents")
+{
+	Pool pool(75, UNLIMITED);
+
+	// The child spends the parent's output, so it has to go along with it.
+	TransactionPtr pParent = FakeModels::CreateTx({ 1 }, { 2 }, 100);
+	TransactionPtr pChild = FakeModels::CreateTx({ 2 }, { 3 }, 1000);
+	TransactionPtr pOther = FakeModels::CreateTx({ 4 }, { 5 }, 300);
+	pool.AddTransaction(pParent, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pChild, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pOther, EDandelionStatus::FLUFFED);
+
+	TransactionPtr pNew = FakeModels::CreateTx({ 6 }, { 7 }, 200);
+	const std::vector<TransactionPtr> evicted = pool.AddTransaction(pNew, EDandelionStatus::FLUFFED);
+	REQUIRE(evicted.size() == 2);
+	REQUIRE(evicted[0] == pParent);
+	REQUIRE(evicted[1] == pChild);
+	REQUIRE(pool.Size() == 2);
+	REQUIRE(pool.GetTotalWeight() == 50);
+	REQUIRE(pool.ContainsTransaction(*pOther));
+	REQUIRE(pool.ContainsTransaction(*pNew));
+}
+
+TEST_CASE("Pool - Memory limit")
+{
+	TransactionPtr pTx1 = FakeModels::CreateTx({ 1 }, { 2 }, 100);
+	TransactionPtr pTx2 = FakeModels::CreateTx({ 3 }, { 4 }, 200);
+	TransactionPtr pTx3 = FakeModels::CreateTx({ 5 }, { 6 }, 300);
+
+	Pool pool(UNLIMITED, Pool::EstimateBytes(*pTx1) * 2);
+	pool.AddTransaction(pTx1, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pTx2, EDandelionStatus::FLUFFED);
+
+	const std::vector<TransactionPtr> evicted = pool.AddTransaction(pTx3, EDandelionStatus::FLUFFED);
+	REQUIRE(evicted.size() == 1);
+	REQUIRE(evicted.front() == pTx1);
+	REQUIRE(pool.GetTotalBytes() <= Pool::EstimateBytes(*pTx1) * 2);
+}
+
+TEST_CASE("Pool - Ordered by fee rate, parents first")
+{
+	Pool pool(UNLIMITED, UNLIMITED);
+
+	TransactionPtr pParent = FakeModels::CreateTx({ 1 }, { 2 }, 100);
+	TransactionPtr pChild = FakeModels::CreateTx({ 2 }, { 3 }, 1000);
+	TransactionPtr pHigh = FakeModels::CreateTx({ 4 }, { 5 }, 500);
+	TransactionPtr pLow = FakeModels::CreateTx({ 6 }, { 7 }, 50);
+	TransactionPtr pStemmed = FakeModels::CreateTx({ 8 }, { 9 }, 5000);
+	pool.AddTransaction(pParent, EDandelionStatus::TO_FLUFF);
+	pool.AddTransaction(pChild, EDandelionStatus::TO_FLUFF);
+	pool.AddTransaction(pHigh, EDandelionStatus::TO_FLUFF);
+	pool.AddTransaction(pLow, EDandelionStatus::TO_FLUFF);
+	pool.AddTransaction(pStemmed, EDandelionStatus::TO_STEM);
+
+	const std::vector<TransactionPtr> toFluff = pool.FindTransactionsByStatus(EDandelionStatus::TO_FLUFF);
+	REQUIRE(toFluff == std::vector<TransactionPtr>{ pHigh, pParent, pChild, pLow });
+
+	pool.ChangeStatus({ pHigh }, EDandelionStatus::STEMMED);
+	REQUIRE(pool.FindTransactionsByStatus(EDandelionStatus::STEMMED) == std::vector<TransactionPtr>{ pHigh });
+
+	// Entries are still listed in the order they were added.
+	const std::vector<TxPoolEntry> entries = pool.GetEntries();
+	REQUIRE(entries.size() == 5);
+	REQUIRE(entries.front().GetTransaction() == pParent);
+	REQUIRE(entries.back().GetTransaction() == pStemmed);
+}
+
+TEST_CASE("Pool - Select for block")
+{
+	Pool pool(UNLIMITED, UNLIMITED);
+
+	TransactionPtr pParent = FakeModels::CreateTx({ 1 }, { 2 }, 100);
+	TransactionPtr pChild = FakeModels::CreateTx({ 2 }, { 3 }, 1000);
+	TransactionPtr pHigh = FakeModels::CreateTx({ 4 }, { 5 }, 500);
+	TransactionPtr pDoubleSpend = FakeModels::CreateTx({ 4 }, { 6 }, 400);
+	TransactionPtr pLow = FakeModels::CreateTx({ 7 }, { 8 }, 50);
+	pool.AddTransaction(pParent, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pChild, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pHigh, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pDoubleSpend, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pLow, EDandelionStatus::FLUFFED);
+
+	// The double spend loses to the tx paying more.
+	REQUIRE(pool.SelectForBlock(UNLIMITED) == std::vector<TransactionPtr>{ pHigh, pParent, pChild, pLow });
+
+	// Only room for 2 txs, so the child doesn't fit after its parent.
+	REQUIRE(pool.SelectForBlock(50) == std::vector<TransactionPtr>{ pHigh, pParent });
+	REQUIRE(pool.SelectForBlock(24).empty());
+
+	const uint64_t version = pool.GetVersion();
+	pool.RemoveTransaction(*pLow);
+	REQUIRE(pool.GetVersion() != version);
+}
@@ -0,0 +1,63 @@
+#include <catch.hpp>
+
+#include <TxPool/TxPoolSnapshot.h>
+#include <Core/Exceptions/DeserializationException.h>
+#include <FakeModels.h>
+
+static std::vector<TxPoolSnapshot::Entry> CreateEntries()
+{
+	const auto timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(1'600'000'000'123));
+
+	std::vector<TxPoolSnapshot::Entry> entries;
+	entries.push_back(TxPoolSnapshot::Entry{ EPoolType::MEMPOOL, EDandelionStatus::FLUFFED, timestamp, FakeModels::CreateTx(1, 1000, EOutputFeatures::COINBASE_OUTPUT) });
+	entries.push_back(TxPoolSnapshot::Entry{ EPoolType::MEMPOOL, EDandelionStatus::FLUFFED, timestamp + std::chrono::seconds(1), FakeModels::CreateTx(10, 2000, EOutputFeatures::COINBASE_OUTPUT) });
+	entries.push_back(TxPoolSnapshot::Entry{ EPoolType::STEMPOOL, EDandelionStatus::STEMMED, timestamp + std::chrono::seconds(2), FakeModels::CreateTx(20, 3000, EOutputFeatures::COINBASE_OUTPUT) });
+	return entries;
+}
+
+TEST_CASE("TxPoolSnapshot - Round trip")
+{
+	const std::vector<TxPoolSnapshot::Entry> entries = CreateEntries();
+	const std::vector<TxPoolSnapshot::Entry> restored = TxPoolSnapshot::Deserialize(TxPoolSnapshot::Serialize(entries));
+
+	REQUIRE(restored.size() == entries.size());
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		REQUIRE(restored[i].poolType == entries[i].poolType);
+		REQUIRE(restored[i].status == entries[i].status);
+		REQUIRE(restored[i].timestamp == entries[i].timestamp);
+		REQUIRE(restored[i].pTransaction->GetHash() == entries[i].pTransaction->GetHash());
+
+		// Input features survive, so restoring never needs a UTXO lookup.
+		REQUIRE(restored[i].pTransaction->GetInputs().front().GetFeatures() == EOutputFeatures::COINBASE_OUTPUT);
+	}
+
+	REQUIRE(TxPoolSnapshot::Deserialize(TxPoolSnapshot::Serialize({})).empty());
+}
+
+TEST_CASE("TxPoolSnapshot - Corruption")
+{
+	const std::vector<uint8_t> bytes = TxPoolSnapshot::Serialize(CreateEntries());
+
+	// Truncated
+	REQUIRE_THROWS_AS(TxPoolSnapshot::Deserialize(std::vector<uint8_t>(bytes.begin(), bytes.begin() + 40)), DeserializationException);
+	REQUIRE_THROWS_AS(TxPoolSnapshot::Deserialize(std::vector<uint8_t>(bytes.begin(), bytes.end() - 1)), DeserializationException);
+
+	// Flipped bit
+	std::vector<uint8_t> flipped = bytes;
+	flipped[bytes.size() / 2] ^= 0x01;
+	REQUIRE_THROWS_AS(TxPoolSnapshot::Deserialize(flipped), DeserializationException);
+}
+
+TEST_CASE("TxPoolSnapshot - File")
+{
+	const fs::path path = fs::temp_directory_path() / "Test_TxPoolSnapshot.bin";
+	fs::remove(path);
+
+	REQUIRE(TxPoolSnapshot::Read(path).empty());
+
+	TxPoolSnapshot::Write(path, CreateEntries());
+	REQUIRE(TxPoolSnapshot::Read(path).size() == 3);
+
+	fs::remove(path);
+}
@@ -26,6 +26,10 @@ TEST_CASE("Config")
 	REQUIRE(pConfig->GetLogDirectory().generic_u8string().find("LOGS") != std::string::npos);
 	REQUIRE(pConfig->GetLogLevel() == "DEBUG");
 	REQUIRE(pConfig->IsTorBridgesEnabled() == false);
+	REQUIRE(pConfig->GetRestAPIOptions().numThreads == 32);
+	REQUIRE(pConfig->GetRestAPIOptions().keepAlive == true);
+	REQUIRE(pConfig->GetFastLanePort().has_value() == false);
+	REQUIRE(pConfig->GetOwnerAPIOptions().keepAlive == true);
 	// TOR
 	fs::path dataPath = pConfig->GetTorDataPath();
 	std::string torrcPath{ pConfig->GetTorrcPath().u8string() };
@@ -100,4 +104,31 @@ TEST_CASE("Config")
 	REQUIRE(pConfig->GetPreferredPeers().empty() == true);
 	REQUIRE(pConfig->GetAllowedPeers().empty() == true);
 	REQUIRE(pConfig->GetBlockedPeers().empty() == true);
+}
+
+TEST_CASE("Config - HTTP server options")
+{
+	Json::Value json = Config::Default(Environment::AUTOMATED_TESTING)->GetJSON();
+
+	Json::Value restJSON;
+	restJSON["NUM_THREADS"] = 64;
+	restJSON["ENABLE_KEEP_ALIVE"] = false;
+	json["SERVER"]["REST_API"] = restJSON;
+	json["SERVER"]["FAST_LANE_PORT"] = 13415;
+
+	Json::Value ownerJSON;
+	ownerJSON["KEEP_ALIVE_TIMEOUT_MS"] = 10000;
+	ownerJSON["REQUEST_TIMEOUT_MS"] = 30000;
+	json["WALLET"]["OWNER_API"] = ownerJSON;
+
+	ConfigPtr pConfig = Config::Load(json, Environment::AUTOMATED_TESTING);
+
+	REQUIRE(pConfig->GetRestAPIOptions().numThreads == 64);
+	REQUIRE(pConfig->GetRestAPIOptions().keepAlive == false);
+	REQUIRE(pConfig->GetFastLanePort() == std::make_optional<uint16_t>(13415));
+	REQUIRE(pConfig->GetFastLaneOptions().numThreads == 4);
+	REQUIRE(pConfig->GetOwnerAPIOptions().numThreads == 32);
+	REQUIRE(pConfig->GetOwnerAPIOptions().keepAliveTimeoutMs == 10000);
+	REQUIRE(pConfig->GetOwnerAPIOptions().requestTimeoutMs == 30000);
+	REQUIRE(pConfig->GetForeignAPIOptions().keepAlive == true);
 }
\ No newline at end of file
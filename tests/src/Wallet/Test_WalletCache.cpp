@@ -0,0 +1,160 @@
+#include <catch.hpp>
+
+#include <TestFileUtil.h>
+
+#include <Wallet/WalletDB/Sqlite/WalletSqlite.h>
+#include <Wallet/WalletDB/Sqlite/Tables/OutputsTable.h>
+#include <Wallet/WalletDB/Sqlite/Tables/TransactionsTable.h>
+#include <Wallet/WalletDB/Sqlite/Tables/MetadataTable.h>
+#include <Core/Traits/Lockable.h>
+
+static Locked<IWalletDB> OpenWallet(const SqliteDB::Ptr& pDatabase)
+{
+	return Locked<IWalletDB>(std::make_shared<WalletSqlite>(fs::temp_directory_path(), "test", pDatabase));
+}
+
+static OutputDataEntity CreateOutput(const uint8_t i, const EOutputStatus status)
+{
+	return OutputDataEntity(
+		KeyChainPath::FromString("m/0/0").GetChild(i),
+		SecretKey(CBigInteger<32>::ValueOf(i)),
+		TransactionOutput(EOutputFeatures::DEFAULT, Commitment(CBigInteger<33>::ValueOf(i)), RangeProof(std::vector<uint8_t>(675, i))),
+		1000 * (uint64_t)i,
+		status,
+		std::nullopt,
+		std::nullopt,
+		std::nullopt,
+		std::vector<std::string>{}
+	);
+}
+
+static WalletTx CreateTx(const uint32_t walletTxId)
+{
+	return WalletTx(
+		walletTxId,
+		EWalletTxType::RECEIVED,
+		std::nullopt,
+		std::nullopt,
+		std::nullopt,
+		std::chrono::system_clock::now(),
+		std::nullopt,
+		std::nullopt,
+		1000,
+		0,
+		std::nullopt,
+		std::nullopt,
+		std::nullopt
+	);
+}
+
+static std::unique_ptr<OutputDataEntity> FindOutput(const std::vector<OutputDataEntity>& outputs, const Commitment& commitment)
+{
+	for (const OutputDataEntity& output : outputs) {
+		if (output.GetCommitment() == commitment) {
+			return std::make_unique<OutputDataEntity>(output);
+		}
+	}
+
+	return nullptr;
+}
+
+TEST_CASE("WalletCache - Commit & Rollback")
+{
+	auto pTempFile = TestFileUtil::CreateTempFile();
+	SqliteDB::Ptr pDatabase = SqliteDB::Open(pTempFile->GetPath(), "test");
+	OutputsTable::CreateTable(*pDatabase);
+	TransactionsTable::CreateTable(*pDatabase);
+	MetadataTable::CreateTable(*pDatabase);
+
+	const SecureVector masterSeed(32, 7);
+	const OutputDataEntity output1 = CreateOutput(1, EOutputStatus::SPENDABLE);
+	const OutputDataEntity output2 = CreateOutput(2, EOutputStatus::SPENDABLE);
+
+	Locked<IWalletDB> walletDB = OpenWallet(pDatabase);
+
+	// Load the cache before anything is written, so commits must be applied to it.
+	REQUIRE(walletDB.Read()->GetOutputs(masterSeed).empty());
+
+	SECTION("Commit")
+	{
+		{
+			auto pBatch = walletDB.BatchWrite();
+			pBatch->AddOutputs(masterSeed, { output1 });
+			pBatch->AddTransaction(masterSeed, CreateTx(1));
+
+			// Pending writes are visible within the batch.
+			REQUIRE(pBatch->GetOutputs(masterSeed).size() == 1);
+			REQUIRE(pBatch->GetTransactionById(masterSeed, 1) != nullptr);
+
+			pBatch->Commit();
+		}
+
+		auto pReader = walletDB.Read();
+		REQUIRE(pReader->GetOutputs(masterSeed).size() == 1);
+		REQUIRE(FindOutput(pReader->GetOutputs(masterSeed), output1.GetCommitment()) != nullptr);
+		REQUIRE(pReader->GetTransactions(masterSeed).size() == 1);
+		REQUIRE(pReader->GetTransactionById(masterSeed, 1) != nullptr);
+
+		// The cache matches what was committed to the database.
+		Locked<IWalletDB> reopened = OpenWallet(pDatabase);
+		REQUIRE(reopened.Read()->GetOutputs(masterSeed).size() == 1);
+		REQUIRE(reopened.Read()->GetTransactions(masterSeed).size() == 1);
+	}
+
+	SECTION("Rollback")
+	{
+		{
+			auto pBatch = walletDB.BatchWrite();
+			pBatch->AddOutputs(masterSeed, { output1 });
+			pBatch->Commit();
+		}
+
+		{
+			auto pBatch = walletDB.BatchWrite();
+
+			OutputDataEntity spent = output1;
+			spent.SetStatus(EOutputStatus::SPENT);
+			pBatch->AddOutputs(masterSeed, { spent, output2 });
+			pBatch->AddTransaction(masterSeed, CreateTx(2));
+			REQUIRE(pBatch->GetOutputs(masterSeed).size() == 2);
+
+			pBatch->Rollback();
+		}
+
+		auto pReader = walletDB.Read();
+		const std::vector<OutputDataEntity> outputs = pReader->GetOutputs(masterSeed);
+		REQUIRE(outputs.size() == 1);
+		REQUIRE(FindOutput(outputs, output1.GetCommitment())->GetStatus() == EOutputStatus::SPENDABLE);
+		REQUIRE(FindOutput(outputs, output2.GetCommitment()) == nullptr);
+		REQUIRE(pReader->GetTransactionById(masterSeed, 2) == nullptr);
+
+		Locked<IWalletDB> reopened = OpenWallet(pDatabase);
+		REQUIRE(reopened.Read()->GetOutputs(masterSeed).size() == 1);
+		REQUIRE(reopened.Read()->GetTransactions(masterSeed).empty());
+	}
+
+	SECTION("Rollback after loading the cache mid-batch")
+	{
+		// A new session's cache is first loaded inside the batch, so it reads the uncommitted row.
+		Locked<IWalletDB> reopened = OpenWallet(pDatabase);
+		{
+			auto pBatch = reopened.BatchWrite();
+			pBatch->AddOutputs(masterSeed, { output2 });
+			REQUIRE(pBatch->GetOutputs(masterSeed).size() == 1);
+
+			pBatch->Rollback();
+		}
+
+		REQUIRE(reopened.Read()->GetOutputs(masterSeed).empty());
+	}
+
+	SECTION("Uncommitted batch is rolled back")
+	{
+		{
+			auto pBatch = walletDB.BatchWrite();
+			pBatch->AddOutputs(masterSeed, { output2 });
+		}
+
+		REQUIRE(walletDB.Read()->GetOutputs(masterSeed).empty());
+	}
+}